@@ -5,12 +5,18 @@
 #include <vespa/document/config/documenttypes_config_fwd.h>
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/datatype/referencedatatype.h>
+#include <vespa/document/datatype/mapdatatype.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/mapfieldvalue.h>
 #include <vespa/document/fieldvalue/referencefieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/repo/document_type_repo_factory.h>
 #include <vespa/document/select/parser.h>
+#include <vespa/document/serialization/lazydocumentview.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("document_select_test");
@@ -21,8 +27,12 @@ using document::DocumentType;
 using document::DocumentTypeRepo;
 using document::DocumentTypeRepoFactory;
 using document::Field;
+using document::IntFieldValue;
+using document::LazyDocumentView;
+using document::MapFieldValue;
 using document::ReferenceDataType;
 using document::ReferenceFieldValue;
+using document::StringFieldValue;
 using document::BucketIdFactory;
 using document::select::Parser;
 using document::select::Result;
@@ -30,6 +40,7 @@ using document::select::ResultList;
 
 std::shared_ptr<DocumenttypesConfig> make_document_types() {
     using Struct = document::config_builder::Struct;
+    using Map = document::config_builder::Map;
     document::config_builder::DocumenttypesConfigBuilderHelper builder;
     constexpr int parent_doctype_id = 42;
     constexpr int child_doctype_id = 43;
@@ -39,7 +50,8 @@ std::shared_ptr<DocumenttypesConfig> make_document_types() {
                      Struct("parent.body"));
     builder.document(child_doctype_id, "child",
                      Struct("child.header").
-                     addField("ref", ref_type_id),
+                     addField("ref", ref_type_id).
+                     addField("weights", Map(document::DataType::T_STRING, document::DataType::T_INT)),
                      Struct("child.body")).
         referenceType(ref_type_id, parent_doctype_id);
     return std::make_shared<DocumenttypesConfig>(builder.config());
@@ -59,6 +71,7 @@ public:
     DocumentSelectTest();
     ~DocumentSelectTest() override;
     void check_select(const Document &doc, const vespalib::string &expression, const Result &exp_result);
+    void check_select(const LazyDocumentView &view, const vespalib::string &expression, const Result &exp_result);
 };
 
 DocumentSelectTest::DocumentSelectTest()
@@ -82,6 +95,13 @@ DocumentSelectTest::check_select(const Document& doc, const vespalib::string& ex
     EXPECT_EQ(node->contains(doc), exp_result);
 }
 
+void
+DocumentSelectTest::check_select(const LazyDocumentView& view, const vespalib::string& expression, const Result &exp_result)
+{
+    auto node = _parser->parse(expression);
+    EXPECT_EQ(node->contains(view), exp_result);
+}
+
 
 TEST_F(DocumentSelectTest, check_existing_reference_field)
 {
@@ -116,4 +136,24 @@ TEST_F(DocumentSelectTest, check_missing_reference_field)
     check_select(*document, "child.ref > \"id::parent::2\"", Result::Invalid);
 }
 
+TEST_F(DocumentSelectTest, check_lazy_document_view)
+{
+    auto document = std::make_unique<Document>(*_child_document_type, DocumentId("id::child::0"));
+    document->setFieldValue(_child_ref_field, std::make_unique<ReferenceFieldValue>(_child_ref_field_type, DocumentId("id::parent::1")));
+    MapFieldValue weights(_child_document_type->getField("weights").getDataType());
+    weights.put(StringFieldValue("foo"), IntFieldValue(3));
+    weights.put(StringFieldValue("bar"), IntFieldValue(5));
+    document->setValue("weights", weights);
+    vespalib::nbostream stream = document->serialize();
+    LazyDocumentView view(*_repo, stream);
+    check_select(view, "child", Result::True);
+    check_select(view, "parent", Result::False);
+    check_select(view, "id.type == \"child\"", Result::True);
+    check_select(view, "child.ref == \"id::parent::1\"", Result::True);
+    check_select(view, "child.weights{bar} == 5", Result::True);
+    check_select(view, "child.weights{foo} == 5", Result::False);
+    check_select(view, "child.weights{baz} == null", Result::True);
+    check_select(view, "child.weights.value == 3", Result::True);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,234 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/base/exceptions.h>
+#include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/datatype/mapdatatype.h>
+#include <vespa/document/fieldset/fieldsets.h>
+#include <vespa/document/fieldvalue/arrayfieldvalue.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/iteratorhandler.h>
+#include <vespa/document/fieldvalue/mapfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/fieldvalue/structfieldvalue.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/serialization/lazydocumentview.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace document;
+using vespalib::nbostream;
+
+namespace {
+
+class Collector : public fieldvalue::IteratorHandler {
+public:
+    std::vector<vespalib::string> values;
+private:
+    void onPrimitive(uint32_t, const Content & content) override {
+        values.push_back(content.getValue().toString());
+    }
+};
+
+StructFieldValue
+make_mystruct(const Document & doc, int32_t key, const vespalib::string & value)
+{
+    StructFieldValue result(doc.getField("mystruct").getDataType());
+    result.setValue("key", IntFieldValue(key));
+    result.setValue("value", StringFieldValue(value));
+    return result;
+}
+
+}
+
+class LazyDocumentViewTest : public ::testing::Test {
+protected:
+    TestDocRepo              _test_repo;
+    const DocumentTypeRepo & _repo;
+    Document                 _doc;
+
+    LazyDocumentViewTest();
+    ~LazyDocumentViewTest() override;
+
+    std::unique_ptr<LazyDocumentView> make_view() const {
+        nbostream stream = _doc.serialize();
+        return std::make_unique<LazyDocumentView>(_repo, stream);
+    }
+    FieldPath field_path(vespalib::stringref expression) const {
+        FieldPath path;
+        _doc.getType().buildFieldPath(path, expression);
+        return path;
+    }
+    std::vector<vespalib::string> collect_from_document(vespalib::stringref expression) const {
+        Collector collector;
+        _doc.iterateNested(field_path(expression), collector);
+        return collector.values;
+    }
+    std::vector<vespalib::string> collect_from_view(const LazyDocumentView & view, vespalib::stringref expression) const {
+        Collector collector;
+        FieldPath path = field_path(expression);
+        view.iterateNested(path.getFullRange(), collector);
+        return collector.values;
+    }
+};
+
+LazyDocumentViewTest::LazyDocumentViewTest()
+    : _test_repo(),
+      _repo(_test_repo.getTypeRepo()),
+      _doc(*_repo.getDocumentType("testdoctype1"), DocumentId("id:ns:testdoctype1::lazy"))
+{
+    _doc.setValue("headerval", IntFieldValue(42));
+    _doc.setValue("content", StringFieldValue("a long body that is never decoded"));
+    _doc.setValue("mystruct", make_mystruct(_doc, 1, "first"));
+
+    ArrayFieldValue tags(_doc.getField("tags").getDataType());
+    tags.add(StringFieldValue("tag0"));
+    tags.add(StringFieldValue("tag1"));
+    tags.add(StringFieldValue("tag2"));
+    _doc.setValue("tags", tags);
+
+    MapFieldValue mymap(_doc.getField("mymap").getDataType());
+    mymap.put(IntFieldValue(3), StringFieldValue("three"));
+    mymap.put(IntFieldValue(5), StringFieldValue("five"));
+    _doc.setValue("mymap", mymap);
+
+    const DataType & struct_map_type = _doc.getField("structarrmap").getDataType();
+    const DataType & struct_array_type = struct_map_type.cast_map()->getValueType();
+    MapFieldValue structarrmap(struct_map_type);
+    ArrayFieldValue a_array(struct_array_type);
+    a_array.add(make_mystruct(_doc, 10, "a0"));
+    ArrayFieldValue b_array(struct_array_type);
+    b_array.add(make_mystruct(_doc, 20, "b0"));
+    b_array.add(make_mystruct(_doc, 21, "b1"));
+    structarrmap.put(StringFieldValue("a"), a_array);
+    structarrmap.put(StringFieldValue("b"), b_array);
+    _doc.setValue("structarrmap", structarrmap);
+}
+
+LazyDocumentViewTest::~LazyDocumentViewTest() = default;
+
+TEST_F(LazyDocumentViewTest, header_is_read_without_decoding_fields)
+{
+    auto view = make_view();
+    EXPECT_EQ(_doc.getId(), view->getId());
+    EXPECT_EQ(_doc.getType(), view->getType());
+    EXPECT_TRUE(view->hasValue(view->getField("content")));
+    EXPECT_FALSE(view->hasValue(view->getField("title")));
+    EXPECT_THROW(view->getField("no_such_field"), FieldNotFoundException);
+    EXPECT_EQ(0u, view->getDecodedValueCount());
+}
+
+TEST_F(LazyDocumentViewTest, single_field_is_decoded_on_access)
+{
+    auto view = make_view();
+    auto value = view->getValue(view->getField("headerval"));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(IntFieldValue(42), *value);
+    EXPECT_FALSE(view->getValue(view->getField("title")));
+    EXPECT_EQ(1u, view->getDecodedValueCount());
+}
+
+TEST_F(LazyDocumentViewTest, struct_field_is_decoded_without_the_rest_of_the_struct)
+{
+    auto view = make_view();
+    auto value = view->getNestedValue(field_path("mystruct.value"));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(StringFieldValue("first"), *value);
+    EXPECT_EQ(1u, view->getDecodedValueCount());
+}
+
+TEST_F(LazyDocumentViewTest, array_element_is_decoded_without_the_other_elements)
+{
+    auto view = make_view();
+    auto value = view->getNestedValue(field_path("tags[2]"));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(StringFieldValue("tag2"), *value);
+    EXPECT_FALSE(view->getNestedValue(field_path("tags[3]")));
+    EXPECT_EQ(1u, view->getDecodedValueCount());
+}
+
+TEST_F(LazyDocumentViewTest, map_value_is_decoded_without_the_other_values)
+{
+    auto view = make_view();
+    auto value = view->getNestedValue(field_path("mymap{5}"));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(StringFieldValue("five"), *value);
+    // Both keys are compared, only the matching value is decoded.
+    EXPECT_EQ(3u, view->getDecodedValueCount());
+    EXPECT_FALSE(view->getNestedValue(field_path("mymap{4}")));
+}
+
+TEST_F(LazyDocumentViewTest, nested_struct_in_map_of_arrays_is_decoded_on_its_own)
+{
+    auto view = make_view();
+    auto value = view->getNestedValue(field_path("structarrmap{b}[1].value"));
+    ASSERT_TRUE(value);
+    EXPECT_EQ(StringFieldValue("b1"), *value);
+    EXPECT_EQ(3u, view->getDecodedValueCount());
+    EXPECT_FALSE(view->getNestedValue(field_path("structarrmap{c}[0].value")));
+    EXPECT_FALSE(view->getNestedValue(field_path("structarrmap{a}[1].value")));
+}
+
+TEST_F(LazyDocumentViewTest, path_addressing_several_values_is_rejected_by_get_nested_value)
+{
+    auto view = make_view();
+    EXPECT_THROW(view->getNestedValue(field_path("structarrmap.value")), vespalib::IllegalArgumentException);
+}
+
+TEST_F(LazyDocumentViewTest, iterate_nested_matches_document)
+{
+    auto view = make_view();
+    for (const char * expression : {"headerval", "mystruct.key", "tags", "tags[1]", "mymap{3}", "mymap.key",
+                                    "mymap.value", "structarrmap{b}", "structarrmap{b}[0].key",
+                                    "structarrmap.value", "structarrmap{b}[$x].value", "title", "mymap{4}"})
+    {
+        SCOPED_TRACE(expression);
+        EXPECT_EQ(collect_from_document(expression), collect_from_view(*view, expression));
+    }
+}
+
+TEST_F(LazyDocumentViewTest, iterate_nested_only_decodes_the_field_it_ends_in)
+{
+    auto view = make_view();
+    EXPECT_EQ(std::vector<vespalib::string>({"b0", "b1"}), collect_from_view(*view, "structarrmap{b}[$x].value"));
+    // Keys "a" and "b" are compared, then the array of "b" is decoded and iterated.
+    EXPECT_EQ(3u, view->getDecodedValueCount());
+}
+
+TEST_F(LazyDocumentViewTest, document_with_selected_fields_can_be_created)
+{
+    auto view = make_view();
+    const DocumentType & type = view->getType();
+    auto doc = view->createDocument(Field::Set::Builder().add(&type.getField("headerval"))
+                                                         .add(&type.getField("mymap"))
+                                                         .add(&type.getField("title"))
+                                                         .build());
+    EXPECT_EQ(_doc.getId(), doc->getId());
+    EXPECT_EQ(*_doc.getValue("headerval"), *doc->getValue("headerval"));
+    EXPECT_EQ(*_doc.getValue("mymap"), *doc->getValue("mymap"));
+    EXPECT_FALSE(doc->hasValue("title"));
+    EXPECT_FALSE(doc->hasValue("content"));
+    EXPECT_EQ(2u, view->getDecodedValueCount());
+}
+
+TEST_F(LazyDocumentViewTest, view_can_be_created_from_buffer)
+{
+    nbostream stream = _doc.serialize();
+    vespalib::DataBuffer buffer(stream.size());
+    buffer.writeBytes(stream.peek(), stream.size());
+    LazyDocumentView view(_repo, std::move(buffer));
+    EXPECT_EQ(_doc.getId(), view.getId());
+    EXPECT_EQ(*_doc.getValue("content"), *view.getValue(view.getField("content")));
+}
+
+TEST_F(LazyDocumentViewTest, stream_is_consumed)
+{
+    nbostream stream = _doc.serialize();
+    stream << uint32_t(17);
+    LazyDocumentView view(_repo, stream);
+    EXPECT_EQ(sizeof(uint32_t), stream.size());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
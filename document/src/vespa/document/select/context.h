@@ -8,6 +8,7 @@ namespace document {
     class Document;
     class DocumentId;
     class DocumentUpdate;
+    class LazyDocumentView;
 }
 
 namespace document::select {
@@ -21,6 +22,7 @@ public:
     Context(const Document & doc);
     Context(const DocumentId & docId);
     Context(const DocumentUpdate & docUpdate);
+    Context(const LazyDocumentView & docView);
     virtual ~Context();
 
     void setVariableMap(std::unique_ptr<VariableMap> map);
@@ -29,6 +31,7 @@ public:
     const Document *_doc;
     const DocumentId *_docId;
     const DocumentUpdate *_docUpdate;
+    const LazyDocumentView *_docView;
 private:
     std::unique_ptr<VariableMap> _variables;
 };
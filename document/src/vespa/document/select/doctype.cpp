@@ -6,6 +6,7 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/serialization/lazydocumentview.h>
 #include <ostream>
 
 namespace document::select {
@@ -34,6 +35,9 @@ DocType::contains(const Context &context) const
                 documentTypeEqualsName(doc.getType(),
                                        _doctype)));
     }
+    if (context._docView != NULL) {
+        return ResultList(Result::get(documentTypeEqualsName(context._docView->getType(), _doctype)));
+    }
     if (context._docId != NULL) {
         return ResultList(Result::get((context._docId->getDocType() == _doctype)));
     }
@@ -51,6 +55,10 @@ DocType::trace(const Context& context, std::ostream& out) const
         out << "DocType - Doc is type " << doc.getType()
             << ", wanted " << _doctype << ", returning "
             << result << ".\n";
+    } else if (context._docView != NULL) {
+        out << "DocType - Doc is type " << context._docView->getType()
+            << ", wanted " << _doctype << ", returning "
+            << result << ".\n";
     } else if (context._docId != NULL) {
         out << "DocType - Doc is type (document id -- unknown type)"
             << ", wanted " << _doctype << ", returning "
@@ -8,6 +8,7 @@
 #include <vespa/document/fieldvalue/referencefieldvalue.h>
 #include <vespa/document/fieldvalue/iteratorhandler.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/serialization/lazydocumentview.h>
 #include <vespa/vespalib/util/md5.h>
 #include <vespa/document/util/stringutil.h>
 #include <vespa/vespalib/text/lowercase.h>
@@ -403,13 +404,13 @@ bool is_simple_imported_field(const vespalib::string& expr, const DocumentType&
 std::unique_ptr<Value>
 FieldValueNode::getValue(const Context& context) const
 {
-    if (context._doc == nullptr) {
+    if ((context._doc == nullptr) && (context._docView == nullptr)) {
         return std::make_unique<InvalidValue>();
     }
 
-    const Document& doc = *context._doc;
+    const DocumentType& doc_type = (context._doc != nullptr) ? context._doc->getType() : context._docView->getType();
 
-    if (!documentTypeEqualsName(doc.getType(), _doctype)) {
+    if (!documentTypeEqualsName(doc_type, _doctype)) {
         return std::make_unique<InvalidValue>();
     }
     // Imported fields can only be meaningfully evaluated inside Proton, so we
@@ -419,14 +420,19 @@ FieldValueNode::getValue(const Context& context) const
     // augment the FieldPath code with knowledge of imported fields.
     // When a selection is running inside Proton, it will patch FieldValueNodes for
     // imported fields, which removes this check entirely.
-    if (is_simple_imported_field(_fieldExpression, doc.getType())) {
+    if (is_simple_imported_field(_fieldExpression, doc_type)) {
         return std::make_unique<NullValue>();
     }
     try {
-        initFieldPath(doc.getType());
+        initFieldPath(doc_type);
 
         IteratorHandler handler;
-        doc.iterateNested(_fieldPath.getFullRange(), handler);
+        if (context._doc != nullptr) {
+            context._doc->iterateNested(_fieldPath.getFullRange(), handler);
+        } else {
+            // Only the values addressed by the field path are decoded from the serialized document.
+            context._docView->iterateNested(_fieldPath.getFullRange(), handler);
+        }
 
         if (handler.hasSingleValue()) {
             return std::move(handler).stealSingleValue();
@@ -551,6 +557,8 @@ IdValueNode::getValue(const Context& context) const
 {
     if (context._doc != NULL) {
         return getValue(context._doc->getId());
+    } else if (context._docView != NULL) {
+        return getValue(context._docView->getId());
     } else if (context._docId != NULL) {
         return getValue(*context._docId);
     } else {
@@ -614,6 +622,8 @@ IdValueNode::traceValue(const Context& context,
 {
     if (context._doc != NULL) {
         return traceValue(context._doc->getId(), out);
+    } else if (context._docView != NULL) {
+        return traceValue(context._docView->getId(), out);
     } else if (context._docId != NULL) {
         return traceValue(*context._docId, out);
     } else {
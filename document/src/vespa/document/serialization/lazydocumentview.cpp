@@ -0,0 +1,438 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "lazydocumentview.h"
+#include "util.h"
+#include "vespadocumentdeserializer.h"
+#include <vespa/document/base/exceptions.h>
+#include <vespa/document/datatype/arraydatatype.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/datatype/mapdatatype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/iteratorhandler.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/repo/fixedtyperepo.h>
+#include <vespa/document/util/serializableexceptions.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+using vespalib::ConstBufferRef;
+using vespalib::IllegalArgumentException;
+using vespalib::nbostream;
+using vespalib::stringref;
+using vespalib::compression::CompressionConfig;
+using vespalib::make_string_short::fmt;
+
+namespace document {
+
+namespace {
+
+struct RawStructField {
+    uint32_t id;
+    uint32_t size;
+    uint32_t offset;
+};
+
+ByteBuffer
+deCompress(CompressionConfig::Type compression, uint32_t uncompressedLength, ConstBufferRef compressed)
+{
+    ByteBuffer uncompressed(vespalib::alloc::Alloc::alloc(uncompressedLength), uncompressedLength);
+    vespalib::DataBuffer target(const_cast<char *>(uncompressed.getBuffer()), uncompressed.getLength());
+    target.clear();
+    try {
+        vespalib::compression::decompress(compression, uncompressedLength, compressed, target, false);
+    } catch (const std::runtime_error &) {
+        throw DeserializeException(fmt("Document was compressed with code unknown code %d", compression), VESPA_STRLOC);
+    }
+    if (target.getDataLen() != uncompressedLength) {
+        throw DeserializeException(fmt("Did not decompress to the expected length: had %zu, wanted %u, got %zu",
+                                       compressed.size(), uncompressedLength, target.getDataLen()),
+                                   VESPA_STRLOC);
+    }
+    return uncompressed;
+}
+
+/**
+ * Reads the header of a serialized struct and advances the stream past it.
+ * Returns the uncompressed field data, which is owned by 'owned' when the
+ * struct was compressed.
+ */
+ConstBufferRef
+readRawStruct(nbostream & stream, std::vector<RawStructField> & fields, std::vector<ByteBuffer> & owned)
+{
+    size_t data_size = readValue<uint32_t>(stream);
+    auto compression = CompressionConfig::Type(readValue<uint8_t>(stream));
+    size_t uncompressed_size = 0;
+    if (CompressionConfig::isCompressed(compression)) {
+        uncompressed_size = getInt2_4_8Bytes(stream);
+    }
+    size_t field_count = getInt1_4Bytes(stream);
+    fields.clear();
+    fields.reserve(field_count);
+    uint32_t offset = 0;
+    for (size_t i = 0; i < field_count; ++i) {
+        const uint32_t id = getInt1_4Bytes(stream);
+        const uint32_t size = getInt2_4_8Bytes(stream);
+        fields.push_back(RawStructField{id, size, offset});
+        offset += size;
+    }
+    if (data_size > stream.size()) {
+        throw DeserializeException("Invalid struct data.", VESPA_STRLOC);
+    }
+    ConstBufferRef data(stream.peek(), data_size);
+    stream.adjustReadPos(data_size);
+    if (CompressionConfig::isCompressed(compression) && (data_size > 0)) {
+        if (compression != CompressionConfig::LZ4) {
+            throw DeserializeException("Unsupported compression type.", VESPA_STRLOC);
+        }
+        owned.push_back(deCompress(compression, uncompressed_size, data));
+        data = ConstBufferRef(owned.back().getBuffer(), owned.back().getLength());
+    }
+    if (offset > data.size()) {
+        throw DeserializeException("Struct field sizes exceed struct data.", VESPA_STRLOC);
+    }
+    return data;
+}
+
+}  // namespace
+
+LazyDocumentView::LazyDocumentView(const DocumentTypeRepo & repo, vespalib::DataBuffer && buffer)
+    : _repo(&repo),
+      _type(nullptr),
+      _id(),
+      _version(0),
+      _buffer(std::move(buffer)),
+      _uncompressed(),
+      _fields(),
+      _decodedValues(0)
+{
+    if (_buffer.referencesExternalData()) {
+        vespalib::DataBuffer copy(_buffer.getDataLen());
+        copy.writeBytes(_buffer.getData(), _buffer.getDataLen());
+        _buffer = std::move(copy);
+    }
+    deserializeHeader();
+}
+
+LazyDocumentView::LazyDocumentView(const DocumentTypeRepo & repo, nbostream & stream)
+    : _repo(&repo),
+      _type(nullptr),
+      _id(),
+      _version(0),
+      _buffer(),
+      _uncompressed(),
+      _fields(),
+      _decodedValues(0)
+{
+    nbostream header(stream.peek(), stream.size());
+    readValue<uint16_t>(header);
+    size_t serialized_size = sizeof(uint16_t) + sizeof(uint32_t) + readValue<uint32_t>(header);
+    if (serialized_size > stream.size()) {
+        throw DeserializeException(fmt("Stream failed size(%zu), needed(%zu) to deserialize document",
+                                       stream.size(), serialized_size), VESPA_STRLOC);
+    }
+    _buffer.ensureFree(serialized_size);
+    _buffer.writeBytes(stream.peek(), serialized_size);
+    stream.adjustReadPos(serialized_size);
+    deserializeHeader();
+}
+
+LazyDocumentView::~LazyDocumentView() = default;
+
+void
+LazyDocumentView::deserializeHeader()
+{
+    nbostream stream(_buffer.getData(), _buffer.getDataLen());
+    _version = readValue<uint16_t>(stream);
+    if (_version != Document::getNewestSerializationVersion()) {
+        throw DeserializeException(fmt("Unrecognized serialization version %d", _version), VESPA_STRLOC);
+    }
+    uint32_t data_size = readValue<uint32_t>(stream);
+    size_t data_start_size = stream.size();
+
+    stringref id(stream.peek());
+    _id.set(id);
+    stream.adjustReadPos(id.size() + 1);
+    uint8_t content_code = readValue<uint8_t>(stream);
+    stringref type_name(stream.peek());
+    stream.adjustReadPos(type_name.size() + 1);
+    readValue<uint16_t>(stream);  // skip version
+    _type = _repo->getDocumentType(type_name);
+    if (_type == nullptr) {
+        throw DocumentTypeNotFoundException(type_name, VESPA_STRLOC);
+    }
+    Document::verifyIdAndType(_id, _type);
+
+    // Header and body chunks, see VespaDocumentDeserializer::readDocument().
+    if (content_code & 0x02) {
+        readDocumentStruct(stream);
+    }
+    if (content_code & 0x04) {
+        readDocumentStruct(stream);
+    }
+    if (data_start_size - stream.size() != data_size) {
+        throw DeserializeException(fmt("Length mismatch. Was %zu, expected %u.",
+                                       data_start_size - stream.size(), data_size), VESPA_STRLOC);
+    }
+}
+
+void
+LazyDocumentView::readDocumentStruct(nbostream & stream)
+{
+    std::vector<RawStructField> fields;
+    ConstBufferRef data = readRawStruct(stream, fields, _uncompressed);
+    for (const RawStructField & field : fields) {
+        FieldEntry entry{field.id, field.size, data.c_str() + field.offset};
+        auto found = std::find_if(_fields.begin(), _fields.end(),
+                                  [&](const FieldEntry & existing) { return existing.id == field.id; });
+        if (found != _fields.end()) {
+            *found = entry;
+        } else {
+            _fields.push_back(entry);
+        }
+    }
+}
+
+ConstBufferRef
+LazyDocumentView::getRawField(uint32_t fieldId) const
+{
+    for (const FieldEntry & entry : _fields) {
+        if (entry.id == fieldId) {
+            return ConstBufferRef(entry.data, entry.size);
+        }
+    }
+    return ConstBufferRef();
+}
+
+const Field &
+LazyDocumentView::getField(stringref name) const
+{
+    return _type->getField(name);
+}
+
+bool
+LazyDocumentView::hasValue(const Field & field) const
+{
+    return getRawField(field.getId()).size() != 0;
+}
+
+std::unique_ptr<FieldValue>
+LazyDocumentView::getValue(const Field & field) const
+{
+    ConstBufferRef bytes = getRawField(field.getId());
+    if (bytes.size() == 0) {
+        return {};
+    }
+    return decode(Location{&field.getDataType(), bytes});
+}
+
+std::unique_ptr<FieldValue>
+LazyDocumentView::getNestedValue(const FieldPath & path) const
+{
+    PathRange nested = path.getFullRange();
+    Location location{nullptr, ConstBufferRef()};
+    std::vector<ByteBuffer> owned;
+    if ( ! locate(nested, location, nullptr, owned)) {
+        return {};
+    }
+    if ( ! nested.atEnd()) {
+        throw IllegalArgumentException("Field path does not address a single value", VESPA_STRLOC);
+    }
+    return decode(location);
+}
+
+void
+LazyDocumentView::iterateNested(PathRange nested, fieldvalue::IteratorHandler & handler) const
+{
+    Location location{nullptr, ConstBufferRef()};
+    std::vector<ByteBuffer> owned;
+    if (locate(nested, location, &handler, owned)) {
+        decode(location)->iterateNested(nested, handler);
+    }
+}
+
+std::unique_ptr<Document>
+LazyDocumentView::createDocument(const Field::Set & fields) const
+{
+    auto doc = std::make_unique<Document>(*_type, _id);
+    doc->setRepo(*_repo);
+    for (const Field * field : fields) {
+        auto value = getValue(*field);
+        if (value) {
+            doc->setFieldValue(*field, std::move(value));
+        }
+    }
+    return doc;
+}
+
+bool
+LazyDocumentView::locate(PathRange & nested, Location & location, fieldvalue::IteratorHandler * handler,
+                         std::vector<ByteBuffer> & owned) const
+{
+    if (nested.atEnd() || (nested.cur().getType() != FieldPathEntry::STRUCT_FIELD)) {
+        throw IllegalArgumentException("Illegal field path for document", VESPA_STRLOC);
+    }
+    const Field & field = nested.cur().getFieldRef();
+    location = Location{&field.getDataType(), getRawField(field.getId())};
+    if (location.bytes.size() == 0) {
+        return false;
+    }
+    nested = nested.next();
+    // Walk the entries that select a single nested value. Anything else is left to the decoded value.
+    for (; ! nested.atEnd(); nested = nested.next()) {
+        const FieldPathEntry & entry = nested.cur();
+        const DataType & type = *location.type;
+        if ((entry.getType() == FieldPathEntry::STRUCT_FIELD) && type.isStructured() && ! type.isDocument()) {
+            nbostream stream(location.bytes.c_str(), location.bytes.size());
+            std::vector<RawStructField> fields;
+            ConstBufferRef data = readRawStruct(stream, fields, owned);
+            const Field & nested_field = entry.getFieldRef();
+            auto found = std::find_if(fields.rbegin(), fields.rend(),
+                                      [&](const RawStructField & raw) { return raw.id == uint32_t(nested_field.getId()); });
+            if ((found == fields.rend()) || (found->size == 0)) {
+                return false;
+            }
+            location = Location{&nested_field.getDataType(), ConstBufferRef(data.c_str() + found->offset, found->size)};
+        } else if ((entry.getType() == FieldPathEntry::ARRAY_INDEX) && type.isArray()) {
+            nbostream stream(location.bytes.c_str(), location.bytes.size());
+            VespaDocumentDeserializer deserializer(FixedTypeRepo(*_repo, *_type), stream, _version);
+            uint32_t size = getInt1_2_4Bytes(stream);
+            if (entry.getIndex() >= size) {
+                return false;
+            }
+            const DataType & nested_type = static_cast<const ArrayDataType &>(type).getNestedType();
+            for (uint32_t i = 0; i < entry.getIndex(); ++i) {
+                skip(nested_type, stream, deserializer);
+            }
+            if (handler != nullptr) {
+                handler->setArrayIndex(entry.getIndex());
+            }
+            location = Location{&nested_type, ConstBufferRef(stream.peek(), stream.size())};
+        } else if ((entry.getType() == FieldPathEntry::MAP_KEY) && type.isMap()) {
+            if ( ! locateMapKey(entry, location)) {
+                return false;
+            }
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+bool
+LazyDocumentView::locateMapKey(const FieldPathEntry & entry, Location & location) const
+{
+    const MapDataType & type = *location.type->cast_map();
+    nbostream stream(location.bytes.c_str(), location.bytes.size());
+    VespaDocumentDeserializer deserializer(FixedTypeRepo(*_repo, *_type), stream, _version);
+    uint32_t size = getInt1_2_4Bytes(stream);
+    for (uint32_t i = 0; i < size; ++i) {
+        auto key = decode(type.getKeyType(), deserializer);
+        if (*key == entry.getLookupKey()) {
+            location = Location{&type.getValueType(), ConstBufferRef(stream.peek(), stream.size())};
+            return true;
+        }
+        skip(type.getValueType(), stream, deserializer);
+    }
+    return false;
+}
+
+void
+LazyDocumentView::skip(const DataType & type, nbostream & stream, VespaDocumentDeserializer & deserializer) const
+{
+    if (const MapDataType * map_type = type.cast_map()) {
+        uint32_t size = getInt1_2_4Bytes(stream);
+        for (uint32_t i = 0; i < size; ++i) {
+            skip(map_type->getKeyType(), stream, deserializer);
+            skip(map_type->getValueType(), stream, deserializer);
+        }
+    } else if (type.isArray()) {
+        const DataType & nested_type = static_cast<const ArrayDataType &>(type).getNestedType();
+        uint32_t size = getInt1_2_4Bytes(stream);
+        for (uint32_t i = 0; i < size; ++i) {
+            skip(nested_type, stream, deserializer);
+        }
+    } else if (type.isWeightedSet()) {
+        readValue<uint32_t>(stream);  // skip type id
+        uint32_t size = readValue<uint32_t>(stream);
+        for (uint32_t i = 0; i < size; ++i) {
+            // The element size covers both the element and its weight.
+            stream.adjustReadPos(readValue<uint32_t>(stream));
+        }
+    } else if (type.isTensor()) {
+        stream.adjustReadPos(stream.getInt1_4Bytes());
+    } else if (type.isStructured() && ! type.isDocument()) {
+        size_t data_size = readValue<uint32_t>(stream);
+        auto compression = CompressionConfig::Type(readValue<uint8_t>(stream));
+        if (CompressionConfig::isCompressed(compression)) {
+            getInt2_4_8Bytes(stream);
+        }
+        size_t field_count = getInt1_4Bytes(stream);
+        for (size_t i = 0; i < field_count; ++i) {
+            getInt1_4Bytes(stream);
+            getInt2_4_8Bytes(stream);
+        }
+        stream.adjustReadPos(data_size);
+    } else {
+        switch (type.getId()) {
+        case DataType::T_BOOL:
+        case DataType::T_BYTE:
+            stream.adjustReadPos(1);
+            break;
+        case DataType::T_SHORT:
+            stream.adjustReadPos(2);
+            break;
+        case DataType::T_INT:
+        case DataType::T_FLOAT:
+            stream.adjustReadPos(4);
+            break;
+        case DataType::T_LONG:
+        case DataType::T_DOUBLE:
+            stream.adjustReadPos(8);
+            break;
+        case DataType::T_STRING:
+        case DataType::T_URI: {
+            uint8_t coding = readValue<uint8_t>(stream);
+            stream.adjustReadPos(getInt1_4Bytes(stream));
+            if (coding & 0x40) {
+                stream.adjustReadPos(readValue<uint32_t>(stream));
+            }
+            break;
+        }
+        case DataType::T_RAW:
+        case DataType::T_PREDICATE:
+            stream.adjustReadPos(readValue<uint32_t>(stream));
+            break;
+        default:
+            // References, annotation references and nested documents are rare enough to just be decoded.
+            decode(type, deserializer);
+            break;
+        }
+    }
+}
+
+std::unique_ptr<FieldValue>
+LazyDocumentView::decode(const Location & location) const
+{
+    nbostream stream(location.bytes.c_str(), location.bytes.size());
+    VespaDocumentDeserializer deserializer(FixedTypeRepo(*_repo, *_type), stream, _version);
+    return decode(*location.type, deserializer);
+}
+
+std::unique_ptr<FieldValue>
+LazyDocumentView::decode(const DataType & type, VespaDocumentDeserializer & deserializer) const
+{
+    auto value = type.createFieldValue();
+    try {
+        deserializer.read(*value);
+    } catch (WrongTensorTypeException &) {
+        // A tensor field will appear to have no tensor if the stored tensor
+        // cannot be assigned to the tensor field, as in StructFieldValue.
+    }
+    _decodedValues.fetch_add(1, std::memory_order_relaxed);
+    return value;
+}
+
+}  // namespace document
@@ -0,0 +1,119 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/document/base/documentid.h>
+#include <vespa/document/base/field.h>
+#include <vespa/document/fieldvalue/fieldvalue.h>
+#include <vespa/document/util/bytebuffer.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/buffer.h>
+#include <atomic>
+#include <vector>
+
+namespace vespalib { class nbostream; }
+
+namespace document {
+
+class Document;
+class DocumentType;
+class DocumentTypeRepo;
+class VespaDocumentDeserializer;
+
+/**
+ * Read only view of a serialized document.
+ *
+ * The view keeps the serialized buffer and only parses the document header and
+ * the field tables of the document struct up front. Field values are decoded
+ * when they are accessed. Field paths are resolved directly on the serialized
+ * data through struct fields, array indexes and map keys, so only the value at
+ * the end of the path is decoded, not the enclosing collections.
+ */
+class LazyDocumentView {
+public:
+    using UP = std::unique_ptr<LazyDocumentView>;
+    using PathRange = FieldValue::PathRange;
+
+    /**
+     * Takes ownership of the buffer. A buffer referencing external data is copied.
+     */
+    LazyDocumentView(const DocumentTypeRepo & repo, vespalib::DataBuffer && buffer);
+    /**
+     * Copies the serialized document from the stream and consumes it.
+     */
+    LazyDocumentView(const DocumentTypeRepo & repo, vespalib::nbostream & stream);
+    LazyDocumentView(const LazyDocumentView &) = delete;
+    LazyDocumentView & operator=(const LazyDocumentView &) = delete;
+    ~LazyDocumentView();
+
+    const DocumentId & getId() const noexcept { return _id; }
+    const DocumentType & getType() const noexcept { return *_type; }
+    const DocumentTypeRepo & getRepo() const noexcept { return *_repo; }
+
+    /** @throws FieldNotFoundException if the document type has no such field. */
+    const Field & getField(vespalib::stringref name) const;
+
+    bool hasValue(const Field & field) const;
+
+    /** Decodes a single field. Returns nullptr if the field is not set. */
+    std::unique_ptr<FieldValue> getValue(const Field & field) const;
+
+    /**
+     * Decodes the value at the end of a field path consisting of struct fields,
+     * array indexes and map keys. Returns nullptr if the path does not exist.
+     *
+     * @throws vespalib::IllegalArgumentException if the path addresses more than one value.
+     */
+    std::unique_ptr<FieldValue> getNestedValue(const FieldPath & path) const;
+
+    /**
+     * Read only counterpart of Document::iterateNested(). Struct fields, array
+     * indexes and map keys are resolved on the serialized data. The remaining
+     * path is iterated on the decoded value where the first entry that needs the
+     * whole collection (wildcards, variables and weighted set keys) starts.
+     * Collection and struct scopes are only reported for decoded values, and
+     * modifications done by the handler are not stored.
+     */
+    void iterateNested(PathRange nested, fieldvalue::IteratorHandler & handler) const;
+
+    /**
+     * Creates a document holding the given fields decoded from the view.
+     * Fields not in the set are never decoded.
+     */
+    std::unique_ptr<Document> createDocument(const Field::Set & fields) const;
+
+    /** Number of field values (including map keys compared on lookup) decoded so far. */
+    size_t getDecodedValueCount() const noexcept { return _decodedValues.load(std::memory_order_relaxed); }
+
+private:
+    struct FieldEntry {
+        uint32_t    id;
+        uint32_t    size;
+        const char *data;
+    };
+    struct Location {
+        const DataType           *type;
+        vespalib::ConstBufferRef  bytes;
+    };
+
+    void deserializeHeader();
+    void readDocumentStruct(vespalib::nbostream & stream);
+    vespalib::ConstBufferRef getRawField(uint32_t fieldId) const;
+    bool locate(PathRange & nested, Location & location, fieldvalue::IteratorHandler * handler,
+                std::vector<ByteBuffer> & owned) const;
+    bool locateMapKey(const FieldPathEntry & entry, Location & location) const;
+    void skip(const DataType & type, vespalib::nbostream & stream, VespaDocumentDeserializer & deserializer) const;
+    std::unique_ptr<FieldValue> decode(const Location & location) const;
+    std::unique_ptr<FieldValue> decode(const DataType & type, VespaDocumentDeserializer & deserializer) const;
+
+    const DocumentTypeRepo    *_repo;
+    const DocumentType        *_type;
+    DocumentId                 _id;
+    uint16_t                   _version;
+    vespalib::DataBuffer       _buffer;
+    std::vector<ByteBuffer>    _uncompressed;
+    std::vector<FieldEntry>    _fields;
+    mutable std::atomic<size_t> _decodedValues;
+};
+
+}  // namespace document
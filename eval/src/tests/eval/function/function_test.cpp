@@ -110,6 +110,13 @@ TEST("require that scientific numbers can be parsed") {
     EXPECT_EQUAL(3e-7,    as_number(*Function::parse(params, "3E-7")));
 }
 
+TEST("require that numbers are dumped without loss of precision") {
+    EXPECT_EQUAL("2.5", Function::parse("2.5")->dump());
+    EXPECT_EQUAL("1.05e-05", Function::parse("1.05e-5")->dump());
+    EXPECT_EQUAL("1234567.25", Function::parse("1234567.25")->dump());
+    EXPECT_EQUAL(0.1234567891, as_number(*Function::parse(Function::parse("0.1234567891")->dump())));
+}
+
 TEST("require that true/false can be parsed") {
     EXPECT_EQUAL(1.0, as_number(*Function::parse(params, "true")));
     EXPECT_EQUAL(0.0, as_number(*Function::parse(params, "false")));
@@ -757,6 +764,11 @@ TEST("require that tensor join can be parsed") {
     EXPECT_EQUAL("join(a,b,f(x,y)(x+y))", Function::parse(" join ( a , b , f ( x , y ) ( x + y ) ) ")->dump());
 }
 
+TEST("require that tensor merge can be parsed") {
+    EXPECT_EQUAL("merge(a,b,f(x,y)(x+y))", Function::parse("merge(a,b,f(x,y)(x+y))")->dump());
+    EXPECT_EQUAL("merge(a,b,f(x,y)(x+y))", Function::parse(" merge ( a , b , f ( x , y ) ( x + y ) ) ")->dump());
+}
+
 TEST("require that parenthesis are added around lambda expression when needed") {
     EXPECT_EQUAL("f(x)(sin(x))", Function::parse("sin(x)")->dump_as_lambda());
 }
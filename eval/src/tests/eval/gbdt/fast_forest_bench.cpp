@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/fast_forest.h>
 #include <vespa/eval/eval/vm_forest.h>
 #include <vespa/eval/eval/llvm/compiled_function.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
 #include "model.cpp"
 
 using namespace vespalib::eval;
@@ -23,6 +24,19 @@ void estimate_cost(size_t num_params, const char *label, const T &impl) {
             label, (us_min / 10.0), (us_med / 10.0), (us_max / 10.0), (us_nan / 10.0));
 }
 
+void estimate_batch_cost(size_t num_params, const char *label, const FastForest &forest) {
+    constexpr size_t num_docs = 16;
+    std::vector<float> params;
+    for (size_t i = 0; i < (num_docs * num_params); ++i) {
+        params.push_back(0.25 * ((i % 3) + 1));
+    }
+    std::vector<double> results(num_docs, 0.0);
+    auto ctx = forest.create_context();
+    double us = vespalib::BenchmarkTimer::benchmark([&](){ forest.eval_batch(*ctx, params.data(), num_params, num_docs, results.data()); }, 5.0) * 1000.0 * 1000.0;
+    fprintf(stderr, "[%12s] (per 100 eval): [mixed values, batch of %zu] %6.3f ms\n",
+            label, num_docs, (us / num_docs / 10.0));
+}
+
 void run_fast_forest_bench() {
     for (size_t tree_size: std::vector<size_t>({8,16,32,64,128,256})) {
         for (size_t num_trees: std::vector<size_t>({100, 500, 2500, 5000, 10000})) {
@@ -36,6 +50,7 @@ void run_fast_forest_bench() {
                             auto forest = FastForest::try_convert(*function, min_bits, 64);
                             if (forest) {
                                 estimate_cost(function->num_params(), forest->impl_name().c_str(), *forest);
+                                estimate_batch_cost(function->num_params(), forest->impl_name().c_str(), *forest);
                             }
                             if (min_bits > 64) {
                                 break;
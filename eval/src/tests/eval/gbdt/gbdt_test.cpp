@@ -408,6 +408,34 @@ TEST("require that fast forest evaluation is correct for all tree size categorie
     }
 }
 
+TEST("require that batched fast forest evaluation matches single document evaluation") {
+    for (size_t tree_size: std::vector<size_t>({7,15,30,61,127})) {
+        vespalib::string expression = Model().max_features(35).less_percent(100).invert_percent(50).make_forest(61, tree_size);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        if ((tree_size <= 64) || is_little_endian()) {
+            ASSERT_TRUE(forest);
+            TEST_STATE(forest->impl_name().c_str());
+            size_t num_params = function->num_params();
+            for (size_t num_docs: std::vector<size_t>({1, 5, 8, 19})) {
+                std::vector<float> params;
+                for (size_t doc = 0; doc < num_docs; ++doc) {
+                    for (size_t i = 0; i < num_params; ++i) {
+                        bool is_nan = (((doc + i) % 7) == 3);
+                        params.push_back(is_nan ? std::numeric_limits<float>::quiet_NaN() : float(((doc * 31 + i * 17) % 100) / 100.0));
+                    }
+                }
+                auto ctx = forest->create_context();
+                std::vector<double> results(num_docs, 0.0);
+                forest->eval_batch(*ctx, &params[0], num_params, num_docs, &results[0]);
+                for (size_t doc = 0; doc < num_docs; ++doc) {
+                    EXPECT_EQUAL(results[doc], forest->eval(*ctx, &params[doc * num_params]));
+                }
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that GDBT expressions can be detected") {
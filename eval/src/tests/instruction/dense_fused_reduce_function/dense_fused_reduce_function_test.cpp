@@ -0,0 +1,94 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/instruction/dense_fused_reduce_function.h>
+#include <vespa/eval/eval/test/eval_fixture.h>
+#include <vespa/eval/eval/test/gen_spec.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using vespalib::make_string_short::fmt;
+
+struct FunInfo {
+    using LookFor = DenseFusedReduceFunction;
+    size_t num_steps;
+    Aggr aggr;
+    void verify(const LookFor &fun) const {
+        EXPECT_TRUE(fun.result_is_mutable());
+        EXPECT_EQ(fun.num_steps(), num_steps);
+        EXPECT_EQ(int(fun.aggr()), int(aggr));
+    }
+};
+
+void verify_optimized(const vespalib::string &expr, size_t num_steps, Aggr aggr = Aggr::SUM) {
+    SCOPED_TRACE(expr.c_str());
+    auto fun = Function::parse(expr);
+    CellTypeSpace all_types(CellTypeUtils::list_types(), fun->num_params());
+    EvalFixture::verify<FunInfo>(expr, {FunInfo{num_steps, aggr}}, all_types);
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    SCOPED_TRACE(expr.c_str());
+    auto fun = Function::parse(expr);
+    CellTypeSpace just_double({CellType::DOUBLE}, fun->num_params());
+    EvalFixture::verify<FunInfo>(expr, {}, just_double);
+}
+
+TEST(FusedReduceTest, chained_join_with_full_reduce_is_optimized) {
+    verify_optimized("reduce(x5y3*x5y3$2+x5y3$3,sum)", 2);
+    verify_optimized("reduce(x5y3$3+x5y3*x5y3$2,sum)", 2);
+    verify_optimized("reduce((x5y3-x5y3$2)*(x5y3$3-x5y3$4),sum)", 3);
+}
+
+TEST(FusedReduceTest, map_and_merge_are_fused) {
+    verify_optimized("reduce(map(x5y3*x5y3$2,f(x)(x+1)),sum)", 2);
+    verify_optimized("reduce(map(x5y3-x5y3$2,f(x)(tanh(x))),sum)", 2);
+    verify_optimized("reduce(merge(x5y3,x5y3$2,f(x,y)(x-y))*x5y3$3,sum)", 2);
+}
+
+TEST(FusedReduceTest, numbers_are_broadcast) {
+    verify_optimized("reduce((x5y3+x5y3$2)*2.5,sum)", 2);
+    verify_optimized("reduce(3-x5y3*x5y3$2,sum)", 2);
+    verify_optimized("reduce((x5y3*reduce(x5y3$2,sum))+x5y3$3,sum)", 2);
+}
+
+TEST(FusedReduceTest, multiple_chunks_are_handled) {
+    verify_optimized("reduce(x300*x300$2+x300$3,sum)", 2);
+    verify_optimized("reduce(map(x17y31-x17y31$2,f(x)(x+1)),max)", 2, Aggr::MAX);
+}
+
+TEST(FusedReduceTest, all_aggregators_except_count_are_fused) {
+    for (Aggr aggr: Aggregator::list()) {
+        vespalib::string expr = fmt("reduce(x5y3*x5y3$2+x5y3$3,%s)", AggrNames::name_of(aggr)->c_str());
+        if (aggr == Aggr::COUNT) {
+            verify_not_optimized(expr);
+        } else {
+            verify_optimized(expr, 2, aggr);
+        }
+    }
+}
+
+TEST(FusedReduceTest, single_operation_is_not_optimized) {
+    verify_not_optimized("reduce(x5y3+x5y3$2,sum)");
+    verify_not_optimized("reduce(map(x5y3,f(x)(x+1)),sum)");
+}
+
+TEST(FusedReduceTest, partial_reduce_is_not_optimized) {
+    verify_not_optimized("reduce(x5y3*x5y3$2+x5y3$3,sum,x)");
+}
+
+TEST(FusedReduceTest, sparse_and_mixed_inputs_are_not_optimized) {
+    verify_not_optimized("reduce(x5_1*x5_1$2+x5_1$3,sum)");
+    verify_not_optimized("reduce(x5_1y3*x5_1y3$2+x5_1y3$3,sum)");
+}
+
+TEST(FusedReduceTest, operations_changing_dimensions_are_not_fused) {
+    verify_not_optimized("reduce(x5y3*x5y3$2+x5,sum)");
+    verify_not_optimized("reduce(x5*y3+x5y3,sum)");
+    verify_optimized("reduce((x5*y3+x5y3)*x5y3$2,sum)", 2);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
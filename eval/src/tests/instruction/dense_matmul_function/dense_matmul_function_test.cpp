@@ -101,4 +101,10 @@ TEST("require that matmul outer/outer works correctly") {
     TEST_DO(verify_optimized("reduce(b5d3*b5c2,sum,b)", details));
 }
 
+TEST("require that matmul with large common dimension works correctly") {
+    FunInfo details = { .lhs_size = 3, .common_size = 300, .rhs_size = 5,
+                        .lhs_inner = true, .rhs_inner = false };
+    TEST_DO(verify_optimized("reduce(a3d300*d300e5,sum,d)", details));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
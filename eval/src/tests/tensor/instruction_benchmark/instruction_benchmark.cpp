@@ -29,6 +29,7 @@
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/test/gen_spec.h>
 #include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/eval/value_type_spec.h>
 #include <vespa/eval/instruction/generic_concat.h>
 #include <vespa/eval/instruction/generic_join.h>
 #include <vespa/eval/instruction/generic_map.h>
@@ -107,6 +108,26 @@ Instruction compile_op1_chain(const TensorFunction &node, const ValueBuilderFact
     return {my_multi_instruction_op,(uint64_t)(&param)};
 }
 
+// parameters are expected to already be on the stack in the order
+// their inject nodes are visited.
+void collect_tree(const TensorFunction &node, const ValueBuilderFactory &factory, Stash &stash, std::vector<Instruction> &list) {
+    if (as<tensor_function::Inject>(node)) {
+        return;
+    }
+    std::vector<TensorFunction::Child::CREF> children;
+    node.push_children(children);
+    for (const auto &child: children) {
+        collect_tree(child.get().get(), factory, stash, list);
+    }
+    list.push_back(node.compile_self(factory, stash));
+}
+
+Instruction compile_tree(const TensorFunction &node, const ValueBuilderFactory &factory, Stash &stash) {
+    auto &param = stash.create<MultiOpParam>();
+    collect_tree(node, factory, stash, param.list);
+    return {my_multi_instruction_op,(uint64_t)(&param)};
+}
+
 //-----------------------------------------------------------------------------
 
 struct Impl {
@@ -137,6 +158,33 @@ struct Impl {
         // instructions into a single compound instruction.
         return compile_op1_chain(node, factory, stash);
     }
+    Instruction create_fused_reduce(const ValueType &type, operation::op1_t function, Aggr aggr, Stash &stash) const {
+        // create a complete tensor function for reduce(map(a+b*c)),
+        // and compile all of it since the unfused version needs
+        // multiple instructions.
+        const auto &a_node = tensor_function::inject(type, 0, stash);
+        const auto &b_node = tensor_function::inject(type, 1, stash);
+        const auto &c_node = tensor_function::inject(type, 2, stash);
+        const auto &mul_node = tensor_function::join(b_node, c_node, operation::Mul::f, stash);
+        const TensorFunction *top = &tensor_function::join(a_node, mul_node, operation::Add::f, stash);
+        if (function != nullptr) {
+            top = &tensor_function::map(*top, function, stash);
+        }
+        const auto &reduce_node = tensor_function::reduce(*top, aggr, {}, stash);
+        const auto &node = optimize ? optimize_tensor_function(factory, reduce_node, stash) : reduce_node;
+        return compile_tree(node, factory, stash);
+    }
+    Instruction create_matmul(const ValueType &lhs, const ValueType &rhs, const vespalib::string &dim, Stash &stash) const {
+        // create a complete tensor function for reduce(lhs*rhs,sum,dim),
+        // and compile all of it since the unoptimized version needs
+        // multiple instructions.
+        const auto &lhs_node = tensor_function::inject(lhs, 0, stash);
+        const auto &rhs_node = tensor_function::inject(rhs, 1, stash);
+        const auto &join_node = tensor_function::join(lhs_node, rhs_node, operation::Mul::f, stash);
+        const auto &reduce_node = tensor_function::reduce(join_node, Aggr::SUM, {dim}, stash);
+        const auto &node = optimize ? optimize_tensor_function(factory, reduce_node, stash) : reduce_node;
+        return compile_tree(node, factory, stash);
+    }
     Instruction create_rename(const ValueType &lhs, const std::vector<vespalib::string> &from, const std::vector<vespalib::string> &to, Stash &stash) const {
         // create a complete tensor function, but only compile the relevant instruction
         const auto &lhs_node = tensor_function::inject(lhs, 0, stash);
@@ -503,6 +551,48 @@ void benchmark_reduce(const vespalib::string &desc, const TensorSpec &lhs,
 
 //-----------------------------------------------------------------------------
 
+void benchmark_fused_reduce(const vespalib::string &desc, const TensorSpec &a, const TensorSpec &b,
+                            const TensorSpec &c, operation::op1_t function, Aggr aggr)
+{
+    Stash stash;
+    ValueType type = ValueType::from_spec(a.type());
+    ASSERT_FALSE(type.is_error());
+    ASSERT_EQ(type, ValueType::from_spec(b.type()));
+    ASSERT_EQ(type, ValueType::from_spec(c.type()));
+    std::vector<EvalOp::UP> list;
+    for (const Impl &impl: impl_list) {
+        Stash my_stash;
+        auto op = impl.create_fused_reduce(type, function, aggr, my_stash);
+        std::vector<CREF<TensorSpec>> stack_spec({a, b, c});
+        list.push_back(std::make_unique<EvalOp>(std::move(my_stash), op, stack_spec, impl));
+    }
+    benchmark(desc, list);
+}
+
+//-----------------------------------------------------------------------------
+
+void benchmark_matmul(const vespalib::string &desc, const TensorSpec &lhs,
+                      const TensorSpec &rhs, const vespalib::string &dim)
+{
+    Stash stash;
+    ValueType lhs_type = ValueType::from_spec(lhs.type());
+    ValueType rhs_type = ValueType::from_spec(rhs.type());
+    ValueType res_type = ValueType::join(lhs_type, rhs_type).reduce({dim});
+    ASSERT_FALSE(lhs_type.is_error());
+    ASSERT_FALSE(rhs_type.is_error());
+    ASSERT_FALSE(res_type.is_error());
+    std::vector<EvalOp::UP> list;
+    for (const Impl &impl: impl_list) {
+        Stash my_stash;
+        auto op = impl.create_matmul(lhs_type, rhs_type, dim, my_stash);
+        std::vector<CREF<TensorSpec>> stack_spec({lhs, rhs});
+        list.push_back(std::make_unique<EvalOp>(std::move(my_stash), op, stack_spec, impl));
+    }
+    benchmark(desc, list);
+}
+
+//-----------------------------------------------------------------------------
+
 void benchmark_rename(const vespalib::string &desc, const TensorSpec &lhs,
                       const std::vector<vespalib::string> &from,
                       const std::vector<vespalib::string> &to)
@@ -932,6 +1022,36 @@ TEST(ReduceBench, mixed_reduce) {
     benchmark_reduce("mixed reduce all", lhs, Aggr::SUM, {});
 }
 
+TEST(ReduceBench, dense_fused_reduce) {
+    auto a = GS(1.0).idx("a", 64).idx("b", 64);
+    auto b = GS(2.0).idx("a", 64).idx("b", 64);
+    auto c = GS(3.0).idx("a", 64).idx("b", 64);
+    benchmark_fused_reduce("dense fused multiply-add sum", a, b, c, nullptr, Aggr::SUM);
+    benchmark_fused_reduce("dense fused multiply-add max", a, b, c, nullptr, Aggr::MAX);
+    benchmark_fused_reduce("dense fused multiply-add tanh sum", a, b, c, operation::Tanh::f, Aggr::SUM);
+    benchmark_fused_reduce("dense fused multiply-add floor sum", a, b, c, operation::Floor::f, Aggr::SUM);
+}
+
+//-----------------------------------------------------------------------------
+
+// small integers are used to make the results exact for all cell types
+TEST(MatMulBench, dense_matmul) {
+    auto seq = test::Seq({-3, -2, -1, 0, 1, 2, 3});
+    for (CellType ct: {CellType::FLOAT, CellType::BFLOAT16, CellType::INT8}) {
+        auto name = value_type::cell_type_to_name(ct);
+        auto vec = test::GenSpec().idx("d", 256).seq(seq).cells(ct);
+        auto mat = test::GenSpec().idx("b", 64).idx("d", 256).seq(seq).cells(ct);
+        auto lhs = test::GenSpec().idx("a", 16).idx("d", 256).seq(seq).cells(ct);
+        auto rhs = test::GenSpec().idx("d", 256).idx("e", 16).seq(seq).cells(ct);
+        benchmark_matmul(fmt("dense xw product %s", name.c_str()), vec, mat, "d");
+        benchmark_matmul(fmt("dense matmul %s", name.c_str()), lhs, mat, "d");
+        benchmark_matmul(fmt("dense matmul transposed %s", name.c_str()), lhs, rhs, "d");
+        benchmark_matmul(fmt("dense multi matmul %s", name.c_str()),
+                         test::GenSpec().idx("A", 8).idx("a", 16).idx("d", 256).seq(seq).cells(ct),
+                         test::GenSpec().idx("A", 8).idx("b", 16).idx("d", 256).seq(seq).cells(ct), "d");
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(RenameBench, dense_rename) {
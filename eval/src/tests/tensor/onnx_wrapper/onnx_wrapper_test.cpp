@@ -234,6 +234,81 @@ TEST(OnnxTest, dynamic_onnx_model_can_be_evaluated)
     //-------------------------------------------------------------------------
 }
 
+TEST(OnnxTest, dynamic_onnx_model_can_be_evaluated_in_batches)
+{
+    Onnx model(dynamic_model, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner;
+
+    ValueType query_type = ValueType::from_spec("tensor<float>(a[1],b[4])");
+    std::vector<float> query_values({1.0, 2.0, 3.0, 4.0});
+    DenseValueView query(query_type, TypedCells(query_values));
+    EXPECT_TRUE(planner.bind_input_type(query_type, model.inputs()[0]));
+
+    ValueType attribute_type = ValueType::from_spec("tensor<float>(a[4],b[1])");
+    std::vector<float> attribute_values({5.0, 6.0, 7.0, 8.0});
+    DenseValueView attribute(attribute_type, TypedCells(attribute_values));
+    std::vector<float> other_attribute_values({5.0, 6.0, 7.0, 9.0});
+    DenseValueView other_attribute(attribute_type, TypedCells(other_attribute_values));
+    EXPECT_TRUE(planner.bind_input_type(attribute_type, model.inputs()[1]));
+
+    ValueType bias_type = ValueType::from_spec("tensor<float>(a[1],b[2])");
+    std::vector<float> bias_values_1({4.0, 5.0});
+    std::vector<float> bias_values_2({5.0, 6.0});
+    std::vector<float> bias_values_3({6.0, 7.0});
+    DenseValueView bias_1(bias_type, TypedCells(bias_values_1));
+    DenseValueView bias_2(bias_type, TypedCells(bias_values_2));
+    DenseValueView bias_3(bias_type, TypedCells(bias_values_3));
+    EXPECT_TRUE(planner.bind_input_type(bias_type, model.inputs()[2]));
+
+    Onnx::WireInfo wire_info = planner.get_wire_info(model);
+    EXPECT_EQ(Onnx::BatchEvalContext::find_batch_dimension(model, wire_info), "batch");
+    Onnx::BatchEvalContext ctx(model, wire_info, 4);
+    EXPECT_EQ(ctx.max_batch_size(), 4);
+    EXPECT_TRUE(ctx.is_batched_param(0));
+    EXPECT_FALSE(ctx.is_batched_param(1));
+    EXPECT_TRUE(ctx.is_batched_param(2));
+
+    const Value &output = ctx.get_result(0);
+    EXPECT_EQ(output.type().to_spec(), "tensor<float>(d0[1],d1[1])");
+    //-------------------------------------------------------------------------
+    const Value *biases[] = { &bias_1, &bias_2, &bias_3 };
+    for (size_t doc = 0; doc < 3; ++doc) {
+        EXPECT_TRUE(ctx.bind_param(doc, 0, query));
+        EXPECT_TRUE(ctx.bind_param(doc, 1, attribute));
+        EXPECT_TRUE(ctx.bind_param(doc, 2, *biases[doc]));
+    }
+    ctx.eval(3);
+    EXPECT_EQ(ctx.batch_size(), 3);
+    float expect[] = { 79.0, 81.0, 83.0 };
+    for (size_t doc = 0; doc < 3; ++doc) {
+        ctx.select_result(doc);
+        auto cells = output.cells();
+        EXPECT_EQ(cells.type, CellType::FLOAT);
+        EXPECT_EQ(cells.size, 1);
+        EXPECT_EQ(cells.typify<float>()[0], expect[doc]);
+    }
+    //-------------------------------------------------------------------------
+    EXPECT_TRUE(ctx.bind_param(0, 1, attribute));
+    EXPECT_FALSE(ctx.bind_param(1, 1, other_attribute));
+    //-------------------------------------------------------------------------
+    ctx.clear_results();
+    EXPECT_EQ(output.cells().typify<float>()[0], 0.0);
+    //-------------------------------------------------------------------------
+}
+
+TEST(OnnxTest, models_without_batch_dimension_cannot_be_evaluated_in_batches)
+{
+    Onnx model(guess_batch_model, Onnx::Optimize::ENABLE);
+    Onnx::WirePlanner planner;
+    ValueType in_type = ValueType::from_spec("tensor<float>(a[3])");
+    EXPECT_TRUE(planner.bind_input_type(in_type, model.inputs()[0]));
+    EXPECT_TRUE(planner.bind_input_type(in_type, model.inputs()[1]));
+    planner.prepare_output_types(model);
+    Onnx::WireInfo wire_info = planner.get_wire_info(model);
+    EXPECT_EQ(Onnx::BatchEvalContext::find_batch_dimension(model, wire_info), "");
+    EXPECT_THROW(Onnx::BatchEvalContext(model, wire_info, 4), Ort::Exception);
+}
+
 TEST(OnnxTest, int_types_onnx_model_can_be_evaluated)
 {
     Onnx model(int_types_model, Onnx::Optimize::ENABLE);
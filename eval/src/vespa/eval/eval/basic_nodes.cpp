@@ -8,6 +8,7 @@
 #include "fast_value.h"
 #include "node_tools.h"
 #include <vespa/vespalib/util/stringfmt.h>
+#include <cstdlib>
 
 namespace vespalib::eval::nodes {
 
@@ -25,7 +26,12 @@ struct Frame {
 
 vespalib::string
 Number::dump(DumpContext &) const {
-    return make_string("%g", _value);
+    // use the short form when it parses back to the same value
+    vespalib::string str = make_string("%g", _value);
+    if (strtod(str.c_str(), nullptr) != _value) {
+        str = make_string("%.17g", _value);
+    }
+    return str;
 }
 
 vespalib::string
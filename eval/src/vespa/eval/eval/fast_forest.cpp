@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -143,10 +144,16 @@ template <> vespalib::string fixed_impl_name<uint64_t>() { return "ff-fixed<64>"
 template <typename T>
 constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 
+// number of documents evaluated together when batching; masks for
+// the same tree are interleaved across documents to let the compiler
+// vectorize mask application and leaf lookup
+constexpr size_t batch_lanes = 8;
+
 template <typename T>
 struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> batch_masks;
+    FixedContext(size_t num_trees) : masks(num_trees), batch_masks() {}
 };
 
 template <typename T>
@@ -197,9 +204,16 @@ struct FixedForest : FastForest {
     static void apply_masks(T *ctx_masks, const DMask *pos, const DMask *end);
     double get_result(const T *ctx_masks) const;
 
+    static void apply_batch_masks(T *ctx_masks, const Mask *pos, const Mask *end, const float *limits, float max_limit);
+    static void apply_batch_masks(T *ctx_masks, size_t lane, const DMask *pos, const DMask *end);
+    void get_batch_results(const T *ctx_masks, size_t num_docs, double *results) const;
+    void eval_block(T *ctx_masks, const float *params, size_t num_params, size_t num_docs, double *results) const;
+
     vespalib::string impl_name() const override { return fixed_impl_name<T>(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_params,
+                    size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -335,6 +349,110 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+template <typename T>
+void
+FixedForest<T>::apply_batch_masks(T *ctx_masks, const Mask *pos, const Mask *end, const float *limits, float max_limit)
+{
+    // NaN limits never satisfy the comparison below
+    for (; (pos < end) && !(max_limit < pos->value); ++pos) {
+        T *dst = ctx_masks + (pos->tree * batch_lanes);
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            dst[lane] &= (pos->value <= limits[lane]) ? pos->bits : T(~T(0));
+        }
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::apply_batch_masks(T *ctx_masks, size_t lane, const DMask *pos, const DMask *end)
+{
+    for (; pos < end; ++pos) {
+        ctx_masks[(pos->tree * batch_lanes) + lane] &= pos->bits;
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::get_batch_results(const T *ctx_masks, size_t num_docs, double *results) const
+{
+    // same summation order as get_result for each document
+    double result1[batch_lanes] = {};
+    double result2[batch_lanes] = {};
+    const float *leafs = &_padded_leafs[0];
+    size_t leaf_cnt = _max_leafs;
+    size_t tree = 0;
+    for (; (tree + 3) < _num_trees; tree += 4) {
+        const T *masks = ctx_masks + (tree * batch_lanes);
+        const float *tree_leafs = leafs + (tree * leaf_cnt);
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            result1[lane] += tree_leafs[(0 * leaf_cnt) + get_lsb(masks[(0 * batch_lanes) + lane])];
+            result2[lane] += tree_leafs[(1 * leaf_cnt) + get_lsb(masks[(1 * batch_lanes) + lane])];
+            result1[lane] += tree_leafs[(2 * leaf_cnt) + get_lsb(masks[(2 * batch_lanes) + lane])];
+            result2[lane] += tree_leafs[(3 * leaf_cnt) + get_lsb(masks[(3 * batch_lanes) + lane])];
+        }
+    }
+    for (; tree < _num_trees; ++tree) {
+        const T *masks = ctx_masks + (tree * batch_lanes);
+        const float *tree_leafs = leafs + (tree * leaf_cnt);
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            result1[lane] += tree_leafs[get_lsb(masks[lane])];
+        }
+    }
+    for (size_t lane = 0; lane < num_docs; ++lane) {
+        results[lane] = (result1[lane] + result2[lane]);
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::eval_block(T *ctx_masks, const float *params, size_t num_params, size_t num_docs, double *results) const
+{
+    assert(num_docs <= batch_lanes);
+    memset(ctx_masks, 0xff, _num_trees * batch_lanes * sizeof(T));
+    const Mask *mask_pos = &_masks[0];
+    float limits[batch_lanes];
+    for (size_t feature = 0; feature < _mask_sizes.size(); ++feature) {
+        uint32_t size = _mask_sizes[feature];
+        bool any_limit = false;
+        float max_limit = -std::numeric_limits<float>::infinity();
+        for (size_t lane = 0; lane < batch_lanes; ++lane) {
+            if (lane < num_docs) {
+                float limit = params[(lane * num_params) + feature];
+                limits[lane] = limit;
+                if (!std::isnan(limit)) {
+                    any_limit = true;
+                    max_limit = std::max(max_limit, limit);
+                } else {
+                    apply_batch_masks(ctx_masks, lane,
+                                      &_default_masks[_default_offsets[feature]],
+                                      &_default_masks[_default_offsets[feature + 1]]);
+                }
+            } else {
+                limits[lane] = std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+        if (any_limit) {
+            apply_batch_masks(ctx_masks, mask_pos, mask_pos + size, limits, max_limit);
+        }
+        mask_pos += size;
+    }
+    get_batch_results(ctx_masks, num_docs, results);
+}
+
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t num_params,
+                           size_t num_docs, double *results) const
+{
+    auto &ctx = static_cast<FixedContext<T>&>(context);
+    ctx.batch_masks.resize(_num_trees * batch_lanes);
+    T *ctx_masks = &ctx.batch_masks[0];
+    for (size_t i = 0; i < num_docs; i += batch_lanes) {
+        eval_block(ctx_masks, params + (i * num_params), num_params,
+                   std::min(batch_lanes, num_docs - i), results + i);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
@@ -661,6 +779,15 @@ FastForest::try_convert(const Function &fun, size_t min_fixed, size_t max_fixed)
     return FastForest::UP();
 }
 
+void
+FastForest::eval_batch(Context &context, const float *params, size_t num_params,
+                       size_t num_docs, double *results) const
+{
+    for (size_t i = 0; i < num_docs; ++i) {
+        results[i] = eval(context, params + (i * num_params));
+    }
+}
+
 double
 FastForest::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
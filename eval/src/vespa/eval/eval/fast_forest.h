@@ -36,6 +36,12 @@ public:
     virtual vespalib::string impl_name() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+    // evaluate several documents at once; 'params' holds 'num_params'
+    // consecutive values for each document and 'results' gets one
+    // value per document. The default is to evaluate one document at
+    // a time.
+    virtual void eval_batch(Context &context, const float *params, size_t num_params,
+                            size_t num_docs, double *results) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
@@ -93,7 +93,7 @@ public:
     const Function &lambda() const { return *_lambda; }
     vespalib::string dump(DumpContext &ctx) const override {
         vespalib::string str;
-        str += "join(";
+        str += "merge(";
         str += _lhs->dump(ctx);
         str += ",";
         str += _rhs->dump(ctx);
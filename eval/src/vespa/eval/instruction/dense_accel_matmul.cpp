@@ -0,0 +1,58 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_accel_matmul.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/stash.h>
+
+namespace vespalib::eval {
+
+namespace {
+
+static const auto &hw = hwaccelrated::IAccelrated::getAccelerator();
+
+float my_dot_product(const Int8Float *lhs, const Int8Float *rhs, size_t len) {
+    return hw.dotProduct(reinterpret_cast<const int8_t *>(lhs), reinterpret_cast<const int8_t *>(rhs), len);
+}
+
+float my_dot_product(const BFloat16 *lhs, const BFloat16 *rhs, size_t len) {
+    return hw.dotProduct(lhs, rhs, len);
+}
+
+// make the cells of each row/column contiguous along the common dimension
+template <typename CT>
+const CT *common_inner(const CT *src, size_t size, size_t common_size, bool is_common_inner, Stash &stash) {
+    if (is_common_inner) {
+        return src;
+    }
+    auto dst = stash.create_uninitialized_array<CT>(size * common_size);
+    for (size_t i = 0; i < common_size; ++i) {
+        for (size_t j = 0; j < size; ++j) {
+            dst[(j * common_size) + i] = src[(i * size) + j];
+        }
+    }
+    return dst.begin();
+}
+
+} // namespace <unnamed>
+
+template <typename CT>
+void dense_accel_matmul(const CT *lhs, const CT *rhs, float *dst,
+                        size_t lhs_size, size_t common_size, size_t rhs_size,
+                        bool lhs_common_inner, bool rhs_common_inner, Stash &stash)
+{
+    lhs = common_inner(lhs, lhs_size, common_size, lhs_common_inner, stash);
+    rhs = common_inner(rhs, rhs_size, common_size, rhs_common_inner, stash);
+    for (size_t i = 0; i < lhs_size; ++i, lhs += common_size) {
+        const CT *row = rhs;
+        for (size_t j = 0; j < rhs_size; ++j, row += common_size) {
+            *dst++ = my_dot_product(lhs, row, common_size);
+        }
+    }
+}
+
+template void dense_accel_matmul<Int8Float>(const Int8Float *, const Int8Float *, float *,
+                                            size_t, size_t, size_t, bool, bool, Stash &);
+template void dense_accel_matmul<BFloat16>(const BFloat16 *, const BFloat16 *, float *,
+                                           size_t, size_t, size_t, bool, bool, Stash &);
+
+} // namespace
@@ -0,0 +1,33 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/int8float.h>
+#include <vespa/vespalib/util/bfloat16.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace vespalib { class Stash; }
+
+namespace vespalib::eval {
+
+// int8 and bfloat16 matrices are not supported by cblas
+template <typename CT>
+constexpr bool has_accel_matmul = (std::is_same_v<CT,Int8Float> || std::is_same_v<CT,BFloat16>);
+
+/**
+ * Dense matrix multiplication for int8 and bfloat16 cells, used by
+ * DenseMatMulFunction, DenseXWProductFunction and
+ * DenseMultiMatMulFunction. Each result cell is a dot product
+ * calculated by the hardware accelerated kernels in vespalib; int8
+ * products are accumulated as integers (using VNNI when available)
+ * and bfloat16 products as float. Operands not having the common
+ * dimension innermost are transposed into scratch memory taken from
+ * the stash first. The lhs_size x rhs_size result is stored as float.
+ **/
+template <typename CT>
+void dense_accel_matmul(const CT *lhs, const CT *rhs, float *dst,
+                        size_t lhs_size, size_t common_size, size_t rhs_size,
+                        bool lhs_common_inner, bool rhs_common_inner, Stash &stash);
+
+} // namespace
@@ -0,0 +1,322 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_fused_reduce_function.h"
+#include <vespa/eval/eval/inline_operation.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/typify.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+namespace vespalib::eval {
+
+using Child = TensorFunction::Child;
+using State = InterpretedFunction::State;
+using tensor_function::Join;
+using tensor_function::Map;
+using tensor_function::Merge;
+using tensor_function::Op2;
+using tensor_function::Reduce;
+using tensor_function::unwrap_param;
+using tensor_function::wrap_param;
+using namespace operation;
+
+using Self = DenseFusedReduceFunction::Self;
+using Step = DenseFusedReduceFunction::Step;
+using Leaf = DenseFusedReduceFunction::Leaf;
+using Dims = std::vector<ValueType::Dimension>;
+
+namespace {
+
+constexpr size_t chunk_size = DenseFusedReduceFunction::chunk_size;
+
+// cell types used for chunk registers; int8 and bfloat16 cells are
+// converted to float when loaded, just like they are when used as
+// input to any other operation.
+struct TypifyRegCellType {
+    template <typename T> using Result = TypifyResultType<T>;
+    template <typename F> static decltype(auto) resolve(CellType value, F &&f) {
+        switch (value) {
+        case CellType::DOUBLE: return f(Result<double>());
+        case CellType::FLOAT:  return f(Result<float>());
+        default: break;
+        }
+        abort();
+    }
+};
+
+template <typename CT>
+const void *my_load_cells(const Value &value, size_t offset, size_t n, void *scratch) {
+    const CT *src = value.cells().typify<CT>().cbegin() + offset;
+    if constexpr (std::is_same_v<CT,double> || std::is_same_v<CT,float>) {
+        return src;
+    } else {
+        float *dst = static_cast<float *>(scratch);
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = src[i];
+        }
+        return dst;
+    }
+}
+
+// numbers are broadcast into their register once, since the first
+// chunk is always the largest one
+template <typename RCT>
+const void *my_load_number(const Value &value, size_t offset, size_t n, void *scratch) {
+    RCT *dst = static_cast<RCT *>(scratch);
+    if (offset == 0) {
+        std::fill(dst, dst + n, RCT(value.as_double()));
+    }
+    return dst;
+}
+
+template <typename ICT, typename OCT, typename Fun>
+void my_map_step(const Step &step, const void *const *regs, void *dst_in, size_t n) {
+    Fun fun(step.map_fun);
+    const ICT *src = static_cast<const ICT *>(regs[step.lhs]);
+    OCT *dst = static_cast<OCT *>(dst_in);
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = fun(src[i]);
+    }
+}
+
+template <typename LCT, typename RCT, typename OCT, typename Fun>
+void my_join_step(const Step &step, const void *const *regs, void *dst_in, size_t n) {
+    Fun fun(step.join_fun);
+    const LCT *lhs = static_cast<const LCT *>(regs[step.lhs]);
+    const RCT *rhs = static_cast<const RCT *>(regs[step.rhs]);
+    OCT *dst = static_cast<OCT *>(dst_in);
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = fun(lhs[i], rhs[i]);
+    }
+}
+
+template <typename RCT, typename AGGR>
+void my_fused_reduce_op(State &state, uint64_t param) {
+    const auto &self = unwrap_param<Self>(param);
+    size_t num_leaves = self.leaves.size();
+    auto regs = state.stash.create_uninitialized_array<const void *>(self.num_regs);
+    auto scratch = state.stash.create_uninitialized_array<double>(self.num_regs * chunk_size);
+    auto reg_mem = [&](size_t reg) -> void * { return scratch.begin() + (reg * chunk_size); };
+    for (const Step &step: self.steps) {
+        regs[step.dst] = reg_mem(step.dst);
+    }
+    std::array<AGGR,8> aggrs;
+    for (size_t offset = 0; offset < self.num_cells; offset += chunk_size) {
+        size_t n = std::min(chunk_size, self.num_cells - offset);
+        for (size_t i = 0; i < num_leaves; ++i) {
+            const Leaf &leaf = self.leaves[i];
+            regs[leaf.reg] = leaf.load(state.peek(num_leaves - 1 - i), offset, n, reg_mem(leaf.reg));
+        }
+        for (const Step &step: self.steps) {
+            step.fun(step, regs.begin(), reg_mem(step.dst), n);
+        }
+        const RCT *src = static_cast<const RCT *>(regs[self.root_reg]);
+        size_t i = 0;
+        for (; (i + 7) < n; i += 8) {
+            for (size_t j = 0; j < 8; ++j) {
+                aggrs[j].sample(src[i + j]);
+            }
+        }
+        for (size_t j = 0; (i + j) < n; ++j) {
+            aggrs[j].sample(src[i + j]);
+        }
+    }
+    aggrs[0].merge(aggrs[4]);
+    aggrs[1].merge(aggrs[5]);
+    aggrs[2].merge(aggrs[6]);
+    aggrs[3].merge(aggrs[7]);
+    aggrs[0].merge(aggrs[2]);
+    aggrs[1].merge(aggrs[3]);
+    aggrs[0].merge(aggrs[1]);
+    state.pop_n_push(num_leaves, state.stash.create<DoubleValue>(aggrs[0].result()));
+}
+
+struct SelectLoadCells {
+    template <typename CT> static auto invoke() { return my_load_cells<CT>; }
+};
+
+struct SelectLoadNumber {
+    template <typename RCT> static auto invoke() { return my_load_number<RCT>; }
+};
+
+struct SelectMapStep {
+    template <typename ICT, typename OCT, typename Fun> static auto invoke() {
+        return my_map_step<ICT, OCT, Fun>;
+    }
+};
+
+struct SelectJoinStep {
+    template <typename LCT, typename RCT, typename OCT, typename Fun> static auto invoke() {
+        return my_join_step<LCT, RCT, OCT, Fun>;
+    }
+};
+
+struct SelectFusedReduceOp {
+    template <typename RCT, typename AGGR> static auto invoke() {
+        return my_fused_reduce_op<RCT, typename AGGR::template templ<double>>;
+    }
+};
+
+using MapStepTypify = TypifyValue<TypifyRegCellType,TypifyOp1>;
+using JoinStepTypify = TypifyValue<TypifyRegCellType,TypifyOp2>;
+using ReduceTypify = TypifyValue<TypifyRegCellType,TypifyAggr>;
+
+bool is_number(const TensorFunction &node) {
+    return node.result_type().is_double();
+}
+
+bool has_dims(const TensorFunction &node, const Dims &dims) {
+    return (node.result_type().dimensions() == dims);
+}
+
+bool can_fuse(const TensorFunction &node, const Dims &dims) {
+    if (!has_dims(node, dims)) {
+        return false;
+    }
+    auto is_input = [&dims](const TensorFunction &child) {
+                        return (is_number(child) || has_dims(child, dims));
+                    };
+    if (auto map = as<Map>(node)) {
+        return is_input(map->child());
+    }
+    if (auto join = as<Join>(node)) {
+        return (is_input(join->lhs()) && is_input(join->rhs()));
+    }
+    if (auto merge = as<Merge>(node)) {
+        return (is_input(merge->lhs()) && is_input(merge->rhs()));
+    }
+    return false;
+}
+
+size_t count_fused_ops(const TensorFunction &node, const Dims &dims) {
+    if (!can_fuse(node, dims)) {
+        return 0;
+    }
+    std::vector<Child::CREF> children;
+    node.push_children(children);
+    size_t result = 1;
+    for (const Child &child: children) {
+        result += count_fused_ops(child.get(), dims);
+    }
+    return result;
+}
+
+// translates a fusable tree into leaves and steps, where each step
+// reads registers written by earlier steps or loaded from leaves
+struct FusionBuilder {
+    const Dims &dims;
+    Self self;
+    std::vector<CellType> reg_types;
+    std::vector<Child> children;
+    explicit FusionBuilder(const Dims &dims_in) : dims(dims_in), self(), reg_types(), children() {}
+    size_t add_reg(CellType cell_type) {
+        reg_types.push_back(cell_type);
+        return (reg_types.size() - 1);
+    }
+    size_t add_leaf(const TensorFunction &node, CellType number_type) {
+        Leaf leaf;
+        if (is_number(node)) {
+            leaf.reg = add_reg(number_type);
+            leaf.load = typify_invoke<1,TypifyRegCellType,SelectLoadNumber>(number_type);
+        } else {
+            const ValueType &type = node.result_type();
+            leaf.reg = add_reg(type.cell_meta().decay().cell_type);
+            leaf.load = typify_invoke<1,TypifyCellType,SelectLoadCells>(type.cell_type());
+        }
+        self.leaves.push_back(leaf);
+        children.emplace_back(node);
+        return leaf.reg;
+    }
+    size_t add(const TensorFunction &node, CellType number_type) {
+        if (!can_fuse(node, dims)) {
+            return add_leaf(node, number_type);
+        }
+        CellType res_type = node.result_type().cell_type();
+        Step step{};
+        if (auto map = as<Map>(node)) {
+            step.map_fun = map->function();
+            step.lhs = add(map->child(), res_type);
+            step.fun = typify_invoke<3,MapStepTypify,SelectMapStep>(reg_types[step.lhs], res_type, step.map_fun);
+        } else {
+            auto op2 = as<Op2>(node);
+            assert(op2 != nullptr);
+            auto join = as<Join>(node);
+            step.join_fun = join ? join->function() : as<Merge>(node)->function();
+            step.lhs = add(op2->lhs(), res_type);
+            step.rhs = add(op2->rhs(), res_type);
+            step.fun = typify_invoke<4,JoinStepTypify,SelectJoinStep>(reg_types[step.lhs], reg_types[step.rhs],
+                                                                      res_type, step.join_fun);
+        }
+        step.dst = add_reg(res_type);
+        self.steps.push_back(step);
+        return step.dst;
+    }
+};
+
+} // namespace vespalib::eval::<unnamed>
+
+DenseFusedReduceFunction::Self::Self()
+    : leaves(), steps(), num_regs(0), root_reg(0),
+      root_cell_type(CellType::DOUBLE), num_cells(0), aggr(Aggr::SUM)
+{
+}
+
+DenseFusedReduceFunction::Self::~Self() = default;
+
+DenseFusedReduceFunction::DenseFusedReduceFunction(Self self, std::vector<Child> children)
+    : tensor_function::Node(ValueType::double_type()),
+      _self(std::move(self)),
+      _children(std::move(children))
+{
+}
+
+DenseFusedReduceFunction::~DenseFusedReduceFunction() = default;
+
+void
+DenseFusedReduceFunction::push_children(std::vector<Child::CREF> &target) const
+{
+    for (const Child &c : _children) {
+        target.emplace_back(c);
+    }
+}
+
+void
+DenseFusedReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    visitor.visitString("aggr", *AggrNames::name_of(_self.aggr));
+    visitor.visitInt("num_steps", _self.steps.size());
+    visitor.visitInt("num_cells", _self.num_cells);
+}
+
+InterpretedFunction::Instruction
+DenseFusedReduceFunction::compile_self(const ValueBuilderFactory &, Stash &) const
+{
+    auto op = typify_invoke<2,ReduceTypify,SelectFusedReduceOp>(_self.root_cell_type, _self.aggr);
+    return InterpretedFunction::Instruction(op, wrap_param<Self>(_self));
+}
+
+const TensorFunction &
+DenseFusedReduceFunction::optimize(const TensorFunction &expr, Stash &stash)
+{
+    auto reduce = as<Reduce>(expr);
+    if (reduce && expr.result_type().is_double() && (reduce->aggr() != Aggr::COUNT)) {
+        const TensorFunction &child = reduce->child();
+        const ValueType &type = child.result_type();
+        // single operations are left to more specific optimizers
+        if (type.is_dense() && !type.is_double() && (count_fused_ops(child, type.dimensions()) >= 2)) {
+            FusionBuilder builder(type.dimensions());
+            builder.self.root_reg = builder.add(child, CellType::DOUBLE);
+            builder.self.root_cell_type = type.cell_type();
+            builder.self.num_regs = builder.reg_types.size();
+            builder.self.num_cells = type.dense_subspace_size();
+            builder.self.aggr = reduce->aggr();
+            return stash.create<DenseFusedReduceFunction>(std::move(builder.self), std::move(builder.children));
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::eval
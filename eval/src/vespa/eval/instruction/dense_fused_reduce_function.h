@@ -0,0 +1,75 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::eval {
+
+/**
+ * Tensor function reducing a chain of dense map/join/merge operations
+ * to a scalar without creating intermediate tensors. All fused
+ * operations must produce dense tensors with the same dimensions,
+ * and their inputs must either be tensors with those dimensions or
+ * numbers (which are broadcast). The cells are processed in small
+ * chunks; each operation is applied to one chunk at a time, keeping
+ * all temporary results in cache before they are aggregated. Known
+ * operations are inlined and each operation is specialized for its
+ * input and output cell types.
+ **/
+class DenseFusedReduceFunction : public tensor_function::Node
+{
+    using Super = tensor_function::Node;
+public:
+    static constexpr size_t chunk_size = 256;
+
+    struct Step;
+    using load_fun_t = const void *(*)(const Value &value, size_t offset, size_t n, void *scratch);
+    using step_fun_t = void (*)(const Step &step, const void *const *regs, void *dst, size_t n);
+
+    // a fused operation reading and writing chunk registers
+    struct Step {
+        step_fun_t fun;
+        tensor_function::map_fun_t map_fun;
+        tensor_function::join_fun_t join_fun;
+        size_t lhs;
+        size_t rhs;
+        size_t dst;
+    };
+
+    // a child whose cells are loaded into a chunk register
+    struct Leaf {
+        load_fun_t load;
+        size_t reg;
+    };
+
+    struct Self {
+        std::vector<Leaf> leaves;
+        std::vector<Step> steps;
+        size_t num_regs;
+        size_t root_reg;
+        CellType root_cell_type;
+        size_t num_cells;
+        Aggr aggr;
+        Self();
+        ~Self();
+    };
+
+private:
+    Self _self;
+    std::vector<Child> _children;
+
+public:
+    DenseFusedReduceFunction(Self self, std::vector<Child> children);
+    ~DenseFusedReduceFunction() override;
+    size_t num_steps() const { return _self.steps.size(); }
+    size_t num_cells() const { return _self.num_cells; }
+    Aggr aggr() const { return _self.aggr; }
+    bool result_is_mutable() const override { return true; }
+    void push_children(std::vector<Child::CREF> &children) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    InterpretedFunction::Instruction compile_self(const ValueBuilderFactory &factory, Stash &stash) const override;
+    static const TensorFunction &optimize(const TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::eval
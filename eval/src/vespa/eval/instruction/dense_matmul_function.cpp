@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dense_matmul_function.h"
+#include "dense_accel_matmul.h"
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
@@ -73,6 +74,18 @@ void my_cblas_float_matmul_op(InterpretedFunction::State &state, uint64_t param)
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
 }
 
+template <typename CT, bool lhs_common_inner, bool rhs_common_inner>
+void my_accel_matmul_op(InterpretedFunction::State &state, uint64_t param) {
+    const DenseMatMulFunction::Self &self = unwrap_param<DenseMatMulFunction::Self>(param);
+    auto lhs_cells = state.peek(1).cells().typify<CT>();
+    auto rhs_cells = state.peek(0).cells().typify<CT>();
+    auto dst_cells = state.stash.create_uninitialized_array<float>(self.lhs_size * self.rhs_size);
+    dense_accel_matmul(lhs_cells.cbegin(), rhs_cells.cbegin(), dst_cells.begin(),
+                       self.lhs_size, self.common_size, self.rhs_size,
+                       lhs_common_inner, rhs_common_inner, state.stash);
+    state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
+}
+
 bool is_matrix(const ValueType &type) {
     return (type.is_dense() && (type.dimensions().size() == 2));
 }
@@ -122,6 +135,9 @@ struct SelectDenseMatmul {
             return my_cblas_double_matmul_op<LhsCommonInner::value, RhsCommonInner::value>;
         } else if (std::is_same_v<LCT,float> && std::is_same_v<RCT,float>) {
             return my_cblas_float_matmul_op<LhsCommonInner::value, RhsCommonInner::value>;
+        } else if constexpr (std::is_same_v<LCT,RCT> && has_accel_matmul<LCT>) {
+            assert((std::is_same_v<OCT,float>));
+            return my_accel_matmul_op<LCT, LhsCommonInner::value, RhsCommonInner::value>;
         } else {
             return my_matmul_op<LCT, RCT, OCT, LhsCommonInner::value, RhsCommonInner::value>;
         }
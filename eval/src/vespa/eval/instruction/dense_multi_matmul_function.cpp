@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "dense_multi_matmul_function.h"
+#include "dense_accel_matmul.h"
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
@@ -59,6 +60,24 @@ void my_cblas_float_multi_matmul_op(InterpretedFunction::State &state, uint64_t
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type(), TypedCells(dst_cells)));
 }
 
+template <typename CT>
+void my_accel_multi_matmul_op(InterpretedFunction::State &state, uint64_t param) {
+    const DenseMultiMatMulFunction &self = unwrap_param<DenseMultiMatMulFunction>(param);
+    size_t lhs_block_size = self.lhs_size() * self.common_size();
+    size_t rhs_block_size = self.rhs_size() * self.common_size();
+    size_t dst_block_size = self.lhs_size() * self.rhs_size();
+    size_t num_blocks = self.matmul_cnt();
+    const CT *lhs = state.peek(1).cells().typify<CT>().cbegin();
+    const CT *rhs = state.peek(0).cells().typify<CT>().cbegin();
+    auto dst_cells = state.stash.create_uninitialized_array<float>(dst_block_size * num_blocks);
+    float *dst = dst_cells.begin();
+    for (size_t i = 0; i < num_blocks; ++i, lhs += lhs_block_size, rhs += rhs_block_size, dst += dst_block_size) {
+        dense_accel_matmul(lhs, rhs, dst, self.lhs_size(), self.common_size(), self.rhs_size(),
+                           self.lhs_common_inner(), self.rhs_common_inner(), state.stash);
+    }
+    state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type(), TypedCells(dst_cells)));
+}
+
 InterpretedFunction::op_function my_select(CellType cell_type) {
     if (cell_type == CellType::DOUBLE) {
         return my_cblas_double_multi_matmul_op;
@@ -66,6 +85,12 @@ InterpretedFunction::op_function my_select(CellType cell_type) {
     if (cell_type == CellType::FLOAT) {
         return my_cblas_float_multi_matmul_op;
     }
+    if (cell_type == CellType::INT8) {
+        return my_accel_multi_matmul_op<Int8Float>;
+    }
+    if (cell_type == CellType::BFLOAT16) {
+        return my_accel_multi_matmul_op<BFloat16>;
+    }
     abort();
 }
 
@@ -116,7 +141,8 @@ struct DimPrefix {
 bool check_input_type(const ValueType &type, const DimList &relevant) {
     return (type.is_dense() &&
             (relevant.size() >= 2) &&
-            ((type.cell_type() == CellType::FLOAT) || (type.cell_type() == CellType::DOUBLE)));
+            ((type.cell_type() == CellType::FLOAT) || (type.cell_type() == CellType::DOUBLE) ||
+             (type.cell_type() == CellType::INT8) || (type.cell_type() == CellType::BFLOAT16)));
 }
 
 bool is_multi_matmul(const ValueType &a, const ValueType &b, const vespalib::string &reduce_dim) {
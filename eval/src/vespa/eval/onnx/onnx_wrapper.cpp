@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/classname.h>
 #include <assert.h>
 #include <cmath>
+#include <cstring>
 #include <stdlib.h>
 #include <stdio.h>
 #include <type_traits>
@@ -626,6 +627,256 @@ Onnx::EvalContext::get_result(size_t i) const
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+struct ElementSize {
+    template <typename T> static size_t invoke() { return sizeof(T); }
+    size_t operator()(Onnx::ElementType elements) {
+        return typify_invoke<1,MyTypify,ElementSize>(elements);
+    }
+};
+
+struct CreateOnnxTensorView {
+    template <typename T> static Ort::Value invoke(Ort::MemoryInfo &memory, char *data, size_t num_cells,
+                                                   const std::vector<int64_t> &sizes)
+    {
+        return Ort::Value::CreateTensor<T>(memory, reinterpret_cast<T *>(data), num_cells, sizes.data(), sizes.size());
+    }
+    Ort::Value operator()(Onnx::ElementType elements, Ort::MemoryInfo &memory, char *data, size_t num_cells,
+                          const std::vector<int64_t> &sizes)
+    {
+        return typify_invoke<1,MyTypify,CreateOnnxTensorView>(elements, memory, data, num_cells, sizes);
+    }
+};
+
+bool has_symbolic_dimension(const Onnx::TensorInfo &info, size_t first, const vespalib::string &name) {
+    for (size_t i = first; i < info.dimensions.size(); ++i) {
+        if (info.dimensions[i].is_symbolic() && (info.dimensions[i].name == name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+vespalib::string leading_single_symbol(const Onnx::TensorInfo &info, const Onnx::TensorType &type) {
+    if (!info.dimensions.empty() && info.dimensions[0].is_symbolic() &&
+        !type.dimensions.empty() && (type.dimensions[0] == 1))
+    {
+        return info.dimensions[0].name;
+    }
+    return "";
+}
+
+} // <unnamed>
+
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::convert_param(const Value &param, void *dst)
+{
+    auto cells = param.cells().typify<SRC>();
+    size_t n = cells.size();
+    const SRC *src = cells.begin();
+    DST *dst_cells = static_cast<DST *>(dst);
+    for (size_t i = 0; i < n; ++i) {
+        dst_cells[i] = DST(src[i]);
+    }
+}
+
+template <typename SRC, typename DST>
+void
+Onnx::BatchEvalContext::convert_result(Ort::Value &src, size_t offset, const Value &dst)
+{
+    auto cells = unconstify(dst.cells().typify<DST>());
+    size_t n = cells.size();
+    DST *dst_cells = cells.begin();
+    const SRC *src_cells = src.GetTensorMutableData<SRC>() + offset;
+    for (size_t i = 0; i < n; ++i) {
+        dst_cells[i] = DST(src_cells[i]);
+    }
+}
+
+struct Onnx::BatchEvalContext::SelectConvertParam {
+    template <typename ...Ts> static auto invoke() { return convert_param<Ts...>; }
+    auto operator()(CellType ct, Onnx::ElementType et) {
+        return typify_invoke<2,MyTypify,SelectConvertParam>(ct, et);
+    }
+};
+
+struct Onnx::BatchEvalContext::SelectConvertResult {
+    template <typename ...Ts> static auto invoke() { return convert_result<Ts...>; }
+    auto operator()(Onnx::ElementType et, CellType ct) {
+        return typify_invoke<2,MyTypify,SelectConvertResult>(et, ct);
+    }
+};
+
+Onnx::BatchEvalContext::Param::Param(bool batched_in, size_t elem_size_in, size_t doc_cells_in,
+                                     std::vector<int64_t> doc_sizes_in, size_t max_docs, param_fun_t convert_in)
+    : batched(batched_in),
+      elem_size(elem_size_in),
+      doc_cells(doc_cells_in),
+      doc_sizes(std::move(doc_sizes_in)),
+      buffer(elem_size * doc_cells * max_docs),
+      scratch(batched ? 0 : elem_size * doc_cells),
+      convert(convert_in)
+{
+}
+
+vespalib::string
+Onnx::BatchEvalContext::find_batch_dimension(const Onnx &model, const WireInfo &wire_info)
+{
+    if (model.outputs().empty()) {
+        return "";
+    }
+    vespalib::string batch_dim = leading_single_symbol(model.outputs()[0], wire_info.onnx_outputs[0]);
+    if (batch_dim.empty()) {
+        return "";
+    }
+    for (size_t i = 0; i < model.outputs().size(); ++i) {
+        const auto &output = model.outputs()[i];
+        if ((leading_single_symbol(output, wire_info.onnx_outputs[i]) != batch_dim) ||
+            has_symbolic_dimension(output, 1, batch_dim))
+        {
+            return "";
+        }
+    }
+    size_t num_batched = 0;
+    for (size_t i = 0; i < model.inputs().size(); ++i) {
+        const auto &input = model.inputs()[i];
+        if (leading_single_symbol(input, wire_info.onnx_inputs[i]) == batch_dim) {
+            if (has_symbolic_dimension(input, 1, batch_dim)) {
+                return "";
+            }
+            ++num_batched;
+        } else if (has_symbolic_dimension(input, 0, batch_dim)) {
+            return "";
+        }
+    }
+    return (num_batched > 0) ? batch_dim : "";
+}
+
+Onnx::BatchEvalContext::BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t max_batch_size)
+    : _model(model),
+      _wire_info(wire_info),
+      _max_batch_size(std::max(max_batch_size, size_t(1))),
+      _batch_size(0),
+      _cpu_memory(Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault)),
+      _params(),
+      _param_values(),
+      _result_values(),
+      _results(),
+      _result_cells(),
+      _result_converters()
+{
+    assert(_wire_info.vespa_inputs.size()  == _model.inputs().size());
+    assert(_wire_info.onnx_inputs.size()   == _model.inputs().size());
+    assert(_wire_info.onnx_outputs.size()  == _model.outputs().size());
+    assert(_wire_info.vespa_outputs.size() == _model.outputs().size());
+    vespalib::string batch_dim = find_batch_dimension(_model, _wire_info);
+    if (batch_dim.empty()) {
+        throw Ort::Exception("[onnx wrapper] model does not have a batch dimension", ORT_FAIL);
+    }
+    _params.reserve(_model.inputs().size());
+    _param_values.reserve(_model.inputs().size());
+    for (size_t i = 0; i < _model.inputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_inputs[i];
+        const auto &onnx = _wire_info.onnx_inputs[i];
+        bool batched = (leading_single_symbol(_model.inputs()[i], onnx) == batch_dim);
+        _params.emplace_back(batched, ElementSize()(onnx.elements), vespa.dense_subspace_size(), onnx.dimensions,
+                             batched ? _max_batch_size : 1, SelectConvertParam()(vespa.cell_type(), onnx.elements));
+        _param_values.emplace_back(nullptr);
+    }
+    _result_values.reserve(_model.outputs().size());
+    _results.reserve(_model.outputs().size());
+    for (size_t i = 0; i < _model.outputs().size(); ++i) {
+        const auto &vespa = _wire_info.vespa_outputs[i];
+        const auto &onnx = _wire_info.onnx_outputs[i];
+        _result_values.emplace_back(nullptr);
+        _results.push_back(CreateVespaTensor()(vespa));
+        _result_cells.push_back(vespa.dense_subspace_size());
+        _result_converters.push_back(SelectConvertResult()(onnx.elements, vespa.cell_type()));
+    }
+}
+
+Onnx::BatchEvalContext::~BatchEvalContext() = default;
+
+bool
+Onnx::BatchEvalContext::bind_param(size_t doc, size_t i, const Value &param)
+{
+    assert(doc < _max_batch_size);
+    auto &p = _params[i];
+    if (p.batched) {
+        p.convert(param, p.buffer.data() + (doc * p.doc_cells * p.elem_size));
+        return true;
+    }
+    if (doc == 0) {
+        p.convert(param, p.buffer.data());
+        return true;
+    }
+    p.convert(param, p.scratch.data());
+    return (memcmp(p.scratch.data(), p.buffer.data(), p.scratch.size()) == 0);
+}
+
+void
+Onnx::BatchEvalContext::eval(size_t batch_size)
+{
+    assert((batch_size > 0) && (batch_size <= _max_batch_size));
+    _batch_size = 0;
+    for (size_t i = 0; i < _params.size(); ++i) {
+        auto &p = _params[i];
+        std::vector<int64_t> sizes = p.doc_sizes;
+        size_t num_docs = 1;
+        if (p.batched) {
+            sizes[0] = batch_size;
+            num_docs = batch_size;
+        }
+        _param_values[i] = CreateOnnxTensorView()(_wire_info.onnx_inputs[i].elements, _cpu_memory,
+                                                  p.buffer.data(), p.doc_cells * num_docs, sizes);
+    }
+    for (auto &result: _result_values) {
+        result = Ort::Value(nullptr);
+    }
+    Ort::Session &session = const_cast<Ort::Session&>(_model._session);
+    Ort::RunOptions run_opts(nullptr);
+    session.Run(run_opts,
+                _model._input_name_refs.data(), _param_values.data(), _param_values.size(),
+                _model._output_name_refs.data(), _result_values.data(), _result_values.size());
+    for (size_t i = 0; i < _result_values.size(); ++i) {
+        auto actual = get_type_of(_result_values[i]);
+        auto expected = _wire_info.onnx_outputs[i].dimensions;
+        expected[0] = batch_size;
+        if (actual.dimensions != expected) {
+            throw Ort::Exception(fmt("[onnx wrapper] output '%s' has unexpected batched type: %s",
+                                     _model.outputs()[i].name.c_str(), actual.type_as_string().c_str()), ORT_FAIL);
+        }
+    }
+    _batch_size = batch_size;
+}
+
+void
+Onnx::BatchEvalContext::select_result(size_t doc)
+{
+    assert(doc < _batch_size);
+    for (size_t i = 0; i < _result_values.size(); ++i) {
+        _result_converters[i](_result_values[i], doc * _result_cells[i], *_results[i]);
+    }
+}
+
+void
+Onnx::BatchEvalContext::clear_results()
+{
+    for (const Value::UP &result: _results) {
+        clear_vespa_tensor(*result);
+    }
+}
+
+const Value &
+Onnx::BatchEvalContext::get_result(size_t i) const
+{
+    return *_results[i];
+}
+
+//-----------------------------------------------------------------------------
+
 Ort::AllocatorWithDefaultOptions Onnx::_alloc;
 
 Onnx::Shared::Shared()
@@ -141,6 +141,75 @@ public:
         const Value &get_result(size_t i) const;
     };
 
+    // evaluation context for several documents at once, using the
+    // wire info for a single document. Inputs having the batch
+    // dimension (see find_batch_dimension) are stacked along it,
+    // while all other inputs are shared by the documents in a batch.
+    // Outputs are split per document using select_result.
+    class BatchEvalContext {
+    private:
+        using param_fun_t = void (*)(const Value &param, void *dst);
+        using result_fun_t = void (*)(Ort::Value &src, size_t offset, const Value &dst);
+
+        struct Param {
+            bool                 batched;
+            size_t               elem_size;
+            size_t               doc_cells;
+            std::vector<int64_t> doc_sizes;
+            std::vector<char>    buffer;
+            std::vector<char>    scratch;
+            param_fun_t          convert;
+            Param(bool batched_in, size_t elem_size_in, size_t doc_cells_in,
+                  std::vector<int64_t> doc_sizes_in, size_t max_docs, param_fun_t convert_in);
+        };
+
+        const Onnx                  &_model;
+        const WireInfo              &_wire_info;
+        size_t                       _max_batch_size;
+        size_t                       _batch_size;
+        Ort::MemoryInfo              _cpu_memory;
+        std::vector<Param>           _params;
+        std::vector<Ort::Value>      _param_values;
+        std::vector<Ort::Value>      _result_values;
+        std::vector<Value::UP>       _results;
+        std::vector<size_t>          _result_cells;
+        std::vector<result_fun_t>    _result_converters;
+
+        template <typename SRC, typename DST>
+        static void convert_param(const Value &param, void *dst);
+
+        template <typename SRC, typename DST>
+        static void convert_result(Ort::Value &src, size_t offset, const Value &dst);
+
+    public:
+        struct SelectConvertParam;
+        struct SelectConvertResult;
+
+        // name of the symbolic outermost dimension of all outputs
+        // that is also the outermost dimension of at least one input,
+        // bound to size 1 for a single document; empty if the model
+        // cannot be evaluated in batches
+        static vespalib::string find_batch_dimension(const Onnx &model, const WireInfo &wire_info);
+
+        BatchEvalContext(const Onnx &model, const WireInfo &wire_info, size_t max_batch_size);
+        ~BatchEvalContext();
+        size_t num_params() const { return _params.size(); }
+        size_t num_results() const { return _results.size(); }
+        size_t max_batch_size() const { return _max_batch_size; }
+        size_t batch_size() const { return _batch_size; }
+        bool is_batched_param(size_t i) const { return _params[i].batched; }
+        // bind a parameter for the document at the given position in
+        // the batch; returns false if a shared parameter differs from
+        // the one bound for the first document in the batch
+        bool bind_param(size_t doc, size_t i, const Value &param);
+        void eval(size_t batch_size);
+        // make the results of the given document in the last evaluated
+        // batch available through get_result
+        void select_result(size_t doc);
+        void clear_results();
+        const Value &get_result(size_t i) const;
+    };
+
 private:
     // common stuff shared between model sessions
     class Shared {
@@ -824,6 +824,61 @@ TEST_F(ConformanceTest, multi_remove_does_not_remove_docs_if_specified_timestamp
     }
 }
 
+TEST_F(ConformanceTest, put_or_remove_batch_applies_operations_in_order)
+{
+    document::TestDocMan testDocMan;
+    _factory->clear();
+    PersistenceProviderUP spi(getSpi(*_factory, testDocMan));
+    Context context(Priority(0), Trace::TraceLevel(0));
+
+    Bucket bucket(makeSpiBucket(BucketId(8, 0x01)));
+    spi->createBucket(bucket);
+
+    std::vector<Document::SP> docs;
+    for (size_t i(0); i < 10; i++) {
+        docs.push_back(testDocMan.createRandomDocumentAtLocation(0x01, i));
+    }
+    spi->put(bucket, Timestamp(1), docs[0]);
+
+    std::vector<std::future<std::unique_ptr<Result>>> futures;
+    std::vector<spi::BatchOperation> ops;
+    auto add_put = [&](Timestamp ts, Document::SP doc) {
+        auto onDone = std::make_unique<CatchResult>();
+        futures.push_back(onDone->future_result());
+        ops.emplace_back(ts, std::move(doc), std::move(onDone));
+    };
+    auto add_remove = [&](Timestamp ts, const DocumentId & id) {
+        auto onDone = std::make_unique<CatchResult>();
+        futures.push_back(onDone->future_result());
+        ops.emplace_back(ts, id, std::move(onDone));
+    };
+    for (size_t i(1); i < docs.size(); i++) {
+        add_put(Timestamp(10 + i), docs[i]);
+    }
+    add_remove(Timestamp(20), docs[0]->getId());
+    add_remove(Timestamp(21), docs[1]->getId());
+    add_remove(Timestamp(22), testDocMan.createRandomDocumentAtLocation(0x01, 100)->getId());
+    spi->putOrRemoveBatchAsync(bucket, std::move(ops));
+
+    std::vector<std::unique_ptr<Result>> results;
+    for (auto & future : futures) {
+        results.push_back(future.get());
+        ASSERT_TRUE(results.back());
+        EXPECT_EQ(Result::ErrorType::NONE, results.back()->getErrorCode());
+    }
+    size_t num_puts = docs.size() - 1;
+    EXPECT_TRUE(dynamic_cast<RemoveResult &>(*results[num_puts]).wasFound());
+    EXPECT_TRUE(dynamic_cast<RemoveResult &>(*results[num_puts + 1]).wasFound());
+    EXPECT_FALSE(dynamic_cast<RemoveResult &>(*results[num_puts + 2]).wasFound());
+
+    for (size_t i(0); i < docs.size(); i++) {
+        GetResult gr = spi->get(bucket, document::AllFields(), docs[i]->getId(), context);
+        EXPECT_EQ(Result::ErrorType::NONE, gr.getErrorCode());
+        EXPECT_EQ(i > 1, gr.hasDocument());
+    }
+    EXPECT_EQ(docs.size() - 2, spi->getBucketInfo(bucket).getBucketInfo().getDocumentCount());
+}
+
 TEST_F(ConformanceTest, testRemoveMerge)
 {
     document::TestDocMan testDocMan;
@@ -0,0 +1,34 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batch_operation.h"
+#include <vespa/document/fieldvalue/document.h>
+
+namespace storage::spi {
+
+BatchOperation::BatchOperation(Timestamp timestamp, DocumentSP doc, OperationComplete::UP onComplete) noexcept
+    : _type(Type::PUT),
+      _timestamp(timestamp),
+      _doc(std::move(doc)),
+      _id(),
+      _onComplete(std::move(onComplete))
+{}
+
+BatchOperation::BatchOperation(Timestamp timestamp, DocumentId id, OperationComplete::UP onComplete) noexcept
+    : _type(Type::REMOVE),
+      _timestamp(timestamp),
+      _doc(),
+      _id(std::move(id)),
+      _onComplete(std::move(onComplete))
+{}
+
+BatchOperation::BatchOperation(BatchOperation &&) noexcept = default;
+BatchOperation & BatchOperation::operator=(BatchOperation &&) noexcept = default;
+BatchOperation::~BatchOperation() = default;
+
+const DocumentId &
+BatchOperation::getDocumentId() const noexcept
+{
+    return (_type == Type::PUT) ? _doc->getId() : _id;
+}
+
+}
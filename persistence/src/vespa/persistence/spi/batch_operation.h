@@ -0,0 +1,41 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "operationcomplete.h"
+#include "types.h"
+#include <vespa/document/base/documentid.h>
+
+namespace storage::spi {
+
+/**
+ * A put or remove of a single document, used as an element in a batch of
+ * operations towards the same bucket. Each operation has its own completion
+ * handler, receiving the same result as the corresponding single document
+ * operation (putAsync or removeIfFoundAsync) would have produced.
+ */
+class BatchOperation {
+public:
+    enum class Type : uint8_t { PUT, REMOVE };
+
+    BatchOperation(Timestamp timestamp, DocumentSP doc, OperationComplete::UP onComplete) noexcept;
+    BatchOperation(Timestamp timestamp, DocumentId id, OperationComplete::UP onComplete) noexcept;
+    BatchOperation(BatchOperation &&) noexcept;
+    BatchOperation & operator=(BatchOperation &&) noexcept;
+    ~BatchOperation();
+
+    Type getType() const noexcept { return _type; }
+    Timestamp getTimestamp() const noexcept { return _timestamp; }
+    // Not available for a put after its document has been stolen.
+    const DocumentId & getDocumentId() const noexcept;
+    OperationComplete & getOnComplete() noexcept { return *_onComplete; }
+    DocumentSP stealDocument() noexcept { return std::move(_doc); }
+    OperationComplete::UP stealOnComplete() noexcept { return std::move(_onComplete); }
+private:
+    Type                  _type;
+    Timestamp             _timestamp;
+    DocumentSP            _doc;
+    DocumentId            _id;
+    OperationComplete::UP _onComplete;
+};
+
+}
@@ -58,6 +58,17 @@ PersistenceProvider::removeIfFound(const Bucket& bucket, Timestamp timestamp, co
     return dynamic_cast<const RemoveResult &>(*future.get());
 }
 
+void
+PersistenceProvider::putOrRemoveBatchAsync(const Bucket& bucket, std::vector<BatchOperation> ops) {
+    for (auto & op : ops) {
+        if (op.getType() == BatchOperation::Type::PUT) {
+            putAsync(bucket, op.getTimestamp(), op.stealDocument(), op.stealOnComplete());
+        } else {
+            removeIfFoundAsync(bucket, op.getTimestamp(), op.getDocumentId(), op.stealOnComplete());
+        }
+    }
+}
+
 UpdateResult
 PersistenceProvider::update(const Bucket& bucket, Timestamp timestamp, DocumentUpdateSP upd) {
     auto catcher = std::make_unique<CatchResult>();
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "batch_operation.h"
 #include "bucket.h"
 #include "bucketinfo.h"
 #include "context.h"
@@ -191,6 +192,16 @@ struct PersistenceProvider
      */
     virtual void removeIfFoundAsync(const Bucket&, Timestamp timestamp, const DocumentId& id, OperationComplete::UP) = 0;
 
+    /**
+     * Perform a batch of puts and removes towards the same bucket, in the
+     * given order. Removes have the semantics of removeIfFound(). Each
+     * operation is completed through its own completion handler.
+     * Batching allows the provider to amortize per operation overhead,
+     * e.g. by persisting all operations with a single write and sync.
+     * The default implementation performs the operations one by one.
+     */
+    virtual void putOrRemoveBatchAsync(const Bucket&, std::vector<BatchOperation> ops);
+
     /**
      * Remove any trace of the entry with the given timestamp. (Be it a document
      * or a remove entry) This is usually used to revert previously performed
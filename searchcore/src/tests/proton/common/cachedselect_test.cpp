@@ -599,6 +599,57 @@ TEST_F("Test that single value attribute with complex attribute field results in
     TEST_DO(checkSelect(cs, f.db().getDoc(3u), Result::False));
 }
 
+void
+checkFilter(const CachedSelect::SP &cs, const std::vector<uint32_t> &lids)
+{
+    SelectContext ctx(*cs);
+    ctx.getAttributeGuards();
+    SessionUP session(cs->createSession());
+    std::vector<uint32_t> expected;
+    for (uint32_t lid : lids) {
+        ctx._docId = lid;
+        if (session->contains(ctx)) {
+            expected.push_back(lid);
+        }
+    }
+    std::vector<uint32_t> filtered(lids);
+    session->filter(ctx, filtered);
+    EXPECT_EQUAL(expected, filtered);
+}
+
+TEST_F("Test that batched filtering gives same result as per document evaluation", PreDocSelectFixture)
+{
+    f.db().addDoc(4u, "id:ns:test::4", "foo", "null", noIntVal, 5);
+    f.db().addDoc(5u, "id:ns:test::5", "bar", "null", 45, 5);
+    std::vector<uint32_t> lids = {1u, 2u, 3u, 4u, 5u};
+    std::vector<vespalib::string> selections = {
+        "test.aa == 3",
+        "test.aa != 3",
+        "test.aa < 7",
+        "test.aa <= 7",
+        "test.aa > 3",
+        "7 >= test.aa",
+        "test.aa > 3.5",
+        "test.aa == 3 or test.aa == 45",
+        "not (test.aa == 3 and test.aa < 10)",
+        "test.aa == null",
+        "test.aa = 3",
+        "test.aa == 3 AND test.ia == \"foo\"",
+        "test.aa > 3 OR test.ia == \"foo\""
+    };
+    for (const auto &selection : selections) {
+        TEST_STATE(selection.c_str());
+        CachedSelect::SP cs = f.testParse(selection, "test");
+        TEST_DO(checkFilter(cs, lids));
+    }
+    CachedSelect::SP cs = f.testParse("test.aa < 7", "test");
+    SelectContext ctx(*cs);
+    ctx.getAttributeGuards();
+    std::vector<uint32_t> filtered(lids);
+    cs->createSession()->filter(ctx, filtered);
+    EXPECT_EQUAL(std::vector<uint32_t>({1u, 2u}), filtered);
+}
+
 TEST_F("Test performance when using attributes", TestFixture)
 {
     MyDB &db(*f._db);
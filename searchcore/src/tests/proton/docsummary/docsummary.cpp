@@ -532,7 +532,7 @@ TEST("requireThatDocsumRequestIsProcessed")
     req.hits.emplace_back(gid2);
     req.hits.emplace_back(gid4);
     req.hits.emplace_back(gid9);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:[ {docsum:{a:20}}, {docsum:{a:40}}, {} ]}", *rep));
 }
 
@@ -550,7 +550,7 @@ TEST("requireThatRewritersAreUsed")
     DocsumRequest req;
     req.resultClassName = "class2";
     req.hits.emplace_back(gid1);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:[ {docsum:{aa:20}} ]}", *rep));
 }
 
@@ -570,7 +570,7 @@ TEST("requireThatSummariesTimeout")
     EXPECT_TRUE(req.expired());
     req.resultClassName = "class2";
     req.hits.emplace_back(gid1);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     const auto & root = rep->root();
     const auto & field = root["errors"];
     EXPECT_TRUE(field.valid());
@@ -592,7 +592,7 @@ void verifyFieldListHonoured(DocsumRequest::FieldList fields, const std::string
     req.resultClassName = "class6";
     req.hits.emplace_back(gid1);
     req.setFields(fields);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime(json, *rep));
 }
 
@@ -664,7 +664,7 @@ TEST("requireThatAttributesAreUsed")
     req.resultClassName = "class3";
     req.hits.emplace_back(gid2);
     req.hits.emplace_back(gid3);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
 
     EXPECT_TRUE(assertSlime("{docsums:[ {docsum:{"
                             "ba:10,bb:10.1250,"
@@ -700,7 +700,7 @@ TEST("requireThatAttributesAreUsed")
     }
     gate.await();
 
-    DocsumReply::UP rep2 = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep2 = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     TEST_DO(assertTensor(make_tensor(TensorSpec("tensor(x{},y{})")
                                      .add({{"x", "a"}, {"y", "b"}}, 4)),
                          "bj", *rep2, 1));
@@ -708,7 +708,7 @@ TEST("requireThatAttributesAreUsed")
     DocsumRequest req3;
     req3.resultClassName = "class3";
     req3.hits.emplace_back(gid3);
-    DocsumReply::UP rep3 = dc._ddb->getDocsums(req3);
+    DocsumReply::UP rep3 = dc._ddb->getDocsums(req3, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:[{docsum:{bj:x01020178017901016101624010000000000000}}]}", *rep3));
 }
 
@@ -885,7 +885,7 @@ TEST("requireThatPositionsAreUsed")
     DocsumRequest req;
     req.resultClassName = "class5";
     req.hits.emplace_back(gid1);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:["
                             "{docsum:{sp2:1047758"
                             ",sp2x:{x:1002, y:1003, latlong:'N0.001003;E0.001002'}"
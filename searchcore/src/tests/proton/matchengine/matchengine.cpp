@@ -20,7 +20,7 @@ public:
     explicit MySearchHandler(size_t numHits = 0) :
         _numHits(numHits), _name("my"), _reply("myreply")
     {}
-    DocsumReply::UP getDocsums(const DocsumRequest &) override {
+    DocsumReply::UP getDocsums(const DocsumRequest &, vespalib::ThreadBundle &) override {
         return std::make_unique<DocsumReply>();
     }
 
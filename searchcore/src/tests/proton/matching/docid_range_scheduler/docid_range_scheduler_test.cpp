@@ -287,4 +287,113 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work-stealing scheduler claims tasks of decreasing size") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 17);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 16u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(9, 11)));
+    EXPECT_EQUAL(scheduler.unassigned_size(), 12u);
+    for (uint32_t docid = 3; docid < 9; ++docid) {
+        TEST_DO(verify_range(scheduler.next_range(0), DocidRange(docid, docid + 1)));
+    }
+    EXPECT_EQUAL(scheduler.total_size(0), 8u);
+    EXPECT_EQUAL(scheduler.total_size(1), 2u);
+    EXPECT_EQUAL(scheduler.steal_count(0), 0u);
+    EXPECT_EQUAL(scheduler.steal_count(1), 0u);
+}
+
+TEST("require that the work-stealing scheduler steals half of the largest remaining range") {
+    WorkStealingDocidRangeScheduler scheduler(3, 1, 22);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 2)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(8, 9)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(15, 16)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(9, 10)));
+    for (uint32_t docid = 2; docid < 8; ++docid) {
+        TEST_DO(verify_range(scheduler.next_range(0), DocidRange(docid, docid + 1)));
+    }
+    // thread 2 has 6 docs left while thread 1 has 5 docs left
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(19, 20)));
+    EXPECT_EQUAL(scheduler.steal_count(0), 1u);
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(16, 17)));
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(17, 18)));
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(18, 19)));
+    // thread 1 has 5 docs left, the back 3 are stolen
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(12, 13)));
+    EXPECT_EQUAL(scheduler.steal_count(2), 1u);
+    EXPECT_EQUAL(scheduler.total_size(0), 8u);
+    EXPECT_EQUAL(scheduler.total_size(1), 2u);
+    EXPECT_EQUAL(scheduler.total_size(2), 5u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 6u);
+}
+
+TEST("require that the work-stealing scheduler is done when there is nothing left to steal") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 5);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 2)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(3, 4)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(2, 3)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 3u);
+    EXPECT_EQUAL(scheduler.total_size(1), 1u);
+    EXPECT_EQUAL(scheduler.steal_count(0), 1u);
+    EXPECT_EQUAL(scheduler.steal_count(1), 0u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work-stealing scheduler respects the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(1, 3, 9);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(4, 7)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(7, 9)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+}
+
+TEST("require that the work-stealing scheduler does not support work sharing") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 17);
+    EXPECT_TRUE(scheduler.make_idle_observer().is_always_zero());
+    TEST_DO(verify_range(scheduler.share_range(0, DocidRange(1, 9)), DocidRange(1, 9)));
+}
+
+TEST_MT_FF("require that the work-stealing scheduler protects against documents underflow",
+           2, WorkStealingDocidRangeScheduler(num_threads, 1, 0), TimeBomb(60))
+{
+    TEST_DO(verify_range(f1.first_range(thread_id), DocidRange()));
+    EXPECT_EQUAL(f1.total_size(thread_id), 0u);
+    EXPECT_EQUAL(f1.unassigned_size(), 0u);
+}
+
+TEST_MT_FFF("require that the work-stealing scheduler assigns each docid exactly once",
+            8, WorkStealingDocidRangeScheduler(num_threads, 1, 100000),
+            std::vector<std::atomic<uint32_t>>(100000), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2[docid].fetch_add(1, std::memory_order_relaxed);
+        }
+        if (thread_id == 0) {
+            // make thread 0 slow to have others steal its work
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        size_t total = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total += f1.total_size(i);
+        }
+        EXPECT_EQUAL(total, 99999u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f2[0].load(), 0u);
+        for (uint32_t docid = 1; docid < 100000; ++docid) {
+            EXPECT_EQUAL(f2[docid].load(), 1u);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -144,6 +144,26 @@ TEST("requireThatMinMaxTimesAreRecorded") {
     EXPECT_APPROX(5.0, stats.queryLatencyMax(), 0.00001);
 }
 
+TEST("requireThatPartitionStealsAndIdleTimeAreAdded") {
+    MatchingStats::Partition part1;
+    part1.steals(3).idle_time(0.25);
+    EXPECT_EQUAL(3u, part1.steals());
+    EXPECT_EQUAL(0.25, part1.idle_time_avg());
+    EXPECT_EQUAL(1u, part1.idle_time_count());
+    MatchingStats::Partition part2;
+    part2.steals(2).idle_time(0.75);
+    MatchingStats stats1;
+    stats1.merge_partition(part1, 0);
+    MatchingStats stats2;
+    stats2.merge_partition(part2, 0);
+    stats1.add(stats2);
+    EXPECT_EQUAL(5u, stats1.getPartition(0).steals());
+    EXPECT_EQUAL(0.5, stats1.getPartition(0).idle_time_avg());
+    EXPECT_EQUAL(2u, stats1.getPartition(0).idle_time_count());
+    EXPECT_EQUAL(0.25, stats1.getPartition(0).idle_time_min());
+    EXPECT_EQUAL(0.75, stats1.getPartition(0).idle_time_max());
+}
+
 TEST("requireThatPartitionsAreAddedCorrectly") {
     MatchingStats all1;
     EXPECT_EQUAL(0u, all1.docidSpaceCovered());
@@ -365,7 +365,7 @@ struct MyWorld {
 
         explicit MySearchHandler(Matcher::SP matcher) noexcept : _matcher(std::move(matcher)) {}
 
-        DocsumReply::UP getDocsums(const DocsumRequest &) override {
+        DocsumReply::UP getDocsums(const DocsumRequest &, vespalib::ThreadBundle &) override {
             return {};
         }
         SearchReply::UP match(const SearchRequest &, vespalib::ThreadBundle &) const override {
@@ -431,16 +431,16 @@ struct MyWorld {
         return std::make_unique<FieldInfo>(*field);
     }
 
-    FeatureSet::SP getSummaryFeatures(const DocsumRequest & req) {
+    FeatureSet::SP getSummaryFeatures(const DocsumRequest & req, vespalib::ThreadBundle &thread_bundle = ttb()) {
         Matcher::SP matcher = createMatcher();
         auto docsum_matcher = matcher->create_docsum_matcher(req, searchContext, attributeContext, *sessionManager);
-        return docsum_matcher->get_summary_features();
+        return docsum_matcher->get_summary_features(thread_bundle);
     }
 
-    FeatureSet::SP getRankFeatures(const DocsumRequest & req) {
+    FeatureSet::SP getRankFeatures(const DocsumRequest & req, vespalib::ThreadBundle &thread_bundle = ttb()) {
         Matcher::SP matcher = createMatcher();
         auto docsum_matcher = matcher->create_docsum_matcher(req, searchContext, attributeContext, *sessionManager);
-        return docsum_matcher->get_rank_features();
+        return docsum_matcher->get_rank_features(thread_bundle);
     }
 
     MatchingElements::UP get_matching_elements(const DocsumRequest &req, const MatchingElementsFields &fields) {
@@ -816,6 +816,31 @@ TEST("require that rank features are filled") {
     EXPECT_EQUAL(60, f[0].as_double());
 }
 
+TEST("require that summary and rank features can be calculated using multiple threads") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    DocsumRequest::SP req = MyWorld::createSimpleDocsumRequest("f1", "foo");
+    vespalib::SimpleThreadBundle thread_bundle(3);
+    FeatureSet::SP expect_summary = world.getSummaryFeatures(*req);
+    FeatureSet::SP summary = world.getSummaryFeatures(*req, thread_bundle);
+    FeatureSet::SP expect_rank = world.getRankFeatures(*req);
+    FeatureSet::SP rank = world.getRankFeatures(*req, thread_bundle);
+    for (const auto &[expect, actual] : {std::make_pair(expect_summary, summary), std::make_pair(expect_rank, rank)}) {
+        ASSERT_EQUAL(3u, actual->numDocs());
+        ASSERT_EQUAL(expect->numFeatures(), actual->numFeatures());
+        EXPECT_TRUE(expect->getNames() == actual->getNames());
+        for (uint32_t docid : {10u, 15u, 30u}) {
+            const FeatureSet::Value *e = expect->getFeaturesByDocId(docid);
+            const FeatureSet::Value *a = actual->getFeaturesByDocId(docid);
+            ASSERT_TRUE(e != nullptr && a != nullptr);
+            for (uint32_t i = 0; i < actual->numFeatures(); ++i) {
+                EXPECT_TRUE(e[i] == a[i]);
+            }
+        }
+    }
+}
+
 TEST("require that search session can be cached") {
     MyWorld world;
     world.basicSetup();
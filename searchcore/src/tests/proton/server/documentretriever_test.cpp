@@ -35,6 +35,7 @@
 #include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/serialization/lazydocumentview.h>
 #include <vespa/document/test/fieldvalue_helpers.h>
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/testkit/testapp.h>
@@ -143,11 +144,13 @@ const TensorDataType tensorDataType(ValueType::from_spec(tensor_spec));
 struct MyDocumentStore : proton::test::DummyDocumentStore {
     mutable std::unique_ptr<Document> _testDoc;
     bool _set_position_struct_field;
+    mutable uint32_t _lazy_reads;
 
     MyDocumentStore()
         : proton::test::DummyDocumentStore(),
           _testDoc(),
-          _set_position_struct_field(true)
+          _set_position_struct_field(true),
+          _lazy_reads(0)
     {
     }
 
@@ -183,6 +186,11 @@ struct MyDocumentStore : proton::test::DummyDocumentStore {
 
         return doc;
     }
+
+    DocumentViewUP readLazy(DocumentIdT lid, const DocumentTypeRepo &r) const override {
+        ++_lazy_reads;
+        return search::IDocumentStore::readLazy(lid, r);
+    }
     
     uint64_t
     initFlush(uint64_t syncToken) override
@@ -480,6 +488,51 @@ TEST_F("require that we can look up NONE and DOCIDONLY field sets", Fixture) {
         EXPECT_TRUE(doc->getFields().empty());
 }
 
+TEST_F("require that only requested attributes are patched into partial stored document", Fixture) {
+    DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
+    const DocumentType &doc_type = *f.repo.getDocumentType(doc_type_name);
+    document::FieldCollection field_set(doc_type, document::Field::Set::Builder()
+                                                      .add(&doc_type.getField(static_field))
+                                                      .add(&doc_type.getField(dyn_field_i))
+                                                      .add(&doc_type.getField(dyn_field_nai))
+                                                      .build());
+    Document::UP doc = f._retriever->getPartialDocument(meta_data.lid, doc_id, field_set);
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(static_field), static_value));
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(dyn_field_i), dyn_value_i));
+    EXPECT_FALSE(doc->getValue(dyn_field_nai));
+    EXPECT_FALSE(doc->getValue(dyn_field_s));
+    EXPECT_FALSE(doc->getValue(dyn_field_nas));
+
+    doc = f._retriever->getPartialDocument(meta_data.lid, doc_id, doc_type.getField(static_field));
+    ASSERT_TRUE(doc);
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(static_field), static_value));
+    EXPECT_FALSE(doc->getValue(dyn_field_i));
+}
+
+TEST_F("require that partial stored document only holds requested fields from lazy document view", Fixture) {
+    DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
+    const DocumentType &doc_type = *f.repo.getDocumentType(doc_type_name);
+    document::FieldCollection field_set(doc_type, document::Field::Set::Builder()
+                                                      .add(&doc_type.getField(static_field))
+                                                      .add(&doc_type.getField(dyn_field_s))
+                                                      .build());
+    Document::UP doc = f._retriever->getPartialDocument(meta_data.lid, doc_id, field_set);
+    ASSERT_TRUE(doc);
+    EXPECT_EQUAL(1u, f.doc_store._lazy_reads);
+    EXPECT_EQUAL(doc_id, doc->getId());
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(doc->getValue(static_field), static_value));
+    EXPECT_TRUE(checkFieldValue<StringFieldValue>(doc->getValue(dyn_field_s), dyn_value_s));
+    EXPECT_FALSE(doc->getValue(dyn_field_nai));
+    EXPECT_FALSE(doc->getValue(dyn_field_nas));
+    EXPECT_FALSE(doc->getValue(zcurve_field));
+    EXPECT_FALSE(doc->getValue(dyn_field_tensor));
+
+    doc = f._retriever->getFullDocument(meta_data.lid);
+    ASSERT_TRUE(doc);
+    EXPECT_EQUAL(1u, f.doc_store._lazy_reads);
+}
+
 TEST_F("require that attributes are patched into stored document unless also index field", Fixture) {
     f.addIndexField(Schema::IndexField(dyn_field_s, DataType::STRING)).build();
     DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
@@ -16,8 +16,10 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/size_literals.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("feedstates_test");
@@ -75,13 +77,14 @@ struct Fixture
     bucketdb::BucketDBHandler _bucketDBHandler;
     ReplayThrottlingPolicy _replay_throttling_policy;
     MyIncSerialNum _inc_serial_num;
+    vespalib::ThreadStackExecutor _shared_executor;
     ReplayTransactionLogState state;
 
-    Fixture();
+    explicit Fixture(uint32_t replay_concurrency = 1);
     ~Fixture();
 };
 
-Fixture::Fixture()
+Fixture::Fixture(uint32_t replay_concurrency)
     : feed_view1(),
       feed_view2(),
       feed_view_ptr(&feed_view1),
@@ -91,11 +94,17 @@ Fixture::Fixture()
       _bucketDBHandler(_bucketDB),
       _replay_throttling_policy({}),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num)
+      _shared_executor(4, 128_Ki),
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num,
+            _shared_executor, replay_concurrency)
 {
 }
 Fixture::~Fixture() = default;
 
+struct ParallelFixture : public Fixture {
+    ParallelFixture() : Fixture(4) {}
+};
+
 
 struct RemoveOperationContext
 {
@@ -104,18 +113,20 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    explicit RemoveOperationContext(search::SerialNum serial);
+    explicit RemoveOperationContext(search::SerialNum serial, uint32_t num_entries = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, uint32_t num_entries)
     : doc_id("id:ns:doctypename::bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet(std::make_unique<Packet>(0xf000))
 {
     op.serialize(str);
     ConstBufferRef buf(str.data(), str.wp());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (uint32_t i = 0; i < num_entries; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() = default;
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -151,6 +162,22 @@ TEST_F("require that replay progress is tracked", Fixture)
     f.state.receive(wrap, executor);
     EXPECT_EQUAL(10u, progress.getCurrent());
     EXPECT_EQUAL(0.5, progress.getProgress());
+    EXPECT_EQUAL(1u, progress.getEntries());
+}
+
+TEST_F("require that packet entries can be deserialized in parallel during replay", ParallelFixture)
+{
+    RemoveOperationContext opCtx(10, 200);
+    TlsReplayProgress progress("test", 9, 209);
+    auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, &progress);
+    ForegroundThreadExecutor executor;
+
+    // Serial numbers are checked to be consecutive as operations are replayed.
+    f.state.receive(wrap, executor);
+    EXPECT_EQUAL(200, f.feed_view1.remove_handled);
+    EXPECT_EQUAL(209u, progress.getCurrent());
+    EXPECT_EQUAL(200u, progress.getEntries());
+    EXPECT_EQUAL(209u, f._inc_serial_num._serial_num);
 }
 
 }  // namespace
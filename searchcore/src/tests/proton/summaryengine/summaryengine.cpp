@@ -57,7 +57,7 @@ public:
         : _name(name), _reply(reply)
     {}
 
-    DocsumReply::UP getDocsums(const DocsumRequest &request) override {
+    DocsumReply::UP getDocsums(const DocsumRequest &request, vespalib::ThreadBundle &) override {
         return std::make_unique<DocsumReply>(createSlimeReply(request.hits.size()));
     }
 
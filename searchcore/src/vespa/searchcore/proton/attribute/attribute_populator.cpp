@@ -18,6 +18,8 @@ namespace proton {
 
 namespace {
 
+constexpr uint32_t MAX_PENDING_COMMITS = 64;
+
 class PopulateDoneContext : public IDestructorCallback
 {
     std::shared_ptr<document::Document> _doc;
@@ -59,7 +61,10 @@ AttributePopulator::AttributePopulator(const proton::IAttributeManager::SP &mgr,
       _initSerialNum(initSerialNum),
       _currSerialNum(initSerialNum),
       _configSerialNum(configSerialNum),
-      _subDbName(subDbName)
+      _subDbName(subDbName),
+      _pending_gate(),
+      _pending_commits(),
+      _num_pending_commits(0)
 {
     if (LOG_WOULD_LOG(event)) {
         EventLogger::populateAttributeStart(getNames());
@@ -68,6 +73,7 @@ AttributePopulator::AttributePopulator(const proton::IAttributeManager::SP &mgr,
 
 AttributePopulator::~AttributePopulator()
 {
+    await_pending_commits();
     if (LOG_WOULD_LOG(event)) {
         EventLogger::populateAttributeComplete(getNames(),_currSerialNum - _initSerialNum);
     }
@@ -78,14 +84,32 @@ AttributePopulator::handleExisting(uint32_t lid, const std::shared_ptr<document:
 {
     search::SerialNum serialNum(nextSerialNum());
     _writer.put(serialNum, *doc, lid, std::make_shared<PopulateDoneContext>(doc));
-    vespalib::Gate gate;
-    _writer.forceCommit(serialNum, std::make_shared<vespalib::GateCallback>(gate));
-    gate.await();
+    if (!_pending_commits) {
+        _pending_gate = std::make_unique<vespalib::Gate>();
+        _pending_commits = std::make_shared<vespalib::GateCallback>(*_pending_gate);
+    }
+    _writer.forceCommit(serialNum, _pending_commits);
+    if (++_num_pending_commits >= MAX_PENDING_COMMITS) {
+        await_pending_commits();
+    }
+}
+
+void
+AttributePopulator::await_pending_commits()
+{
+    if (!_pending_commits) {
+        return;
+    }
+    _pending_commits.reset();
+    _pending_gate->await();
+    _pending_gate.reset();
+    _num_pending_commits = 0;
 }
 
 void
 AttributePopulator::done()
 {
+    await_pending_commits();
     auto mgr = _writer.getAttributeManager();
     auto flushTargets = mgr->getFlushTargets();
     for (const auto &flushTarget : flushTargets) {
@@ -5,10 +5,19 @@
 #include "attribute_writer.h"
 #include <vespa/searchcore/proton/reprocessing/i_reprocessing_reader.h>
 
+namespace vespalib {
+class Gate;
+class GateCallback;
+}
+
 namespace proton {
 
 /**
  * Class used to populate attribute vectors based on visiting the content of a document store.
+ *
+ * Each document is committed on its own, but a window of commits is allowed to be pending.
+ * This lets the prepare step of two-phase puts (e.g. for tensor attributes with hnsw index)
+ * for the documents in the window run in parallel in the shared executor.
  */
 class AttributePopulator : public IReprocessingReader
 {
@@ -18,8 +27,12 @@ private:
     search::SerialNum _currSerialNum;
     search::SerialNum _configSerialNum;
     vespalib::string  _subDbName;
+    std::unique_ptr<vespalib::Gate>         _pending_gate;
+    std::shared_ptr<vespalib::GateCallback> _pending_commits;
+    uint32_t                                _num_pending_commits;
 
     search::SerialNum nextSerialNum();
+    void await_pending_commits();
 
     std::vector<vespalib::string> getNames() const;
 
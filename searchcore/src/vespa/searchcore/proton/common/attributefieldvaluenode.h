@@ -20,6 +20,7 @@ public:
     std::unique_ptr<document::select::Value> getValue(const Context &context) const override;
     std::unique_ptr<document::select::Value> traceValue(const Context &context, std::ostream& out) const override;
     document::select::ValueNode::UP clone() const override;
+    uint32_t attr_guard_index() const noexcept { return _attr_guard_index; }
 };
 
 } // namespace proton
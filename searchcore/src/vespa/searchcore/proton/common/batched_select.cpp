@@ -0,0 +1,294 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batched_select.h"
+#include "attributefieldvaluenode.h"
+#include "selectcontext.h"
+#include <vespa/document/select/branch.h>
+#include <vespa/document/select/compare.h>
+#include <vespa/document/select/operator.h>
+#include <vespa/document/select/result.h>
+#include <vespa/document/select/resultlist.h>
+#include <vespa/document/select/traversingvisitor.h>
+#include <vespa/document/select/valuenodes.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <cassert>
+
+namespace proton {
+
+using document::select::And;
+using document::select::Compare;
+using document::select::FieldValueNode;
+using document::select::FloatValueNode;
+using document::select::FunctionOperator;
+using document::select::IntegerValueNode;
+using document::select::Node;
+using document::select::Not;
+using document::select::Or;
+using document::select::Result;
+using document::select::ValueNode;
+using search::attribute::IAttributeVector;
+
+using LidVector = BatchedSelect::LidVector;
+using Results = BatchedSelect::Results;
+
+class BatchedSelect::Step {
+public:
+    virtual ~Step() = default;
+    virtual void evaluate(SelectContext &context, const LidVector &lids, Results &results) const = 0;
+};
+
+namespace {
+
+/*
+ * Evaluates a subexpression by walking the expression tree once per lid.
+ */
+class TreeStep : public BatchedSelect::Step {
+    const Node &_node;
+public:
+    explicit TreeStep(const Node &node) noexcept : _node(node) {}
+    void evaluate_one(SelectContext &context, uint32_t lid, const Result *&result) const {
+        context._docId = lid;
+        result = &_node.contains(context).combineResults();
+    }
+    void evaluate(SelectContext &context, const LidVector &lids, Results &results) const override {
+        results.resize(lids.size());
+        for (size_t i = 0; i < lids.size(); ++i) {
+            evaluate_one(context, lids[i], results[i]);
+        }
+    }
+};
+
+class AndStep : public BatchedSelect::Step {
+    std::unique_ptr<Step> _left;
+    std::unique_ptr<Step> _right;
+public:
+    AndStep(std::unique_ptr<Step> left, std::unique_ptr<Step> right) noexcept
+        : _left(std::move(left)), _right(std::move(right)) {}
+    void evaluate(SelectContext &context, const LidVector &lids, Results &results) const override {
+        Results right;
+        _left->evaluate(context, lids, results);
+        _right->evaluate(context, lids, right);
+        for (size_t i = 0; i < results.size(); ++i) {
+            results[i] = &(*results[i] && *right[i]);
+        }
+    }
+};
+
+class OrStep : public BatchedSelect::Step {
+    std::unique_ptr<Step> _left;
+    std::unique_ptr<Step> _right;
+public:
+    OrStep(std::unique_ptr<Step> left, std::unique_ptr<Step> right) noexcept
+        : _left(std::move(left)), _right(std::move(right)) {}
+    void evaluate(SelectContext &context, const LidVector &lids, Results &results) const override {
+        Results right;
+        _left->evaluate(context, lids, results);
+        _right->evaluate(context, lids, right);
+        for (size_t i = 0; i < results.size(); ++i) {
+            results[i] = &(*results[i] || *right[i]);
+        }
+    }
+};
+
+class NotStep : public BatchedSelect::Step {
+    std::unique_ptr<Step> _child;
+public:
+    explicit NotStep(std::unique_ptr<Step> child) noexcept : _child(std::move(child)) {}
+    void evaluate(SelectContext &context, const LidVector &lids, Results &results) const override {
+        _child->evaluate(context, lids, results);
+        for (auto &result : results) {
+            result = &!*result;
+        }
+    }
+};
+
+enum class CompareOp { EQ, NE, LT, LEQ, GT, GEQ };
+
+/*
+ * Mirrors the numeric comparisons in document::select::Value, where all
+ * operators are derived from less than and equality.
+ */
+template <typename L, typename R>
+bool
+compare(CompareOp op, L lhs, R rhs) noexcept
+{
+    bool lt = (rhs > lhs);
+    bool eq = (lhs == rhs);
+    switch (op) {
+    case CompareOp::EQ:  return eq;
+    case CompareOp::NE:  return !eq;
+    case CompareOp::LT:  return lt;
+    case CompareOp::LEQ: return lt || eq;
+    case CompareOp::GT:  return !lt && !eq;
+    case CompareOp::GEQ: return !lt;
+    }
+    return false;
+}
+
+/*
+ * Compares a single value numeric attribute with a numeric constant for all
+ * lids at once. Lids with undefined attribute values, and attributes that
+ * turn out not to be numeric, are left to the expression tree.
+ */
+template <typename ConstT>
+class AttributeCompareStep : public BatchedSelect::Step {
+    TreeStep  _tree;
+    uint32_t  _attr_guard_index;
+    CompareOp _op;
+    ConstT    _constant;
+    bool      _attr_on_left;
+
+    template <typename AttrT, typename GetValue>
+    void compare_all(SelectContext &context, const IAttributeVector &attr, GetValue get_value,
+                     const LidVector &lids, Results &results) const
+    {
+        results.resize(lids.size());
+        for (size_t i = 0; i < lids.size(); ++i) {
+            uint32_t lid = lids[i];
+            if (attr.isUndefined(lid)) {
+                _tree.evaluate_one(context, lid, results[i]);
+                continue;
+            }
+            AttrT value = get_value(lid);
+            bool match = _attr_on_left ? compare(_op, value, _constant) : compare(_op, _constant, value);
+            results[i] = &Result::get(match);
+        }
+    }
+public:
+    AttributeCompareStep(const Compare &node, uint32_t attr_guard_index, CompareOp op,
+                         ConstT constant, bool attr_on_left) noexcept
+        : _tree(node),
+          _attr_guard_index(attr_guard_index),
+          _op(op),
+          _constant(constant),
+          _attr_on_left(attr_on_left)
+    {}
+    void evaluate(SelectContext &context, const LidVector &lids, Results &results) const override {
+        const auto &attr = context.guarded_attribute_at_index(_attr_guard_index);
+        if (attr.isIntegerType()) {
+            compare_all<IAttributeVector::largeint_t>(context, attr, [&attr](uint32_t lid) { return attr.getInt(lid); },
+                                                      lids, results);
+        } else if (attr.isFloatingPointType()) {
+            compare_all<double>(context, attr, [&attr](uint32_t lid) { return attr.getFloat(lid); },
+                                lids, results);
+        } else {
+            _tree.evaluate(context, lids, results);
+        }
+    }
+};
+
+/*
+ * Checks that all field references in an expression are single value
+ * attributes, in which case and/or/not branches can be combined element-wise
+ * without loss of precision (no variables are bound by the comparisons).
+ */
+class AttributeFieldsOnly : public document::select::TraversingVisitor {
+public:
+    bool _attributes_only = true;
+    void visitFieldValueNode(const FieldValueNode &expr) override {
+        if (dynamic_cast<const AttributeFieldValueNode *>(&expr) == nullptr) {
+            _attributes_only = false;
+        }
+    }
+};
+
+bool
+has_attribute_fields_only(const Node &node)
+{
+    AttributeFieldsOnly visitor;
+    node.visit(visitor);
+    return visitor._attributes_only;
+}
+
+bool
+to_compare_op(const document::select::Operator &op, CompareOp &result)
+{
+    if (&op == &FunctionOperator::EQ) {
+        result = CompareOp::EQ;
+    } else if (&op == &FunctionOperator::NE) {
+        result = CompareOp::NE;
+    } else if (&op == &FunctionOperator::LT) {
+        result = CompareOp::LT;
+    } else if (&op == &FunctionOperator::LEQ) {
+        result = CompareOp::LEQ;
+    } else if (&op == &FunctionOperator::GT) {
+        result = CompareOp::GT;
+    } else if (&op == &FunctionOperator::GEQ) {
+        result = CompareOp::GEQ;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<BatchedSelect::Step>
+make_attribute_compare(const Compare &node, const AttributeFieldValueNode &attr, const ValueNode &constant,
+                       CompareOp op, bool attr_on_left)
+{
+    if (const auto *int_node = dynamic_cast<const IntegerValueNode *>(&constant)) {
+        return std::make_unique<AttributeCompareStep<int64_t>>(node, attr.attr_guard_index(), op,
+                                                               int_node->getValue(), attr_on_left);
+    }
+    if (const auto *float_node = dynamic_cast<const FloatValueNode *>(&constant)) {
+        return std::make_unique<AttributeCompareStep<double>>(node, attr.attr_guard_index(), op,
+                                                              float_node->getValue(), attr_on_left);
+    }
+    return {};
+}
+
+std::unique_ptr<BatchedSelect::Step>
+compile(const Node &node, uint32_t &attribute_comparisons)
+{
+    if (!has_attribute_fields_only(node)) {
+        return std::make_unique<TreeStep>(node);
+    }
+    if (const auto *and_node = dynamic_cast<const And *>(&node)) {
+        auto left = compile(and_node->getLeft(), attribute_comparisons);
+        return std::make_unique<AndStep>(std::move(left), compile(and_node->getRight(), attribute_comparisons));
+    }
+    if (const auto *or_node = dynamic_cast<const Or *>(&node)) {
+        auto left = compile(or_node->getLeft(), attribute_comparisons);
+        return std::make_unique<OrStep>(std::move(left), compile(or_node->getRight(), attribute_comparisons));
+    }
+    if (const auto *not_node = dynamic_cast<const Not *>(&node)) {
+        return std::make_unique<NotStep>(compile(not_node->getChild(), attribute_comparisons));
+    }
+    if (const auto *compare_node = dynamic_cast<const Compare *>(&node)) {
+        CompareOp op;
+        if (to_compare_op(compare_node->getOperator(), op)) {
+            std::unique_ptr<BatchedSelect::Step> step;
+            const auto &left = compare_node->getLeft();
+            const auto &right = compare_node->getRight();
+            if (const auto *attr = dynamic_cast<const AttributeFieldValueNode *>(&left)) {
+                step = make_attribute_compare(*compare_node, *attr, right, op, true);
+            } else if (const auto *attr_right = dynamic_cast<const AttributeFieldValueNode *>(&right)) {
+                step = make_attribute_compare(*compare_node, *attr_right, left, op, false);
+            }
+            if (step) {
+                ++attribute_comparisons;
+                return step;
+            }
+        }
+    }
+    return std::make_unique<TreeStep>(node);
+}
+
+}
+
+BatchedSelect::BatchedSelect(const Node &root)
+    : _root(),
+      _attribute_comparisons(0)
+{
+    _root = compile(root, _attribute_comparisons);
+}
+
+BatchedSelect::~BatchedSelect() = default;
+
+void
+BatchedSelect::evaluate(SelectContext &context, const LidVector &lids, Results &results) const
+{
+    _root->evaluate(context, lids, results);
+    assert(results.size() == lids.size());
+}
+
+}
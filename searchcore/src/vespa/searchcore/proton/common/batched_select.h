@@ -0,0 +1,52 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace document::select {
+    class Node;
+    class Result;
+}
+
+namespace proton {
+
+class SelectContext;
+
+/**
+ * Selection expression compiled for evaluation over a batch of local
+ * document ids, using the attribute vectors guarded by a select context.
+ *
+ * Comparisons between a numeric single value attribute field and a numeric
+ * constant are evaluated directly against the attribute vector for the whole
+ * batch, and and/or/not branches are combined element-wise. Any other
+ * subexpression, and any document with an undefined attribute value, is
+ * evaluated by the expression tree for one document id at a time, thus the
+ * result is always the same as calling contains() on the expression.
+ */
+class BatchedSelect
+{
+public:
+    using Results = std::vector<const document::select::Result *>;
+    using LidVector = std::vector<uint32_t>;
+    class Step;
+
+    // The expression must outlive this object.
+    explicit BatchedSelect(const document::select::Node &root);
+    ~BatchedSelect();
+
+    /*
+     * Evaluate the expression for each of the given lids. Attribute guards
+     * must have been taken on the context.
+     */
+    void evaluate(SelectContext &context, const LidVector &lids, Results &results) const;
+
+    // Number of comparisons evaluated directly against attribute vectors.
+    uint32_t attribute_comparisons() const noexcept { return _attribute_comparisons; }
+private:
+    std::unique_ptr<Step> _root;
+    uint32_t              _attribute_comparisons;
+};
+
+}
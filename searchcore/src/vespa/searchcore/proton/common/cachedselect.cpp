@@ -2,6 +2,7 @@
 
 #include "cachedselect.h"
 #include "attributefieldvaluenode.h"
+#include "batched_select.h"
 #include "select_utils.h"
 #include "selectcontext.h"
 #include "selectpruner.h"
@@ -125,10 +126,14 @@ CachedSelect::Session::Session(std::unique_ptr<document::select::Node> docSelect
                                std::unique_ptr<document::select::Node> preDocSelect)
     : _docSelect(std::move(docSelect)),
       _preDocOnlySelect(std::move(preDocOnlySelect)),
-      _preDocSelect(std::move(preDocSelect))
+      _preDocSelect(std::move(preDocSelect)),
+      _batchedPreDocOnlySelect(_preDocOnlySelect ? std::make_unique<BatchedSelect>(*_preDocOnlySelect) : nullptr),
+      _batchedPreDocSelect(_preDocSelect ? std::make_unique<BatchedSelect>(*_preDocSelect) : nullptr)
 {
 }
 
+CachedSelect::Session::~Session() = default;
+
 bool
 CachedSelect::Session::contains(const SelectContext &context) const
 {
@@ -146,6 +151,29 @@ CachedSelect::Session::contains(const document::Document &doc) const
             (_docSelect && (_docSelect->contains(doc) == document::select::Result::True));
 }
 
+void
+CachedSelect::Session::filter(SelectContext &context, std::vector<uint32_t> &lids) const
+{
+    BatchedSelect::Results results;
+    auto keep_lids = [&lids, &results](const document::select::Result &wanted, bool keep_if_wanted) {
+        size_t kept = 0;
+        for (size_t i = 0; i < lids.size(); ++i) {
+            if ((results[i] == &wanted) == keep_if_wanted) {
+                lids[kept++] = lids[i];
+            }
+        }
+        lids.resize(kept);
+    };
+    if (_batchedPreDocSelect) {
+        _batchedPreDocSelect->evaluate(context, lids, results);
+        keep_lids(document::select::Result::False, false);
+    }
+    if (_batchedPreDocOnlySelect) {
+        _batchedPreDocOnlySelect->evaluate(context, lids, results);
+        keep_lids(document::select::Result::True, true);
+    }
+}
+
 const document::select::Node &
 CachedSelect::Session::selectNode() const
 {
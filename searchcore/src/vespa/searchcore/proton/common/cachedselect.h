@@ -20,6 +20,7 @@ namespace search::attribute { class ReadableAttributeVector; }
 
 namespace proton {
 
+class BatchedSelect;
 class SelectContext;
 class SelectPruner;
 
@@ -37,13 +38,22 @@ public:
         std::unique_ptr<document::select::Node> _docSelect;
         std::unique_ptr<document::select::Node> _preDocOnlySelect;
         std::unique_ptr<document::select::Node> _preDocSelect;
+        std::unique_ptr<BatchedSelect>          _batchedPreDocOnlySelect;
+        std::unique_ptr<BatchedSelect>          _batchedPreDocSelect;
 
     public:
         Session(std::unique_ptr<document::select::Node> docSelect,
                 std::unique_ptr<document::select::Node> preDocOnlySelect,
                 std::unique_ptr<document::select::Node> preDocSelect);
+        ~Session();
         bool contains(const SelectContext &context) const;
         bool contains(const document::Document &doc) const;
+        /**
+         * Remove the lids that can not match without retrieving the
+         * documents, evaluating the attribute parts of the selection for
+         * all lids in one pass. Same outcome as contains(context) per lid.
+         */
+        void filter(SelectContext &context, std::vector<uint32_t> &lids) const;
         const document::select::Node &selectNode() const;
     };
 
@@ -104,7 +104,8 @@ DocsumContext::createSlimeReply()
 DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docsumWriter,
                              IDocsumStore & docsumStore, std::shared_ptr<Matcher> matcher,
                              ISearchContext & searchCtx, IAttributeContext & attrCtx,
-                             const IAttributeManager & attrMgr, SessionManager & sessionMgr) :
+                             const IAttributeManager & attrMgr, SessionManager & sessionMgr,
+                             vespalib::ThreadBundle & threadBundle) :
     _request(request),
     _docsumWriter(docsumWriter),
     _docsumStore(docsumStore),
@@ -113,7 +114,8 @@ DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docs
     _attrCtx(attrCtx),
     _attrMgr(attrMgr),
     _docsumState(*this),
-    _sessionMgr(sessionMgr)
+    _sessionMgr(sessionMgr),
+    _threadBundle(threadBundle)
 {
     initState();
 }
@@ -129,7 +131,7 @@ DocsumContext::fillSummaryFeatures(search::docsummary::GetDocsumsState& state)
 {
     assert(&_docsumState == &state);
     if (_matcher->canProduceSummaryFeatures()) {
-        state._summaryFeatures = _matcher->getSummaryFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+        state._summaryFeatures = _matcher->getSummaryFeatures(_request, _searchCtx, _attrCtx, _sessionMgr, _threadBundle);
     }
     state._summaryFeaturesCached = false;
 }
@@ -142,7 +144,7 @@ DocsumContext::fillRankFeatures(search::docsummary::GetDocsumsState& state)
     if ( ! state._args.dumpFeatures()) {
         return;
     }
-    state._rankFeatures = _matcher->getRankFeatures(_request, _searchCtx, _attrCtx, _sessionMgr);
+    state._rankFeatures = _matcher->getRankFeatures(_request, _searchCtx, _attrCtx, _sessionMgr, _threadBundle);
 }
 
 std::unique_ptr<MatchingElements>
@@ -7,6 +7,8 @@
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace proton {
 
 namespace matching {
@@ -30,6 +32,7 @@ private:
     const search::IAttributeManager      & _attrMgr;
     search::docsummary::GetDocsumsState    _docsumState;
     matching::SessionManager             & _sessionMgr;
+    vespalib::ThreadBundle               & _threadBundle;
 
     void initState();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
@@ -44,7 +47,8 @@ public:
                   matching::ISearchContext & searchCtx,
                   search::attribute::IAttributeContext & attrCtx,
                   const search::IAttributeManager & attrMgr,
-                  matching::SessionManager & sessionMgr);
+                  matching::SessionManager & sessionMgr,
+                  vespalib::ThreadBundle & threadBundle);
 
     search::engine::DocsumReply::UP getDocsums();
 
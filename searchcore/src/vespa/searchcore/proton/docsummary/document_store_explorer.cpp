@@ -7,6 +7,7 @@ using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 using search::DataStoreFileChunkStats;
 using search::DataStoreStorageStats;
+using search::VisitCacheShardStats;
 
 namespace proton {
 
@@ -27,6 +28,21 @@ setMemoryUsage(Cursor &object, const vespalib::MemoryUsage &usage)
     memory.setLong("onHoldBytes", usage.allocatedBytesOnHold());
 }
 
+void
+setVisitCacheShardStats(Cursor &object, const std::vector<VisitCacheShardStats> &shardStats)
+{
+    Cursor &shards = object.setObject("visitCache").setArray("shards");
+    for (const auto &shard : shardStats) {
+        Cursor &shardCursor = shards.addObject();
+        shardCursor.setLong("hits", shard.stats.hits);
+        shardCursor.setLong("misses", shard.stats.misses);
+        shardCursor.setLong("evictions", shard.evictions);
+        shardCursor.setLong("invalidations", shard.stats.invalidations);
+        shardCursor.setLong("elements", shard.stats.elements);
+        shardCursor.setLong("memoryUsed", shard.stats.memory_used);
+    }
+}
+
 }
 
 void
@@ -58,6 +74,7 @@ DocumentStoreExplorer::get_state(const Inserter &inserter, bool full) const
             chunkCursor.setLong("nameid", chunk.nameId());
             chunkCursor.setString("name", chunk.createName(baseDir));
         }
+        setVisitCacheShardStats(object, store.getVisitCacheShardStats());
     }
 }
 
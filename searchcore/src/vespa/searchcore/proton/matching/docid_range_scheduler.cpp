@@ -9,6 +9,17 @@ namespace {
 
 size_t clamped_sub(size_t a, size_t b) { return (b > a) ? 0 : (a - b); }
 
+// workers claim this fraction of their remaining range as the next task
+constexpr uint32_t task_divisor = 4;
+
+uint64_t pack_range(DocidRange range) {
+    return ((uint64_t(range.begin) << 32) | range.end);
+}
+
+DocidRange unpack_range(uint64_t value) {
+    return DocidRange(uint32_t(value >> 32), uint32_t(value));
+}
+
 } // namespace proton::matching::<unnamed>
 
 const std::atomic<size_t> IdleObserver::_always_zero(0);
@@ -164,4 +175,93 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::take_task(size_t thread_id)
+{
+    Worker &self = _workers[thread_id];
+    uint64_t packed = self.range.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange todo = unpack_range(packed);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        uint32_t task = std::min(uint32_t(todo.size()), std::max(_min_task, uint32_t(todo.size() / task_divisor)));
+        DocidRange rest(todo.begin + task, todo.end);
+        if (self.range.compare_exchange_weak(packed, pack_range(rest),
+                                             std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            self.assigned.store(self.assigned.load(std::memory_order_relaxed) + task, std::memory_order_relaxed);
+            return DocidRange(todo.begin, rest.begin);
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    Worker &self = _workers[thread_id];
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_packed = 0;
+        size_t victim_size = 0;
+        for (size_t i = 1; i < _workers.size(); ++i) {
+            size_t candidate = (thread_id + i) % _workers.size();
+            uint64_t packed = _workers[candidate].range.load(std::memory_order_acquire);
+            size_t size = unpack_range(packed).size();
+            if (size > victim_size) {
+                victim = candidate;
+                victim_packed = packed;
+                victim_size = size;
+            }
+        }
+        if (victim_size == 0) {
+            return false;
+        }
+        // ranges are never re-used, so a successful exchange means the victim range was untouched
+        DocidRange todo = unpack_range(victim_packed);
+        DocidRange rest(todo.begin, todo.end - ((victim_size + 1) / 2));
+        if (_workers[victim].range.compare_exchange_strong(victim_packed, pack_range(rest),
+                                                           std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            self.range.store(pack_range(DocidRange(rest.end, todo.end)), std::memory_order_release);
+            self.steals.store(self.steals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].range.store(pack_range(splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    DocidRange task = take_task(thread_id);
+    while (task.empty() && steal(thread_id)) {
+        task = take_task(thread_id);
+    }
+    return task;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const Worker &worker: _workers) {
+        sum += unpack_range(worker.range.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
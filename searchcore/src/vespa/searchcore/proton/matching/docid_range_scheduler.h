@@ -102,6 +102,10 @@ public:
  * will return the remaining work to be done by the thread calling
  * it. The returned range is guaranteed to be a prefix of the range
  * passed as input to the 'share_range' function.
+ *
+ * The 'steal_count' function returns the number of times the given
+ * worker has taken work away from another worker. It is always zero
+ * for schedulers that do not employ work-stealing.
  **/
 struct DocidRangeScheduler {
     typedef std::unique_ptr<DocidRangeScheduler> UP;
@@ -111,6 +115,7 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual size_t steal_count(size_t thread_id) const = 0;
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -132,6 +137,7 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t) const override { return 0; }
 };
 
 /**
@@ -159,6 +165,7 @@ public:
     size_t unassigned_size() const override { return _unassigned.load(std::memory_order_relaxed); }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t) const override { return 0; }
 };
 
 /**
@@ -198,6 +205,48 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(_num_idle); }
     DocidRange share_range(size_t, DocidRange todo) override;
+    size_t steal_count(size_t) const override { return 0; }
+};
+
+/**
+ * A lock-free work-stealing scheduler. Each thread starts out owning
+ * an equal part of the docid space, from which it claims tasks of
+ * decreasing size from the front. A thread that runs out of work
+ * steals the back half of the largest remaining range owned by
+ * another thread and continues claiming tasks from that. The range
+ * owned by each thread is packed into a single atomic value, making
+ * both claiming and stealing work a single compare-and-swap. Workers
+ * never block and never need to share work cooperatively; a worker
+ * is done when no other worker has any unclaimed work left.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> range;
+        std::atomic<size_t>   assigned;
+        std::atomic<size_t>   steals;
+        Worker() noexcept : range(0), assigned(0), steals(0) {}
+    };
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    VESPA_DLL_LOCAL DocidRange take_task(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override {
+        return _workers[thread_id].assigned.load(std::memory_order_relaxed);
+    }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t thread_id) const override {
+        return _workers[thread_id].steals.load(std::memory_order_relaxed);
+    }
 };
 
 }
@@ -6,6 +6,7 @@
 #include "extract_features.h"
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/searchcommon/attribute/i_search_context.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
@@ -29,6 +30,7 @@ using search::queryeval::IntermediateBlueprint;
 using search::queryeval::MatchingElementsSearch;
 using search::queryeval::SameElementBlueprint;
 using search::queryeval::SearchIterator;
+using vespalib::ThreadBundle;
 
 using AttrSearchCtx = search::attribute::ISearchContext;
 
@@ -39,16 +41,23 @@ namespace {
 FeatureSet::UP
 get_feature_set(const MatchToolsFactory &mtf,
                 const std::vector<uint32_t> &docs,
-                bool summaryFeatures)
+                bool summaryFeatures,
+                ThreadBundle &thread_bundle)
 {
-    MatchTools::UP matchTools = mtf.createMatchTools();
-    if (summaryFeatures) {
-        matchTools->setup_summary();
+    FeatureSet::UP retval;
+    if ((thread_bundle.size() > 1) && (docs.size() > 1)) {
+        retval = ExtractFeatures::get_feature_set(mtf, summaryFeatures ? &MatchTools::setup_summary : &MatchTools::setup_dump,
+                                                  docs, thread_bundle);
     } else {
-        matchTools->setup_dump();
+        MatchTools::UP matchTools = mtf.createMatchTools();
+        if (summaryFeatures) {
+            matchTools->setup_summary();
+        } else {
+            matchTools->setup_dump();
+        }
+        retval = ExtractFeatures::get_feature_set(matchTools->search(), matchTools->rank_program(), docs,
+                                                  matchTools->getDoom(), mtf.get_feature_rename_map());
     }
-    auto retval = ExtractFeatures::get_feature_set(matchTools->search(), matchTools->rank_program(), docs,
-                                                   matchTools->getDoom(), mtf.get_feature_rename_map());
     if (auto onSummaryTask = mtf.createOnSummaryTask()) {
         onSummaryTask->run(docs);
     }
@@ -147,21 +156,21 @@ DocsumMatcher::~DocsumMatcher() {
 }
 
 FeatureSet::UP
-DocsumMatcher::get_summary_features() const
+DocsumMatcher::get_summary_features(ThreadBundle &thread_bundle) const
 {
     if (!_mtf) {
         return std::make_unique<FeatureSet>();
     }
-    return get_feature_set(*_mtf, _docs, true);
+    return get_feature_set(*_mtf, _docs, true, thread_bundle);
 }
 
 FeatureSet::UP
-DocsumMatcher::get_rank_features() const
+DocsumMatcher::get_rank_features(ThreadBundle &thread_bundle) const
 {
     if (!_mtf) {
         return std::make_unique<FeatureSet>();
     }
-    return get_feature_set(*_mtf, _docs, false);
+    return get_feature_set(*_mtf, _docs, false, thread_bundle);
 }
 
 MatchingElements::UP
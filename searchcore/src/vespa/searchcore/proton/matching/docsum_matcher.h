@@ -8,6 +8,8 @@
 #include <vector>
 #include <memory>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace proton::matching {
 
 class MatchToolsFactory;
@@ -24,6 +26,7 @@ private:
     using FeatureSet = search::FeatureSet;
     using MatchingElementsFields = search::MatchingElementsFields;
     using MatchingElements = search::MatchingElements;
+    using ThreadBundle = vespalib::ThreadBundle;
 
     std::shared_ptr<SearchSession>     _from_session;
     std::unique_ptr<MatchToolsFactory> _from_mtf;
@@ -38,8 +41,9 @@ public:
 
     using UP = std::unique_ptr<DocsumMatcher>;
 
-    FeatureSet::UP get_summary_features() const;
-    FeatureSet::UP get_rank_features() const;
+    // the thread bundle is used to calculate features for different documents in parallel
+    FeatureSet::UP get_summary_features(ThreadBundle &thread_bundle) const;
+    FeatureSet::UP get_rank_features(ThreadBundle &thread_bundle) const;
     MatchingElements::UP get_matching_elements(const MatchingElementsFields &fields) const;
 };
 
@@ -5,6 +5,7 @@
 #include <cassert>
 
 using search::feature_t;
+using search::fef::FeatureExecutor;
 using search::fef::FeatureResolver;
 using search::fef::RankProgram;
 using search::fef::LazyValue;
@@ -22,15 +23,51 @@ extractScoreFeature(const RankProgram &rankProgram)
     return resolver.resolve(0);
 }
 
+size_t
+calculateBatchSize(const std::vector<FeatureExecutor *> &executors)
+{
+    size_t batch_size = 1;
+    for (const FeatureExecutor *executor: executors) {
+        size_t max_batch_size = executor->max_batch_size();
+        batch_size = (batch_size == 1) ? max_batch_size : std::min(batch_size, max_batch_size);
+    }
+    return batch_size;
+}
+
 }
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
     : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _batchExecutors(rankProgram.get_batch_executors()),
+      _batchSize(calculateBatchSize(_batchExecutors))
 {
 }
 
+template <typename It>
+void
+DocumentScorer::scoreChunk(It begin, It end)
+{
+    uint32_t beginId = begin->first.first;
+    uint32_t endId = (end - 1)->first.first + 1;
+    _searchItr.initRange(beginId, endId);
+    for (It it = begin; it != end; ++it) {
+        uint32_t docId = it->first.first;
+        _searchItr.unpack(docId);
+        for (FeatureExecutor *executor: _batchExecutors) {
+            executor->collect(docId);
+        }
+    }
+    for (FeatureExecutor *executor: _batchExecutors) {
+        executor->flush_batch();
+    }
+    _searchItr.initRange(beginId, endId);
+    for (It it = begin; it != end; ++it) {
+        it->first.second = doScore(it->first.first);
+    }
+}
+
 void
 DocumentScorer::score(TaggedHits &hits)
 {
@@ -39,6 +76,14 @@ DocumentScorer::score(TaggedHits &hits)
     }
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
+    if (_batchSize > 1) {
+        for (auto pos = hits.begin(); pos != hits.end(); ) {
+            auto end = pos + std::min(_batchSize, size_t(hits.end() - pos));
+            scoreChunk(pos, end);
+            pos = end;
+        }
+        return;
+    }
     _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
     for (auto &hit: hits) {
         hit.first.second = doScore(hit.first.first);
@@ -12,13 +12,20 @@ namespace proton::matching {
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking
  * match data. The doScore function must be called with increasing
- * docid.
+ * docid. If the rank program has executors able to evaluate several
+ * documents at once, the score function will let them evaluate
+ * chunks of hits together before the hits are scored one by one.
  */
 class DocumentScorer
 {
 private:
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    std::vector<search::fef::FeatureExecutor *> _batchExecutors;
+    size_t _batchSize;
+
+    template <typename It>
+    void scoreChunk(It begin, It end);
 
 public:
     using TaggedHit = IMatchLoopCommunicator::TaggedHit;
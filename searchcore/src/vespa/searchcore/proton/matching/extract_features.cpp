@@ -61,22 +61,23 @@ void extract_values(const FeatureResolver &resolver, uint32_t docid, FeatureSet:
 struct MyChunk : Runnable {
     const std::pair<uint32_t,uint32_t> *begin;
     const std::pair<uint32_t,uint32_t> *end;
-    FeatureValues &result;
+    FeatureSet::Value *values;
+    size_t num_features;
     const Doom &doom;
     MyChunk(const std::pair<uint32_t,uint32_t> *begin_in,
             const std::pair<uint32_t,uint32_t> *end_in,
-            FeatureValues &result_in, const Doom &doom_in)
-      : begin(begin_in), end(end_in), result(result_in), doom(doom_in) {}
+            FeatureSet::Value *values_in, size_t num_features_in, const Doom &doom_in)
+      : begin(begin_in), end(end_in), values(values_in), num_features(num_features_in), doom(doom_in) {}
     void calculate_features(SearchIterator &search, const FeatureResolver &resolver) {
         assert(end > begin);
-        assert(resolver.num_features() == result.names.size());
+        assert(resolver.num_features() == num_features);
         search.initRange(begin[0].first, end[-1].first + 1);
         for (auto pos = begin; pos != end; ++pos) {
             if (doom.hard_doom()) {
                 return;
             }
             search.unpack(pos->first);
-            auto *dst = &result.values[pos->second * resolver.num_features()];
+            auto *dst = &values[pos->second * num_features];
             extract_values(resolver, pos->first, dst);
         }
     }
@@ -87,11 +88,12 @@ struct FirstChunk : MyChunk {
     const FeatureResolver &resolver;
     FirstChunk(const std::pair<uint32_t,uint32_t> *begin_in,
                const std::pair<uint32_t,uint32_t> *end_in,
-               FeatureValues &result_in,
+               FeatureSet::Value *values_in,
+               size_t num_features_in,
                const Doom &doom_in,
                SearchIterator &search_in,
                const FeatureResolver &resolver_in)
-      : MyChunk(begin_in, end_in, result_in, doom_in),
+      : MyChunk(begin_in, end_in, values_in, num_features_in, doom_in),
         search(search_in),
         resolver(resolver_in) {}
     void run() override { calculate_features(search, resolver); }
@@ -99,21 +101,55 @@ struct FirstChunk : MyChunk {
 
 struct LaterChunk : MyChunk {
     const MatchToolsFactory &mtf;
+    ExtractFeatures::SetupFunction setup;
     LaterChunk(const std::pair<uint32_t,uint32_t> *begin_in,
                const std::pair<uint32_t,uint32_t> *end_in,
-               FeatureValues &result_in,
+               FeatureSet::Value *values_in,
+               size_t num_features_in,
                const Doom &doom_in,
-               const MatchToolsFactory &mtf_in)
-      : MyChunk(begin_in, end_in, result_in, doom_in),
-        mtf(mtf_in) {}
+               const MatchToolsFactory &mtf_in,
+               ExtractFeatures::SetupFunction setup_in)
+      : MyChunk(begin_in, end_in, values_in, num_features_in, doom_in),
+        mtf(mtf_in),
+        setup(setup_in) {}
     void run() override {
         auto tools = mtf.createMatchTools();
-        tools->setup_match_features();
+        ((*tools).*setup)();
         FeatureResolver resolver(tools->rank_program().get_seeds(false));
         calculate_features(tools->search(), resolver);
     }
 };
 
+// Split the documents into one chunk per thread. The first chunk
+// uses the already prepared match tools, the others create their own.
+void calculate_features(const MatchToolsFactory &mtf, ExtractFeatures::SetupFunction setup,
+                        MatchTools &tools, const FeatureResolver &resolver, const OrderedDocs &docs,
+                        FeatureSet::Value *values, ThreadBundle &thread_bundle)
+{
+    size_t num_threads = thread_bundle.size();
+    std::vector<Runnable::UP> chunks;
+    chunks.reserve(num_threads);
+    size_t per_thread = docs.size() / num_threads;
+    size_t rest_docs = docs.size() % num_threads;
+    size_t idx = 0;
+    for (size_t i = 0; i < num_threads; ++i) {
+        size_t chunk_size = per_thread + (i < rest_docs);
+        if (chunk_size == 0) {
+            break;
+        }
+        if (i == 0) {
+            chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], values, resolver.num_features(),
+                                                          tools.getDoom(), tools.search(), resolver));
+        } else {
+            chunks.push_back(std::make_unique<LaterChunk>(&docs[idx], &docs[idx + chunk_size], values, resolver.num_features(),
+                                                          tools.getDoom(), mtf, setup));
+        }
+        idx += chunk_size;
+    }
+    assert(idx == docs.size());
+    thread_bundle.run(chunks);
+}
+
 } // unnamed
 
 FeatureSet::UP
@@ -136,6 +172,27 @@ ExtractFeatures::get_feature_set(SearchIterator &search, RankProgram &rank_progr
     return result;
 }
 
+FeatureSet::UP
+ExtractFeatures::get_feature_set(const MatchToolsFactory &mtf, SetupFunction setup, const std::vector<uint32_t> &docs,
+                                 ThreadBundle &thread_bundle)
+{
+    auto tools = mtf.createMatchTools();
+    ((*tools).*setup)();
+    FeatureResolver resolver(tools->rank_program().get_seeds(false));
+    auto result = std::make_unique<FeatureSet>(extract_names(resolver, mtf.get_feature_rename_map()), docs.size());
+    if (!docs.empty()) {
+        OrderedDocs ordered_docs;
+        ordered_docs.reserve(docs.size());
+        for (uint32_t docid: docs) {
+            ordered_docs.emplace_back(docid, result->addDocId(docid));
+        }
+        if (result->numFeatures() > 0) {
+            calculate_features(mtf, setup, *tools, resolver, ordered_docs, result->getFeaturesByIndex(0), thread_bundle);
+        }
+    }
+    return result;
+}
+
 FeatureValues
 ExtractFeatures::get_match_features(const MatchToolsFactory &mtf, const OrderedDocs &docs, ThreadBundle &thread_bundle)
 {
@@ -145,26 +202,7 @@ ExtractFeatures::get_match_features(const MatchToolsFactory &mtf, const OrderedD
     FeatureResolver resolver(tools->rank_program().get_seeds(false));
     result.names = extract_names(resolver, mtf.get_feature_rename_map());
     result.values.resize(result.names.size() * docs.size());
-    size_t num_threads = thread_bundle.size();
-    std::vector<Runnable::UP> chunks;
-    chunks.reserve(num_threads);
-    size_t per_thread = docs.size() / num_threads;
-    size_t rest_docs = docs.size() % num_threads;
-    size_t idx = 0;
-    for (size_t i = 0; i < num_threads; ++i) {
-        size_t chunk_size = per_thread + (i < rest_docs);
-        if (chunk_size == 0) {
-            break;
-        }
-        if (i == 0) {
-            chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), tools->search(), resolver));
-        } else {
-            chunks.push_back(std::make_unique<LaterChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), mtf));
-        }
-        idx += chunk_size;
-    }
-    assert(idx == docs.size());
-    thread_bundle.run(chunks);
+    calculate_features(mtf, &MatchTools::setup_match_features, *tools, resolver, docs, result.values.data(), thread_bundle);
     return result;
 }
 
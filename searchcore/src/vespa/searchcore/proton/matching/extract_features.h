@@ -13,6 +13,7 @@ namespace search::fef { class RankProgram; }
 
 namespace proton::matching {
 
+class MatchTools;
 class MatchToolsFactory;
 
 struct ExtractFeatures {
@@ -22,6 +23,8 @@ struct ExtractFeatures {
     using SearchIterator = search::queryeval::SearchIterator;
     using RankProgram = search::fef::RankProgram;
     using StringStringMap = search::StringStringMap;
+    // used to select which rank program to set up (summary, dump, match features)
+    using SetupFunction = void (MatchTools::*)();
 
     /**
      * Extract all seed features from a rank program for a list of
@@ -30,6 +33,14 @@ struct ExtractFeatures {
      **/
     static FeatureSet::UP get_feature_set(SearchIterator &search, RankProgram &rank_program, const std::vector<uint32_t> &docs, const vespalib::Doom &doom, const StringStringMap &renames);
 
+    /**
+     * Extract all seed features from a rank program for a list of
+     * documents (must be in ascending order) using multiple
+     * threads. Each thread uses its own match tools created by the
+     * given factory and prepared by the given setup function.
+     **/
+    static FeatureSet::UP get_feature_set(const MatchToolsFactory &mtf, SetupFunction setup, const std::vector<uint32_t> &docs, ThreadBundle &thread_bundle);
+
     // first: docid, second: result index (must be sorted on docid)
     using OrderedDocs = std::vector<std::pair<uint32_t,uint32_t>>;
 
@@ -60,8 +60,11 @@ struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
 };
 
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, bool workStealing, uint32_t numDocs)
 {
+    if (workStealing) {
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, 1, numDocs);
+    }
     if (numSearchPartitions == 0) {
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
@@ -94,13 +97,14 @@ MatchMaster::match(search::engine::Trace & trace,
                    const MatchToolsFactory &mtf,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool workStealing)
 {
     vespalib::Timer query_latency_time;
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.heapSize));
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, workStealing, params.numDocs);
 
     std::vector<MatchThread::UP> threadState;
     for (size_t i = 0; i < threadBundle.size(); ++i) {
@@ -117,11 +121,18 @@ MatchMaster::match(search::engine::Trace & trace,
     double query_time_s = vespalib::to_s(query_latency_time.elapsed());
     double rerank_time_s = vespalib::to_s(timedCommunicator.elapsed);
     double match_time_s = 0.0;
+    vespalib::steady_time match_loop_done;
+    for (const auto & matchThread : threadState) {
+        match_loop_done = std::max(match_loop_done, matchThread->get_match_loop_done());
+    }
     LazyThreadTraceInserter inserter(trace);
     for (size_t i = 0; i < threadState.size(); ++i) {
         const MatchThread & matchThread = *threadState[i];
         match_time_s = std::max(match_time_s, matchThread.get_match_time());
-        _stats.merge_partition(matchThread.get_thread_stats(), i);
+        // a thread is also idle while waiting for the slowest thread to complete its match loop
+        MatchingStats::Partition thread_stats = matchThread.get_thread_stats();
+        thread_stats.idle_time(matchThread.get_idle_time() + vespalib::to_s(match_loop_done - matchThread.get_match_loop_done()));
+        _stats.merge_partition(thread_stats, i);
         inserter.handle(matchThread.getTrace());
         matchThread.get_issues().for_each_message([](const auto &msg){ Issue::report(Issue(msg)); });
     }
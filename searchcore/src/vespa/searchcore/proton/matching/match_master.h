@@ -30,7 +30,8 @@ public:
                                       const MatchToolsFactory &mtf,
                                       ResultProcessor &resultProcessor,
                                       uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      bool workStealing);
 
     static MatchingStats getStats(MatchMaster && rhs) { return std::move(rhs._stats); }
 };
@@ -62,11 +62,18 @@ MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollec
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _batch_executor(tools.rank_program().get_batch_seed_executor()),
+      _batch_size(_batch_executor ? _batch_executor->max_batch_size() : 1),
+      _batch_docids(),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
       _doom(tools.getDoom()),
+      _hit_docids(),
+      _hit_scores(),
+      _num_buffered_hits(0),
       dropped()
 {
+    _batch_docids.reserve(_batch_size);
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
@@ -79,15 +86,28 @@ MatchThread::Context::rankHit(uint32_t docId) {
     }
     if (use_rank_drop_limit != RankDropLimitE::no) {
         if (__builtin_expect(score > _rankDropLimit, true)) {
-            _hits.addHit(docId, score);
+            bufferHit(docId, score);
         } else if (use_rank_drop_limit == RankDropLimitE::track) {
             dropped.template emplace_back(docId);
         }
     } else {
-        _hits.addHit(docId, score);
+        bufferHit(docId, score);
     }
 }
 
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::rankCollectedHits() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _batch_executor->flush_batch();
+    for (uint32_t docId: _batch_docids) {
+        rankHit<use_rank_drop_limit>(docId);
+    }
+    _batch_docids.clear();
+}
+
 //-----------------------------------------------------------------------------
 
 double
@@ -128,6 +148,15 @@ MatchThread::maybe_limit(MatchTools &tools, uint32_t matches, uint32_t docId, ui
     return &tools.search();
 }
 
+DocidRange
+MatchThread::next_range()
+{
+    WaitTimer next_range_timer(idle_time_s);
+    DocidRange docid_range = scheduler.next_range(thread_id);
+    next_range_timer.done();
+    return docid_range;
+}
+
 bool
 MatchThread::try_share(DocidRange &docid_range, uint32_t next_docid) {
     DocidRange todo(next_docid, docid_range.end);
@@ -150,7 +179,7 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
             search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            context.scoreHit<use_rank_drop_limit>(docId);
         } else {
             context.addHit(docId);
         }
@@ -165,6 +194,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.rankCollectedHits<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -179,7 +211,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     Context context(matchParams.rankDropLimit, tools, hits, num_threads);
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty();
-         docid_range = scheduler.next_range(thread_id))
+         docid_range = next_range())
     {
         if (!softDoomed) {
             uint32_t lastCovered = inner_match_loop<Strategy, do_rank, do_limit, do_share_work, use_rank_drop_limit>(context, tools, docid_range);
@@ -190,6 +222,8 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
             docsCovered += std::min(lastCovered, docid_range.end) - docid_range.begin;
         }
     }
+    context.flushHits();
+    match_loop_done = vespalib::steady_clock::now();
     uint32_t matches = context.matches;
     if (do_limit && context.isBelowLimit()) {
         const size_t searchedSoFar = scheduler.total_size(thread_id);
@@ -201,6 +235,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.steals(scheduler.steal_count(thread_id));
     if (softDoomed) {
         thread_stats.doomOvertime(overtime);
     }
@@ -414,6 +449,8 @@ MatchThread::MatchThread(size_t thread_id_in,
     total_time_s(0.0),
     match_time_s(0.0),
     wait_time_s(0.0),
+    idle_time_s(0.0),
+    match_loop_done(),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores()),
     trace(std::make_unique<Trace>(relativeTime, traceLevel, profileDepth)),
     first_phase_profiler(),
@@ -16,6 +16,7 @@
 #include <vespa/searchlib/common/unique_issues.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
+#include <array>
 
 namespace search::engine {
     class Trace;
@@ -65,6 +66,8 @@ private:
     double                        total_time_s;
     double                        match_time_s;
     double                        wait_time_s;
+    double                        idle_time_s;
+    vespalib::steady_time         match_loop_done;
     bool                          match_with_ranking;
     std::unique_ptr<Trace>        trace;
     std::unique_ptr<vespalib::ExecutionProfiler> first_phase_profiler;
@@ -77,18 +80,56 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
-        void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
+        // rank hits in batches if the score is calculated by a batch executor
+        template <RankDropLimitE use_rank_drop_limit>
+        void scoreHit(uint32_t docId) {
+            if (_batch_executor != nullptr) {
+                collectHit<use_rank_drop_limit>(docId);
+            } else {
+                rankHit<use_rank_drop_limit>(docId);
+            }
+        }
+        template <RankDropLimitE use_rank_drop_limit>
+        void rankCollectedHits();
+        void addHit(uint32_t docId) { bufferHit(docId, search::zero_rank_value); }
+        void flushHits() {
+            _hits.addHits(_hit_docids.data(), _hit_scores.data(), _num_buffered_hits);
+            _num_buffered_hits = 0;
+        }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
         bool   atSoftDoom() const { return _doom.soft_doom(); }
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        // hits are passed to the hit collector in batches
+        static constexpr size_t hit_buffer_size = 64;
+        void bufferHit(uint32_t docId, search::feature_t score) {
+            _hit_docids[_num_buffered_hits] = docId;
+            _hit_scores[_num_buffered_hits] = score;
+            if (++_num_buffered_hits == hit_buffer_size) {
+                flushHits();
+            }
+        }
+        template <RankDropLimitE use_rank_drop_limit>
+        void collectHit(uint32_t docId) {
+            _batch_executor->collect(docId);
+            _batch_docids.push_back(docId);
+            if (_batch_docids.size() == _batch_size) {
+                rankCollectedHits<use_rank_drop_limit>();
+            }
+        }
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        search::fef::FeatureExecutor *_batch_executor;
+        size_t                        _batch_size;
+        std::vector<uint32_t>         _batch_docids;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom     &_doom;
+        std::array<uint32_t, hit_buffer_size>          _hit_docids;
+        std::array<search::feature_t, hit_buffer_size> _hit_scores;
+        size_t          _num_buffered_hits;
     public:
         std::vector<uint32_t> dropped;
     };
@@ -96,6 +137,7 @@ private:
     double estimate_match_frequency(uint32_t matches, uint32_t searchedSoFar) __attribute__((noinline));
     SearchIterator *maybe_limit(MatchTools &tools, uint32_t matches, uint32_t docId, uint32_t endId) __attribute__((noinline));
 
+    DocidRange next_range();
     bool any_idle() const { return (idle_observer.get() > 0); }
     bool try_share(DocidRange &docid_range, uint32_t next_docid) __attribute__((noinline));
 
@@ -136,6 +178,9 @@ public:
     void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
+    // time spent waiting for more docid ranges to match
+    double get_idle_time() const { return idle_time_s; }
+    vespalib::steady_time get_match_loop_done() const { return match_loop_done; }
     PartialResult::UP extract_result() { return std::move(resultContext->result); }
     const Trace & getTrace() const { return *trace; }
     const UniqueIssues &get_issues() const { return my_issues; }
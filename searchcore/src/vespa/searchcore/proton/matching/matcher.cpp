@@ -122,6 +122,8 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const ve
         throw vespalib::IllegalArgumentException(fmt("failed to compile rank setup :\n%s",
                                                      _rankSetup->getJoinedWarnings().c_str()), VESPA_STRLOC);
     }
+    LOG(debug, "rank setup compiled, %zu subexpression evaluations saved by sharing results",
+        _rankSetup->num_reused_expressions());
 }
 
 Matcher::~Matcher() = default;
@@ -244,8 +246,9 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
+        bool workStealing = WorkStealing::lookup(rankProperties, _rankSetup->useWorkStealing());
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numParts);
+                                                          _distributionKey, numParts, workStealing);
         my_stats = MatchMaster::getStats(std::move(master));
 
         bool wasLimited = mtf->match_limiter().was_limited();
@@ -324,18 +327,20 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
 
 FeatureSet::SP
 Matcher::getSummaryFeatures(const DocsumRequest & req, ISearchContext & searchCtx,
-                            IAttributeContext & attrCtx, SessionManager &sessionMgr) const
+                            IAttributeContext & attrCtx, SessionManager &sessionMgr,
+                            vespalib::ThreadBundle &threadBundle) const
 {
     auto docsum_matcher = create_docsum_matcher(req, searchCtx, attrCtx, sessionMgr);
-    return docsum_matcher->get_summary_features();
+    return docsum_matcher->get_summary_features(threadBundle);
 }
 
 FeatureSet::SP
 Matcher::getRankFeatures(const DocsumRequest & req, ISearchContext & searchCtx,
-                         IAttributeContext & attrCtx, SessionManager &sessionMgr) const
+                         IAttributeContext & attrCtx, SessionManager &sessionMgr,
+                         vespalib::ThreadBundle &threadBundle) const
 {
     auto docsum_matcher = create_docsum_matcher(req, searchCtx, attrCtx, sessionMgr);
-    return docsum_matcher->get_rank_features();
+    return docsum_matcher->get_rank_features(threadBundle);
 }
 
 MatchingElements::UP
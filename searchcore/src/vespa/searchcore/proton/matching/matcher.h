@@ -133,11 +133,13 @@ public:
      * @param req the docsum request
      * @param searchCtx abstract view of searchable data
      * @param attrCtx abstract view of attribute data
+     * @param threadBundle used to calculate features in parallel
      * @return calculated summary features.
      **/
     search::FeatureSet::SP
     getSummaryFeatures(const DocsumRequest & req, ISearchContext & searchCtx,
-                       IAttributeContext & attrCtx, SessionManager &sessionManager) const;
+                       IAttributeContext & attrCtx, SessionManager &sessionManager,
+                       vespalib::ThreadBundle &threadBundle) const;
 
     /**
      * Perform matching for the documents in the given docsum request
@@ -147,11 +149,13 @@ public:
      * @param req the docsum request
      * @param searchCtx abstract view of searchable data
      * @param attrCtx abstract view of attribute data
+     * @param threadBundle used to calculate features in parallel
      * @return calculated rank features.
      **/
     search::FeatureSet::SP
     getRankFeatures(const DocsumRequest & req, ISearchContext & searchCtx,
-                    IAttributeContext & attrCtx, SessionManager &sessionManager) const;
+                    IAttributeContext & attrCtx, SessionManager &sessionManager,
+                    vespalib::ThreadBundle &threadBundle) const;
 
     /**
      * Perform partial matching for the documents in the given docsum request
@@ -63,9 +63,11 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _steals;
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
+        Avg    _idle_time;
         friend MatchingStats;
     public:
         Partition() noexcept
@@ -74,9 +76,11 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _steals(0),
               _doomOvertime(),
               _active_time(),
-              _wait_time() { }
+              _wait_time(),
+              _idle_time() { }
 
         Partition &docsCovered(size_t value) { _docsCovered = value; return *this; }
         size_t docsCovered() const { return _docsCovered; }
@@ -88,6 +92,8 @@ public:
         size_t docsReRanked() const { return _docsReRanked; }
         Partition &softDoomed(bool v) { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const { return _softDoomed; }
+        Partition &steals(size_t value) { _steals = value; return *this; }
+        size_t steals() const { return _steals; }
         Partition & doomOvertime(vespalib::duration overtime) { _doomOvertime.set(vespalib::to_s(overtime)); return *this; }
         vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
@@ -101,6 +107,11 @@ public:
         size_t wait_time_count() const { return _wait_time.count(); }
         double wait_time_min() const { return _wait_time.min(); }
         double wait_time_max() const { return _wait_time.max(); }
+        Partition &idle_time(double time_s) { _idle_time.set(time_s); return *this; }
+        double idle_time_avg() const { return _idle_time.avg(); }
+        size_t idle_time_count() const { return _idle_time.count(); }
+        double idle_time_min() const { return _idle_time.min(); }
+        double idle_time_max() const { return _idle_time.max(); }
 
         Partition &add(const Partition &rhs) {
             _docsCovered += rhs.docsCovered();
@@ -108,10 +119,12 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _steals += rhs._steals;
             _doomOvertime.add(rhs._doomOvertime);
 
             _active_time.add(rhs._active_time);
             _wait_time.add(rhs._wait_time);
+            _idle_time.add(rhs._idle_time);
             return *this;
         }
     };
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "onnx_models.h"
+#include <algorithm>
 #include <cassert>
 
 namespace proton::matching {
@@ -44,6 +45,7 @@ OnnxModels::configure(const ModelConfig &config, Model &model)
         model.output_name(output.name, output.as);
     }
     model.dry_run_on_setup(config.dryRunOnSetup);
+    model.batch_size(std::max(1, config.batchSize));
 }
 
 }
@@ -169,8 +169,10 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
       docsMatched("docs_matched", {}, "Number of documents matched", this),
       docsRanked("docs_ranked", {}, "Number of documents ranked (first phase)", this),
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
+      steals("steals", {}, "Number of times a docid range was stolen from another thread", this),
       activeTime("active_time", {}, "Time (sec) spent doing actual work", this),
-      waitTime("wait_time", {}, "Time (sec) spent waiting for other external threads and resources", this)
+      waitTime("wait_time", {}, "Time (sec) spent waiting for other external threads and resources", this),
+      idleTime("idle_time", {}, "Time (sec) spent without any docid range to match", this)
 { }
 
 DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::~DocIdPartition() = default;
@@ -181,10 +183,13 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
     docsMatched.inc(stats.docsMatched());
     docsRanked.inc(stats.docsRanked());
     docsReRanked.inc(stats.docsReRanked());
+    steals.inc(stats.steals());
     activeTime.addValueBatch(stats.active_time_avg(), stats.active_time_count(),
                              stats.active_time_min(), stats.active_time_max());
     waitTime.addValueBatch(stats.wait_time_avg(), stats.wait_time_count(),
                            stats.wait_time_min(), stats.wait_time_max());
+    idleTime.addValueBatch(stats.idle_time_avg(), stats.idle_time_count(),
+                           stats.idle_time_min(), stats.idle_time_max());
 }
 
 void
@@ -4,6 +4,7 @@
 
 using search::transactionlog::DomainInfo;
 using search::transactionlog::DomainStats;
+using search::transactionlog::GroupCommitter;
 
 namespace proton {
 
@@ -27,6 +28,29 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     replayTime.set(stats.maxSessionRunTime.count());
 }
 
+TransLogServerMetrics::GroupCommitMetrics::GroupCommitMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("transactionlog_group_commit", {}, "Transaction log group commit metrics", parent),
+      rounds("rounds", {}, "The number of group commit rounds", this),
+      roundChunks("round_chunks", {}, "The number of chunks written per group commit round", this),
+      syncLatency("sync_latency", {}, "The time (in seconds) spent syncing per group commit round", this),
+      lastStats()
+{
+}
+
+TransLogServerMetrics::GroupCommitMetrics::~GroupCommitMetrics() = default;
+
+void
+TransLogServerMetrics::GroupCommitMetrics::update(const Stats &stats)
+{
+    uint64_t newRounds = stats.rounds - lastStats.rounds;
+    if (newRounds > 0) {
+        rounds.inc(newRounds);
+        roundChunks.addValue((stats.chunks - lastStats.chunks) / newRounds);
+        syncLatency.addValue(vespalib::to_s(stats.total_sync_time - lastStats.total_sync_time) / newRounds);
+    }
+    lastStats = stats;
+}
+
 void
 TransLogServerMetrics::considerAddDomains(const DomainStats &stats)
 {
@@ -62,7 +86,9 @@ TransLogServerMetrics::updateDomainMetrics(const DomainStats &stats)
 }
 
 TransLogServerMetrics::TransLogServerMetrics(metrics::MetricSet *parent)
-    : _parent(parent)
+    : _parent(parent),
+      _domainMetrics(),
+      _groupCommitMetrics()
 {
 }
 
@@ -76,4 +102,13 @@ TransLogServerMetrics::update(const DomainStats &stats)
     updateDomainMetrics(stats);
 }
 
+void
+TransLogServerMetrics::update(const GroupCommitter::Stats &stats)
+{
+    if (!_groupCommitMetrics) {
+        _groupCommitMetrics = std::make_unique<GroupCommitMetrics>(_parent);
+    }
+    _groupCommitMetrics->update(stats);
+}
+
 } // namespace proton
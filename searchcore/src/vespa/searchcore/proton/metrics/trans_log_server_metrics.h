@@ -4,7 +4,9 @@
 
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
+#include <vespa/metrics/countmetric.h>
 #include <vespa/searchlib/transactionlog/domainconfig.h>
+#include <vespa/searchlib/transactionlog/group_committer.h>
 
 namespace proton {
 
@@ -26,9 +28,23 @@ public:
         void update(const search::transactionlog::DomainInfo &stats);
     };
 
+    struct GroupCommitMetrics : public metrics::MetricSet
+    {
+        using Stats = search::transactionlog::GroupCommitter::Stats;
+        metrics::LongCountMetric rounds;
+        metrics::LongValueMetric roundChunks;
+        metrics::DoubleValueMetric syncLatency;
+        Stats lastStats;
+
+        GroupCommitMetrics(metrics::MetricSet *parent);
+        ~GroupCommitMetrics() override;
+        void update(const Stats &stats);
+    };
+
 private:
     metrics::MetricSet *_parent;
     std::map<vespalib::string, DomainMetrics::UP> _domainMetrics;
+    std::unique_ptr<GroupCommitMetrics> _groupCommitMetrics;
 
     void considerAddDomains(const search::transactionlog::DomainStats &stats);
     void considerRemoveDomains(const search::transactionlog::DomainStats &stats);
@@ -38,6 +54,7 @@ public:
     TransLogServerMetrics(metrics::MetricSet *parent);
     ~TransLogServerMetrics();
     void update(const search::transactionlog::DomainStats &stats);
+    void update(const search::transactionlog::GroupCommitter::Stats &stats);
 };
 
 } // namespace proton
@@ -165,13 +165,17 @@ public:
         if (_dscTrue || _metaOnly) {
             return true;
         }
-        if (_selectCxt) {
-            _selectCxt->_docId = meta.lid;
-        }
-        if (!_gidFilter.gid_might_match_selection(meta.gid)) {
-            return false;
+        return _gidFilter.gid_might_match_selection(meta.gid);
+    }
+    /*
+     * Remove lids that passed match(meta) but can not match the selection,
+     * by evaluating attribute based parts of it for all of them at once.
+     */
+    void filter(IDocumentRetriever::LidVector & lids) const {
+        if (_dscTrue || _metaOnly) {
+            return;
         }
-        return _selectSession->contains(*_selectCxt);
+        _selectSession->filter(*_selectCxt, lids);
     }
     bool match(const search::DocumentMetaData & meta, const Document * doc) const {
         if (_dscTrue || _metaOnly) {
@@ -262,6 +266,7 @@ DocumentIterator::fetchCompleteSource(const IDocumentRetriever & source, Iterate
             }
         }
     }
+    matcher.filter(lidsToFetch);
     LOG(debug, "metadata count after filtering: %zu", lidsToFetch.size());
 
     list.reserve(lidsToFetch.size());
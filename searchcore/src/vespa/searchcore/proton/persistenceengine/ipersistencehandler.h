@@ -4,6 +4,7 @@
 #include "i_document_retriever.h"
 #include "resulthandler.h"
 #include <vespa/searchcore/proton/common/feedtoken.h>
+#include <vespa/document/base/documentid.h>
 
 namespace document {
     class Document;
@@ -48,6 +49,31 @@ public:
     virtual void handleRemove(FeedToken token, const storage::spi::Bucket &bucket,
                               storage::spi::Timestamp timestamp, const document::DocumentId &id) = 0;
 
+    /**
+     * A put (when doc is set) or a remove, as part of a batch towards the same bucket.
+     */
+    struct BatchEntry {
+        FeedToken               token;
+        storage::spi::Timestamp timestamp;
+        DocumentSP              doc;
+        document::DocumentId    id;
+    };
+    using Batch = std::vector<BatchEntry>;
+
+    /**
+     * Handle a batch of puts and removes towards the same bucket, in order.
+     * The default implementation handles them one by one.
+     */
+    virtual void handlePutOrRemoveBatch(const storage::spi::Bucket &bucket, Batch batch) {
+        for (auto & entry : batch) {
+            if (entry.doc) {
+                handlePut(std::move(entry.token), bucket, entry.timestamp, std::move(entry.doc));
+            } else {
+                handleRemove(std::move(entry.token), bucket, entry.timestamp, entry.id);
+            }
+        }
+    }
+
     virtual void handleListBuckets(IBucketIdListResultHandler &resultHandler) = 0;
     virtual void handleSetClusterState(const storage::spi::ClusterState &calc, IGenericResultHandler &resultHandler) = 0;
 
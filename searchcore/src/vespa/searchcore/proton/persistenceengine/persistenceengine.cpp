@@ -10,6 +10,7 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/util/feed_reject_helper.h>
 #include <vespa/document/base/exceptions.h>
+#include <algorithm>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -431,6 +432,58 @@ PersistenceEngine::removeAsyncSingle(const Bucket& b, Timestamp t, const Documen
     handler->handleRemove(feedtoken::make(std::move(transportContext)), b, t, id);
 }
 
+void
+PersistenceEngine::putOrRemoveBatchAsync(const Bucket& b, std::vector<storage::spi::BatchOperation> ops)
+{
+    using storage::spi::BatchOperation;
+    // Operations are grouped per handler (document type) while keeping their relative order.
+    std::vector<std::pair<IPersistenceHandler *, IPersistenceHandler::Batch>> batches;
+    ReadGuard rguard(_rwMutex);
+    for (auto & op : ops) {
+        const bool isPut = (op.getType() == BatchOperation::Type::PUT);
+        auto fail = [&op, isPut](Result::ErrorType type, const vespalib::string & msg) {
+            if (isPut) {
+                op.stealOnComplete()->onComplete(std::make_unique<Result>(type, msg));
+            } else {
+                op.stealOnComplete()->onComplete(std::make_unique<RemoveResult>(type, msg));
+            }
+        };
+        const DocumentId & id = op.getDocumentId();
+        if (isPut && !_writeFilter.acceptWriteOperation()) {
+            IResourceWriteFilter::State state = _writeFilter.getAcceptState();
+            if (!state.acceptWriteOperation()) {
+                fail(Result::ErrorType::RESOURCE_EXHAUSTED,
+                     fmt("Put operation rejected for document '%s': '%s'", id.toString().c_str(), state.message().c_str()));
+                continue;
+            }
+        }
+        if (!id.hasDocType()) {
+            fail(Result::ErrorType::PERMANENT_ERROR, fmt("Old id scheme not supported in elastic mode (%s)", id.toString().c_str()));
+            continue;
+        }
+        DocTypeName docType(id.getDocType());
+        IPersistenceHandler * handler = getHandler(rguard, b.getBucketSpace(), docType);
+        if (!handler) {
+            fail(Result::ErrorType::PERMANENT_ERROR, fmt("No handler for document type '%s'", docType.toString().c_str()));
+            continue;
+        }
+        auto itr = std::find_if(batches.begin(), batches.end(), [handler](const auto & batch) { return batch.first == handler; });
+        if (itr == batches.end()) {
+            batches.emplace_back(handler, IPersistenceHandler::Batch());
+            itr = batches.end() - 1;
+            itr->second.reserve(ops.size());
+        }
+        auto transportContext = std::make_shared<AsyncTransportContext>(1, op.stealOnComplete());
+        if (isPut) {
+            itr->second.push_back({feedtoken::make(std::move(transportContext)), op.getTimestamp(), op.stealDocument(), DocumentId()});
+        } else {
+            itr->second.push_back({feedtoken::make(std::move(transportContext)), op.getTimestamp(), storage::spi::DocumentSP(), id});
+        }
+    }
+    for (auto & batch : batches) {
+        batch.first->handlePutOrRemoveBatch(b, std::move(batch.second));
+    }
+}
 
 void
 PersistenceEngine::updateAsync(const Bucket& b, Timestamp t, DocumentUpdate::SP upd, OperationComplete::UP onComplete)
@@ -6,6 +6,7 @@
 #include "executor_threading_service_explorer.h"
 #include "maintenance_controller_explorer.h"
 #include "documentdb.h"
+#include "feedhandler.h"
 #include <vespa/searchcore/proton/bucketdb/bucket_db_explorer.h>
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/searchcore/proton/matching/session_manager_explorer.h>
@@ -40,6 +41,17 @@ DocumentDBExplorer::get_state(const Inserter &inserter, bool full) const
         documents.setLong("total", dmss.numTotalDocs());
         documents.setLong("removed", dmss.numRemovedDocs());
     }
+    const TlsReplayProgress *replayProgress = _docDb->getFeedHandler().getReplayProgressTracker();
+    if (replayProgress != nullptr) {
+        Cursor &replay = object.setObject("replay");
+        replay.setLong("first", replayProgress->getFirst());
+        replay.setLong("last", replayProgress->getLast());
+        replay.setLong("current", replayProgress->getCurrent());
+        replay.setDouble("progress", replayProgress->getProgress());
+        replay.setLong("entries", replayProgress->getEntries());
+        replay.setDouble("elapsedTime", vespalib::to_s(replayProgress->getElapsed()));
+        replay.setDouble("entriesPerSecond", replayProgress->getEntriesPerSecond());
+    }
 }
 
 const vespalib::string SUB_DB = "subdb";
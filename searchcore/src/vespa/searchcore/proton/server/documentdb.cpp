@@ -204,6 +204,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _bucketHandler(_writeService.master()),
       _indexCfg(makeIndexConfig(protonCfg.index)),
       _replay_throttling_policy(std::make_unique<ReplayThrottlingPolicy>(make_replay_throttling_policy(protonCfg.replayThrottlingPolicy))),
+      _replay_concurrency(std::max(1, protonCfg.replay.concurrency)),
       _config_store(std::move(config_store)),
       _sessionManager(std::make_shared<matching::SessionManager>(protonCfg.grouping.sessionmanager.maxentries)),
       _metricsWireService(metricsWireService),
@@ -749,7 +750,8 @@ DocumentDB::startTransactionLogReplay()
                                       oldestFlushedSerial,
                                       newestFlushedSerial,
                                       *_config_store,
-                                      *_replay_throttling_policy);
+                                      *_replay_throttling_policy,
+                                      _replay_concurrency);
     _initGate.countDown();
 
     LOG(debug, "DocumentDB(%s): Database started.", _docTypeName.toString().c_str());
@@ -781,10 +783,10 @@ DocumentDB::match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle
 }
 
 std::unique_ptr<DocsumReply>
-DocumentDB::getDocsums(const DocsumRequest & request)
+DocumentDB::getDocsums(const DocsumRequest & request, vespalib::ThreadBundle &threadBundle)
 {
     ISearchHandler::SP view(_subDBs.getReadySubDB()->getSearchView());
-    return view->getDocsums(request);
+    return view->getDocsums(request, threadBundle);
 }
 
 IFlushTarget::List
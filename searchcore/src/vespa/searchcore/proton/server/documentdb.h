@@ -117,6 +117,7 @@ private:
     BucketHandler                                    _bucketHandler;
     index::IndexConfig                               _indexCfg;
     std::unique_ptr<ReplayThrottlingPolicy>          _replay_throttling_policy;
+    uint32_t                                         _replay_concurrency;
     ConfigStore::UP                                  _config_store;
     std::shared_ptr<matching::SessionManager>        _sessionManager; // TODO: This should not have to be a shared pointer.
     MetricsWireService                              &_metricsWireService;
@@ -367,7 +368,7 @@ public:
     match(const search::engine::SearchRequest &req, vespalib::ThreadBundle &threadBundle) const;
 
     std::unique_ptr<search::engine::DocsumReply>
-    getDocsums(const search::engine::DocsumRequest & request);
+    getDocsums(const search::engine::DocsumRequest & request, vespalib::ThreadBundle &threadBundle);
 
     IFlushTargetList getFlushTargets();
     void flushDone(SerialNum flushedSerial);
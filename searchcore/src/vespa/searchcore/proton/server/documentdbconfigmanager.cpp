@@ -177,7 +177,8 @@ getStoreConfig(const ProtonConfig::Summary::Cache & cache, const HwInfo & hwInfo
                       : cache.maxbytes;
     return DocumentStore::Config(deriveCompression(cache.compression), maxBytes, cache.initialentries)
             .allowVisitCaching(cache.allowvisitcaching)
-            .updateStrategy(derive(cache.updateStrategy));
+            .updateStrategy(derive(cache.updateStrategy))
+            .visitCacheShards(std::max(1, cache.visitShards));
 }
 
 LogDocumentStore::Config
@@ -191,6 +192,7 @@ deriveConfig(const ProtonConfig::Summary & summary, const HwInfo & hwInfo) {
             .setMaxNumLids(log.maxnumlids)
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
+            .setZStdDictionarySize(chunk.compression.dictionarysize)
             .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
     return {config, logConfig};
 }
@@ -8,6 +8,7 @@
 #include <vespa/document/fieldvalue/intfieldvalue.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/fieldset/fieldsets.h>
+#include <vespa/document/serialization/lazydocumentview.h>
 #include <vespa/searchcommon/attribute/attributecontent.h>
 #include <vespa/searchcore/proton/attribute/document_field_retriever.h>
 #include <vespa/vespalib/geo/zcurve.h>
@@ -143,6 +144,28 @@ DocumentRetriever::needFetchFromDocStore(const FieldSet & fieldSet) const {
     abort();
 }
 
+Field::Set
+DocumentRetriever::requestedAttributeFields(const FieldSet & fieldSet) const {
+    switch (fieldSet.getType()) {
+        case FieldSet::Type::FIELD: {
+            const auto & field = static_cast<const Field&>(fieldSet);
+            return isFieldAttribute(field) ? Field::Set::Builder().add(&field).build() : Field::Set::emptySet();
+        }
+        case FieldSet::Type::SET: {
+            const auto &set = static_cast<const document::FieldCollection &>(fieldSet);
+            Field::Set::Builder builder;
+            for (const Field * field : set.getFields()) {
+                if (isFieldAttribute(*field)) {
+                    builder.add(field);
+                }
+            }
+            return builder.build();
+        }
+        default:
+            return _attributeFields;
+    }
+}
+
 bool
 DocumentRetriever::isFieldAttribute(const Field& field) const {
     return _attributeFields.contains(field);
@@ -152,6 +175,19 @@ DocumentRetriever::~DocumentRetriever() = default;
 
 namespace {
 
+bool
+isFieldSubset(const FieldSet & fieldSet) {
+    return (fieldSet.getType() == FieldSet::Type::FIELD) || (fieldSet.getType() == FieldSet::Type::SET);
+}
+
+Field::Set
+requestedFields(const FieldSet & fieldSet) {
+    if (fieldSet.getType() == FieldSet::Type::FIELD) {
+        return Field::Set::Builder().add(&static_cast<const Field&>(fieldSet)).build();
+    }
+    return static_cast<const document::FieldCollection &>(fieldSet).getFields();
+}
+
 std::unique_ptr<document::FieldValue>
 positionFromZcurve(int64_t zcurve) {
     int32_t x, y;
@@ -238,10 +274,19 @@ Document::UP
 DocumentRetriever::getPartialDocument(search::DocumentIdT lid, const document::DocumentId & docId, const FieldSet & fieldSet) const {
     Document::UP doc;
     if (needFetchFromDocStore(fieldSet)) {
-        doc = _doc_store.read(lid, getDocumentTypeRepo());
-        if (doc) {
-            populate(lid, *doc);
-            FieldSet::stripFields(*doc, fieldSet);
+        if (isFieldSubset(fieldSet)) {
+            // Only the requested fields are decoded from the serialized document.
+            auto view = _doc_store.readLazy(lid, getDocumentTypeRepo());
+            if (view) {
+                doc = view->createDocument(requestedFields(fieldSet));
+                populate(lid, *doc, requestedAttributeFields(fieldSet));
+            }
+        } else {
+            doc = _doc_store.read(lid, getDocumentTypeRepo());
+            if (doc) {
+                populate(lid, *doc, requestedAttributeFields(fieldSet));
+                FieldSet::stripFields(*doc, fieldSet);
+            }
         }
     } else {
         doc = std::make_unique<Document>(getDocumentType(), docId);
@@ -50,6 +50,8 @@ public:
     bool needFetchFromDocStore(const document::FieldSet &) const;
 private:
     void populate(search::DocumentIdT lid, document::Document & doc, const document::Field::Set & attributeFields) const;
+    // Attribute fields that survive stripping the document down to the given field set.
+    document::Field::Set requestedAttributeFields(const document::FieldSet & fieldSet) const;
 
     bool isFieldAttribute(const document::Field & field) const override;
     const search::index::Schema     &_schema;
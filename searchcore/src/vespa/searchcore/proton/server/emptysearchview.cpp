@@ -22,7 +22,7 @@ EmptySearchView::EmptySearchView() = default;
 
 
 DocsumReply::UP
-EmptySearchView::getDocsums(const DocsumRequest &req)
+EmptySearchView::getDocsums(const DocsumRequest &req, vespalib::ThreadBundle &)
 {
     LOG(debug, "getDocsums(): resultClass(%s), numHits(%zu)",
         req.resultClassName.c_str(), req.hits.size());
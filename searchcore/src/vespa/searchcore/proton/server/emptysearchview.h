@@ -13,7 +13,7 @@ public:
 
     EmptySearchView();
 
-    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle) override;
 
     std::unique_ptr<SearchReply>
     match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const override;
@@ -57,35 +57,63 @@ ignoreOperation(const DocumentOperation &op) {
 }
 
 class TlsMgrWriter : public TlsWriter {
+    using Packet = search::transactionlog::Packet;
+    using DoneCallbacksList = search::transactionlog::Writer::DoneCallbacksList;
     TransactionLogManager &_tls_mgr;
     std::shared_ptr<search::transactionlog::Writer> _writer;
+    bool                   _batching;
+    Packet                 _batch;
+    DoneCallbacksList      _batchDone;
 public:
     TlsMgrWriter(TransactionLogManager &tls_mgr,
                  const search::transactionlog::WriterFactory & factory)
         : _tls_mgr(tls_mgr),
-          _writer(factory.getWriter(tls_mgr.getDomainName()))
+          _writer(factory.getWriter(tls_mgr.getDomainName())),
+          _batching(false),
+          _batch(0),
+          _batchDone()
     { }
     void appendOperation(const FeedOperation &op, DoneCallback onDone) override;
     [[nodiscard]] CommitResult startCommit(DoneCallback onDone) override {
         return _writer->startCommit(std::move(onDone));
     }
+    void startBatch() override { _batching = true; }
+    void endBatch() override;
     bool erase(SerialNum oldest_to_keep) override;
     SerialNum sync(SerialNum syncTo) override;
 };
 
 void
 TlsMgrWriter::appendOperation(const FeedOperation &op, DoneCallback onDone) {
-    using Packet = search::transactionlog::Packet;
     vespalib::nbostream stream;
     op.serialize(stream);
     LOG(debug, "appendOperation(): serialNum(%" PRIu64 "), type(%u), size(%zu)",
         op.getSerialNum(), (uint32_t)op.getType(), stream.size());
     Packet::Entry entry(op.getSerialNum(), op.getType(), vespalib::ConstBufferRef(stream.data(), stream.size()));
+    if (_batching) {
+        _batch.add(entry);
+        if (onDone) {
+            _batchDone.push_back(std::move(onDone));
+        }
+        return;
+    }
     Packet packet(entry.serializedSize());
     packet.add(entry);
     _writer->append(packet, std::move(onDone));
 }
 
+void
+TlsMgrWriter::endBatch() {
+    _batching = false;
+    if (_batch.empty()) {
+        return;
+    }
+    LOG(debug, "endBatch(): appending %zu operations in one packet, size(%zu)", _batch.size(), _batch.sizeBytes());
+    _writer->append(_batch, std::make_shared<vespalib::KeepAlive<DoneCallbacksList>>(std::move(_batchDone)));
+    _batch.clear();
+    _batchDone.clear();
+}
+
 bool
 TlsMgrWriter::erase(SerialNum oldest_to_keep) {
     return _tls_mgr.getSession()->erase(oldest_to_keep);
@@ -151,6 +179,17 @@ FeedHandler::doHandleOperation(FeedToken token, FeedOperation::UP op)
     _feedState->handleOperation(std::move(token), std::move(op));
 }
 
+void
+FeedHandler::doHandleOperations(OperationBatch ops)
+{
+    assert(_writeService.master().isCurrentThread());
+    _tlsWriter->startBatch();
+    for (auto & entry : ops) {
+        _feedState->handleOperation(std::move(entry.first), std::move(entry.second));
+    }
+    _tlsWriter->endBatch();
+}
+
 void
 FeedHandler::performPut(FeedToken token, PutOperation &op) {
     op.assertValid();
@@ -470,13 +509,15 @@ void
 FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flushedSummaryMgrSerial,
                                   SerialNum oldestFlushedSerial, SerialNum newestFlushedSerial,
                                   ConfigStore &config_store,
-                                  const ReplayThrottlingPolicy& replay_throttling_policy)
+                                  const ReplayThrottlingPolicy& replay_throttling_policy,
+                                  uint32_t replay_concurrency)
 {
     (void) newestFlushedSerial;
     assert(_activeFeedView);
     assert(_bucketDBHandler);
     auto state = make_shared<ReplayTransactionLogState>
-                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this);
+                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this,
+                           _writeService.shared(), replay_concurrency);
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -757,6 +798,16 @@ FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
     }));
 }
 
+void
+FeedHandler::handleOperations(OperationBatch ops)
+{
+    // Same as handleOperation(), but all operations are performed by a single master thread task,
+    // allowing them to be appended to the transaction log as one packet and covered by the same commit.
+    _writeService.blocking_master_execute(makeLambdaTask([this, ops = std::move(ops)]() mutable {
+        doHandleOperations(std::move(ops));
+    }));
+}
+
 void
 FeedHandler::handleMove(MoveOperation &op, vespalib::IDestructorCallback::SP moveDoneCtx)
 {
@@ -53,6 +53,8 @@ class FeedHandler: private search::transactionlog::client::Callback,
                    public IGetSerialNum,
                    public IIncSerialNum
 {
+public:
+    using OperationBatch = std::vector<std::pair<FeedToken, std::unique_ptr<FeedOperation>>>;
 private:
     using Packet = search::transactionlog::Packet;
     using RPC = search::transactionlog::client::RPC;
@@ -103,6 +105,7 @@ private:
      * The current feed state is sampled here.
      */
     void doHandleOperation(FeedToken token, FeedOperationUP op);
+    void doHandleOperations(OperationBatch ops);
 
     bool considerWriteOperationForRejection(FeedToken & token, const FeedOperation &op);
     bool considerUpdateOperationForRejection(FeedToken &token, UpdateOperation &op);
@@ -181,6 +184,8 @@ public:
      * @param flushedSummaryMgrSerial The flushed serial number of the
      *                                document store.
      * @param config_store            Reference to the config store.
+     * @param replay_concurrency      Max number of tasks used to deserialize
+     *                                the entries of a packet in parallel.
      */
 
     void
@@ -189,7 +194,8 @@ public:
                          SerialNum oldestFlushedSerial,
                          SerialNum newestFlushedSerial,
                          ConfigStore &config_store,
-                         const ReplayThrottlingPolicy& replay_throttling_policy);
+                         const ReplayThrottlingPolicy& replay_throttling_policy,
+                         uint32_t replay_concurrency);
 
     /**
      * Called when a flush is done and allows pruning of the transaction log.
@@ -232,12 +238,18 @@ public:
     float getReplayProgress() const {
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
+    const TlsReplayProgress *getReplayProgressTracker() const { return _tlsReplayProgress.get(); }
     bool getTransactionLogReplayDone() const;
     vespalib::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
 
     void performOperation(FeedToken token, FeedOperationUP op);
     void handleOperation(FeedToken token, FeedOperationUP op);
+    /**
+     * Handle a batch of operations in order. The operations are stored
+     * in the transaction log as a single packet.
+     */
+    void handleOperations(OperationBatch ops);
 
     void handleMove(MoveOperation &op, std::shared_ptr<vespalib::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
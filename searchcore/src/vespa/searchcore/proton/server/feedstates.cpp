@@ -10,10 +10,13 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcore/proton/common/replay_feed_token_factory.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
 #include <cassert>
+#include <exception>
+#include <span>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -33,6 +36,8 @@ namespace proton {
 namespace {
 
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
+// Smallest number of packet entries worth deserializing in a separate task.
+constexpr size_t MIN_ENTRIES_PER_DESERIALIZE_TASK = 16;
 
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
@@ -147,32 +152,134 @@ public:
     }
 };
 
+/**
+ * Replays the entries of a packet in serial number order. With a
+ * concurrency above 1, the entries between config changes are first
+ * deserialized in parallel using the shared executor, while the resulting
+ * operations are still replayed one by one in the executor thread, thus
+ * preserving the order of operations for each document.
+ */
 class PacketDispatcher {
 public:
-    PacketDispatcher(IReplayPacketHandler *packet_handler)
-        : _packet_handler(packet_handler)
+    using FeedOperationUP = std::unique_ptr<FeedOperation>;
+    PacketDispatcher(IReplayPacketHandler *packet_handler, Executor &shared_executor, uint32_t concurrency)
+        : _packet_handler(packet_handler),
+          _shared_executor(shared_executor),
+          _concurrency(concurrency)
     {}
 
     void handlePacket(PacketWrapper & wrap);
 private:
+    void handlePacketSerial(vespalib::nbostream &handle, TlsReplayProgress *progress);
+    void handlePacketParallel(vespalib::nbostream &handle, TlsReplayProgress *progress);
+    std::vector<FeedOperationUP> deserializeParallel(std::span<const Packet::Entry> entries);
     void handleEntry(const Packet::Entry &entry);
+    void handleOperation(const FeedOperation &op);
     IReplayPacketHandler *_packet_handler;
+    Executor             &_shared_executor;
+    uint32_t              _concurrency;
 };
 
 void
 PacketDispatcher::handlePacket(PacketWrapper & wrap)
 {
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
+    if (_concurrency > 1) {
+        handlePacketParallel(handle, wrap.progress);
+    } else {
+        handlePacketSerial(handle, wrap.progress);
+    }
+    if (wrap.progress != nullptr) {
+        wrap.progress->addEntries(wrap.packet.size());
+    }
+    wrap.result = RPC::OK;
+    wrap.gate.countDown();
+}
+
+void
+PacketDispatcher::handlePacketSerial(vespalib::nbostream &handle, TlsReplayProgress *progress)
+{
     while ( !handle.empty() ) {
         Packet::Entry entry;
         entry.deserialize(handle);
         handleEntry(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+        if (progress != nullptr) {
+            handleProgress(*progress, entry.serial());
         }
     }
-    wrap.result = RPC::OK;
-    wrap.gate.countDown();
+}
+
+void
+PacketDispatcher::handlePacketParallel(vespalib::nbostream &handle, TlsReplayProgress *progress)
+{
+    std::vector<Packet::Entry> entries;
+    while ( !handle.empty() ) {
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    std::span<const Packet::Entry> remaining(entries);
+    while ( !remaining.empty()) {
+        // A config change might change the document type repo used to deserialize the following entries.
+        if (remaining.front().type() == FeedOperation::NEW_CONFIG) {
+            handleEntry(remaining.front());
+            if (progress != nullptr) {
+                handleProgress(*progress, remaining.front().serial());
+            }
+            remaining = remaining.subspan(1);
+            continue;
+        }
+        size_t count = 1;
+        while ((count < remaining.size()) && (remaining[count].type() != FeedOperation::NEW_CONFIG)) {
+            ++count;
+        }
+        auto ops = deserializeParallel(remaining.first(count));
+        for (const auto &op : ops) {
+            handleOperation(*op);
+            if (progress != nullptr) {
+                handleProgress(*progress, op->getSerialNum());
+            }
+        }
+        remaining = remaining.subspan(count);
+    }
+}
+
+std::vector<PacketDispatcher::FeedOperationUP>
+PacketDispatcher::deserializeParallel(std::span<const Packet::Entry> entries)
+{
+    const document::DocumentTypeRepo &repo = _packet_handler->getDeserializeRepo();
+    std::vector<FeedOperationUP> ops(entries.size());
+    size_t num_tasks = std::max(size_t(1), std::min(size_t(_concurrency), entries.size() / MIN_ENTRIES_PER_DESERIALIZE_TASK));
+    std::vector<std::exception_ptr> failures(num_tasks);
+    auto deserialize_slice = [&](size_t task_id) {
+        size_t begin = entries.size() * task_id / num_tasks;
+        size_t end = entries.size() * (task_id + 1) / num_tasks;
+        try {
+            for (size_t i = begin; i < end; ++i) {
+                ops[i] = ReplayPacketDispatcher::deserialize(entries[i], repo);
+            }
+        } catch (...) {
+            failures[task_id] = std::current_exception();
+        }
+    };
+    vespalib::CountDownLatch latch(num_tasks - 1);
+    for (size_t task_id = 1; task_id < num_tasks; ++task_id) {
+        auto task = makeLambdaTask([&, task_id]() {
+            deserialize_slice(task_id);
+            latch.countDown();
+        });
+        auto rejected = _shared_executor.execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    deserialize_slice(0);
+    latch.await();
+    for (const auto &failure : failures) {
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+    return ops;
 }
 
 void
@@ -187,6 +294,16 @@ PacketDispatcher::handleEntry(const Packet::Entry &entry) {
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
+void
+PacketDispatcher::handleOperation(const FeedOperation &op) {
+    LOG(spam, "replay operation: serial(%" PRIu64 "), type(%u)", op.getSerialNum(), op.getType());
+
+    _packet_handler->check_serial_num(op.getSerialNum());
+    ReplayPacketDispatcher dispatcher(*_packet_handler);
+    dispatcher.replayOperation(op);
+    _packet_handler->optionalCommit(op.getSerialNum());
+}
+
 }  // namespace
 
 ReplayTransactionLogState::ReplayTransactionLogState(
@@ -196,10 +313,14 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         const ReplayThrottlingPolicy &replay_throttling_policy,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        Executor &shared_executor,
+        uint32_t replay_concurrency)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num))
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num)),
+      _shared_executor(shared_executor),
+      _replay_concurrency(replay_concurrency)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
@@ -207,7 +328,7 @@ ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
     executor.execute(makeLambdaTask([this, wrap = wrap] () {
-        PacketDispatcher dispatcher(_packet_handler.get());
+        PacketDispatcher dispatcher(_packet_handler.get(), _shared_executor, _replay_concurrency);
         dispatcher.handlePacket(*wrap);
     }));
 }
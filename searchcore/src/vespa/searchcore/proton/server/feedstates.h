@@ -48,6 +48,8 @@ public:
 class ReplayTransactionLogState : public FeedState {
     vespalib::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor &_shared_executor;
+    uint32_t _replay_concurrency;
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
@@ -56,7 +58,9 @@ public:
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             const ReplayThrottlingPolicy &replay_throttling_policy,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            vespalib::Executor &shared_executor,
+            uint32_t replay_concurrency);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
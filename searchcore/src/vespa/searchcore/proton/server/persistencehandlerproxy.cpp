@@ -54,6 +54,22 @@ PersistenceHandlerProxy::handleRemove(FeedToken token, const Bucket &bucket, Tim
     _feedHandler.handleOperation(std::move(token), std::move(op));
 }
 
+void
+PersistenceHandlerProxy::handlePutOrRemoveBatch(const Bucket &bucket, Batch batch)
+{
+    document::BucketId bucketId = bucket.getBucketId().stripUnused();
+    FeedHandler::OperationBatch ops;
+    ops.reserve(batch.size());
+    for (auto & entry : batch) {
+        if (entry.doc) {
+            ops.emplace_back(std::move(entry.token), std::make_unique<PutOperation>(bucketId, entry.timestamp, std::move(entry.doc)));
+        } else {
+            ops.emplace_back(std::move(entry.token), std::make_unique<RemoveOperationWithDocId>(bucketId, entry.timestamp, entry.id));
+        }
+    }
+    _feedHandler.handleOperations(std::move(ops));
+}
+
 void
 PersistenceHandlerProxy::handleListBuckets(IBucketIdListResultHandler &resultHandler)
 {
@@ -36,6 +36,8 @@ public:
                       storage::spi::Timestamp timestamp,
                       const document::DocumentId &id) override;
 
+    void handlePutOrRemoveBatch(const storage::spi::Bucket &bucket, Batch batch) override;
+
     void handleListBuckets(IBucketIdListResultHandler &resultHandler) override;
     void handleSetClusterState(const storage::spi::ClusterState &calc, IGenericResultHandler &resultHandler) override;
 
@@ -305,7 +305,9 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
                                                  protonConfig.search.async);
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _distributionKey = protonConfig.distributionkey;
-    _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async);
+    _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads,
+                                                     protonConfig.numthreadsperdocsum,
+                                                     protonConfig.docsum.async);
     _summaryEngine->set_issue_forwarding(protonConfig.forwardIssues);
 
     IFlushStrategy::SP strategy;
@@ -774,6 +776,9 @@ Proton::updateMetrics(const metrics::MetricLockGuard &)
         auto tls = _tls->getTransLogServer();
         if (tls) {
             metrics.transactionLog.update(tls->getDomainStats());
+            if (const auto *groupCommitter = tls->getGroupCommitter()) {
+                metrics.transactionLog.update(groupCommitter->getStats());
+            }
         }
 
         const DiskMemUsageFilter &usageFilter = _diskMemUsageSampler->writeFilter();
@@ -9,14 +9,42 @@ using vespalib::IllegalStateException;
 
 namespace proton {
 
+namespace {
+
+template <typename OperationType, typename... Args>
+std::unique_ptr<FeedOperation>
+deserializeOperation(vespalib::nbostream &is, const document::DocumentTypeRepo &repo, Args &&... args)
+{
+    auto op = std::make_unique<OperationType>(std::forward<Args>(args)...);
+    op->deserialize(is, repo);
+    return op;
+}
+
+void
+checkFullyConsumed(const vespalib::nbostream &is, uint32_t entryType)
+{
+    if ( ! is.empty()) {
+        throw document::DeserializeException
+            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                         entryType, is.size()));
+    }
+}
+
+[[noreturn]] void
+throwUnknownType(uint32_t entryType)
+{
+    throw IllegalStateException
+        (make_string("Got packet entry with unknown type id '%u' from TLS", entryType));
+}
+
+}
+
 template <typename OperationType>
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+ReplayPacketDispatcher::replay(const FeedOperation &op)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
     store(op);
-    _handler.replay(op);
+    _handler.replay(static_cast<const OperationType &>(op));
 }
 
 
@@ -28,70 +56,111 @@ ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
 
 void
 ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+{
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
+        op.deserialize(is, _handler.getDeserializeRepo());
+        _handler.replay(op);
+        checkFullyConsumed(is, entry.type());
+    } else {
+        auto op = deserialize(entry, _handler.getDeserializeRepo());
+        replayOperation(*op);
+    }
+}
+
+
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::deserialize(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
 {
     vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    std::unique_ptr<FeedOperation> op;
     switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperationWithDocId op;
-        replay(op, is, entry);
+    case FeedOperation::PUT:
+        op = deserializeOperation<PutOperation>(is, repo);
         break;
-    } case FeedOperation::REMOVE_GID: {
-        RemoveOperationWithGid op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE:
+        op = deserializeOperation<RemoveOperationWithDocId>(is, repo);
         break;
-    } case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
+    case FeedOperation::REMOVE_GID:
+        op = deserializeOperation<RemoveOperationWithGid>(is, repo);
         break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
+    case FeedOperation::UPDATE:
+        op = deserializeOperation<UpdateOperation>(is, repo, FeedOperation::UPDATE);
         break;
-    } case FeedOperation::NEW_CONFIG: {
-        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
-        op.deserialize(is, _handler.getDeserializeRepo());
-        _handler.replay(op);
+    case FeedOperation::NOOP:
+        op = deserializeOperation<NoopOperation>(is, repo);
         break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::DELETE_BUCKET:
+        op = deserializeOperation<DeleteBucketOperation>(is, repo);
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        op = deserializeOperation<SplitBucketOperation>(is, repo);
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        op = deserializeOperation<JoinBucketsOperation>(is, repo);
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        op = deserializeOperation<PruneRemovedDocumentsOperation>(is, repo);
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        op = deserializeOperation<MoveOperation>(is, repo);
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::CREATE_BUCKET:
+        op = deserializeOperation<CreateBucketOperation>(is, repo);
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
+    case FeedOperation::COMPACT_LID_SPACE:
+        op = deserializeOperation<CompactLidSpaceOperation>(is, repo);
         break;
-    } default:
-        throw IllegalStateException
-            (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
+    default:
+        throwUnknownType(entry.type());
     }
-    if ( ! is.empty()) {
-        throw document::DeserializeException
-            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
-                         entry.type(), is.size()));
+    checkFullyConsumed(is, entry.type());
+    op->setSerialNum(entry.serial());
+    return op;
+}
+
+
+void
+ReplayPacketDispatcher::replayOperation(const FeedOperation &op)
+{
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        replay<PutOperation>(op);
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        replay<RemoveOperation>(op);
+        break;
+    case FeedOperation::UPDATE:
+        replay<UpdateOperation>(op);
+        break;
+    case FeedOperation::NOOP:
+        replay<NoopOperation>(op);
+        break;
+    case FeedOperation::DELETE_BUCKET:
+        replay<DeleteBucketOperation>(op);
+        break;
+    case FeedOperation::SPLIT_BUCKET:
+        replay<SplitBucketOperation>(op);
+        break;
+    case FeedOperation::JOIN_BUCKETS:
+        replay<JoinBucketsOperation>(op);
+        break;
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        replay<PruneRemovedDocumentsOperation>(op);
+        break;
+    case FeedOperation::MOVE:
+        replay<MoveOperation>(op);
+        break;
+    case FeedOperation::CREATE_BUCKET:
+        replay<CreateBucketOperation>(op);
+        break;
+    case FeedOperation::COMPACT_LID_SPACE:
+        replay<CompactLidSpaceOperation>(op);
+        break;
+    default:
+        throwUnknownType(op.getType());
     }
 }
 
@@ -5,6 +5,8 @@
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
 
+namespace document { class DocumentTypeRepo; }
+
 namespace proton {
 
 class FeedOperation;
@@ -20,7 +22,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replay(const FeedOperation &op);
 
 protected:
     virtual void store(const FeedOperation &op);
@@ -30,6 +32,16 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Deserialize a packet entry into a feed operation, using the given
+     * document type repo. Can be called by any thread, as it does not use
+     * the handler. Not supported for NEW_CONFIG entries, which must be
+     * replayed using replayEntry().
+     */
+    static std::unique_ptr<FeedOperation> deserialize(const Packet::Entry &entry,
+                                                      const document::DocumentTypeRepo &repo);
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
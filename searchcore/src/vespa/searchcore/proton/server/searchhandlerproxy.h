@@ -18,7 +18,7 @@ public:
     SearchHandlerProxy(std::shared_ptr<DocumentDB> documentDB);
 
     ~SearchHandlerProxy() override;
-    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request, ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const SearchRequest &req, ThreadBundle &threadBundle) const override;
 };
 
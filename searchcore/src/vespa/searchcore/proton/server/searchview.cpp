@@ -99,7 +99,7 @@ SearchView::SearchView(ISummaryManager::ISummarySetup::SP summarySetup, MatchVie
 SearchView::~SearchView() = default;
 
 DocsumReply::UP
-SearchView::getDocsums(const DocsumRequest & req)
+SearchView::getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle)
 {
     LOG(spam, "getDocsums(): resultClass(%s), numHits(%zu)", req.resultClassName.c_str(), req.hits.size());
     if (_summarySetup->getResultConfig().lookupResultClassId(req.resultClassName.c_str()) == ResultConfig::noClassID()) {
@@ -107,16 +107,16 @@ SearchView::getDocsums(const DocsumRequest & req)
                      req.resultClassName.c_str(), req.hits.size());
         return createEmptyReply(req);
     }
-    SearchView::InternalDocsumReply reply = getDocsumsInternal(req);
+    SearchView::InternalDocsumReply reply = getDocsumsInternal(req, threadBundle);
     while ( ! reply.second ) {
         LOG(debug, "Must refetch docsums since the lids have moved.");
-        reply = getDocsumsInternal(req);
+        reply = getDocsumsInternal(req, threadBundle);
     }
     return std::move(reply.first);
 }
 
 SearchView::InternalDocsumReply
-SearchView::getDocsumsInternal(const DocsumRequest & req)
+SearchView::getDocsumsInternal(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle)
 {
     IDocumentMetaStoreContext::IReadGuard::UP readGuard = _matchView->getDocumentMetaStore()->getReadGuard();
     const search::IDocumentMetaStore & metaStore = readGuard->get();
@@ -128,7 +128,7 @@ SearchView::getDocsumsInternal(const DocsumRequest & req)
     MatchContext::UP mctx = _matchView->createContext();
     auto ctx = std::make_unique<DocsumContext>(req, _summarySetup->getDocsumWriter(), *store, _matchView->getMatcher(req.ranking),
                                                mctx->getSearchContext(), mctx->getAttributeContext(),
-                                               *_summarySetup->getAttributeManager(), *getSessionManager());
+                                               *_summarySetup->getAttributeManager(), *getSessionManager(), threadBundle);
     SearchView::InternalDocsumReply reply(ctx->getDocsums(), true);
     uint64_t endGeneration = readGuard->get().getCurrentGeneration();
     if (startGeneration != endGeneration) {
@@ -33,11 +33,11 @@ public:
     DocIdLimit &getDocIdLimit() const { return _matchView->getDocIdLimit(); }
     matching::MatchingStats getMatcherStats(const vespalib::string &rankProfile) const { return _matchView->getMatcherStats(rankProfile); }
 
-    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const override;
 private:
     SearchView(ISummaryManager::ISummarySetup::SP summarySetup, MatchView::SP matchView);
-    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req);
+    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle);
     ISummaryManager::ISummarySetup::SP _summarySetup;
     MatchView::SP                      _matchView;
 };
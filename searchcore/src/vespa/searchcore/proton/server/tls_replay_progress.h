@@ -4,6 +4,7 @@
 
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 #include <memory>
 
@@ -16,6 +17,9 @@ private:
     const search::SerialNum _first;
     const search::SerialNum _last;
     std::atomic<search::SerialNum> _current;
+    const vespalib::steady_time _start;
+    std::atomic<uint64_t>   _entries;
+    std::atomic<vespalib::steady_time> _lastUpdate;
 
 public:
     typedef std::unique_ptr<TlsReplayProgress> UP;
@@ -26,7 +30,10 @@ public:
         : _domainName(domainName),
           _first(first),
           _last(last),
-          _current(first)
+          _current(first),
+          _start(vespalib::steady_clock::now()),
+          _entries(0),
+          _lastUpdate(_start)
     {
     }
     const vespalib::string &getDomainName() const noexcept { return _domainName; }
@@ -41,6 +48,17 @@ public:
         }
     }
     void updateCurrent(search::SerialNum current) noexcept { _current.store(current, std::memory_order_relaxed); }
+    // Called after replaying a packet, to track replay throughput.
+    void addEntries(uint64_t entries) noexcept {
+        _entries.fetch_add(entries, std::memory_order_relaxed);
+        _lastUpdate.store(vespalib::steady_clock::now(), std::memory_order_relaxed);
+    }
+    uint64_t getEntries() const noexcept { return _entries.load(std::memory_order_relaxed); }
+    vespalib::duration getElapsed() const noexcept { return _lastUpdate.load(std::memory_order_relaxed) - _start; }
+    double getEntriesPerSecond() const noexcept {
+        double elapsed = vespalib::to_s(getElapsed());
+        return (elapsed > 0.0) ? (getEntries() / elapsed) : 0.0;
+    }
 };
 
 } // namespace proton
@@ -13,6 +13,12 @@ namespace proton {
 struct TlsWriter : public IOperationStorer {
     virtual ~TlsWriter() = default;
 
+    /**
+     * Operations appended between startBatch() and endBatch() may be
+     * handed to the transaction log as a single packet when the batch ends.
+     */
+    virtual void startBatch() { }
+    virtual void endBatch() { }
     virtual bool erase(search::SerialNum oldest_to_keep) = 0;
     virtual search::SerialNum sync(search::SerialNum syncTo) = 0;
 };
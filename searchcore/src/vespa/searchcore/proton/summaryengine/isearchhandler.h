@@ -35,7 +35,7 @@ public:
     /**
      * @return Use the request and produce the document summary result.
      */
-    virtual std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request) = 0;
+    virtual std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & request, ThreadBundle &threadBundle) = 0;
 
     virtual std::unique_ptr<SearchReply>
     match(const SearchRequest &req, ThreadBundle &threadBundle) const = 0;
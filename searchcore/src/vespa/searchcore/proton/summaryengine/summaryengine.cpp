@@ -42,6 +42,7 @@ uint32_t getNumDocs(const DocsumReply &reply) {
 }
 
 VESPA_THREAD_STACK_TAG(summary_engine_executor)
+VESPA_THREAD_STACK_TAG(summary_engine_thread_bundle)
 
 } // namespace anonymous
 
@@ -57,13 +58,15 @@ SummaryEngine::DocsumMetrics::DocsumMetrics()
 
 SummaryEngine::DocsumMetrics::~DocsumMetrics() = default;
 
-SummaryEngine::SummaryEngine(size_t numThreads, bool async)
+SummaryEngine::SummaryEngine(size_t numThreads, size_t threadsPerDocsum, bool async)
     : _lock(),
       _async(async),
       _closed(false),
       _forward_issues(true),
       _handlers(),
       _executor(numThreads, 128_Ki, CpuUsage::wrap(summary_engine_executor, CpuUsage::Category::READ)),
+      _threadBundlePool(std::max(size_t(1), threadsPerDocsum),
+                        CpuUsage::wrap(summary_engine_thread_bundle, CpuUsage::Category::READ)),
       _metrics(std::make_unique<DocsumMetrics>())
 { }
 
@@ -130,8 +133,9 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
     DocsumReply::UP reply;
     if (req) {
         ISearchHandler::SP searchHandler = getSearchHandler(DocTypeName(*req));
+        vespalib::SimpleThreadBundle::UP threadBundle = _threadBundlePool.obtain();
         if (searchHandler) {
-            reply = searchHandler->getDocsums(*req);
+            reply = searchHandler->getDocsums(*req, *threadBundle);
         } else {
             HandlerMap<ISearchHandler>::Snapshot snapshot;
             {
@@ -139,9 +143,10 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
                 snapshot = _handlers.snapshot();
             }
             if (snapshot.valid()) {
-                reply = snapshot.get()->getDocsums(*req); // use the first handler
+                reply = snapshot.get()->getDocsums(*req, *threadBundle); // use the first handler
             }
         }
+        _threadBundlePool.release(std::move(threadBundle));
         updateDocsumMetrics(vespalib::to_s(req->getTimeUsed()), getNumDocs(*reply));
         if (req->expired()) {
             vespalib::Issue::report("docsum request timed out; results may be incomplete");
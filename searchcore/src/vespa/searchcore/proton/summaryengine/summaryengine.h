@@ -6,6 +6,7 @@
 #include <vespa/searchcore/proton/common/handlermap.hpp>
 #include <vespa/searchlib/engine/docsumapi.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/metricset.h>
@@ -37,6 +38,7 @@ private:
     std::atomic<bool>             _forward_issues;
     HandlerMap<ISearchHandler>    _handlers;
     vespalib::ThreadStackExecutor _executor;
+    vespalib::SimpleThreadBundle::Pool _threadBundlePool;
     std::unique_ptr<metrics::MetricSet> _metrics;
 
 public:
@@ -50,8 +52,13 @@ public:
      * using the putSearchHandler() method.
      *
      * @param numThreads Number of threads allocated for handling summary requests.
+     * @param threadsPerDocsum Number of threads used to calculate summary features and
+     *                         rank features for a single summary request.
      */
-    SummaryEngine(size_t numThreads, bool async);
+    SummaryEngine(size_t numThreads, size_t threadsPerDocsum, bool async);
+    SummaryEngine(size_t numThreads, bool async)
+        : SummaryEngine(numThreads, 1, async)
+    { }
     SummaryEngine(size_t numThreads)
         : SummaryEngine(numThreads, true)
     { }
@@ -35,6 +35,7 @@ struct DummyDocumentStore : public search::IDocumentStore
     size_t getDiskBloat() const override { return 0; }
     size_t getMaxSpreadAsBloat() const override { return getDiskBloat(); }
     vespalib::CacheStats getCacheStats() const override { return vespalib::CacheStats(); }
+    std::vector<search::VisitCacheShardStats> getVisitCacheShardStats() const override { return {}; }
     const vespalib::string &getBaseDir() const override { return _baseDir; }
     void accept(search::IDocumentStoreReadVisitor &,
                 search::IDocumentStoreVisitorProgress &,
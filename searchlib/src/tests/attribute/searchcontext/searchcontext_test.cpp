@@ -18,6 +18,7 @@
 #include <vespa/searchlib/test/searchiteratorverifier.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
 #include <vespa/vespalib/util/compress.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/stllike/asciistream.h>
@@ -248,6 +249,7 @@ private:
     void performFuzzySearch(const StringAttribute & vec, const vespalib::string & term,
                              const DocSet & expected, TermType termType);
     void testFuzzySearch(const AttributePtr & ptr);
+    void testFuzzySearchManyValues(const AttributePtr & ptr);
     void testFuzzySearch();
 
     // test that search is working after clear doc
@@ -1567,11 +1569,51 @@ SearchContextTest::testFuzzySearch(const AttributePtr & ptr)
     }
 }
 
+void
+SearchContextTest::testFuzzySearchManyValues(const AttributePtr & ptr)
+{
+    LOG(info, "testFuzzySearchManyValues: vector '%s'", ptr->getName().c_str());
+
+    auto & vec = dynamic_cast<StringAttribute &>(*ptr.get());
+
+    // Many unique values where only a few are within edit distance of the term,
+    // exercising skipping of non-matching dictionary ranges.
+    uint32_t numDocs = 1000;
+    addDocs(*ptr.get(), numDocs);
+    vespalib::FuzzyMatcher matcher("fuzzysearch", 2, 0, false);
+    DocSet expected;
+    for (uint32_t doc = 1; doc < numDocs + 1; ++doc) {
+        vespalib::string value("fuzzysearch");
+        value[doc % 11] = 'a' + (doc / 11) % 26;
+        if (doc % 3 == 0) {
+            value[(doc / 7) % 11] = 'A' + doc % 26;
+        }
+        if (doc % 5 == 0) {
+            value.append("xy");
+        }
+        if (doc % 4 == 0) {
+            value[(doc / 13) % 11] = '0' + doc % 10;
+        }
+        ASSERT_TRUE(doc < vec.getNumDocs());
+        EXPECT_TRUE(vec.update(doc, value));
+        if (matcher.isMatch(value.c_str())) {
+            expected.put(doc);
+        }
+    }
+
+    ptr->commit(true);
+
+    EXPECT_LESS(expected.size(), numDocs);
+    performFuzzySearch(vec, "fuzzysearch", expected, TermType::FUZZYTERM);
+    performFuzzySearch(vec, "FUZZYSEARCH", expected, TermType::FUZZYTERM);
+}
+
 void
 SearchContextTest::testFuzzySearch()
 {
     for (const auto & cfg : _stringCfg) {
         testFuzzySearch(AttributeFactory::createAttribute(cfg.first, cfg.second));
+        testFuzzySearchManyValues(AttributeFactory::createAttribute(cfg.first, cfg.second));
     }
 }
 
@@ -3,6 +3,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/diskindex/fieldreader.h>
 #include <vespa/searchlib/diskindex/fieldwriter.h>
+#include <vespa/searchlib/diskindex/fileheader.h>
 #include <vespa/searchlib/diskindex/pagedict4file.h>
 #include <vespa/searchlib/diskindex/pagedict4randread.h>
 #include <vespa/searchlib/diskindex/zcposoccrandread.h>
@@ -161,6 +162,7 @@ public:
 private:
     bool _dynamicK;
     bool _encode_interleaved_features;
+    bool _block_doc_ids;
     uint32_t _numWordIds;
     uint32_t _docIdLimit;
     vespalib::string _namepref;
@@ -172,6 +174,7 @@ public:
     WrappedFieldWriter(const vespalib::string &namepref,
                        bool dynamicK,
                        bool encoce_cheap_fatures,
+                       bool block_doc_ids,
                        uint32_t numWordIds,
                        uint32_t docIdLimit);
     ~WrappedFieldWriter();
@@ -185,11 +188,13 @@ WrappedFieldWriter::~WrappedFieldWriter() {}
 WrappedFieldWriter::WrappedFieldWriter(const vespalib::string &namepref,
                                        bool dynamicK,
                                        bool encode_interleaved_features,
+                                       bool block_doc_ids,
                                        uint32_t numWordIds,
                                        uint32_t docIdLimit)
     : _fieldWriter(),
       _dynamicK(dynamicK),
       _encode_interleaved_features(encode_interleaved_features),
+      _block_doc_ids(block_doc_ids),
       _numWordIds(numWordIds),
       _docIdLimit(docIdLimit),
       _namepref(dirprefix + namepref),
@@ -211,7 +216,7 @@ WrappedFieldWriter::open()
     _fieldWriter = std::make_unique<FieldWriter>(_docIdLimit, _numWordIds);
     _fieldWriter->open(_namepref,
                        minSkipDocs, minChunkDocs,
-                       _dynamicK, _encode_interleaved_features,
+                       _dynamicK, _encode_interleaved_features, _block_doc_ids,
                        _schema, _indexId,
                        FieldLengthInfo(4.5, 42),
                        tuneFileWrite, fileHeaderContext);
@@ -373,19 +378,20 @@ void
 writeField(FakeWordSet &wordSet,
            uint32_t docIdLimit,
            const std::string &namepref,
-           bool dynamicK, bool encode_interleaved_features)
+           bool dynamicK, bool encode_interleaved_features, bool block_doc_ids)
 {
     const char *dynamicKStr = dynamicK ? "true" : "false";
 
     LOG(info,
         "enter writeField, "
-        "namepref=%s, dynamicK=%s, encode_interleaved_features=%s",
+        "namepref=%s, dynamicK=%s, encode_interleaved_features=%s, block_doc_ids=%s",
         namepref.c_str(),
         dynamicKStr,
-        bool_to_str(encode_interleaved_features));
+        bool_to_str(encode_interleaved_features),
+        bool_to_str(block_doc_ids));
     vespalib::Timer tv;
     WrappedFieldWriter ostate(namepref,
-                              dynamicK, encode_interleaved_features,
+                              dynamicK, encode_interleaved_features, block_doc_ids,
                               wordSet.getNumWords(), docIdLimit);
     FieldWriter::remove(dirprefix + namepref);
     ostate.open();
@@ -558,7 +564,8 @@ fusionField(uint32_t numWordIds,
             const vespalib::string &opref,
             bool doRaw,
             bool dynamicK,
-            bool encode_interleaved_features)
+            bool encode_interleaved_features,
+            bool block_doc_ids)
 {
     const char *rawStr = doRaw ? "true" : "false";
     const char *dynamicKStr = dynamicK ? "true" : "false";
@@ -573,7 +580,7 @@ fusionField(uint32_t numWordIds,
         rawStr,
         dynamicKStr, bool_to_str(encode_interleaved_features));
 
-    WrappedFieldWriter ostate(opref, dynamicK, encode_interleaved_features, numWordIds, docIdLimit);
+    WrappedFieldWriter ostate(opref, dynamicK, encode_interleaved_features, block_doc_ids, numWordIds, docIdLimit);
     WrappedFieldReader istate(ipref, numWordIds, docIdLimit);
 
     vespalib::Timer tv;
@@ -609,24 +616,42 @@ fusionField(uint32_t numWordIds,
 }
 
 
+void
+check_posting_format(const vespalib::string &namepref, bool dynamicK, bool block_doc_ids)
+{
+    search::diskindex::FileHeader header;
+    TuneFileSeqRead tuneFileRead;
+    bool tasted = header.taste(dirprefix + namepref + "posocc.dat.compressed", tuneFileRead);
+    assert(tasted);
+    (void) tasted;
+    const vespalib::string &expected = dynamicK
+                                       ? search::diskindex::ZcPosOccRandRead::getIdentifier(block_doc_ids)
+                                       : search::diskindex::Zc4PosOccRandRead::getIdentifier(block_doc_ids);
+    assert(header.getFormats().size() == 2);
+    assert(header.getFormats()[0] == expected);
+    (void) expected;
+}
+
 void
 testFieldWriterVariant(FakeWordSet &wordSet, uint32_t doc_id_limit,
                        const vespalib::string &file_name_prefix,
                        bool dynamic_k,
                        bool encode_interleaved_features,
+                       bool block_doc_ids,
                        bool verbose)
 {
-    writeField(wordSet, doc_id_limit, file_name_prefix, dynamic_k, encode_interleaved_features);
+    writeField(wordSet, doc_id_limit, file_name_prefix, dynamic_k, encode_interleaved_features, block_doc_ids);
+    check_posting_format(file_name_prefix, dynamic_k, block_doc_ids);
     readField(wordSet, doc_id_limit, file_name_prefix, dynamic_k, encode_interleaved_features, verbose);
     randReadField(wordSet, file_name_prefix, dynamic_k, encode_interleaved_features, verbose);
     fusionField(wordSet.getNumWords(),
                 doc_id_limit,
                 file_name_prefix, file_name_prefix + "x",
-                false, dynamic_k, encode_interleaved_features);
+                false, dynamic_k, encode_interleaved_features, block_doc_ids);
     fusionField(wordSet.getNumWords(),
                 doc_id_limit,
                 file_name_prefix, file_name_prefix + "xx",
-                true, dynamic_k, encode_interleaved_features);
+                true, dynamic_k, encode_interleaved_features, block_doc_ids);
     check_fusion(file_name_prefix);
     remove_field(file_name_prefix);
 }
@@ -636,15 +661,18 @@ testFieldWriterVariants(FakeWordSet &wordSet,
                         uint32_t docIdLimit, bool verbose)
 {
     disableSkip();
-    testFieldWriterVariant(wordSet, docIdLimit, "new4", true, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "new5", false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "new4", true, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "new5", false, false, false, verbose);
     enableSkip();
-    testFieldWriterVariant(wordSet, docIdLimit, "newskip4", true, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "newskip5", false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newskip4", true, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newskip5", false, false, false, verbose);
     enableSkipChunks();
-    testFieldWriterVariant(wordSet, docIdLimit, "newchunk4", true, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "newchunk5", false, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "newchunkcf4", true, true, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunk4", true, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunk5", false, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkcf4", true, true, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkblock4", true, false, true, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkblock5", false, false, true, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkblockcf4", true, true, true, verbose);
 }
 
 
@@ -653,14 +681,15 @@ testFieldWriterVariantsWithHighLids(FakeWordSet &wordSet, uint32_t docIdLimit,
                              bool verbose)
 {
     disableSkip();
-    testFieldWriterVariant(wordSet, docIdLimit, "hlid4", true, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "hlid5", false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlid4", true, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlid5", false, false, false, verbose);
     enableSkip();
-    testFieldWriterVariant(wordSet, docIdLimit, "hlidskip4", true, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "hlidskip5", false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlidskip4", true, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlidskip5", false, false, false, verbose);
     enableSkipChunks();
-    testFieldWriterVariant(wordSet, docIdLimit, "hlidchunk4", true, false, verbose);
-    testFieldWriterVariant(wordSet, docIdLimit, "hlidchunk5", false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlidchunk4", true, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlidchunk5", false, false, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "hlidchunkblock5", false, false, true, verbose);
 }
 
 int
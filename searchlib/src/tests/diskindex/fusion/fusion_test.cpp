@@ -446,6 +446,21 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         ASSERT_TRUE(dw6.setup(tuneFileSearch));
         validateDiskIndex(dw6, true, true);
     } while (0);
+    do {
+        std::vector<vespalib::string> sources;
+        SelectorArray selector(numDocs, 0);
+        sources.push_back(prefix + "dump3");
+        Fusion fusion(schema, prefix + "dump7", sources, selector,
+                      tuneFileIndexing, fileHeaderContext);
+        fusion.set_block_doc_ids_pos_index_format(true);
+        fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
+    } while (0);
+    do {
+        DiskIndex dw7(prefix + "dump7");
+        ASSERT_TRUE(dw7.setup(tuneFileSearch));
+        validateDiskIndex(dw7, true, true);
+    } while (0);
     do {
         std::vector<vespalib::string> sources;
         SelectorArray selector(numDocs, 0);
@@ -8,12 +8,16 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <zstd.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -100,4 +104,49 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+vespalib::string makeDocument(size_t i) {
+    return vespalib::make_string("{\"id\":\"id:ns:music::%zu\",\"title\":\"Title number %zu\",\"artist\":\"Artist %zu\","
+                                 "\"year\":%zu,\"genre\":\"%s\"}", i, i * 7, i % 13, 1950 + i % 70, (i % 2) ? "rock" : "jazz");
+}
+
+ZStdDictionary::SP trainDictionary() {
+    vespalib::string samples;
+    std::vector<size_t> sampleSizes;
+    for (size_t i(0); i < 1000; i++) {
+        vespalib::string doc = makeDocument(i);
+        samples += doc;
+        sampleSizes.push_back(doc.size());
+    }
+    return ZStdDictionary::train(samples.data(), sampleSizes, 4_Ki, 9);
+}
+
+void packDocument(const vespalib::string & doc, const ZStdDictionary * dictionary, vespalib::DataBuffer & buffer) {
+    ChunkFormatV2 chunk(10);
+    chunk.getBuffer().write(doc.data(), doc.size());
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD), dictionary);
+}
+
+TEST("require that V2 can compress and decompress zstd using a dictionary") {
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    EXPECT_NOT_EQUAL(0u, dictionary->getId());
+    vespalib::string doc = makeDocument(1234);
+    vespalib::DataBuffer withDictionary;
+    vespalib::DataBuffer withoutDictionary;
+    packDocument(doc, dictionary.get(), withDictionary);
+    packDocument(doc, nullptr, withoutDictionary);
+    EXPECT_LESS(withDictionary.getDataLen(), withoutDictionary.getDataLen());
+
+    ChunkFormat::UP deserialized = ChunkFormat::deserialize(withDictionary.getData(), withDictionary.getDataLen(), false, dictionary.get());
+    std::vector<char> v(doc.size());
+    deserialized->getBuffer().read(&v[0], doc.size());
+    EXPECT_EQUAL(doc, vespalib::string(&v[0], v.size()));
+
+    EXPECT_EXCEPTION(ChunkFormat::deserialize(withDictionary.getData(), withDictionary.getDataLen(), false),
+                     ChunkException, "Missing zstd dictionary");
+    deserialized = ChunkFormat::deserialize(withoutDictionary.getData(), withoutDictionary.getDataLen(), false, dictionary.get());
+    deserialized->getBuffer().read(&v[0], doc.size());
+    EXPECT_EQUAL(doc, vespalib::string(&v[0], v.size()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,13 +2,17 @@
 
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/docstore/filechunk.h>
+#include <vespa/searchlib/docstore/randreaders.h>
 #include <vespa/searchlib/docstore/writeablefilechunk.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/compressionconfig.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <iomanip>
 #include <iostream>
 
@@ -31,10 +35,19 @@ struct MyFileHeaderContext : public FileHeaderContext {
 
 struct SetLidObserver : public ISetLid {
     std::vector<uint32_t> lids;
+    LidInfoWithLidV lidInfos;
     void setLid(const unique_lock &guard, uint32_t lid, const LidInfo &lidInfo) override {
         (void) guard;
-        (void) lidInfo;
         lids.push_back(lid);
+        lidInfos.emplace_back(lidInfo, lid);
+    }
+};
+
+struct CollectingBufferVisitor : public IBufferVisitor {
+    std::vector<vespalib::string> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        (void) lid;
+        visited.emplace_back(buffer.c_str(), buffer.size());
     }
 };
 
@@ -72,11 +85,12 @@ struct FixtureBase {
         return serialNum++;
     };
 
-    explicit FixtureBase(const vespalib::string &baseName, bool dirCleanup = true)
+    explicit FixtureBase(const vespalib::string &baseName, bool dirCleanup = true,
+                         const TuneFileSummary &tune = TuneFileSummary())
         : dir(baseName),
           executor(1, 0x10000),
           serialNum(1),
-          tuneFile(),
+          tuneFile(tune),
           fileHeaderCtx(),
           updateLock(),
           lidObserver(),
@@ -98,8 +112,9 @@ FixtureBase::~FixtureBase() = default;
 struct ReadFixture : public FixtureBase {
     FileChunk chunk;
 
-    explicit ReadFixture(const vespalib::string &baseName, bool dirCleanup = true)
-        : FixtureBase(baseName, dirCleanup),
+    explicit ReadFixture(const vespalib::string &baseName, bool dirCleanup = true,
+                         const TuneFileSummary &tune = TuneFileSummary())
+        : FixtureBase(baseName, dirCleanup, tune),
           chunk(FileChunk::FileId(0),
                 FileChunk::NameId(1234),
                 baseName,
@@ -121,7 +136,9 @@ struct WriteFixture : public FixtureBase {
 
     WriteFixture(const vespalib::string &baseName,
                  uint32_t docIdLimit,
-                 bool dirCleanup = true)
+                 bool dirCleanup = true,
+                 const CompressionConfig &compression = CompressionConfig(),
+                 FileChunk::ZStdDictionarySP dictionary = FileChunk::ZStdDictionarySP())
         : FixtureBase(baseName, dirCleanup),
           chunk(executor,
                 FileChunk::FileId(0),
@@ -129,11 +146,12 @@ struct WriteFixture : public FixtureBase {
                 baseName,
                 serialNum,
                 docIdLimit,
-                WriteableFileChunk::Config(CompressionConfig(), 0x1000),
+                WriteableFileChunk::Config(compression, 0x1000),
                 tuneFile,
                 fileHeaderCtx,
                 &bucketizer,
-                false)
+                false,
+                std::move(dictionary))
     {
         dir.cleanup(dirCleanup);
     }
@@ -142,7 +160,9 @@ struct WriteFixture : public FixtureBase {
         chunk.flushPendingChunks(serialNum);
     }
     WriteFixture &append(uint32_t lid) {
-        vespalib::string data = getData(lid);
+        return append(lid, getData(lid));
+    }
+    WriteFixture &append(uint32_t lid, const vespalib::string &data) {
         chunk.append(nextSerialNum(), lid, data.c_str(), data.size(), CpuUsage::Category::WRITE);
         return *this;
     }
@@ -239,7 +259,87 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
     }
 }
 
+TEST("require that lids in several chunks can be read as one batch using io_uring")
+{
+    {
+        WriteFixture f("tmp", 1000, false);
+        f.append(1).append(2);
+        f.flush();
+        f.append(3);
+        f.flush();
+        f.append(4).append(5);
+        f.flush();
+    }
+    {
+        TuneFileSummary tune;
+        tune._randRead.setWantIoUring();
+        ReadFixture f("tmp", true, tune);
+        f.chunk.enableRead();
+        f.updateLidMap(1000);
+        EXPECT_EQUAL(3u, f.chunk.getNumChunks());
+        const LidInfoWithLidV &lidInfos = f.lidObserver.lidInfos;
+        CollectingBufferVisitor visitor;
+        f.chunk.read(lidInfos.begin(), lidInfos.size(), visitor);
+        std::vector<vespalib::string> expData({getData(1), getData(2), getData(3), getData(4), getData(5)});
+        EXPECT_EQUAL(expData, visitor.visited);
+    }
+}
+
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
+
+vespalib::string
+getJsonData(uint32_t lid)
+{
+    return vespalib::make_string("{\"id\":\"id:ns:music::%u\",\"title\":\"Title number %u\",\"artist\":\"Artist %u\","
+                                 "\"year\":%u,\"genre\":\"%s\"}", lid, lid * 7, lid % 13, 1950 + lid % 70, (lid % 2) ? "rock" : "jazz");
+}
+
+ZStdDictionary::SP
+trainDictionary()
+{
+    vespalib::string samples;
+    std::vector<size_t> sampleSizes;
+    for (uint32_t lid(1000); lid < 2000; lid++) {
+        vespalib::string data = getJsonData(lid);
+        samples += data;
+        sampleSizes.push_back(data.size());
+    }
+    return ZStdDictionary::train(samples.data(), sampleSizes, 4_Ki, 9);
+}
+
+TEST("require that chunks compressed with zstd dictionary can be read back using dictionary from dat file header")
+{
+    ZStdDictionary::SP dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    {
+        WriteFixture f("tmp", 1000, false, CompressionConfig(CompressionConfig::ZSTD), dictionary);
+        f.append(1, getJsonData(1)).append(2, getJsonData(2));
+        f.flush();
+        f.append(3, getJsonData(3));
+        f.flush();
+    }
+    {
+        MMapRandRead datFile(FileChunk::createDatFileName("tmp"), 0, 0);
+        uint64_t datHeaderLen = FileChunk::readDataHeader(datFile);
+        EXPECT_LESS(0u, datHeaderLen);
+        FileChunk::ZStdDictionarySP readDictionary = FileChunk::readDataHeaderDictionary(datFile, datHeaderLen);
+        ASSERT_TRUE(readDictionary);
+        EXPECT_EQUAL(dictionary->getId(), readDictionary->getId());
+    }
+    {
+        ReadFixture f("tmp", true);
+        f.chunk.enableRead();
+        f.updateLidMap(1000);
+        ASSERT_TRUE(f.chunk.getDictionary());
+        EXPECT_EQUAL(dictionary->getId(), f.chunk.getDictionary()->getId());
+        const LidInfoWithLidV &lidInfos = f.lidObserver.lidInfos;
+        CollectingBufferVisitor visitor;
+        f.chunk.read(lidInfos.begin(), lidInfos.size(), visitor);
+        std::vector<vespalib::string> expData({getJsonData(1), getJsonData(2), getJsonData(3)});
+        EXPECT_EQUAL(expData, visitor.visited);
+    }
+}
 
 TEST("require that operator == detects inequality") {
     using C = WriteableFileChunk::Config;
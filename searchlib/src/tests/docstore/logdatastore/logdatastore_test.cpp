@@ -390,6 +390,73 @@ TEST("test visit cache does not cache empty ones and is able to access some back
     EXPECT_EQUAL(1u, visitCache.read({1,3}).getBlobSet().getPositions().size());
 }
 
+TEST("test sharded visit cache invalidates overlapping sets across shards") {
+    const char * A7 = "aAaAaAa";
+    VisitStore store;
+    IDataStore & datastore = store.getStore();
+    for (uint32_t lid = 1; lid <= 6; lid++) {
+        datastore.write(lid, lid, A7, 7);
+    }
+
+    VisitCache visitCache(datastore, 100000, CompressionConfig::Type::LZ4, 4);
+    EXPECT_EQUAL(4u, visitCache.getNumShards());
+    EXPECT_EQUAL(3u, visitCache.read({1,2,3}).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(3u, visitCache.read({2,4,6}).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(3u, visitCache.read({2,4,6}).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(2u, visitCache.read({3,5}).getBlobSet().getPositions().size());
+
+    auto shards = visitCache.getShardStats();
+    ASSERT_EQUAL(4u, shards.size());
+    // {1,2,3} lives in shard 1 and is invalidated by {2,4,6} in shard 2.
+    EXPECT_EQUAL(0u, shards[1].stats.hits);
+    EXPECT_EQUAL(1u, shards[1].stats.invalidations);
+    EXPECT_EQUAL(0u, shards[1].stats.elements);
+    EXPECT_EQUAL(1u, shards[2].stats.hits);
+    EXPECT_EQUAL(1u, shards[2].stats.elements);
+    EXPECT_EQUAL(1u, shards[3].stats.elements);
+    EXPECT_EQUAL(0u, shards[0].stats.elements);
+    for (const auto & shard : shards) {
+        EXPECT_EQUAL(0u, shard.evictions);
+    }
+    EXPECT_EQUAL(2u, visitCache.getCacheStats().elements);
+
+    visitCache.remove(4);
+    EXPECT_EQUAL(0u, visitCache.getShardStats()[2].stats.elements);
+    EXPECT_EQUAL(1u, visitCache.getCacheStats().elements);
+}
+
+TEST("test sharded visit cache counts evictions per shard") {
+    const char * A7 = "aAaAaAa";
+    VisitStore store;
+    IDataStore & datastore = store.getStore();
+    for (uint32_t lid = 1; lid <= 4; lid++) {
+        datastore.write(lid, lid, A7, 7);
+    }
+
+    VisitCache visitCache(datastore, 2, CompressionConfig::Type::LZ4, 2);
+    EXPECT_EQUAL(2u, visitCache.read({1,2}).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(2u, visitCache.read({3,4}).getBlobSet().getPositions().size());
+    EXPECT_EQUAL(1u, visitCache.read({2}).getBlobSet().getPositions().size());
+
+    auto shards = visitCache.getShardStats();
+    ASSERT_EQUAL(2u, shards.size());
+    // {1,2} is evicted by {3,4}, so {2} has no overlapping set left to invalidate.
+    EXPECT_EQUAL(1u, shards[1].evictions);
+    EXPECT_EQUAL(0u, shards[1].stats.invalidations);
+    EXPECT_EQUAL(1u, shards[1].stats.elements);
+    EXPECT_EQUAL(0u, shards[0].evictions);
+    EXPECT_EQUAL(0u, shards[0].stats.invalidations);
+    EXPECT_EQUAL(1u, shards[0].stats.elements);
+
+    visitCache.remove(1);
+    EXPECT_EQUAL(0u, visitCache.getShardStats()[0].stats.invalidations);
+    EXPECT_EQUAL(0u, visitCache.getShardStats()[1].stats.invalidations);
+    visitCache.remove(2);
+    EXPECT_EQUAL(1u, visitCache.getShardStats()[0].stats.invalidations);
+    EXPECT_EQUAL(0u, visitCache.getShardStats()[0].stats.elements);
+    EXPECT_EQUAL(0u, visitCache.getShardStats()[1].stats.invalidations);
+}
+
 using vespalib::string;
 using document::DataType;
 using document::Document;
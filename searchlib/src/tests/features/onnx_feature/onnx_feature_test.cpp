@@ -138,6 +138,42 @@ TEST_F(OnnxFeatureTest, dynamic_onnx_model_can_be_calculated) {
     EXPECT_EQ(get(3), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 89.0));
 }
 
+TEST_F(OnnxFeatureTest, dynamic_onnx_model_can_be_calculated_in_batches) {
+    add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
+    add_expr("attribute_tensor", "tensor<float>(a[4],b[1]):[[5],[6],[7],[8]]");
+    add_expr("bias_tensor", "tensor<float>(a[1],b[2]):[[4,5]]");
+    add_onnx(std::move(OnnxModel("dynamic", dynamic_model).batch_size(4)));
+    compile(onnx_feature("dynamic"));
+    ASSERT_EQ(program.get_batch_executors().size(), 1u);
+    auto &executor = *program.get_batch_executors()[0];
+    EXPECT_EQ(executor.max_batch_size(), 4u);
+    for (uint32_t docid: {1, 2, 3}) {
+        executor.collect(docid);
+    }
+    executor.flush_batch();
+    EXPECT_EQ(get(1), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 79.0));
+    EXPECT_EQ(get(2), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 84.0));
+    EXPECT_EQ(get(3), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 89.0));
+    EXPECT_EQ(get(5), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 99.0));
+    EXPECT_EQ(get(2), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 84.0));
+}
+
+TEST_F(OnnxFeatureTest, batch_with_different_shared_inputs_is_calculated_per_document) {
+    add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
+    add_expr("attribute_tensor", "tensor<float>(a[4],b[1]):[[docid],[6],[7],[8]]");
+    add_expr("bias_tensor", "tensor<float>(a[1],b[2]):[[4,5]]");
+    add_onnx(std::move(OnnxModel("dynamic", dynamic_model).batch_size(4)));
+    compile(onnx_feature("dynamic"));
+    ASSERT_EQ(program.get_batch_executors().size(), 1u);
+    auto &executor = *program.get_batch_executors()[0];
+    for (uint32_t docid: {1, 2}) {
+        executor.collect(docid);
+    }
+    executor.flush_batch();
+    EXPECT_EQ(get(1), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 75.0));
+    EXPECT_EQ(get(2), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 78.0));
+}
+
 TEST_F(OnnxFeatureTest, strange_input_and_output_names_are_normalized) {
     add_expr("input_0", "tensor<float>(a[2]):[10,20]");
     add_expr("input_1", "tensor<float>(a[2]):[5,10]");
@@ -3,7 +3,9 @@
 
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/searchlib/fef/feature_type.h>
+#include <vespa/searchlib/fef/featurenamebuilder.h>
 #include <vespa/searchlib/fef/featurenameparser.h>
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/fef/test/dummy_dependency_handler.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
@@ -68,13 +70,14 @@ struct SetupResult {
     DummyDependencyHandler deps;
     bool setup_ok;
     SetupResult(const TypeMap &object_inputs, const vespalib::string &expression,
-                const vespalib::string &expression_name = "");
+                const vespalib::string &expression_name = "", bool share_subexpressions = true);
     ~SetupResult();
 };
 
 SetupResult::SetupResult(const TypeMap &object_inputs,
                          const vespalib::string &expression,
-                         const vespalib::string &expression_name)
+                         const vespalib::string &expression_name,
+                         bool share_subexpressions)
     : stash(), index_env(), query_env(&index_env), rank(make_replacer()), deps(rank), setup_ok(false)
 {
     rank.setName("self");
@@ -82,6 +85,9 @@ SetupResult::SetupResult(const TypeMap &object_inputs,
         deps.define_object_input(input.first, ValueType::from_spec(input.second));
     }
     std::vector<vespalib::string> params;
+    if (share_subexpressions) {
+        index_env.getProperties().add(indexproperties::eval::ShareSubexpressions::NAME, "true");
+    }
     if (expression_name.empty()) {
         index_env.getProperties().add("self.rankingScript", expression);
     } else {
@@ -123,6 +129,21 @@ void verify_input_count(const vespalib::string &expression, size_t expect) {
     EXPECT_EQUAL(result.deps.input.size(), expect);
 }
 
+void verify_inputs(const TypeMap &object_inputs, const vespalib::string &expression,
+                   const std::vector<vespalib::string> &expect, bool share_subexpressions = true)
+{
+    SetupResult result(object_inputs, expression, "", share_subexpressions);
+    EXPECT_TRUE(result.setup_ok);
+    ASSERT_EQUAL(result.deps.input.size(), expect.size());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_EQUAL(result.deps.input[i], expect[i]);
+    }
+}
+
+vespalib::string shared(const vespalib::string &subexpression) {
+    return FeatureNameBuilder().baseName("rankingExpression").parameter(subexpression).buildName();
+}
+
 TEST("require that expression with only number inputs produce number output (compiled)") {
     TEST_DO(verify_output_type({}, "a*b", FeatureType::number()));
 }
@@ -169,6 +190,32 @@ TEST("require that replaced expressions override result type") {
                                FeatureType::number()));
 }
 
+const TypeMap vectors = {{"a", "tensor(x[3])"}, {"b", "tensor(x[3])"}};
+
+TEST("require that nested full reductions are calculated by separate features") {
+    TEST_DO(verify_inputs(vectors, "x+reduce(a*b,sum)", {"x", shared("reduce((a*b),sum)")}));
+    TEST_DO(verify_inputs(vectors, "reduce(a*b,sum)+reduce(a*b,max,x)", {shared("reduce((a*b),sum)"), "a", "b"}));
+    TEST_DO(verify_inputs(vectors, "max(reduce(a*reduce(b,max),sum),1.5)", {shared("reduce((a*reduce(b,max)),sum)")}));
+}
+
+TEST("require that nested full reductions are not matched inside an earlier tensor lambda") {
+    TEST_DO(verify_inputs(vectors, "reduce(tensor(x[2])(x+reduce(a*b,sum)),max,x)+reduce(a*b,sum)",
+                          {"a", "b", shared("reduce((a*b),sum)")}));
+}
+
+TEST("require that identical subexpressions are calculated by the same feature") {
+    TEST_DO(verify_inputs(vectors, "reduce(a*b,sum)+reduce(a * b,sum)*2", {shared("reduce((a*b),sum)")}));
+}
+
+TEST("require that the expression itself is not calculated by a separate feature") {
+    TEST_DO(verify_inputs(vectors, "reduce(a*reduce(b,sum),sum)", {"a", shared("reduce(b,sum)")}));
+    TEST_DO(verify_inputs(vectors, "reduce(a*b,sum)", {"a", "b"}));
+}
+
+TEST("require that subexpression sharing is disabled by default") {
+    TEST_DO(verify_inputs(vectors, "x+reduce(a*b,sum)", {"x", "a", "b"}, false));
+}
+
 TEST_F("require that replaced expressions create the appropriate executor", SetupResult({}, "foo")) {
     EXPECT_TRUE(f1.setup_ok);
     FeatureExecutor &executor = f1.rank.createExecutor(f1.query_env, f1.stash);
@@ -311,6 +311,14 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        { // vespa.matching.work_stealing
+            EXPECT_EQUAL(matching::WorkStealing::NAME, vespalib::string("vespa.matching.work_stealing"));
+            EXPECT_EQUAL(matching::WorkStealing::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), false);
+            p.add("vespa.matching.work_stealing", "true");
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), true);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -395,6 +395,30 @@ TEST_F("require that fast-forest gbdt evaluation is pure", Fixture()) {
     EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
 }
 
+const vespalib::string docid_tree_expr = "if(docid<2,1,2)+if(docid<3,10,20)";
+
+TEST_F("require that fast-forest gbdt evaluation can be batched", Fixture()) {
+    f1.use_fast_forest().add_expr("rank", docid_tree_expr).compile();
+    EXPECT_EQUAL(1u, f1.program.get_batch_executors().size());
+    FeatureExecutor *executor = f1.program.get_batch_seed_executor();
+    ASSERT_TRUE(executor != nullptr);
+    EXPECT_TRUE(executor->max_batch_size() > 1u);
+    for (uint32_t docid: {1, 2, 3}) {
+        executor->collect(docid);
+    }
+    executor->flush_batch();
+    EXPECT_EQUAL(f1.get(1), 11.0);
+    EXPECT_EQUAL(f1.get(2), 12.0);
+    EXPECT_EQUAL(f1.get(3), 22.0);
+    EXPECT_EQUAL(f1.get(4), 22.0);
+}
+
+TEST_F("require that constant fast-forest gbdt evaluation is not batched", Fixture()) {
+    f1.use_fast_forest().add_expr("rank", tree_expr).compile();
+    EXPECT_EQUAL(0u, f1.program.get_batch_executors().size());
+    EXPECT_TRUE(f1.program.get_batch_seed_executor() == nullptr);
+}
+
 TEST_F("require that rank program can be profiled", Fixture()) {
     ExecutionProfiler profiler(64);
     f1.add("mysum(value(10),ivalue(5))").compile(&profiler);
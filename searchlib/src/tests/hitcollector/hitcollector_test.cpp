@@ -549,4 +549,48 @@ TEST("require that hits can be added out of order only after passing array limit
     TEST_DO(checkResult(*rs, nullptr));
 }
 
+void checkSameResult(ResultSet & actual, ResultSet & expect)
+{
+    ASSERT_EQUAL(expect.getArrayUsed(), actual.getArrayUsed());
+    for (uint32_t i = 0; i < expect.getArrayUsed(); ++i) {
+        EXPECT_EQUAL(expect.getArray()[i].getDocId(), actual.getArray()[i].getDocId());
+        EXPECT_EQUAL(expect.getArray()[i].getRank(), actual.getArray()[i].getRank());
+    }
+    TEST_DO(checkResult(actual, expect.getBitOverflow()));
+}
+
+void testAddHits(uint32_t numDocs, uint32_t maxHitsSize, size_t batchSize, bool ascending)
+{
+    std::vector<uint32_t> docIds;
+    std::vector<feature_t> scores;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        docIds.push_back(ascending ? i : ((i * 7919) % numDocs));
+        scores.push_back((docIds.back() * 31) % 97);
+    }
+    HitCollector expect(numDocs, maxHitsSize);
+    HitCollector actual(numDocs, maxHitsSize);
+    for (size_t i = 0; i < docIds.size(); ++i) {
+        expect.addHit(docIds[i], scores[i]);
+    }
+    for (size_t i = 0; i < docIds.size(); i += batchSize) {
+        actual.addHits(docIds.data() + i, scores.data() + i, std::min(batchSize, docIds.size() - i));
+    }
+    auto expect_rs = expect.getResultSet();
+    auto actual_rs = actual.getResultSet();
+    TEST_DO(checkSameResult(*actual_rs, *expect_rs));
+}
+
+TEST("require that adding hits in batches gives the same result as adding them one by one") {
+    for (uint32_t numDocs : {1000u, 5003u}) {
+        // hit vector only, docid vector and bitvector
+        for (uint32_t maxHitsSize : {numDocs, 100u, 20u}) {
+            for (size_t batchSize : {1, 7, 8, 64, 10000}) {
+                for (bool ascending : {true, false}) {
+                    TEST_DO(testAddHits(numDocs, maxHitsSize, batchSize, ascending));
+                }
+            }
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -688,4 +688,40 @@ TEST("verify search iterator conformance") {
     }
 }
 
+TEST("require that block max skipping over attribute posting lists gives the same hits as regular wand") {
+    constexpr uint32_t doc_id_limit = 10000;
+    DocumentWeightAttributeHelper helper;
+    helper.add_docs(doc_id_limit);
+    std::vector<int32_t> doc_weights(doc_id_limit);
+    for (uint32_t docid = 1; docid < doc_id_limit; ++docid) {
+        doc_weights[docid] = (docid % 997 == 0) ? 1000 : (docid % 13);
+        helper.set_doc(docid, docid % 2, doc_weights[docid]);
+    }
+    std::vector<int32_t> weights = {1, 2};
+    std::vector<IDocumentWeightAttribute::LookupResult> dict_entries;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        dict_entries.push_back(helper.dwa().lookup(vespalib::make_string("%zu", i).c_str(), helper.dwa().get_dictionary_snapshot()));
+    }
+    score_t threshold = 500;
+    SimpleResult expect;
+    for (uint32_t docid = 1; docid < doc_id_limit; ++docid) {
+        if (weights[docid % 2] * score_t(doc_weights[docid]) > threshold) {
+            expect.addHit(docid);
+        }
+    }
+    EXPECT_EQUAL(10u, expect.getHitCount());
+    for (bool use_dwa: {false, true}) {
+        for (bool strict: {false, true}) {
+            DummyHeap heap;
+            TermFieldMatchData tfmd;
+            MatchParams match_params(heap, threshold, 1.0, 1);
+            match_params.setDocIdLimit(doc_id_limit);
+            auto search = create_wand(use_dwa, tfmd, match_params, weights, dict_entries, helper.dwa(), strict);
+            SimpleResult actual;
+            actual.search(*search, doc_id_limit);
+            EXPECT_EQUAL(expect, actual);
+        }
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
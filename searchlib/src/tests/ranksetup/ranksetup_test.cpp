@@ -247,6 +247,7 @@ private:
 
     void checkFeatures(std::map<vespalib::string, feature_t> &exp, std::map<vespalib::string, feature_t> &actual);
     void testFeatureNormalization();
+    void testSharedSubexpressions();
 
 public:
     RankSetupTest();
@@ -919,6 +920,46 @@ RankSetupTest::testFeatureNormalization()
     }
 }
 
+void
+RankSetupTest::testSharedSubexpressions()
+{
+    vespalib::string dot = "reduce(concat(value(2),value(3),x),sum)";
+    vespalib::string e1 = FNB().baseName("rankingExpression").parameter(dot + "+1").buildName();
+    vespalib::string e2 = FNB().baseName("rankingExpression").parameter(dot + "*2").buildName();
+    IndexEnvironment sharedEnv;
+    sharedEnv.getProperties().add(indexproperties::eval::ShareSubexpressions::NAME, "true");
+    { // subexpression shared between expressions
+        RankSetup rs(_factory, sharedEnv);
+        rs.addSummaryFeature(e1);
+        rs.addSummaryFeature(e2);
+        EXPECT_TRUE(rs.compile());
+        EXPECT_EQUAL(rs.num_reused_expressions(), 1u);
+    }
+    { // subexpression sharing is disabled by default
+        RankSetup rs(_factory, _indexEnv);
+        rs.addSummaryFeature(e1);
+        rs.addSummaryFeature(e2);
+        EXPECT_TRUE(rs.compile());
+        EXPECT_EQUAL(rs.num_reused_expressions(), 0u);
+    }
+    { // reuse of functions is not counted
+        IndexEnvironment indexEnv;
+        indexEnv.getProperties().add(indexproperties::eval::ShareSubexpressions::NAME, "true");
+        indexEnv.getProperties().add("rankingExpression(foo).rankingScript", "value(2)+1");
+        RankSetup rs(_factory, indexEnv);
+        rs.addSummaryFeature(FNB().baseName("rankingExpression").parameter("rankingExpression(foo)+1").buildName());
+        rs.addSummaryFeature(FNB().baseName("rankingExpression").parameter("rankingExpression(foo)*2").buildName());
+        EXPECT_TRUE(rs.compile());
+        EXPECT_EQUAL(rs.num_reused_expressions(), 0u);
+    }
+    { // subexpressions are calculated correctly
+        vespalib::string e3 = FNB().baseName("rankingExpression").parameter(dot + "*" + dot + "+1").buildName();
+        QueryEnvironment queryEnv(&sharedEnv);
+        RankEnvironment rankEnv(_factory, sharedEnv, queryEnv);
+        EXPECT_TRUE(testExecution(rankEnv, e1, 6.0f, e3, 26.0f));
+    }
+}
+
 
 RankSetupTest::RankSetupTest() :
     _factory(),
@@ -977,6 +1018,7 @@ RankSetupTest::Main()
     testExecution();
     testFeatureDump();
     testFeatureNormalization();
+    testSharedSubexpressions();
 
     TEST_DONE();
 }
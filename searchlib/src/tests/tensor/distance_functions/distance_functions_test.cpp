@@ -11,6 +11,7 @@
 LOG_SETUP("distance_function_test");
 
 using namespace search::tensor;
+using vespalib::BFloat16;
 using vespalib::eval::Int8Float;
 using vespalib::eval::TypedCells;
 using search::attribute::DistanceMetric;
@@ -89,6 +90,61 @@ TEST(DistanceFunctionsTest, euclidean_int8_smoketest)
     EXPECT_DOUBLE_EQ(12.0, euclid->calc(t(p1), t(p7)));
     EXPECT_DOUBLE_EQ(14.0, euclid->calc(t(p5), t(p7)));
 
+    auto angular = make_distance_function(DistanceMetric::Angular, ct);
+    EXPECT_EQ(ct, angular->expected_cell_type());
+    EXPECT_DOUBLE_EQ(1.0, angular->calc(t(p1), t(p5)));
+    EXPECT_DOUBLE_EQ(4.0/3.0, angular->calc(t(p1), t(p7)));
+}
+
+template <typename T>
+void verify_euclidean_with_limit(const DistanceFunction &euclid)
+{
+    std::vector<T> zeros(1000, T(0.0));
+    std::vector<T> ones(1000, T(1.0));
+    EXPECT_DOUBLE_EQ(1000.0, euclid.calc(t(zeros), t(ones)));
+    EXPECT_DOUBLE_EQ(1000.0, euclid.calc_with_limit(t(zeros), t(ones), 1000.0));
+    double partial = euclid.calc_with_limit(t(zeros), t(ones), 100.0);
+    EXPECT_GT(partial, 100.0);
+    EXPECT_LT(partial, 1000.0);
+}
+
+TEST(DistanceFunctionsTest, euclidean_with_limit_stops_early)
+{
+    using vespalib::eval::CellType;
+    verify_euclidean_with_limit<double>(*make_distance_function(DistanceMetric::Euclidean, CellType::DOUBLE));
+    verify_euclidean_with_limit<float>(*make_distance_function(DistanceMetric::Euclidean, CellType::FLOAT));
+    verify_euclidean_with_limit<BFloat16>(*make_distance_function(DistanceMetric::Euclidean, CellType::BFLOAT16));
+    verify_euclidean_with_limit<Int8Float>(*make_distance_function(DistanceMetric::Euclidean, CellType::INT8));
+    verify_euclidean_with_limit<double>(SquaredEuclideanDistance(CellType::DOUBLE));
+}
+
+TEST(DistanceFunctionsTest, bfloat16_smoketest)
+{
+    auto ct = vespalib::eval::CellType::BFLOAT16;
+
+    auto euclid = make_distance_function(DistanceMetric::Euclidean, ct);
+    auto angular = make_distance_function(DistanceMetric::Angular, ct);
+    auto innerproduct = make_distance_function(DistanceMetric::InnerProduct, ct);
+    EXPECT_EQ(ct, euclid->expected_cell_type());
+    EXPECT_EQ(ct, angular->expected_cell_type());
+    EXPECT_EQ(ct, innerproduct->expected_cell_type());
+
+    std::vector<BFloat16> p0{0.0, 0.0, 0.0};
+    std::vector<BFloat16> p1{1.0, 0.0, 0.0};
+    std::vector<BFloat16> p2{0.0, 1.0, 0.0};
+    std::vector<BFloat16> p7{-1.0, 2.0, -2.0};
+
+    EXPECT_DOUBLE_EQ(1.0, euclid->calc(t(p0), t(p1)));
+    EXPECT_DOUBLE_EQ(2.0, euclid->calc(t(p1), t(p2)));
+    EXPECT_DOUBLE_EQ(12.0, euclid->calc(t(p1), t(p7)));
+    EXPECT_DOUBLE_EQ(12.0, euclid->calc_with_limit(t(p1), t(p7), 100.0));
+
+    EXPECT_DOUBLE_EQ(1.0, angular->calc(t(p1), t(p2)));
+    EXPECT_DOUBLE_EQ(0.0, angular->calc(t(p1), t(p1)));
+    EXPECT_DOUBLE_EQ(4.0/3.0, angular->calc(t(p1), t(p7)));
+
+    EXPECT_DOUBLE_EQ(0.0, innerproduct->calc(t(p1), t(p1)));
+    EXPECT_DOUBLE_EQ(1.0, innerproduct->calc(t(p1), t(p2)));
 }
 
 TEST(DistanceFunctionsTest, angular_gives_expected_score)
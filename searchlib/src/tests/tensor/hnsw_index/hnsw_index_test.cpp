@@ -6,12 +6,16 @@
 #include <vespa/searchlib/tensor/hnsw_index.h>
 #include <vespa/searchlib/tensor/random_level_generator.h>
 #include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/searchlib/tensor/quantized_vector_store.h>
 #include <vespa/searchlib/queryeval/global_filter.h>
 #include <vespa/vespalib/datastore/compaction_spec.h>
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <cmath>
+#include <random>
 #include <vector>
 
 #include <vespa/log/log.h>
@@ -654,6 +658,147 @@ TEST_F(HnswIndexTest, hnsw_graph_is_compacted)
     EXPECT_LT(mem_3.usedBytes(), mem_2.usedBytes());
 }
 
+namespace {
+
+HnswIndexUP
+make_index_using_add_documents(const FloatVectors& vectors, const std::vector<uint32_t>& docids,
+                               vespalib::ThreadBundle& thread_bundle)
+{
+    auto index = std::make_unique<HnswIndex>(vectors, std::make_unique<SquaredEuclideanDistance>(vespalib::eval::CellType::FLOAT),
+                                             std::make_unique<InvLogLevelGenerator>(8),
+                                             HnswIndex::Config(16, 8, 50, 0, true));
+    index->add_documents(docids, thread_bundle);
+    return index;
+}
+
+}
+
+TEST_F(HnswIndexTest, add_documents_gives_same_graph_independent_of_thread_bundle_size)
+{
+    get_vectors().clear();
+    std::vector<uint32_t> docids;
+    uint32_t doc_id = 1;
+    for (uint32_t x = 0; x < 50; ++x) {
+        for (uint32_t y = 0; y < 40; ++y) {
+            get_vectors().set(doc_id, { float(x), float(y) });
+            docids.push_back(doc_id);
+            ++doc_id;
+        }
+    }
+    vespalib::SimpleThreadBundle thread_bundle(4);
+    auto single_threaded = make_index_using_add_documents(get_vectors(), docids, vespalib::ThreadBundle::trivial());
+    auto multi_threaded = make_index_using_add_documents(get_vectors(), docids, thread_bundle);
+    auto link_graph = make_link_graph(*multi_threaded);
+    EXPECT_EQ(make_link_graph(*single_threaded), link_graph);
+    EXPECT_TRUE(multi_threaded->check_link_symmetry());
+    for (uint32_t docid : docids) {
+        EXPECT_FALSE(link_graph[docid].empty());
+        EXPECT_FALSE(link_graph[docid][0].empty());
+    }
+}
+
+TEST_F(HnswIndexTest, quantized_vectors_are_used_for_search_and_results_are_reranked)
+{
+    get_vectors().clear();
+    uint32_t doc_id = 1;
+    for (uint32_t x = 0; x < 30; ++x) {
+        for (uint32_t y = 0; y < 30; ++y) {
+            get_vectors().set(doc_id, { float(x), float(y) });
+            ++doc_id;
+        }
+    }
+    uint32_t doc_id_end = doc_id;
+    auto generator = std::make_unique<LevelGenerator>();
+    level_generator = generator.get();
+    auto quantized_vectors = std::make_unique<QuantizedVectorStore>(2, search::attribute::DistanceMetric::Euclidean);
+    index = std::make_unique<HnswIndex>(vectors, std::make_unique<SquaredEuclideanDistance>(vespalib::eval::CellType::FLOAT),
+                                        std::move(generator),
+                                        HnswIndex::Config(10, 5, 20, 100, true),
+                                        std::move(quantized_vectors));
+    for (doc_id = 1; doc_id < 100; ++doc_id) {
+        add_document(doc_id);
+    }
+    EXPECT_FALSE(index->get_quantized_vectors()->is_trained());
+    for (; doc_id < doc_id_end; ++doc_id) {
+        add_document(doc_id);
+    }
+    EXPECT_TRUE(index->get_quantized_vectors()->is_trained());
+    std::vector<float> query = { 10.2, 20.1 };
+    vespalib::eval::TypedCells qv(vespalib::ConstArrayRef<float>(query.data(), query.size()));
+    auto result = index->find_top_k(4, qv, 50, 10000.0);
+    ASSERT_EQ(4, result.size());
+    // Distances are calculated using the full precision vectors.
+    std::vector<double> exp_distances = { 0.04 + 0.01, 0.64 + 0.01, 0.04 + 0.81, 0.64 + 0.81 };
+    std::vector<double> act_distances;
+    for (const auto& hit : result) {
+        act_distances.push_back(hit.distance);
+    }
+    std::sort(act_distances.begin(), act_distances.end());
+    for (size_t i = 0; i < exp_distances.size(); ++i) {
+        EXPECT_NEAR(exp_distances[i], act_distances[i], 1e-5);
+    }
+    remove_document(1);
+    commit();
+    EXPECT_GT(index->get_quantized_vectors()->memory_usage().usedBytes(), 0u);
+}
+
+TEST_F(HnswIndexTest, quantized_inner_product_search_has_good_recall)
+{
+    constexpr uint32_t num_docs = 1000;
+    constexpr uint32_t num_queries = 20;
+    constexpr uint32_t k = 10;
+    std::mt19937 gen(42);
+    std::normal_distribution<float> dist;
+    auto make_unit_vector = [&]() {
+        std::vector<float> vec(4);
+        float sum_sq = 0.0;
+        for (float& cell : vec) {
+            cell = dist(gen);
+            sum_sq += cell * cell;
+        }
+        for (float& cell : vec) {
+            cell /= std::sqrt(sum_sq);
+        }
+        return vec;
+    };
+    get_vectors().clear();
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        get_vectors().set(docid, make_unit_vector());
+    }
+    auto generator = std::make_unique<LevelGenerator>();
+    level_generator = generator.get();
+    auto quantized_vectors = std::make_unique<QuantizedVectorStore>(4, search::attribute::DistanceMetric::InnerProduct);
+    index = std::make_unique<HnswIndex>(vectors, std::make_unique<InnerProductDistanceHW<float>>(),
+                                        std::move(generator),
+                                        HnswIndex::Config(20, 10, 50, 100, true),
+                                        std::move(quantized_vectors));
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        add_document(docid);
+    }
+    ASSERT_TRUE(index->get_quantized_vectors()->is_trained());
+    InnerProductDistanceHW<float> full_precision;
+    uint32_t found = 0;
+    for (uint32_t i = 0; i < num_queries; ++i) {
+        auto query = make_unit_vector();
+        vespalib::eval::TypedCells qv(vespalib::ConstArrayRef<float>(query.data(), query.size()));
+        std::vector<std::pair<double, uint32_t>> exact;
+        for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+            exact.emplace_back(full_precision.calc(qv, get_vectors().get_vector(docid)), docid);
+        }
+        std::sort(exact.begin(), exact.end());
+        auto result = index->find_top_k(k, qv, 100, 10000.0);
+        for (uint32_t j = 0; j < k; ++j) {
+            for (const auto& hit : result) {
+                if (hit.docid == exact[j].second) {
+                    ++found;
+                }
+            }
+        }
+    }
+    double recall = double(found) / (num_queries * k);
+    EXPECT_GE(recall, 0.9);
+}
+
 TEST(LevelGeneratorTest, gives_various_levels)
 {
     InvLogLevelGenerator generator(4);
@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchlib/transactionlog/translogclient.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/searchlib/transactionlog/group_committer.h>
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/objects/identifiable.h>
@@ -913,6 +914,42 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("test group commit across domains") {
+    const unsigned int NUM_PACKETS = 10;
+    const unsigned int NUM_ENTRIES = 20;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test_group_commit");
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext,
+             createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupCommit(true));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+    ASSERT_TRUE(tlss.tls.getGroupCommitter() != nullptr);
+
+    createDomainTest(tls, "gc1", 0);
+    createDomainTest(tls, "gc2", 1);
+    {
+        vespalib::Gate gate;
+        auto onDone = std::make_shared<vespalib::GateCallback>(gate);
+        fillDomainTest(onDone, tlss.tls, "gc1", NUM_PACKETS, NUM_ENTRIES);
+        fillDomainTest(onDone, tlss.tls, "gc2", NUM_PACKETS, NUM_ENTRIES);
+        onDone.reset();
+        gate.await();
+    }
+    auto stats = tlss.tls.getGroupCommitter()->getStats();
+    EXPECT_EQUAL(2 * NUM_PACKETS, stats.chunks);
+    EXPECT_LESS_EQUAL(stats.rounds, stats.chunks);
+    EXPECT_LESS_EQUAL(stats.syncs, stats.chunks);
+    EXPECT_LESS_EQUAL(stats.max_round_chunks, stats.chunks);
+    for (const char * name : {"gc1", "gc2"}) {
+        auto s1 = openDomainTest(tls, name);
+        TEST_DO(checkFilledDomainTest(*s1, TOTAL_NUM_ENTRIES));
+        SerialNum syncedTo(0);
+        EXPECT_TRUE(s1->sync(TOTAL_NUM_ENTRIES, syncedTo));
+        EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+    }
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
@@ -38,6 +38,16 @@ public:
         return _children[ref].getData();
     }
 
+    // max weight within the posting list block (btree leaf) containing the current docid
+    int32_t get_block_max_weight(uint16_t ref) const {
+        return _children[ref].getLeafAggregated().getMax();
+    }
+
+    // last docid within the posting list block (btree leaf) containing the current docid
+    uint32_t get_block_last_docid(uint16_t ref) const {
+        return _children[ref].getLeafLastKey();
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
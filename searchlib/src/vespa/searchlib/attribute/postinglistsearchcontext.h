@@ -62,6 +62,18 @@ protected:
         return true;
     }
 
+    /*
+     * Check if the dictionary entry at the iterator should be used. If not,
+     * the iterator is advanced to the next entry that might be used.
+     */
+    virtual bool use_dictionary_entry(DictionaryConstIterator & it) const {
+        if (useThis(it)) {
+            return true;
+        }
+        ++it;
+        return false;
+    }
+
     float calculateFilteringCost() const {
         // filtering search time (ms) ~ FSTC * numValues; (FSTC =
         // Filtering Search Time Constant)
@@ -183,6 +195,7 @@ private:
     using RegexpUtil = vespalib::RegexpUtil;
     using Parent::_enumStore;
     bool useThis(const PostingListSearchContext::DictionaryConstIterator & it) const override;
+    bool use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator & it) const override;
 public:
     StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
 };
@@ -306,6 +319,32 @@ StringPostingSearchContext<BaseSC, AttrT, DataT>::useThis(const PostingListSearc
     return true;
 }
 
+template <typename BaseSC, typename AttrT, typename DataT>
+bool
+StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator & it) const {
+    // The dictionary is ordered by folded values, thus only uncased fuzzy matching can skip ahead to the successor.
+    if (this->isFuzzy() && !this->isCased() && this->getFuzzyMatcher().supportsSuccessor()) {
+        vespalib::string successor;
+        if (this->getFuzzyMatcher().isMatch(_enumStore.get_value(it.getKey().load_acquire()), successor)) {
+            return true;
+        }
+        if (successor.empty()) {
+            it = this->_upperDictItr;
+            return false;
+        }
+        auto comp = _enumStore.make_folded_comparator(successor.c_str());
+        if (this->_upperDictItr.valid() &&
+            !comp.less(vespalib::datastore::EntryRef(), this->_upperDictItr.getKey().load_acquire()))
+        {
+            it = this->_upperDictItr;
+        } else {
+            it.seek(vespalib::datastore::AtomicEntryRef(), comp);
+        }
+        return false;
+    }
+    return PostingListSearchContext::use_dictionary_entry(it);
+}
+
 template <typename BaseSC, typename AttrT, typename DataT>
 NumericPostingSearchContext<BaseSC, AttrT, DataT>::
 NumericPostingSearchContext(BaseSC&& base_sc, const Params & params_in, const AttrT &toBeSearched)
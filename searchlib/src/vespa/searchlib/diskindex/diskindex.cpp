@@ -108,16 +108,16 @@ DiskIndex::openField(const vespalib::string &fieldDir,
         if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
             fileHeader.getFormats().size() == 2 &&
-            fileHeader.getFormats()[0] ==
-            DiskPostingFileDynamicKReal::getIdentifier() &&
+            (fileHeader.getFormats()[0] == DiskPostingFileDynamicKReal::getIdentifier(false) ||
+             fileHeader.getFormats()[0] == DiskPostingFileDynamicKReal::getIdentifier(true)) &&
             fileHeader.getFormats()[1] ==
             DiskPostingFileDynamicKReal::getSubIdentifier()) {
             dynamicK = true;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
-                   fileHeader.getFormats()[0] ==
-                   DiskPostingFileReal::getIdentifier() &&
+                   (fileHeader.getFormats()[0] == DiskPostingFileReal::getIdentifier(false) ||
+                    fileHeader.getFormats()[0] == DiskPostingFileReal::getIdentifier(true)) &&
                    fileHeader.getFormats()[1] ==
                    DiskPostingFileReal::getSubIdentifier()) {
             dynamicK = false;
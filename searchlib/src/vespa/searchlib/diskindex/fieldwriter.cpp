@@ -39,6 +39,7 @@ FieldWriter::open(const vespalib::string &prefix,
                   uint32_t minChunkDocs,
                   bool dynamicKPosOccFormat,
                   bool encode_interleaved_features,
+                  bool block_doc_ids,
                   const Schema &schema,
                   const uint32_t indexId,
                   const FieldLengthInfo &field_length_info,
@@ -65,6 +66,9 @@ FieldWriter::open(const vespalib::string &prefix,
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
     }
+    if (block_doc_ids) {
+        params.set("block_doc_ids", block_doc_ids);
+    }
     
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
     _dictFile->setParams(countParams);
@@ -106,7 +106,7 @@ FileHandle::open(vespalib::stringref dir,
     _fieldWriter = std::make_shared<FieldWriter>(docIdLimit, numWordIds);
 
     if (!_fieldWriter->open(dir + "/", 64, 262144u, false,
-                            index.use_interleaved_features(),
+                            index.use_interleaved_features(), false,
                             index.getSchema(), index.getIndex(),
                             field_length_info,
                             tuneFileWrite, fileHeaderContext)) {
@@ -7,7 +7,8 @@
 namespace search::diskindex {
 
 /*
- * Class used to read posting lists of type "Zc.4" and "Zc.5" (dynamic k).
+ * Class used to read posting lists of type "Zc.4" and "Zc.5" (dynamic k),
+ * and their block packed document id variants "Zc.4.block" and "Zc.5.block".
  *
  * Common words have docid deltas and skip info separate from
  * features. If "cheap" features are enabled then they are interleaved
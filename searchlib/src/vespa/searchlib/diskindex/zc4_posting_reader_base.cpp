@@ -3,6 +3,7 @@
 #include "zc4_posting_reader_base.h"
 #include "zc4_posting_header.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
+#include <algorithm>
 
 namespace search::diskindex {
 
@@ -175,6 +176,96 @@ Zc4PostingReaderBase::L4Skip::check(const L3Skip &l3_skip, bool decode_features)
     assert(_l3_skip_pos == l3_skip.get_l3_skip_pos());
 }
 
+Zc4PostingReaderBase::DocIdBlocks::DocIdBlocks()
+    : _headers(),
+      _packed(),
+      _block_pos(0),
+      _block_docs(0),
+      _residue(0),
+      _features_pos(0)
+{
+}
+
+Zc4PostingReaderBase::DocIdBlocks::~DocIdBlocks() = default;
+
+void
+Zc4PostingReaderBase::DocIdBlocks::setup(DecodeContext &decode_context, uint32_t headers_size, uint32_t packed_size, uint32_t num_docs)
+{
+    _headers.clearReserve(headers_size);
+    decode_context.readBytes(_headers._valI, headers_size);
+    _headers._valE = _headers._valI + headers_size;
+    _packed.clearReserve(packed_size);
+    if (packed_size != 0) {
+        decode_context.readBytes(_packed._valI, packed_size);
+    }
+    _packed._valE = _packed._valI + packed_size;
+    _block_pos = 0;
+    _block_docs = 0;
+    _residue = num_docs;
+    _features_pos = 0;
+}
+
+void
+Zc4PostingReaderBase::DocIdBlocks::unpack(uint32_t bits, uint32_t *values)
+{
+    assert(bits <= ZcBlockCodec::max_bits);
+    size_t packed_size = ZcBlockCodec::packed_size(bits);
+    assert(_packed._valI + packed_size <= _packed._valE);
+    ZcBlockCodec::unpack(_packed._valI, bits, values);
+    _packed._valI += packed_size;
+}
+
+void
+Zc4PostingReaderBase::DocIdBlocks::read_block(uint32_t prev_doc_id, uint64_t features_pos, bool decode_features, bool decode_interleaved_features)
+{
+    assert(_residue > 0);
+    assert(_headers._valI < _headers._valE);
+    uint32_t last_doc_id = prev_doc_id + _headers.decode() + 1;
+    _block_pos = 0;
+    _block_docs = std::min(ZcBlockCodec::block_size, _residue);
+    _residue -= _block_docs;
+    unpack(_headers.decode(), _doc_ids);
+    uint32_t doc_id = prev_doc_id;
+    for (uint32_t i = 0; i < _block_docs; ++i) {
+        doc_id += _doc_ids[i] + 1;
+        _doc_ids[i] = doc_id;
+    }
+    assert(doc_id == last_doc_id);
+    if (decode_interleaved_features) {
+        uint32_t field_length_bits = _headers.decode();
+        uint32_t num_occs_bits = _headers.decode();
+        unpack(field_length_bits, _field_lengths);
+        unpack(num_occs_bits, _num_occs);
+    }
+    if (decode_features) {
+        assert(features_pos == _features_pos);
+        _features_pos += _headers.decode();
+    }
+}
+
+void
+Zc4PostingReaderBase::DocIdBlocks::read(NoSkip &no_skip, uint64_t features_pos, bool decode_features, bool decode_interleaved_features)
+{
+    if (_block_pos == _block_docs) {
+        read_block(no_skip.get_doc_id(), features_pos, decode_features, decode_interleaved_features);
+    }
+    no_skip.set_doc_id(_doc_ids[_block_pos]);
+    if (decode_interleaved_features) {
+        no_skip.set_field_length(_field_lengths[_block_pos] + 1);
+        no_skip.set_num_occs(_num_occs[_block_pos] + 1);
+    }
+    ++_block_pos;
+}
+
+void
+Zc4PostingReaderBase::DocIdBlocks::check_end()
+{
+    assert(_residue == 0);
+    assert(_block_pos == _block_docs);
+    assert(_headers._valI == _headers._valE);
+    assert(_packed._valI == _packed._valE);
+}
+
 Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
     : _doc_id_k(K_VALUE_ZCPOSTING_DELTA_DOCID),
       _num_docs(0),
@@ -187,6 +278,7 @@ Zc4PostingReaderBase::Zc4PostingReaderBase(bool dynamic_k)
       _l2_skip(),
       _l3_skip(),
       _l4_skip(),
+      _doc_id_blocks(),
       _chunkNo(0),
       _features_size(0),
       _counts(),
@@ -201,6 +293,16 @@ Zc4PostingReaderBase::~Zc4PostingReaderBase()
 void
 Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_context)
 {
+    if (_posting_params._block_doc_ids) {
+        _doc_id_blocks.read(_no_skip, decode_context.getReadOffset(), _posting_params._encode_features, _posting_params._encode_interleaved_features);
+        if (_residue == 1) {
+            assert(_no_skip.get_doc_id() == _last_doc_id);
+            _doc_id_blocks.check_end();
+        } else {
+            assert(_no_skip.get_doc_id() < _last_doc_id);
+        }
+        return;
+    }
     // Split docid & features.
     if (_no_skip.get_doc_id() >= _l1_skip.get_doc_id()) {
         _no_skip.set_features_pos(decode_context.getReadOffset());
@@ -247,6 +349,17 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
         assert(_num_docs >= _posting_params._min_skip_docs);
         assert(_num_docs == _counts._numDocs);
     }
+    if (_posting_params._block_doc_ids) {
+        // Block headers are stored as docid deltas and packed blocks as L1 skip info
+        assert(header._l2_skip_size == 0);
+        _doc_id_blocks.setup(decode_context, header._doc_ids_size, header._l1_skip_size, _num_docs);
+        if (_has_more || has_more) {
+            assert(_last_doc_id == _counts._segments[_chunkNo]._lastDoc);
+        }
+        _doc_id_blocks.set_features_pos(decode_context.getReadOffset());
+        _has_more = has_more;
+        return;
+    }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
     _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
     _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "zc4_posting_params.h"
+#include "zc_block_codec.h"
 #include "zcbuf.h"
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/index/postinglistcounts.h>
@@ -90,6 +91,28 @@ protected:
         void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
         void check(const L3Skip &l3_skip, bool decode_features);
     };
+    // Helper class for block packed document ids
+    class DocIdBlocks {
+    protected:
+        ZcBuf _headers;
+        ZcBuf _packed;
+        uint32_t _block_pos;
+        uint32_t _block_docs;
+        uint32_t _residue;       // Documents in chunk after current block
+        uint64_t _features_pos;  // Features position at start of next block
+        uint32_t _doc_ids[ZcBlockCodec::block_size];
+        uint32_t _field_lengths[ZcBlockCodec::block_size];
+        uint32_t _num_occs[ZcBlockCodec::block_size];
+        void unpack(uint32_t bits, uint32_t *values);
+        void read_block(uint32_t prev_doc_id, uint64_t features_pos, bool decode_features, bool decode_interleaved_features);
+    public:
+        DocIdBlocks();
+        ~DocIdBlocks();
+        void setup(DecodeContext &decode_context, uint32_t headers_size, uint32_t packed_size, uint32_t num_docs);
+        void set_features_pos(uint64_t features_pos) { _features_pos = features_pos; }
+        void read(NoSkip &no_skip, uint64_t features_pos, bool decode_features, bool decode_interleaved_features);
+        void check_end();
+    };
     uint32_t _doc_id_k;
     uint32_t _num_docs;      // Documents in chunk or word
     search::ComprFileReadContext _readContext;
@@ -102,6 +125,7 @@ protected:
     L2Skip _l2_skip;
     L3Skip _l3_skip;
     L4Skip _l4_skip;
+    DocIdBlocks _doc_id_blocks;
 
     uint64_t _numWords;     // Number of words in file
     uint32_t _chunkNo;      // Chunk number
@@ -52,7 +52,11 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
         e.writeBits((hasMore ? 1 : 0), 1);
     }
 
-    calc_skip_info(_encode_features != nullptr);
+    if (_block_doc_ids) {
+        calc_block_info(_encode_features != nullptr);
+    } else {
+        calc_skip_info(_encode_features != nullptr);
+    }
 
     uint32_t docIdsSize = _zcDocIds.size();
     uint32_t l1SkipSize = _l1Skip.size();
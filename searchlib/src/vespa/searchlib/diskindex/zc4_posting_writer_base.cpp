@@ -1,8 +1,10 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zc4_posting_writer_base.h"
+#include "zc_block_codec.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <algorithm>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -196,6 +198,18 @@ L4SkipEncoder::write_skip(ZcBuf &zc_buf, const L3SkipEncoder &l3_skip)
     encode_skip(zc_buf, l3_skip);
 }
 
+void
+write_packed_block(ZcBuf &zc_buf, const uint32_t *values, uint32_t num_values, uint32_t bits)
+{
+    size_t packed_size = ZcBlockCodec::packed_size(bits);
+    while (zc_buf._valI + packed_size > zc_buf._valE) {
+        zc_buf.expand();
+    }
+    ZcBlockCodec::pack(values, num_values, bits, zc_buf._valI);
+    zc_buf._valI += packed_size;
+    zc_buf.maybeExpand();
+}
+
 }
 
 Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
@@ -207,6 +221,7 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _block_doc_ids(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -272,6 +287,58 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
     l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
 }
 
+/*
+ * Block packed variant of skip info. For each block of document ids a
+ * block header is written to _zcDocIds (last document id delta, bit
+ * widths and features size) while the bit packed document id deltas
+ * (and interleaved features) are written to _l1Skip. No higher level
+ * skip info is needed since the block headers can be scanned quickly.
+ */
+void
+Zc4PostingWriterBase::calc_block_info(bool encode_features)
+{
+    constexpr uint32_t block_size = ZcBlockCodec::block_size;
+    uint32_t doc_id_deltas[block_size];
+    uint32_t field_lengths[block_size];
+    uint32_t num_occs[block_size];
+    uint32_t prev_doc_id = _counts._segments.empty() ? 0u : _counts._segments.back()._lastDoc;
+    size_t num_docs = _docIds.size();
+    for (size_t block_start = 0; block_start < num_docs; block_start += block_size) {
+        uint32_t block_docs = std::min(static_cast<size_t>(block_size), num_docs - block_start);
+        uint64_t features_size = 0;
+        uint32_t doc_id = prev_doc_id;
+        for (uint32_t i = 0; i < block_docs; ++i) {
+            const auto &doc_id_and_feature_size = _docIds[block_start + i];
+            doc_id_deltas[i] = doc_id_and_feature_size._doc_id - doc_id - 1;
+            doc_id = doc_id_and_feature_size._doc_id;
+            if (_encode_interleaved_features) {
+                assert(doc_id_and_feature_size._field_length > 0);
+                field_lengths[i] = doc_id_and_feature_size._field_length - 1;
+                assert(doc_id_and_feature_size._num_occs > 0);
+                num_occs[i] = doc_id_and_feature_size._num_occs - 1;
+            }
+            features_size += doc_id_and_feature_size._features_size;
+        }
+        uint32_t doc_id_bits = ZcBlockCodec::bits_needed(doc_id_deltas, block_docs);
+        _zcDocIds.encode(doc_id - prev_doc_id - 1);
+        _zcDocIds.encode(doc_id_bits);
+        write_packed_block(_l1Skip, doc_id_deltas, block_docs, doc_id_bits);
+        if (_encode_interleaved_features) {
+            uint32_t field_length_bits = ZcBlockCodec::bits_needed(field_lengths, block_docs);
+            uint32_t num_occs_bits = ZcBlockCodec::bits_needed(num_occs, block_docs);
+            _zcDocIds.encode(field_length_bits);
+            _zcDocIds.encode(num_occs_bits);
+            write_packed_block(_l1Skip, field_lengths, block_docs, field_length_bits);
+            write_packed_block(_l1Skip, num_occs, block_docs, num_occs_bits);
+        }
+        if (encode_features) {
+            assert(static_cast<uint32_t>(features_size) == features_size);
+            _zcDocIds.encode(static_cast<uint32_t>(features_size));
+        }
+        prev_doc_id = doc_id;
+    }
+}
+
 void
 Zc4PostingWriterBase::clear_skip_info()
 {
@@ -289,6 +356,7 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_doc_ids", _block_doc_ids);
 }
 
 }
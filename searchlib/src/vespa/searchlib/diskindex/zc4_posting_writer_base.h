@@ -44,8 +44,9 @@ protected:
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
     bool _encode_interleaved_features;
-    ZcBuf _zcDocIds;    // Document id deltas
-    ZcBuf _l1Skip;      // L1 skip info
+    bool _block_doc_ids; // Block pack document ids for words with skip info ?
+    ZcBuf _zcDocIds;    // Document id deltas (block headers if block packed)
+    ZcBuf _l1Skip;      // L1 skip info (packed blocks if block packed)
     ZcBuf _l2Skip;      // L2 skip info
     ZcBuf _l3Skip;      // L3 skip info
     ZcBuf _l4Skip;      // L4 skip info
@@ -62,6 +63,7 @@ protected:
     Zc4PostingWriterBase(index::PostingListCounts &counts);
     ~Zc4PostingWriterBase();
     void calc_skip_info(bool encode_features);
+    void calc_block_info(bool encode_features);
     void clear_skip_info();
 
 public:
@@ -73,8 +75,10 @@ public:
     uint64_t get_num_words() const { return _numWords; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+    bool get_block_doc_ids() const { return _block_doc_ids; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
     void set_encode_interleaved_features(bool encode_interleaved_features) { _encode_interleaved_features = encode_interleaved_features; }
+    void set_block_doc_ids(bool block_doc_ids) { _block_doc_ids = block_doc_ids; }
     void set_posting_list_params(const index::PostingListParams &params);
 };
 
@@ -0,0 +1,104 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zc_block_codec.h"
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace search::diskindex {
+
+namespace {
+
+constexpr uint32_t rows = ZcBlockCodec::block_size / ZcBlockCodec::lanes;
+
+using Lanes = uint32_t __attribute__ ((vector_size (sizeof(uint32_t) * ZcBlockCodec::lanes)));
+
+inline void
+load_lanes(Lanes &dst, const uint8_t *src, uint32_t word)
+{
+    memcpy(&dst, src + word * sizeof(Lanes), sizeof(Lanes));
+}
+
+template <uint32_t bits>
+void
+unpack_bits(const uint8_t *src, uint32_t *values)
+{
+    constexpr uint32_t mask = (bits == 32) ? ~0u : ((1u << bits) - 1);
+    for (uint32_t row = 0; row < rows; ++row) {
+        uint32_t bit_pos = row * bits;
+        uint32_t word = bit_pos / 32;
+        uint32_t shift = bit_pos % 32;
+        Lanes v;
+        load_lanes(v, src, word);
+        v >>= shift;
+        if (shift + bits > 32) {
+            Lanes next;
+            load_lanes(next, src, word + 1);
+            v |= next << (32 - shift);
+        }
+        v &= mask;
+        memcpy(values + row * ZcBlockCodec::lanes, &v, sizeof(v));
+    }
+}
+
+template <>
+void
+unpack_bits<0>(const uint8_t *, uint32_t *values)
+{
+    memset(values, 0, ZcBlockCodec::block_size * sizeof(uint32_t));
+}
+
+using UnpackFunc = void (*)(const uint8_t *, uint32_t *);
+
+template <size_t... bits>
+constexpr auto
+make_unpack_table(std::index_sequence<bits...>)
+{
+    return std::array<UnpackFunc, sizeof...(bits)>{{ &unpack_bits<bits>... }};
+}
+
+constexpr auto unpack_table = make_unpack_table(std::make_index_sequence<ZcBlockCodec::max_bits + 1>());
+
+}
+
+uint32_t
+ZcBlockCodec::bits_needed(const uint32_t *values, uint32_t num_values)
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < num_values; ++i) {
+        acc |= values[i];
+    }
+    return (acc == 0) ? 0 : (32 - __builtin_clz(acc));
+}
+
+void
+ZcBlockCodec::pack(const uint32_t *values, uint32_t num_values, uint32_t bits, uint8_t *dst)
+{
+    assert(num_values <= block_size);
+    assert(bits <= max_bits);
+    uint32_t words[lanes * (max_bits / 2)];
+    uint32_t num_words = packed_size(bits) / sizeof(uint32_t);
+    memset(words, 0, num_words * sizeof(uint32_t));
+    for (uint32_t i = 0; i < num_values; ++i) {
+        uint32_t value = values[i];
+        assert(bits == 32 || (value >> bits) == 0);
+        uint32_t lane = i % lanes;
+        uint32_t bit_pos = (i / lanes) * bits;
+        uint32_t word = bit_pos / 32;
+        uint32_t shift = bit_pos % 32;
+        words[word * lanes + lane] |= value << shift;
+        if (shift + bits > 32) {
+            words[(word + 1) * lanes + lane] |= value >> (32 - shift);
+        }
+    }
+    memcpy(dst, words, num_words * sizeof(uint32_t));
+}
+
+void
+ZcBlockCodec::unpack(const uint8_t *src, uint32_t bits, uint32_t *values)
+{
+    unpack_table[bits](src, values);
+}
+
+}
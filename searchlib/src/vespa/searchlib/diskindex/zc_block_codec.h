@@ -0,0 +1,36 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace search::diskindex {
+
+/*
+ * Bit packing of blocks of up to 128 unsigned values, used for document
+ * id deltas and interleaved features in posting lists with block packed
+ * document ids.
+ *
+ * All values in a block are packed with the same bit width. Values are
+ * laid out vertically in 8 lanes of 32-bit words (value i is stored in
+ * lane i % 8), allowing a full block to be unpacked using 8-wide vector
+ * shifts and masks without any data dependent branches.
+ */
+class ZcBlockCodec {
+public:
+    static constexpr uint32_t block_size = 128;
+    static constexpr uint32_t lanes = 8;
+    static constexpr uint32_t max_bits = 32;
+
+    // Number of bits needed to represent all of the given values.
+    static uint32_t bits_needed(const uint32_t *values, uint32_t num_values);
+    // Number of bytes used by a packed block with the given bit width.
+    static constexpr size_t packed_size(uint32_t bits) { return sizeof(uint32_t) * lanes * ((bits + 1) / 2); }
+    // Pack num_values (<= block_size) values, padding the block with zeros.
+    static void pack(const uint32_t *values, uint32_t num_values, uint32_t bits, uint8_t *dst);
+    // Unpack a full block (block_size values) from src.
+    static void unpack(const uint8_t *src, uint32_t bits, uint32_t *values);
+};
+
+}
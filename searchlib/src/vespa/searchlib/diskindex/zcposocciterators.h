@@ -45,6 +45,24 @@ public:
                      fef::TermFieldMatchDataArray matchData);
 };
 
+template <bool bigEndian, bool dynamic_k>
+class ZcBlockPosOccIterator : public ZcBlockPostingIterator<bigEndian>
+{
+private:
+    using ParentClass = ZcBlockPostingIterator<bigEndian>;
+    using ParentClass::_decodeContext;
+
+    using DecodeContext = std::conditional_t<dynamic_k, bitcompression::EGPosOccDecodeContextCooked<bigEndian>, bitcompression::EG2PosOccDecodeContextCooked<bigEndian>>;
+    DecodeContext _decodeContextReal;
+public:
+    ZcBlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                          bool decode_normal_features, bool decode_interleaved_features,
+                          bool unpack_normal_features, bool unpack_interleaved_features,
+                          uint32_t minChunkDocs, const index::PostingListCounts &counts,
+                          const bitcompression::PosOccFieldsParams *fieldsParams,
+                          fef::TermFieldMatchDataArray matchData);
+};
+
 std::unique_ptr<search::queryeval::SearchIterator>
 create_zc_posocc_iterator(bool bigEndian, const index::PostingListCounts &counts, bitcompression::Position start, uint64_t bit_length, const Zc4PostingParams &posting_params, const bitcompression::PosOccFieldsParams &fields_params, fef::TermFieldMatchDataArray match_data);
 
@@ -58,4 +76,9 @@ extern template class ZcPosOccIterator<false, true>;
 extern template class ZcPosOccIterator<true, false>;
 extern template class ZcPosOccIterator<true, true>;
 
+extern template class ZcBlockPosOccIterator<false, false>;
+extern template class ZcBlockPosOccIterator<false, true>;
+extern template class ZcBlockPosOccIterator<true, false>;
+extern template class ZcBlockPosOccIterator<true, true>;
+
 }
@@ -3,6 +3,10 @@
 #include "zcposoccrandread.h"
 #include "zcposocciterators.h"
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/io/io_uring_reader.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
 
@@ -26,6 +30,8 @@ namespace {
 
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
+vespalib::string myId4Block("Zc.4.block");
+vespalib::string myId5Block("Zc.5.block");
 vespalib::string interleaved_features("interleaved_features");
 
 }
@@ -36,6 +42,7 @@ using vespalib::getLastErrorString;
 
 ZcPosOccRandRead::ZcPosOccRandRead()
     : _file(std::make_unique<FastOS_File>()),
+      _ioUringFile(),
       _fileSize(0),
       _posting_params(64, 1 << 30, 10000000, true, true, false),
       _numWords(0),
@@ -132,9 +139,21 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
             alignedBuffer = _file->AllocateDirectIOBuffer(mallocLen, mallocStart);
             assert(mallocStart != nullptr);
             assert(endOffset + padAfter + padExtraAfter <= _fileSize);
-            _file->ReadBuf(alignedBuffer,
-                           padBefore + vectorLen + padAfter,
-                           startOffset - padBefore);
+            if (_ioUringFile) {
+                vespalib::IoUringReader::Request request(_ioUringFile->getFileDescriptor(), alignedBuffer,
+                                                         padBefore + vectorLen + padAfter, startOffset - padBefore);
+                vespalib::IoUringReader::thread_local_instance().read(std::span(&request, 1));
+                if (request.result != ssize_t(request.len)) {
+                    int error = (request.result < 0) ? -request.result : 0;
+                    throw vespalib::IoException(vespalib::make_string("Failed reading posting list from %s: got %zd of %zu bytes",
+                                                                      _file->GetFileName(), request.result, request.len),
+                                                vespalib::IoException::getErrorType(error), VESPA_STRLOC);
+                }
+            } else {
+                _file->ReadBuf(alignedBuffer,
+                               padBefore + vectorLen + padAfter,
+                               startOffset - padBefore);
+            }
         }
         // Zero decode prefetch memory to avoid uninitialized reads
         if (padExtraAfter > 0) {
@@ -166,6 +185,10 @@ open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
         return false;
     }
     _fileSize = _file->GetSize();
+    if (tuneFileRead.getWantIoUring()) {
+        _ioUringFile = std::make_unique<vespalib::File>(name);
+        _ioUringFile->open(vespalib::File::READONLY);
+    }
 
     readHeader();
     return true;
@@ -175,13 +198,14 @@ open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
 bool
 ZcPosOccRandRead::close()
 {
+    _ioUringFile.reset();
     return _file->Close();
 }
 
 
 template <typename DecodeContext>
 void
-ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
+ZcPosOccRandRead::readHeader(const vespalib::string &identifier, const vespalib::string &block_identifier)
 {
     DecodeContext d(&_fieldsParams);
     ComprFileReadContext drc(d);
@@ -207,7 +231,12 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
     assert(header.hasTag("minSkipDocs"));
     assert(header.getTag("frozen").asInteger() != 0);
     _fileBitSize = header.getTag("fileBitSize").asInteger();
-    assert(header.getTag("format.0").asString() == identifier);
+    const vespalib::string &format = header.getTag("format.0").asString();
+    if (format == block_identifier) {
+        _posting_params._block_doc_ids = true;
+    } else {
+        assert(format == identifier);
+    }
     assert(header.getTag("format.1").asString() == d.getIdentifier());
     _numWords = header.getTag("numWords").asInteger();
     _posting_params._min_chunk_docs = header.getTag("minChunkDocs").asInteger();
@@ -228,13 +257,13 @@ ZcPosOccRandRead::readHeader(const vespalib::string &identifier)
 void
 ZcPosOccRandRead::readHeader()
 {
-    readHeader<EGPosOccDecodeContext<true>>(myId5);
+    readHeader<EGPosOccDecodeContext<true>>(myId5, myId5Block);
 }
 
 const vespalib::string &
-ZcPosOccRandRead::getIdentifier()
+ZcPosOccRandRead::getIdentifier(bool block_doc_ids)
 {
-    return myId5;
+    return block_doc_ids ? myId5Block : myId5;
 }
 
 
@@ -263,13 +292,13 @@ Zc4PosOccRandRead()
 void
 Zc4PosOccRandRead::readHeader()
 {
-    readHeader<EG2PosOccDecodeContext<true> >(myId4);
+    readHeader<EG2PosOccDecodeContext<true> >(myId4, myId4Block);
 }
 
 const vespalib::string &
-Zc4PosOccRandRead::getIdentifier()
+Zc4PosOccRandRead::getIdentifier(bool block_doc_ids)
 {
-    return myId4;
+    return block_doc_ids ? myId4Block : myId4;
 }
 
 const vespalib::string &
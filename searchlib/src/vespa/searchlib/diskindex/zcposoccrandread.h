@@ -9,12 +9,15 @@
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include "zc4_posting_params.h"
 
+namespace vespalib { class File; }
+
 namespace search::diskindex {
 
 class ZcPosOccRandRead : public index::PostingListFileRandRead
 {
 protected:
     std::unique_ptr<FastOS_FileInterface> _file;
+    std::unique_ptr<vespalib::File> _ioUringFile; // Posting lists are read through io_uring when set
     uint64_t         _fileSize;
     Zc4PostingParams _posting_params;
     uint64_t _numWords;     // Number of words in file
@@ -46,9 +49,9 @@ public:
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
     bool close() override;
     template <typename DecodeContext>
-    void readHeader(const vespalib::string &identifier);
+    void readHeader(const vespalib::string &identifier, const vespalib::string &block_identifier);
     virtual void readHeader();
-    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getIdentifier(bool block_doc_ids = false);
     static const vespalib::string &getSubIdentifier();
     const index::FieldLengthInfo &get_field_length_info() const override;
 };
@@ -61,7 +64,7 @@ public:
 
     void readHeader() override;
 
-    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getIdentifier(bool block_doc_ids = false);
     static const vespalib::string &getSubIdentifier();
 };
 
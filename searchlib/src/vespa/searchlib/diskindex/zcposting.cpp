@@ -16,7 +16,11 @@ namespace {
 
 vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
+// Same as above, but with document ids of words with skip info stored as bit packed blocks.
+vespalib::string myId5Block("Zc.5.block");
+vespalib::string myId4Block("Zc.4.block");
 vespalib::string interleaved_features("interleaved_features");
+vespalib::string block_doc_ids("block_doc_ids");
 
 }
 
@@ -121,6 +125,7 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_doc_ids, _reader.get_posting_params()._block_doc_ids);
 }
 
 
@@ -136,7 +141,6 @@ Zc4PostingSeqRead::readHeader()
 {
     FeatureDecodeContextBE &d = _reader.get_decode_features();
     auto &posting_params = _reader.get_posting_params();
-    const vespalib::string &myId = posting_params._dynamic_k ? myId5 : myId4;
 
     vespalib::FileHeader header;
     d.readHeader(header, _file.getSize());
@@ -157,8 +161,12 @@ Zc4PostingSeqRead::readHeader()
     assert(completed);
     (void) completed;
     assert(_fileBitSize >= 8 * headerLen);
-    assert(header.getTag("format.0").asString() == myId);
-    (void) myId;
+    const vespalib::string &format = header.getTag("format.0").asString();
+    if (format == getIdentifier(posting_params._dynamic_k, true)) {
+        posting_params._block_doc_ids = true;
+    } else {
+        assert(format == getIdentifier(posting_params._dynamic_k, false));
+    }
     assert(header.getTag("format.1").asString() == d.getIdentifier());
     _numWords = header.getTag("numWords").asInteger();
     posting_params._min_chunk_docs = header.getTag("minChunkDocs").asInteger();
@@ -178,8 +186,11 @@ Zc4PostingSeqRead::readHeader()
 
 
 const vespalib::string &
-Zc4PostingSeqRead::getIdentifier(bool dynamic_k)
+Zc4PostingSeqRead::getIdentifier(bool dynamic_k, bool block_doc_ids)
 {
+    if (block_doc_ids) {
+        return (dynamic_k ? myId5Block : myId4Block);
+    }
     return (dynamic_k ? myId5 : myId4);
 }
 
@@ -224,7 +235,7 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     EncodeContext &e = _writer.get_encode_context();
     ComprFileWriteContext &wce = _writer.get_write_context();
 
-    const vespalib::string &myId = _writer.get_dynamic_k() ? myId5 : myId4;
+    const vespalib::string &myId = Zc4PostingSeqRead::getIdentifier(_writer.get_dynamic_k(), _writer.get_block_doc_ids());
     vespalib::FileHeader header;
 
     typedef vespalib::GenericHeader::Tag Tag;
@@ -355,6 +366,7 @@ getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_doc_ids, _writer.get_block_doc_ids());
 }
 
 
@@ -43,7 +43,7 @@ public:
     void getParams(PostingListParams &params) override;
     void getFeatureParams(PostingListParams &params) override;
     void readHeader();
-    static const vespalib::string &getIdentifier(bool dynamic_k);
+    static const vespalib::string &getIdentifier(bool dynamic_k, bool block_doc_ids = false);
 };
 
 
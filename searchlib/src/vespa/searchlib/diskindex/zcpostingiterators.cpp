@@ -4,6 +4,7 @@
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <algorithm>
 
 namespace search::diskindex {
 
@@ -613,6 +614,263 @@ void ZcPostingIterator<bigEndian>::rewind(Position start)
     _chunkNo = 0;
 }
 
+template <bool bigEndian>
+ZcBlockPostingIterator<bigEndian>::
+ZcBlockPostingIterator(uint32_t minChunkDocs,
+                       bool dynamicK,
+                       const PostingListCounts &counts,
+                       search::fef::TermFieldMatchDataArray matchData,
+                       Position start, uint32_t docIdLimit,
+                       bool decode_normal_features, bool decode_interleaved_features,
+                       bool unpack_normal_features, bool unpack_interleaved_features)
+    : ZcIteratorBase(std::move(matchData), start, docIdLimit),
+      _decodeContext(nullptr),
+      _header_valI(nullptr),
+      _packed_valI(nullptr),
+      _block_packed(nullptr),
+      _block_prev_doc_id(0),
+      _block_last_doc_id(0),
+      _doc_id_bits(0),
+      _field_length_bits(0),
+      _num_occs_bits(0),
+      _block_pos(0),
+      _block_docs(0),
+      _residue(0),
+      _block_features_pos(0),
+      _next_features_pos(0),
+      _featureSeekPos(0),
+      _chunk_last_doc_id(0),
+      _featuresSize(0),
+      _hasMore(false),
+      _decode_normal_features(decode_normal_features),
+      _decode_interleaved_features(decode_interleaved_features),
+      _unpack_normal_features(unpack_normal_features),
+      _unpack_interleaved_features(unpack_interleaved_features),
+      _chunkNo(0),
+      _minChunkDocs(minChunkDocs),
+      _docIdK(0),
+      _dynamicK(dynamicK),
+      _numDocs(0),
+      _featuresValI(nullptr),
+      _featuresBitOffset(0),
+      _counts(counts)
+{
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
+{
+    typedef FeatureEncodeContext<bigEndian> EC;
+    DecodeContextBase &d = *_decodeContext;
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, d._);
+    uint32_t length;
+    uint64_t val64;
+
+    uint32_t prevDocId = _hasMore ? _chunk_last_doc_id : 0u;
+    UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
+
+    _numDocs = static_cast<uint32_t>(val64) + 1;
+    bool hasMore = false;
+    if (__builtin_expect(_numDocs >= _minChunkDocs, false)) {
+        if (bigEndian) {
+            hasMore = static_cast<int64_t>(oVal) < 0;
+            oVal <<= 1;
+            length = 1;
+        } else {
+            hasMore = (oVal & 1) != 0;
+            oVal >>= 1;
+            length = 1;
+        }
+        UC64_READBITS_NS(o, EC);
+    }
+    if (_dynamicK) {
+        _docIdK = EC::calcDocIdK((_hasMore || hasMore) ? 1 : _numDocs, docIdLimit);
+    }
+    UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_DOCIDSSIZE, EC);
+    uint32_t headersSize = val64 + 1;
+    UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_L1SKIPSIZE, EC);
+    uint32_t packedSize = val64;
+    if (packedSize != 0) {
+        // No L2 skip info for block packed document ids
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_L2SKIPSIZE, EC);
+        assert(val64 == 0);
+    }
+    if (_decode_normal_features) {
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_FEATURESSIZE, EC);
+        _featuresSize = val64;
+    }
+    if (_dynamicK) {
+        UC64_DECODEEXPGOLOMB_NS(o, _docIdK, EC);
+    } else {
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_LASTDOCID, EC);
+    }
+    _chunk_last_doc_id = docIdLimit - 1 - val64;
+    if (_hasMore || hasMore) {
+        if (!_counts._segments.empty()) {
+            assert(_chunk_last_doc_id == _counts._segments[_chunkNo]._lastDoc);
+        }
+    }
+
+    uint64_t bytePad = oPreRead & 7;
+    if (bytePad > 0) {
+        length = bytePad;
+        UC64_READBITS_NS(o, EC);
+    }
+
+    UC64_DECODECONTEXT_STORE(o, d._);
+    assert((d.getBitOffset() & 7) == 0);
+    const uint8_t *bcompr = d.getByteCompr();
+    _header_valI = bcompr;
+    bcompr += headersSize;
+    _packed_valI = bcompr;
+    bcompr += packedSize;
+    d.setByteCompr(bcompr);
+    _hasMore = hasMore;
+    // Save information about start of next chunk
+    _featuresValI = d.getCompr();
+    _featuresBitOffset = d.getBitOffset();
+    _block_last_doc_id = prevDocId;
+    _residue = _numDocs;
+    _next_features_pos = 0;
+    // Unpack first block in chunk
+    read_block_header();
+    decode_block();
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::read_block_header()
+{
+    const uint8_t *valI = _header_valI;
+    _block_prev_doc_id = _block_last_doc_id;
+    ZCDECODE(valI, _block_last_doc_id += 1 +);
+    ZCDECODE(valI, _doc_id_bits =);
+    _block_packed = _packed_valI;
+    _packed_valI += ZcBlockCodec::packed_size(_doc_id_bits);
+    if (_decode_interleaved_features) {
+        ZCDECODE(valI, _field_length_bits =);
+        ZCDECODE(valI, _num_occs_bits =);
+        _packed_valI += ZcBlockCodec::packed_size(_field_length_bits) + ZcBlockCodec::packed_size(_num_occs_bits);
+    }
+    _block_features_pos = _next_features_pos;
+    if (_decode_normal_features) {
+        ZCDECODE(valI, _next_features_pos +=);
+    }
+    _header_valI = valI;
+    _block_docs = std::min(block_size, _residue);
+    _residue -= _block_docs;
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::decode_block()
+{
+    const uint8_t *packed = _block_packed;
+    ZcBlockCodec::unpack(packed, _doc_id_bits, _doc_ids);
+    uint32_t docId = _block_prev_doc_id;
+    for (uint32_t i = 0; i < _block_docs; ++i) {
+        docId += _doc_ids[i] + 1;
+        _doc_ids[i] = docId;
+    }
+#if DEBUG_ZCPOSTING_ASSERT
+    assert(docId == _block_last_doc_id);
+#endif
+    if (_decode_interleaved_features && _unpack_interleaved_features) {
+        packed += ZcBlockCodec::packed_size(_doc_id_bits);
+        ZcBlockCodec::unpack(packed, _field_length_bits, _field_lengths);
+        packed += ZcBlockCodec::packed_size(_field_length_bits);
+        ZcBlockCodec::unpack(packed, _num_occs_bits, _num_occs);
+    }
+    _block_pos = 0;
+    setDocId(_doc_ids[0]);
+    _featureSeekPos = _block_features_pos;
+    clearUnpacked();
+}
+
+template <bool bigEndian>
+bool
+ZcBlockPostingIterator<bigEndian>::seek_block(uint32_t docId)
+{
+    while (docId > _chunk_last_doc_id) {
+        if (!_hasMore) {
+            setAtEnd();
+            return false;
+        }
+        // Skip to start of next chunk
+        _featureSeekPos = 0;
+        featureSeek(_featuresSize);
+        _chunkNo++;
+        readWordStart(getDocIdLimit()); // Read word start for next chunk
+    }
+    if (docId > _block_last_doc_id) {
+        do {
+            read_block_header();
+        } while (docId > _block_last_doc_id);
+        decode_block();
+    }
+    return true;
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::doSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId > _block_last_doc_id, false)) {
+        if (!seek_block(docId)) {
+            return;
+        }
+    }
+    // The last document id in the block acts as sentinel for the scan
+    uint32_t pos = _block_pos;
+    while (__builtin_expect(_doc_ids[pos] < docId, true)) {
+        ++pos;
+        incNeedUnpack();
+    }
+    _block_pos = pos;
+    setDocId(_doc_ids[pos]);
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::doUnpack(uint32_t docId)
+{
+    if (!_matchData.valid() || getUnpacked()) {
+        return;
+    }
+    assert(docId == getDocId());
+    if (_decode_normal_features && _unpack_normal_features) {
+        if (_featureSeekPos != 0) {
+            // Handle deferred feature position seek now.
+            featureSeek(_featureSeekPos);
+            _featureSeekPos = 0;
+        }
+        uint32_t needUnpack = getNeedUnpack();
+        if (needUnpack > 1) {
+            _decodeContext->skipFeatures(needUnpack - 1);
+        }
+        _decodeContext->unpackFeatures(_matchData, docId);
+    } else {
+        _matchData[0]->reset(docId);
+    }
+    if (_decode_interleaved_features && _unpack_interleaved_features) {
+        TermFieldMatchData *tfmd = _matchData[0];
+        tfmd->setFieldLength(_field_lengths[_block_pos] + 1);
+        tfmd->setNumOccs(_num_occs[_block_pos] + 1);
+    }
+    setUnpacked();
+}
+
+template <bool bigEndian>
+void
+ZcBlockPostingIterator<bigEndian>::rewind(Position start)
+{
+    _decodeContext->setPosition(start);
+    _hasMore = false;
+    _chunk_last_doc_id = 0;
+    _chunkNo = 0;
+}
+
 template class ZcRareWordPostingIterator<false, false>;
 template class ZcRareWordPostingIterator<false, true>;
 template class ZcRareWordPostingIterator<true, false>;
@@ -621,4 +879,7 @@ template class ZcRareWordPostingIterator<true, true>;
 template class ZcPostingIterator<true>;
 template class ZcPostingIterator<false>;
 
+template class ZcBlockPostingIterator<true>;
+template class ZcBlockPostingIterator<false>;
+
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "zc_block_codec.h"
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
@@ -343,6 +344,75 @@ public:
     }
 };
 
+/*
+ * Iterator for posting lists with block packed document ids. Block
+ * headers are scanned to locate the block containing the seek target
+ * and that block is then unpacked in one go.
+ */
+template <bool bigEndian>
+class ZcBlockPostingIterator : public ZcIteratorBase
+{
+public:
+    typedef bitcompression::FeatureDecodeContext<bigEndian> DecodeContextBase;
+    typedef index::PostingListCounts PostingListCounts;
+    static constexpr uint32_t block_size = ZcBlockCodec::block_size;
+protected:
+    DecodeContextBase *_decodeContext;
+private:
+    const uint8_t *_header_valI;  // next block header
+    const uint8_t *_packed_valI;  // packed data for next block
+    const uint8_t *_block_packed; // packed data for current block
+    uint32_t _block_prev_doc_id;  // last document id before current block
+    uint32_t _block_last_doc_id;  // last document id in current block
+    uint32_t _doc_id_bits;
+    uint32_t _field_length_bits;
+    uint32_t _num_occs_bits;
+    uint32_t _block_pos;
+    uint32_t _block_docs;
+    uint32_t _residue;            // Documents in chunk after current block
+    uint64_t _block_features_pos;
+    uint64_t _next_features_pos;
+    uint64_t _featureSeekPos;
+    uint32_t _chunk_last_doc_id;
+    uint64_t _featuresSize;
+    bool     _hasMore;
+    bool     _decode_normal_features;
+    bool     _decode_interleaved_features;
+    bool     _unpack_normal_features;
+    bool     _unpack_interleaved_features;
+    uint32_t _chunkNo;
+    uint32_t _minChunkDocs;
+    uint32_t _docIdK;
+    bool     _dynamicK;
+    uint32_t _numDocs;
+    // Start of current features block, needed for seeks
+    const uint64_t *_featuresValI;
+    int _featuresBitOffset;
+    // Counts used for assertions
+    const PostingListCounts &_counts;
+    uint32_t _doc_ids[block_size];
+    uint32_t _field_lengths[block_size];
+    uint32_t _num_occs[block_size];
+
+    void read_block_header();
+    void decode_block();
+    bool seek_block(uint32_t docId);
+    void featureSeek(uint64_t offset) {
+        _decodeContext->_valI = _featuresValI + (_featuresBitOffset + offset) / 64;
+        _decodeContext->setupBits((_featuresBitOffset + offset) & 63);
+    }
+public:
+    ZcBlockPostingIterator(uint32_t minChunkDocs, bool dynamicK, const PostingListCounts &counts,
+                           search::fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
+                           bool decode_normal_features, bool decode_interleaved_features,
+                           bool unpack_normal_features, bool unpack_interleaved_features);
+
+    void doSeek(uint32_t docId) override;
+    void doUnpack(uint32_t docId) override;
+    void readWordStart(uint32_t docIdLimit) override;
+    void rewind(Position start) override;
+};
+
 
 extern template class ZcRareWordPostingIterator<false, false>;
 extern template class ZcRareWordPostingIterator<false, true>;
@@ -352,4 +422,7 @@ extern template class ZcRareWordPostingIterator<true, true>;
 extern template class ZcPostingIterator<true>;
 extern template class ZcPostingIterator<false>;
 
+extern template class ZcBlockPostingIterator<true>;
+extern template class ZcBlockPostingIterator<false>;
+
 }
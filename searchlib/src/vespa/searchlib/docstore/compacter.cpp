@@ -4,6 +4,7 @@
 #include "logdatastore.h"
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.docstore.compacter");
@@ -23,6 +24,34 @@ Compacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *bu
     _ds.write(std::move(guard), fileId, lid, buffer, sz);
 }
 
+DictionarySampler::DictionarySampler(size_t maxBytes)
+    : _maxBytes(maxBytes),
+      _samples(),
+      _sampleSizes()
+{
+    _samples.reserve(maxBytes);
+}
+
+DictionarySampler::~DictionarySampler() = default;
+
+void
+DictionarySampler::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz) {
+    (void) chunkId;
+    (void) lid;
+    guard.unlock();
+    if ((sz > 0) && (_samples.size() + sz <= _maxBytes)) {
+        const char * data = static_cast<const char *>(buffer);
+        _samples.insert(_samples.end(), data, data + sz);
+        _sampleSizes.push_back(sz);
+    }
+}
+
+FileChunk::ZStdDictionarySP
+DictionarySampler::train(size_t maxDictionarySize, int compressionLevel) const
+{
+    return vespalib::compression::ZStdDictionary::train(_samples.data(), _sampleSizes, maxDictionarySize, compressionLevel);
+}
+
 BucketCompacter::BucketCompacter(size_t maxSignificantBucketBits, const CompressionConfig & compression, LogDataStore & ds,
                                  Executor & executor, const IBucketizer & bucketizer, FileId source, FileId destination) :
     _unSignificantBucketBits((maxSignificantBucketBits > 8) ? (maxSignificantBucketBits - 8) : 0),
@@ -23,6 +23,26 @@ private:
     LogDataStore & _ds;
 };
 
+/**
+ * Collects the documents written to it, up to a given number of bytes,
+ * as samples for training a zstd dictionary.
+ */
+class DictionarySampler : public IWriteData
+{
+public:
+    explicit DictionarySampler(size_t maxBytes);
+    ~DictionarySampler() override;
+    void write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz) override;
+    void close() override { }
+    size_t getMaxBytes() const { return _maxBytes; }
+    size_t getNumSamples() const { return _sampleSizes.size(); }
+    FileChunk::ZStdDictionarySP train(size_t maxDictionarySize, int compressionLevel) const;
+private:
+    size_t              _maxBytes;
+    std::vector<char>   _samples;
+    std::vector<size_t> _sampleSizes;
+};
+
 /**
  * This will split the incoming data into buckets.
  * The buckets data will then be written out in bucket order.
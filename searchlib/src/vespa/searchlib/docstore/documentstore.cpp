@@ -5,6 +5,7 @@
 #include "ibucketizer.h"
 #include "value.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/serialization/lazydocumentview.h>
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
@@ -120,7 +121,8 @@ DocumentStore::Config::operator == (const Config &rhs) const {
             (_allowVisitCaching == rhs._allowVisitCaching) &&
             (_initialCacheEntries == rhs._initialCacheEntries) &&
             (_updateStrategy == rhs._updateStrategy) &&
-            (_compression == rhs._compression);
+            (_compression == rhs._compression) &&
+            (_visitCacheShards == rhs._visitCacheShards);
 }
 
 
@@ -130,7 +132,8 @@ DocumentStore::DocumentStore(const Config & config, IDataStore & store)
       _backingStore(store),
       _store(std::make_unique<docstore::BackingStore>(_backingStore, config.getCompression())),
       _cache(std::make_unique<docstore::Cache>(*_store, config.getMaxCacheBytes())),
-      _visitCache(std::make_unique<docstore::VisitCache>(store, config.getMaxCacheBytes(), config.getCompression())),
+      _visitCache(std::make_unique<docstore::VisitCache>(store, config.getMaxCacheBytes(), config.getCompression(),
+                                                          config.getVisitCacheShards())),
       _uncached_lookups(0)
 {
     _cache->reserveElements(config.getInitialCacheEntries());
@@ -194,6 +197,34 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     return std::unique_ptr<document::Document>();
 }
 
+DocumentStore::DocumentViewUP
+DocumentStore::readLazy(DocumentIdT lid, const DocumentTypeRepo &repo) const
+{
+    Value value;
+    if (useCache()) {
+        value = _cache->read(lid);
+        if (value.empty()) {
+            return DocumentViewUP();
+        }
+        Value::Result result = value.decompressed();
+        if ( result.second ) {
+            return std::make_unique<document::LazyDocumentView>(repo, std::move(result.first));
+        } else {
+            LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
+            _cache->invalidate(lid);
+        }
+    }
+
+    _uncached_lookups.fetch_add(1);
+    _store->read(lid, value);
+    if ( ! value.empty() ) {
+        Value::Result result = value.decompressed();
+        assert(result.second);
+        return std::make_unique<document::LazyDocumentView>(repo, std::move(result.first));
+    }
+    return DocumentViewUP();
+}
+
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Document& doc) {
     nbostream stream(12345);
@@ -443,6 +474,11 @@ CacheStats DocumentStore::getCacheStats() const {
     return singleStats;
 }
 
+std::vector<VisitCacheShardStats>
+DocumentStore::getVisitCacheShardStats() const {
+    return _visitCache->getShardStats();
+}
+
 void
 DocumentStore::compactLidSpace(uint32_t wantedDocLidLimit)
 {
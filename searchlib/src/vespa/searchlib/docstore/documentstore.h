@@ -30,14 +30,16 @@ public:
             _maxCacheBytes(1000000000),
             _initialCacheEntries(0),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _visitCacheShards(1)
         { }
         Config(const CompressionConfig & compression, size_t maxCacheBytes, size_t initialCacheEntries) :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
             _initialCacheEntries(initialCacheEntries),
             _updateStrategy(INVALIDATE),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _visitCacheShards(1)
         { }
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxCacheBytes()   const { return _maxCacheBytes; }
@@ -46,6 +48,8 @@ public:
         Config & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
         Config & updateStrategy(UpdateStrategy strategy) { _updateStrategy = strategy; return *this; }
         UpdateStrategy updateStrategy() const { return _updateStrategy; }
+        uint32_t getVisitCacheShards() const { return _visitCacheShards; }
+        Config & visitCacheShards(uint32_t shards) { _visitCacheShards = shards; return *this; }
         bool operator == (const Config &) const;
     private:
         CompressionConfig _compression;
@@ -53,6 +57,7 @@ public:
         size_t _initialCacheEntries;
         UpdateStrategy _updateStrategy;
         bool   _allowVisitCaching;
+        uint32_t _visitCacheShards;
     };
 
     /**
@@ -66,6 +71,7 @@ public:
     ~DocumentStore() override;
 
     DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
+    DocumentViewUP readLazy(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
@@ -83,6 +89,7 @@ public:
     size_t      getDiskBloat() const override { return _backingStore.getDiskBloat(); }
     size_t getMaxSpreadAsBloat() const override { return _backingStore.getMaxSpreadAsBloat(); }
     vespalib::CacheStats getCacheStats() const override;
+    std::vector<VisitCacheShardStats> getVisitCacheShardStats() const override;
     size_t memoryMeta() const override { return _backingStore.memoryMeta(); }
     const vespalib::string & getBaseDir() const override { return _backingStore.getBaseDir(); }
     void accept(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
@@ -12,6 +12,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/util/arrayqueue.hpp>
 #include <vespa/vespalib/util/array.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
@@ -32,6 +33,16 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string ZSTD_DICTIONARY_KEY("zstdDictionary");
+const vespalib::string ZSTD_DICTIONARY_LEVEL_KEY("zstdDictionaryCompressionLevel");
+
+constexpr char hex_digits[] = "0123456789abcdef";
+
+uint8_t
+from_hex(char c)
+{
+    return (c <= '9') ? (c - '0') : (c - 'a' + 10);
+}
 
 }
 
@@ -86,7 +97,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _dictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -270,6 +282,9 @@ FileChunk::enableRead()
             LOG(debug, "enableRead(): MMapRandReadDynamic: file='%s'", _dataFileName.c_str());
             _file = std::make_unique<MMapRandReadDynamic>(_dataFileName, mmapFlags, fadviseOptions);
         }
+    } else if (_tune._randRead.getWantIoUring()) {
+        LOG(debug, "enableRead(): IoUringRandRead: file='%s'", _dataFileName.c_str());
+        _file = std::make_unique<IoUringRandRead>(_dataFileName, _tune._randRead.getAdvise());
     } else {
         LOG(debug, "enableRead(): NormalRandRead: file='%s'", _dataFileName.c_str());
         _file = std::make_unique<NormalRandRead>(_dataFileName);
@@ -278,6 +293,9 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        _dictionary = readDataHeaderDictionary(*_file, _dataHeaderLen);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -353,7 +371,7 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         });
         executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
 
@@ -375,32 +393,43 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
+    std::vector<ChunkRange> ranges;
     uint32_t prevChunk = begin->getChunkId();
     uint32_t start(0);
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
+            ranges.push_back({begin + start, i - start, _chunkInfo[prevChunk]});
             prevChunk = li.getChunkId();
             start = i;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    ranges.push_back({begin + start, count - start, _chunkInfo[prevChunk]});
+    read(ranges, visitor);
 }
 
 void
-FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
+FileChunk::read(const std::vector<ChunkRange> & ranges, IBufferVisitor & visitor) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
-    for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
-        if (buf.size() != 0) {
-            visitor.visit(li.getLid(), buf);
+    std::vector<vespalib::DataBuffer> buffers;
+    std::vector<FileRandRead::ReadRequest> requests;
+    buffers.reserve(ranges.size());
+    requests.reserve(ranges.size());
+    for (const ChunkRange & range : ranges) {
+        buffers.emplace_back(0ul, ALIGNMENT);
+        requests.push_back({range.chunkInfo.getOffset(), range.chunkInfo.getSize(), &buffers.back(), FileRandRead::FSP()});
+    }
+    _file->readBatch(requests);
+    for (size_t r(0); r < ranges.size(); r++) {
+        const ChunkRange & range = ranges[r];
+        const vespalib::DataBuffer & whole = buffers[r];
+        Chunk chunk(range.begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
+        for (size_t i(0); i < range.count; i++) {
+            const LidInfoWithLid & li = *(range.begin + i);
+            vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
+            if (buf.size() != 0) {
+                visitor.visit(li.getLid(), buf);
+            }
         }
     }
 }
@@ -420,7 +449,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -442,6 +471,17 @@ FileChunk::readDataHeader(FileRandRead &datFile)
     return dataHeaderLen;
 }
 
+FileChunk::ZStdDictionarySP
+FileChunk::readDataHeaderDictionary(FileRandRead &datFile, uint64_t dataHeaderLen)
+{
+    vespalib::DataBuffer h(dataHeaderLen, ALIGNMENT);
+    datFile.read(0, h, dataHeaderLen);
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    return readDictionary(header);
+}
+
 
 uint64_t
 FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
@@ -482,6 +522,37 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::ZStdDictionarySP
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if ( ! header.hasTag(ZSTD_DICTIONARY_KEY)) {
+        return {};
+    }
+    const vespalib::string & hex = header.getTag(ZSTD_DICTIONARY_KEY).asString();
+    std::vector<char> data(hex.size() / 2);
+    for (size_t i(0); i < data.size(); i++) {
+        data[i] = (from_hex(hex[2*i]) << 4) | from_hex(hex[2*i + 1]);
+    }
+    int level = header.hasTag(ZSTD_DICTIONARY_LEVEL_KEY) ? header.getTag(ZSTD_DICTIONARY_LEVEL_KEY).asInteger() : 9;
+    return std::make_shared<vespalib::compression::ZStdDictionary>(data.data(), data.size(), level);
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary)
+{
+    // Header string tags are zero terminated, so the binary dictionary is stored hex encoded.
+    vespalib::ConstBufferRef data = dictionary.getData();
+    vespalib::string hex;
+    hex.reserve(data.size() * 2);
+    for (size_t i(0); i < data.size(); i++) {
+        uint8_t byte = data.c_str()[i];
+        hex.push_back(hex_digits[byte >> 4]);
+        hex.push_back(hex_digits[byte & 0xf]);
+    }
+    header.putTag(vespalib::GenericHeader::Tag(ZSTD_DICTIONARY_KEY, hex));
+    header.putTag(vespalib::GenericHeader::Tag(ZSTD_DICTIONARY_LEVEL_KEY, int64_t(dictionary.getCompressionLevel())));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -496,7 +567,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
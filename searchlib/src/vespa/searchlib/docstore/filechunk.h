@@ -22,6 +22,8 @@ namespace vespalib {
     class Executor;
 }
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search {
 
 class DataStoreFileChunkStats;
@@ -106,6 +108,7 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using ZStdDictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -163,6 +166,11 @@ public:
     virtual vespalib::system_time getModificationTime() const;
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
+    /**
+     * Return the zstd dictionary stored in the data file header, if any.
+     * It is used for compressing and decompressing all chunks in the file.
+     */
+    const ZStdDictionarySP & getDictionary() const { return _dictionary; }
     void compact(const IGetLid & iGetLid);
     void appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteData & dest,
                   uint32_t numChunks, IFileChunkVisitorProgress *visitorProgress,
@@ -195,6 +203,10 @@ public:
      */
     static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit);
     static uint64_t readDataHeader(FileRandRead &idxFile);
+    /**
+     * Read the zstd dictionary from the data file header of the given length, if any.
+     */
+    static ZStdDictionarySP readDataHeaderDictionary(FileRandRead &datFile, uint64_t dataHeaderLen);
     static bool isIdxFileEmpty(const vespalib::string & name);
     static void eraseIdxFile(const vespalib::string & name);
     static void eraseDatFile(const vespalib::string & name);
@@ -236,9 +248,17 @@ protected:
 
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
-    void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    struct ChunkRange {
+        LidInfoWithLidV::const_iterator begin;
+        size_t                          count;
+        ChunkInfo                       chunkInfo;
+    };
+    // Reads all the chunks as one batch before visiting the lids in them.
+    void read(const std::vector<ChunkRange> & ranges, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static ZStdDictionarySP readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary);
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer   * _bucketizer;
@@ -253,6 +273,7 @@ protected:
     uint32_t              _numLids;
     uint32_t              _docIdLimit; // Limit when the file was created. Stored in idx file header.
     vespalib::system_time  _modificationTime;
+    ZStdDictionarySP      _dictionary; // Stored in dat file header.
 };
 
 } // namespace search
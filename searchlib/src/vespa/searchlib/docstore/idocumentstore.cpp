@@ -2,6 +2,8 @@
 
 #include "idocumentstore.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/serialization/lazydocumentview.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 namespace search {
 
@@ -11,4 +13,15 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+IDocumentStore::DocumentViewUP
+IDocumentStore::readLazy(DocumentIdT lid, const document::DocumentTypeRepo &repo) const {
+    DocumentUP doc = read(lid, repo);
+    if ( ! doc) {
+        return DocumentViewUP();
+    }
+    vespalib::nbostream stream;
+    doc->serialize(stream);
+    return std::make_unique<document::LazyDocumentView>(repo, stream);
+}
+
 } // namespace search
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idatastore.h"
+#include "visit_cache_shard_stats.h"
 #include <vespa/searchlib/common/i_compactable_lid_space.h>
 #include <vespa/searchlib/query/base.h>
 #include <future>
@@ -10,6 +11,7 @@
 namespace document {
     class Document;
     class DocumentTypeRepo;
+    class LazyDocumentView;
 }
 
 namespace vespalib {
@@ -48,6 +50,7 @@ class IDocumentVisitor
 {
 public:
     using DocumentUP = std::unique_ptr<document::Document>;
+    using DocumentViewUP = std::unique_ptr<document::LazyDocumentView>;
     virtual ~IDocumentVisitor() = default;
     virtual void visit(uint32_t lid, DocumentUP doc) = 0;
     virtual bool allowVisitCaching() const = 0;
@@ -68,6 +71,7 @@ public:
     using SP = std::shared_ptr<IDocumentStore>;
     using LidVector = std::vector<uint32_t>;
     using DocumentUP = std::unique_ptr<document::Document>;
+    using DocumentViewUP = std::unique_ptr<document::LazyDocumentView>;
 
     /**
      * Make a Document from a stored serialized data blob.
@@ -75,6 +79,12 @@ public:
      * @return NULL if there is no document associated with the lid.
      **/
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
+    /**
+     * Make a view of a stored serialized data blob where fields are only decoded when accessed.
+     * @param lid The local ID associated with the document.
+     * @return NULL if there is no document associated with the lid.
+     **/
+    virtual DocumentViewUP readLazy(DocumentIdT lid, const document::DocumentTypeRepo &repo) const;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     /**
@@ -166,6 +176,11 @@ public:
      */
     virtual vespalib::CacheStats getCacheStats() const = 0;
 
+    /**
+     * Returns statistics about each shard of the visit cache.
+     */
+    virtual std::vector<VisitCacheShardStats> getVisitCacheShardStats() const = 0;
+
     /**
      * Returns the base directory from which all structures are stored.
      **/
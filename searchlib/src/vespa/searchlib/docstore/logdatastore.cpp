@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <thread>
 #include <cassert>
 
@@ -45,6 +46,7 @@ LogDataStore::Config::Config()
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
       _skipCrcOnRead(false),
       _compactCompression(CompressionConfig::LZ4),
+      _zstdDictionarySize(0),
       _fileConfig()
 { }
 
@@ -55,6 +57,7 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
+            (_zstdDictionarySize == rhs._zstdDictionarySize) &&
             (_fileConfig == rhs._fileConfig);
 }
 
@@ -78,7 +81,8 @@ LogDataStore::LogDataStore(vespalib::Executor &executor, const vespalib::string
       _tlSyncer(tlSyncer),
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _dictionary()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
@@ -439,6 +443,27 @@ void LogDataStore::setNewFileChunk(const MonitorGuard & guard, FileChunk::UP fil
     _fileChunks[fileId] = std::move(file);
 }
 
+void
+LogDataStore::trainDictionary(FileChunk & fileChunk)
+{
+    const size_t dictionarySize = _config.getZStdDictionarySize();
+    // zstd recommends roughly 100 times the dictionary size as training data.
+    docstore::DictionarySampler sampler(dictionarySize * 100);
+    uint32_t numChunks = std::min(fileChunk.getNumChunks(),
+                                  uint32_t(sampler.getMaxBytes() / _config.getFileConfig().getMaxChunkBytes() + 1));
+    fileChunk.appendTo(_executor, *this, sampler, numChunks, nullptr, CpuCategory::COMPACT);
+    auto dictionary = sampler.train(dictionarySize, _config.getFileConfig().getCompression().compressionLevel);
+    if (dictionary) {
+        LOG(info, "Trained zstd dictionary %u of %zu bytes from %zu samples in file '%s'",
+            dictionary->getId(), dictionary->getData().size(), sampler.getNumSamples(), fileChunk.getName().c_str());
+        MonitorGuard guard(_updateLock);
+        _dictionary = std::move(dictionary);
+    } else {
+        LOG(debug, "Not enough samples (%zu) in file '%s' to train a zstd dictionary",
+            sampler.getNumSamples(), fileChunk.getName().c_str());
+    }
+}
+
 void LogDataStore::compactFile(FileId fileId)
 {
     FileChunk::UP & fc(_fileChunks[fileId.getId()]);
@@ -447,6 +472,9 @@ void LogDataStore::compactFile(FileId fileId)
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
     IWriteData::UP compacter;
     FileId destinationFileId = FileId::active();
+    if ((_config.getZStdDictionarySize() > 0) && (_config.getFileConfig().getCompression().type == CompressionConfig::ZSTD)) {
+        trainDictionary(*fc);
+    }
     if (_bucketizer) {
         size_t disk_footprint = fc->getDiskFootprint();
         size_t disk_bloat = fc->getDiskBloat();
@@ -644,9 +672,10 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
         }
     }
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
+    auto dictionary = (_config.getZStdDictionarySize() > 0) ? _dictionary : FileChunk::ZStdDictionarySP();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
                                                       _config.getFileConfig(), _tune, _fileHeaderContext,
-                                                      _bucketizer.get(), _config.crcOnReadDisabled());
+                                                      _bucketizer.get(), _config.crcOnReadDisabled(), std::move(dictionary));
     file->enableRead();
     return file;
 }
@@ -778,6 +807,9 @@ LogDataStore::preload()
         typedef NameIdSet::const_iterator It;
         for (It it(partList.begin()), mt(--partList.end()); it != mt; it++) {
             _fileChunks.push_back(createReadOnlyFile(FileId(_fileChunks.size()), *it));
+            if (_fileChunks.back()->getDictionary()) {
+                _dictionary = _fileChunks.back()->getDictionary();
+            }
         }
         _fileChunks.push_back(isReadOnly()
             ? createReadOnlyFile(FileId(_fileChunks.size()), *partList.rbegin())
@@ -50,6 +50,7 @@ public:
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
+        Config & setZStdDictionarySize(size_t v) { _zstdDictionarySize = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
@@ -59,6 +60,11 @@ public:
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         const CompressionConfig & compactCompression() const { return _compactCompression; }
+        /**
+         * Max size of the zstd dictionary trained when compacting a file. The dictionary is
+         * stored in the header of new files and used for all their chunks. 0 disables training.
+         */
+        size_t getZStdDictionarySize() const { return _zstdDictionarySize; }
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
         Config & disableCrcOnRead(bool v) { _skipCrcOnRead = v; return *this;}
@@ -71,6 +77,7 @@ public:
         uint32_t                    _maxNumLids;
         bool                        _skipCrcOnRead;
         CompressionConfig           _compactCompression;
+        size_t                      _zstdDictionarySize;
         WriteableFileChunk::Config  _fileConfig;
     };
 public:
@@ -226,6 +233,7 @@ private:
     void updateSerialNum();
 
     size_t computeNumberOfSignificantBucketIdBits(const IBucketizer & bucketizer, FileId fileId) const;
+    void trainDictionary(FileChunk & fileChunk);
 
     /*
      * Protect against compactWorst() dropping file chunk.  Caller must hold
@@ -269,6 +277,7 @@ private:
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    FileChunk::ZStdDictionarySP              _dictionary; // Used for new files. Protected by _updateLock.
 };
 
 } // namespace search
@@ -0,0 +1,15 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "randread.h"
+
+namespace search {
+
+void
+FileRandRead::readBatch(std::span<ReadRequest> requests)
+{
+    for (ReadRequest & request : requests) {
+        request.keepAlive = read(request.offset, *request.buffer, request.sz);
+    }
+}
+
+}
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 class FastOS_FileInterface;
 
@@ -17,7 +18,18 @@ class FileRandRead
 public:
     typedef std::shared_ptr<FastOS_FileInterface> FSP;
     virtual ~FileRandRead() { }
+    struct ReadRequest {
+        size_t                 offset;
+        size_t                 sz;
+        vespalib::DataBuffer * buffer;
+        FSP                    keepAlive;
+    };
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Perform a batch of reads, filling in buffer and keepAlive of each request
+     * as read() would have. The default implementation performs them one by one.
+     */
+    virtual void readBatch(std::span<ReadRequest> requests);
     virtual int64_t getSize() = 0;
 };
 
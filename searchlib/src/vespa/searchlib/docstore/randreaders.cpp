@@ -3,7 +3,12 @@
 #include "randreaders.h"
 #include "summaryexceptions.h"
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/io/io_uring_reader.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/fastos/file.h>
+#include <cinttypes>
+#include <fcntl.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.docstore.randreaders");
@@ -167,4 +172,57 @@ NormalRandRead::getSize()
     return _file->GetSize();
 }
 
+IoUringRandRead::IoUringRandRead(const vespalib::string & fileName, int fadviseOptions)
+    : _file(std::make_unique<vespalib::File>(fileName))
+{
+    _file->open(vespalib::File::READONLY);
+#ifdef __linux__
+    if (fadviseOptions != 0) {
+        posix_fadvise(_file->getFileDescriptor(), 0, 0, fadviseOptions);
+    }
+#else
+    (void) fadviseOptions;
+#endif
+}
+
+IoUringRandRead::~IoUringRandRead() = default;
+
+FileRandRead::FSP
+IoUringRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
+{
+    ReadRequest request{offset, sz, &buffer, FSP()};
+    readBatch(std::span<ReadRequest>(&request, 1));
+    return FSP();
+}
+
+void
+IoUringRandRead::readBatch(std::span<ReadRequest> requests)
+{
+    using Request = vespalib::IoUringReader::Request;
+    std::vector<Request> reads;
+    reads.reserve(requests.size());
+    for (ReadRequest & request : requests) {
+        request.buffer->clear();
+        request.buffer->ensureFree(request.sz);
+        reads.emplace_back(_file->getFileDescriptor(), request.buffer->getFree(), request.sz, request.offset);
+    }
+    vespalib::IoUringReader::thread_local_instance().read(reads);
+    for (size_t i(0); i < requests.size(); i++) {
+        const Request & read = reads[i];
+        if (read.result != ssize_t(read.len)) {
+            int error = (read.result < 0) ? -read.result : 0;
+            throw vespalib::IoException(vespalib::make_string("Failed reading %zu bytes at offset %" PRIu64 " from file '%s', got %zd",
+                                                              read.len, read.offset, _file->getFilename().c_str(), read.result),
+                                        vespalib::IoException::getErrorType(error), VESPA_STRLOC);
+        }
+        requests[i].buffer->moveFreeToData(requests[i].sz);
+    }
+}
+
+int64_t
+IoUringRandRead::getSize()
+{
+    return _file->getFileSize();
+}
+
 }
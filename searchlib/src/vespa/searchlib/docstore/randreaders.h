@@ -8,6 +8,8 @@
 
 class FastOS_FileInterface;
 
+namespace vespalib { class File; }
+
 namespace search {
 
 class DirectIORandRead : public FileRandRead
@@ -60,4 +62,21 @@ private:
     std::unique_ptr<FastOS_FileInterface>  _file;
 };
 
+/**
+ * Reads using io_uring, submitting all reads of a batch at once so that
+ * they are in flight concurrently instead of being issued one by one by
+ * the calling thread. Falls back to pread if io_uring is unavailable.
+ */
+class IoUringRandRead : public FileRandRead
+{
+public:
+    IoUringRandRead(const vespalib::string & fileName, int fadviseOptions);
+    ~IoUringRandRead() override;
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    void readBatch(std::span<ReadRequest> requests) override;
+    int64_t getSize() override;
+private:
+    std::unique_ptr<vespalib::File>  _file;
+};
+
 }
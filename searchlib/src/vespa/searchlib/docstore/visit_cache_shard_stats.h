@@ -0,0 +1,24 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+
+namespace search {
+
+/*
+ * Cache statistics for a single shard of the document store visit cache.
+ * Evictions are the cached sets that have left the shard due to memory
+ * pressure, i.e. without being invalidated.
+ */
+struct VisitCacheShardStats {
+    vespalib::CacheStats stats;
+    size_t evictions;
+
+    VisitCacheShardStats(const vespalib::CacheStats &stats_in, size_t evictions_in)
+        : stats(stats_in),
+          evictions(evictions_in)
+    { }
+};
+
+} // namespace search
@@ -154,16 +154,71 @@ VisitCache::BackingStore::reconfigure(const CompressionConfig &compression) {
 }
 
 
-VisitCache::VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression) :
+VisitCache::KeyShards::KeyShards() = default;
+VisitCache::KeyShards::~KeyShards() = default;
+
+void
+VisitCache::KeyShards::add(const KeySet & keys, uint32_t shardId) {
+    std::lock_guard guard(_lock);
+    for (uint32_t key : keys.getKeys()) {
+        _shards[key] |= (ShardMask(1) << shardId);
+    }
+}
+
+void
+VisitCache::KeyShards::remove(const KeySet & keys, uint32_t shardId) {
+    std::lock_guard guard(_lock);
+    for (uint32_t key : keys.getKeys()) {
+        auto found = _shards.find(key);
+        if (found != _shards.end()) {
+            found->second &= ~(ShardMask(1) << shardId);
+            if (found->second == 0) {
+                _shards.erase(found);
+            }
+        }
+    }
+}
+
+VisitCache::KeyShards::ShardMask
+VisitCache::KeyShards::shardsContaining(const KeySet & keys) const {
+    ShardMask mask = 0;
+    std::lock_guard guard(_lock);
+    for (uint32_t key : keys.getKeys()) {
+        auto found = _shards.find(key);
+        if (found != _shards.end()) {
+            mask |= found->second;
+        }
+    }
+    return mask;
+}
+
+VisitCache::KeyShards::ShardMask
+VisitCache::KeyShards::shardsContaining(uint32_t key) const {
+    std::lock_guard guard(_lock);
+    auto found = _shards.find(key);
+    return (found != _shards.end()) ? found->second : 0;
+}
+
+VisitCache::VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression, uint32_t numShards) :
     _store(store, compression),
-    _cache(std::make_unique<Cache>(_store, cacheSize))
+    _keyShards(),
+    _shards()
 {
+    numShards = std::clamp(numShards, 1u, MAX_SHARDS);
+    _shards.reserve(numShards);
+    for (uint32_t i = 0; i < numShards; i++) {
+        _shards.push_back(std::make_unique<Cache>(_store, cacheSize / numShards, _keyShards, i));
+    }
 }
 
+VisitCache::~VisitCache() = default;
+
 void
 VisitCache::reconfigure(size_t cacheSize, const CompressionConfig &compression) {
     _store.reconfigure(compression);
-    _cache->setCapacityBytes(cacheSize);
+    for (auto & shard : _shards) {
+        shard->setCapacityBytes(cacheSize / _shards.size());
+    }
 }
 
 
@@ -179,24 +234,10 @@ VisitCache::Cache::findSetsContaining(const UniqueLock &, const KeySet & keys) c
     return found;
 }
 
-CompressedBlobSet
-VisitCache::Cache::readSet(const KeySet & key)
-{
-    if (!key.empty()) {
-        {
-            auto cacheGuard = getGuard();
-            if (!hasKey(cacheGuard, key)) {
-                locateAndInvalidateOtherSubsets(cacheGuard, key);
-            }
-        }
-        return read(key);
-    }
-    return CompressedBlobSet();
-}
-
 void
-VisitCache::Cache::locateAndInvalidateOtherSubsets(const UniqueLock & cacheGuard, const KeySet & keys)
+VisitCache::Cache::invalidateOtherSubsets(const KeySet & keys)
 {
+    auto cacheGuard = getGuard();
     // Due to the implementation of insert where the global lock is released and the fact
     // that 2 overlapping keysets kan have different keys and use different ValueLock
     // We do have a theoretical issue.
@@ -212,21 +253,61 @@ VisitCache::Cache::locateAndInvalidateOtherSubsets(const UniqueLock & cacheGuard
 
 CompressedBlobSet
 VisitCache::read(const IDocumentStore::LidVector & lids) const {
-    return _cache->readSet(KeySet(lids));
+    KeySet key(lids);
+    if (key.empty()) {
+        return CompressedBlobSet();
+    }
+    Cache & shard = getShard(key);
+    if (!shard.hasKey(key)) {
+        forEachShard(_keyShards.shardsContaining(key), [&key](Cache & other) {
+            other.invalidateOtherSubsets(key);
+        });
+    }
+    return shard.read(key);
 }
 
 void
 VisitCache::remove(uint32_t key) {
-    _cache->removeKey(key);
+    forEachShard(_keyShards.shardsContaining(key), [key](Cache & shard) {
+        shard.removeKey(key);
+    });
+}
+
+template <typename Func>
+void
+VisitCache::forEachShard(KeyShards::ShardMask mask, Func func) const {
+    for (uint32_t shardId = 0; mask != 0; shardId++, mask >>= 1) {
+        if (mask & 1) {
+            func(*_shards[shardId]);
+        }
+    }
 }
 
 CacheStats
 VisitCache::getCacheStats() const {
-    return _cache->get_stats();
+    CacheStats stats;
+    for (const auto & shard : _shards) {
+        stats += shard->get_stats();
+    }
+    return stats;
+}
+
+std::vector<VisitCacheShardStats>
+VisitCache::getShardStats() const {
+    std::vector<VisitCacheShardStats> result;
+    result.reserve(_shards.size());
+    for (const auto & shard : _shards) {
+        result.emplace_back(shard->get_stats(), shard->getEvict());
+    }
+    return result;
 }
 
-VisitCache::Cache::Cache(BackingStore & b, size_t maxBytes) :
-    Parent(b, maxBytes)
+VisitCache::Cache::Cache(BackingStore & b, size_t maxBytes, KeyShards & keyShards, uint32_t shardId) :
+    Parent(b, maxBytes),
+    _lid2Id(),
+    _id2KeySet(),
+    _keyShards(keyShards),
+    _shardId(shardId)
 { }
 
 VisitCache::Cache::~Cache() = default;
@@ -249,6 +330,7 @@ VisitCache::Cache::onInsert(const K & key) {
     for(uint32_t subKey : key.getKeys()) {
         _lid2Id[subKey] = first;
     }
+    _keyShards.add(key, _shardId);
 }
 
 void
@@ -257,6 +339,7 @@ VisitCache::Cache::onRemove(const K & key) {
         _lid2Id.erase(subKey);
     }
     _id2KeySet.erase(key.getKeys().front());
+    _keyShards.remove(key, _shardId);
 }
 
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idocumentstore.h"
+#include "visit_cache_shard_stats.h"
 #include <vespa/vespalib/stllike/cache.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/stllike/hash_map.h>
@@ -11,6 +12,7 @@
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/util/bytebuffer.h>
+#include <mutex>
 
 namespace search::docstore {
 
@@ -94,17 +96,26 @@ private:
  * Caches a set of objects as a set.
  * The objects are compressed together as a set.
  * The whole set is invalidated when one object of its objects are removed.
+ *
+ * The sets are spread over a number of independently locked shards based on
+ * their lowest key, each shard having an equal share of the memory budget.
+ * An index of which shards hold a set containing a given key is kept so that
+ * invalidation only needs to lock the shards actually affected.
  **/
 class VisitCache {
 public:
     using CompressionConfig = vespalib::compression::CompressionConfig;
-    VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression);
+    static constexpr uint32_t MAX_SHARDS = 64;
+    VisitCache(IDataStore &store, size_t cacheSize, const CompressionConfig &compression, uint32_t numShards = 1);
+    ~VisitCache();
 
     CompressedBlobSet read(const IDocumentStore::LidVector & keys) const;
     void remove(uint32_t key);
     void invalidate(uint32_t key) { remove(key); }
 
     vespalib::CacheStats getCacheStats() const;
+    std::vector<VisitCacheShardStats> getShardStats() const;
+    uint32_t getNumShards() const { return _shards.size(); }
     void reconfigure(size_t cacheSize, const CompressionConfig &compression);
 private:
     /**
@@ -136,6 +147,25 @@ private:
                             vespalib::size<CompressedBlobSet>
                         >;
 
+    /**
+     * Tracks, for each key, the set of shards holding a cached set containing it.
+     * Updated by the shards under their own lock, so it must never be held while
+     * taking a shard lock.
+     */
+    class KeyShards {
+    public:
+        using ShardMask = uint64_t;
+        KeyShards();
+        ~KeyShards();
+        void add(const KeySet & keys, uint32_t shardId);
+        void remove(const KeySet & keys, uint32_t shardId);
+        ShardMask shardsContaining(const KeySet & keys) const;
+        ShardMask shardsContaining(uint32_t key) const;
+    private:
+        mutable std::mutex                       _lock;
+        vespalib::hash_map<uint32_t, ShardMask>  _shards;
+    };
+
     /**
      * This extends the default thread safe cache implementation so that
      * it will correctly invalidate the cached sets when objects are removed/updated.
@@ -144,12 +174,11 @@ private:
      */
     class Cache : public vespalib::cache<CacheParams> {
     public:
-        Cache(BackingStore & b, size_t maxBytes);
+        Cache(BackingStore & b, size_t maxBytes, KeyShards & keyShards, uint32_t shardId);
         ~Cache();
-        CompressedBlobSet readSet(const KeySet & keys);
         void removeKey(uint32_t key);
+        void invalidateOtherSubsets(const KeySet & keys);
     private:
-        void locateAndInvalidateOtherSubsets(const UniqueLock & cacheGuard, const KeySet & keys);
         using IdSet = vespalib::hash_set<uint64_t>;
         using Parent = vespalib::cache<CacheParams>;
         using LidUniqueKeySetId = vespalib::hash_map<uint32_t, uint64_t>;
@@ -159,10 +188,17 @@ private:
         void onRemove(const K & key) override;
         LidUniqueKeySetId _lid2Id;
         IdKeySetMap       _id2KeySet;
+        KeyShards       & _keyShards;
+        uint32_t          _shardId;
     };
 
-    BackingStore            _store;
-    std::unique_ptr<Cache>  _cache;
+    Cache & getShard(const KeySet & keys) const { return *_shards[keys.hash() % _shards.size()]; }
+    template <typename Func>
+    void forEachShard(KeyShards::ShardMask mask, Func func) const;
+
+    BackingStore                        _store;
+    mutable KeyShards                   _keyShards;
+    std::vector<std::unique_ptr<Cache>> _shards;
 };
 
 }
@@ -11,6 +11,7 @@
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.onnx_feature");
@@ -72,22 +73,96 @@ vespalib::string my_dry_run(const Onnx &model, const Onnx::WireInfo &wire) {
 } // <unnamed>
 
 /**
- * Feature executor that evaluates an onnx model
+ * Feature executor that evaluates an onnx model. If the model has a
+ * batch dimension, documents collected before a flush are evaluated
+ * by a single model invocation as long as all inputs without the
+ * batch dimension are equal for the documents in the batch. Other
+ * documents are evaluated one by one.
  */
 class OnnxFeatureExecutor : public FeatureExecutor
 {
 private:
     Onnx::EvalContext _eval_context;
+    std::unique_ptr<Onnx::BatchEvalContext> _batch_context;
+    std::vector<uint32_t> _batch_docids;
+    bool _batch_valid;
+    bool _batch_flushed;
+
+    template <typename CTX>
+    void bind_results(const CTX &ctx) {
+        for (size_t i = 0; i < ctx.num_results(); ++i) {
+            outputs().set_object(i, ctx.get_result(i));
+        }
+    }
+    bool select_batch_result(uint32_t docid) {
+        if (!_batch_flushed) {
+            return false;
+        }
+        auto pos = std::find(_batch_docids.begin(), _batch_docids.end(), docid);
+        if (pos == _batch_docids.end()) {
+            return false;
+        }
+        _batch_context->select_result(pos - _batch_docids.begin());
+        bind_results(*_batch_context);
+        return true;
+    }
 public:
-    OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info)
-        : _eval_context(model, wire_info) {}
+    OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info, size_t batch_size)
+        : _eval_context(model, wire_info),
+          _batch_context(),
+          _batch_docids(),
+          _batch_valid(true),
+          _batch_flushed(false)
+    {
+        if (batch_size > 1) {
+            _batch_context = std::make_unique<Onnx::BatchEvalContext>(model, wire_info, batch_size);
+            _batch_docids.reserve(batch_size);
+        }
+    }
     bool isPure() override { return true; }
+    size_t max_batch_size() const override {
+        return _batch_context ? _batch_context->max_batch_size() : 1;
+    }
     void handle_bind_outputs(vespalib::ArrayRef<fef::NumberOrObject>) override {
-        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
-            outputs().set_object(i, _eval_context.get_result(i));
+        bind_results(_eval_context);
+    }
+    void handle_collect(uint32_t docid) override {
+        if (_batch_flushed) {
+            _batch_docids.clear();
+            _batch_valid = true;
+            _batch_flushed = false;
+        }
+        if (!_batch_valid || (_batch_docids.size() == _batch_context->max_batch_size())) {
+            _batch_valid = false;
+            return;
         }
+        size_t doc = _batch_docids.size();
+        for (size_t i = 0; i < _batch_context->num_params(); ++i) {
+            if (!_batch_context->bind_param(doc, i, inputs().get_object(i).get())) {
+                _batch_valid = false;
+                return;
+            }
+        }
+        _batch_docids.push_back(docid);
     }
-    void execute(uint32_t) override {
+    void handle_flush_batch() override {
+        _batch_flushed = true;
+        if (!_batch_valid || _batch_docids.empty()) {
+            _batch_docids.clear();
+            return;
+        }
+        try {
+            _batch_context->eval(_batch_docids.size());
+        } catch (const Ort::Exception &ex) {
+            Issue::report("onnx model batch evaluation failed: %s", ex.what());
+            _batch_docids.clear();
+        }
+    }
+    void execute(uint32_t docid) override {
+        if (select_batch_result(docid)) {
+            return;
+        }
+        bind_results(_eval_context);
         for (size_t i = 0; i < _eval_context.num_params(); ++i) {
             _eval_context.bind_param(i, inputs().get_object(i).get());
         }
@@ -105,7 +180,8 @@ OnnxBlueprint::OnnxBlueprint(vespalib::stringref baseName)
       _cache_token(),
       _debug_model(),
       _model(nullptr),
-      _wire_info()
+      _wire_info(),
+      _batch_size(1)
 {
     assert((baseName == "onnx") || (baseName == "onnxModel"));
 }
@@ -166,6 +242,15 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
         describeOutput(output_name.value(), "output from onnx model", FeatureType::object(output_type));
     }
     _wire_info = planner.get_wire_info(*_model);
+    _batch_size = 1;
+    if (model_cfg->batch_size() > 1) {
+        if (Onnx::BatchEvalContext::find_batch_dimension(*_model, _wire_info).empty()) {
+            LOG(warning, "onnx model '%s' has no batch dimension, evaluating one document at a time",
+                model_cfg->name().c_str());
+        } else {
+            _batch_size = model_cfg->batch_size();
+        }
+    }
     if (model_cfg->dry_run_on_setup()) {
         auto error_msg = my_dry_run(*_model, _wire_info);
         if (!error_msg.empty()) {
@@ -181,7 +266,7 @@ FeatureExecutor &
 OnnxBlueprint::createExecutor(const IQueryEnvironment &, Stash &stash) const
 {
     assert(_model != nullptr);
-    return stash.create<OnnxFeatureExecutor>(*_model, _wire_info);
+    return stash.create<OnnxFeatureExecutor>(*_model, _wire_info, _batch_size);
 }
 
 }
@@ -0,0 +1,103 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "shared_subexpressions.h"
+#include "feature_name_extractor.h"
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/tensor_nodes.h>
+#include <vespa/searchlib/fef/featurenamebuilder.h>
+#include <set>
+
+using vespalib::eval::Function;
+using vespalib::eval::nodes::DumpContext;
+using vespalib::eval::nodes::Node;
+using vespalib::eval::nodes::TensorReduce;
+using vespalib::eval::nodes::as;
+
+namespace search::features::rankingexpression {
+
+namespace {
+
+bool is_full_reduce(const Node &node) {
+    auto reduce = as<TensorReduce>(node);
+    return (reduce && reduce->dimensions().empty());
+}
+
+// The rewritten expression is produced by dumping the original one
+// and replacing the dumped form of each split out reduction with the
+// name of the feature calculating it.
+struct Rewriter {
+    DumpContext ctx;
+    std::set<vespalib::string> features;
+    bool failed;
+    explicit Rewriter(const std::vector<vespalib::string> &params)
+        : ctx(params), features(), failed(false) {}
+    // returns the rewritten form of 'node', or an empty string if it is unchanged
+    vespalib::string rewrite(const Node &node, bool is_root) {
+        if (!is_root && is_full_reduce(node)) {
+            auto name = fef::FeatureNameBuilder().baseName("rankingExpression").parameter(node.dump(ctx)).buildName();
+            features.insert(name);
+            return name;
+        }
+        if (node.num_children() == 0) {
+            return "";
+        }
+        // Each child is located after the previous one, also when the
+        // previous one was left unchanged. Otherwise the dumped form of a
+        // later child could be matched inside an earlier one (like the
+        // body of a tensor lambda, which is not an AST child).
+        vespalib::string str = node.dump(ctx);
+        bool changed = false;
+        size_t pos = 0;
+        for (size_t i = 0; !failed && (i < node.num_children()); ++i) {
+            const Node &child = node.get_child(i);
+            vespalib::string new_child = rewrite(child, false);
+            vespalib::string old_child = child.dump(ctx);
+            size_t child_pos = str.find(old_child, pos);
+            if (child_pos == vespalib::string::npos) {
+                failed = true;
+                return "";
+            }
+            if (new_child.empty()) {
+                pos = child_pos + old_child.size();
+            } else {
+                str.replace(child_pos, old_child.size(), new_child);
+                pos = child_pos + new_child.size();
+                changed = true;
+            }
+        }
+        return changed ? str : "";
+    }
+};
+
+} // namespace search::features::rankingexpression::<unnamed>
+
+std::shared_ptr<Function const>
+extract_shared_subexpressions(const Function &function, std::set<vespalib::string> &shared_features)
+{
+    std::vector<vespalib::string> params;
+    for (size_t i = 0; i < function.num_params(); ++i) {
+        params.emplace_back(function.param_name(i));
+    }
+    Rewriter rewriter(params);
+    vespalib::string script = rewriter.rewrite(function.root(), true);
+    if (rewriter.failed || script.empty()) {
+        return {};
+    }
+    auto result = Function::parse(script, FeatureNameExtractor());
+    if (result->has_error()) {
+        return {};
+    }
+    std::set<vespalib::string> result_params;
+    for (size_t i = 0; i < result->num_params(); ++i) {
+        result_params.emplace(result->param_name(i));
+    }
+    for (const auto &feature: rewriter.features) {
+        if (result_params.count(feature) == 0) {
+            return {};
+        }
+    }
+    shared_features = std::move(rewriter.features);
+    return result;
+}
+
+}
@@ -0,0 +1,30 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <set>
+
+namespace vespalib::eval { class Function; }
+
+namespace search::features::rankingexpression {
+
+/**
+ * Rewrite a ranking expression so that each full tensor reduction
+ * nested inside it becomes an input feature of its own; a
+ * rankingExpression feature whose parameter is the canonical form of
+ * the reduction. The blueprint resolver only sets up one feature
+ * executor per feature name, which means that a reduction used by
+ * several expressions in the same rank program (like a query/document
+ * embedding dot product used both by a function and by the expression
+ * calculating rank) will only be evaluated once per document. Note
+ * that the expression itself is never replaced as a whole. The names
+ * of the features calculating the split out reductions are stored in
+ * 'shared_features'. Returns nullptr if there is nothing to split out
+ * or if the rewritten expression could not be verified.
+ **/
+std::shared_ptr<vespalib::eval::Function const>
+extract_shared_subexpressions(const vespalib::eval::Function &function, std::set<vespalib::string> &shared_features);
+
+}
@@ -5,9 +5,11 @@
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
+#include <vespa/searchlib/features/rankingexpression/shared_subexpressions.h>
 #include <vespa/eval/eval/param_usage.h>
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.rankingexpression");
@@ -45,18 +47,31 @@ vespalib::string list_issues(const std::vector<vespalib::string> &issues) {
 //-----------------------------------------------------------------------------
 
 /**
- * Implements the executor for fast forest gbdt evaluation
+ * Implements the executor for fast forest gbdt evaluation. Documents
+ * collected before a flush are evaluated together.
  **/
 class FastForestExecutor : public fef::FeatureExecutor
 {
 private:
+    static constexpr size_t batch_size = 16;
+
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     ArrayRef<float> _params;
+    std::vector<float> _batch_params;
+    std::vector<uint32_t> _batch_docids;
+    std::vector<double> _batch_results;
+    bool _batch_flushed;
+
+    void fetch_params(float *dst) const;
 
 public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
+    ~FastForestExecutor() override;
     bool isPure() override { return true; }
+    size_t max_batch_size() const override { return batch_size; }
+    void handle_collect(uint32_t docId) override;
+    void handle_flush_batch() override;
     void execute(uint32_t docId) override;
 };
 
@@ -151,24 +166,67 @@ public:
 FastForestExecutor::FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _batch_params(batch_size * param_space.size(), 0.0),
+      _batch_docids(),
+      _batch_results(batch_size, 0.0),
+      _batch_flushed(false)
 {
+    _batch_docids.reserve(batch_size);
 }
 
+FastForestExecutor::~FastForestExecutor() = default;
+
 void
-FastForestExecutor::execute(uint32_t)
+FastForestExecutor::fetch_params(float *dst) const
 {
     size_t i = 0;
     for (; (i + 3) < _params.size(); i += 4) {
-        _params[i+0] = inputs().get_number(i+0);
-        _params[i+1] = inputs().get_number(i+1);
-        _params[i+2] = inputs().get_number(i+2);
-        _params[i+3] = inputs().get_number(i+3);
+        dst[i+0] = inputs().get_number(i+0);
+        dst[i+1] = inputs().get_number(i+1);
+        dst[i+2] = inputs().get_number(i+2);
+        dst[i+3] = inputs().get_number(i+3);
     }
     for (; i < _params.size(); ++i) {
-        _params[i] = inputs().get_number(i);
+        dst[i] = inputs().get_number(i);
+    }
+}
+
+void
+FastForestExecutor::handle_collect(uint32_t docId)
+{
+    if (_batch_flushed) {
+        _batch_docids.clear();
+        _batch_flushed = false;
+    }
+    if (_batch_docids.size() < batch_size) {
+        fetch_params(_batch_params.data() + (_batch_docids.size() * _params.size()));
+        _batch_docids.push_back(docId);
     }
-    outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
+}
+
+void
+FastForestExecutor::handle_flush_batch()
+{
+    _batch_flushed = true;
+    if (!_batch_docids.empty()) {
+        _forest.eval_batch(*_ctx, _batch_params.data(), _params.size(),
+                           _batch_docids.size(), _batch_results.data());
+    }
+}
+
+void
+FastForestExecutor::execute(uint32_t docId)
+{
+    if (_batch_flushed) {
+        auto pos = std::find(_batch_docids.begin(), _batch_docids.end(), docId);
+        if (pos != _batch_docids.end()) {
+            outputs().set_number(0, _batch_results[pos - _batch_docids.begin()]);
+            return;
+        }
+    }
+    fetch_params(_params.data());
+    outputs().set_number(0, _forest.eval(*_ctx, _params.data()));
 }
 
 //-----------------------------------------------------------------------------
@@ -302,11 +360,22 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
         describeOutput("out", "result of intrinsic expression", _intrinsic_expression->result_type());
         return true;
     }
+    std::set<vespalib::string> shared_features;
+    if (fef::indexproperties::eval::ShareSubexpressions::check(env.getProperties())) {
+        if (auto shared = rankingexpression::extract_shared_subexpressions(*rank_function, shared_features)) {
+            LOG(debug, "%s: reductions calculated as separate features: %s", getName().c_str(), shared->dump().c_str());
+            rank_function = std::move(shared);
+        }
+    }
     bool do_compile = true;
     bool dependency_error = false;
     std::vector<ValueType> input_types;
     for (size_t i = 0; i < rank_function->num_params(); ++i) {
-        if (auto maybe_input = defineInput(rank_function->param_name(i), AcceptInput::ANY)) {
+        vespalib::string input_name = rank_function->param_name(i);
+        auto maybe_input = (shared_features.count(input_name) > 0)
+                           ? defineSharedInput(input_name, AcceptInput::ANY)
+                           : defineInput(input_name, AcceptInput::ANY);
+        if (maybe_input) {
             const FeatureType &input = maybe_input.value();
             _input_is_object.push_back(char(input.is_object()));
             if (input.is_object()) {
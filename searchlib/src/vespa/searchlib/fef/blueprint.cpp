@@ -14,6 +14,14 @@ Blueprint::defineInput(vespalib::stringref inName, AcceptInput accept)
     return _dependency_handler->resolve_input(inName, accept);
 }
 
+std::optional<FeatureType>
+Blueprint::defineSharedInput(vespalib::stringref inName, AcceptInput accept)
+{
+    assert(_dependency_handler != nullptr);
+    _dependency_handler->mark_shared_input(inName);
+    return _dependency_handler->resolve_input(inName, accept);
+}
+
 void
 Blueprint::describeOutput(vespalib::stringref outName,
                           vespalib::stringref desc,
@@ -47,6 +47,8 @@ public:
         virtual std::optional<FeatureType> resolve_input(const vespalib::string &feature_name, AcceptInput accept_type) = 0;
         virtual void define_output(const vespalib::string &output_name, FeatureType type) = 0;
         virtual void fail(const vespalib::string &msg) = 0;
+        // the given input is a subexpression split out to be shared with other features
+        virtual void mark_shared_input(const vespalib::string &feature_name) { (void) feature_name; }
         virtual ~DependencyHandler() = default;
     };
 
@@ -92,6 +94,17 @@ protected:
     std::optional<FeatureType> defineInput(vespalib::stringref inName,
                                            AcceptInput accept = AcceptInput::NUMBER);
 
+    /**
+     * Define an input feature calculating a subexpression that was
+     * split out of this blueprint to be shared with other
+     * features. Reuse of such inputs is tracked by the resolver.
+     *
+     * @param inName feature name of input
+     * @param type accepted input type
+     **/
+    std::optional<FeatureType> defineSharedInput(vespalib::stringref inName,
+                                                 AcceptInput accept = AcceptInput::NUMBER);
+
     /**
      * Describe an output for this blueprint. This method should be
      * invoked by the @ref setup method. Note that the order in which
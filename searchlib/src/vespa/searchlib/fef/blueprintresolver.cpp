@@ -78,6 +78,8 @@ struct Compiler : public Blueprint::DependencyHandler {
     FeatureMap                 &feature_map;
     std::set<vespalib::string>  setup_set;
     std::set<vespalib::string>  failed_set;
+    std::set<vespalib::string>  shared_set;
+    size_t                      num_reused;
     const char                 *min_stack;
     const char                 *max_stack;
 
@@ -93,6 +95,8 @@ struct Compiler : public Blueprint::DependencyHandler {
           feature_map(feature_map_out),
           setup_set(),
           failed_set(),
+          shared_set(),
+          num_reused(0),
           min_stack(nullptr),
           max_stack(nullptr) {}
     ~Compiler();
@@ -196,6 +200,9 @@ struct Compiler : public Blueprint::DependencyHandler {
         }
         auto old_feature = feature_map.find(parser->featureName());
         if (old_feature != feature_map.end()) {
+            if (shared_set.count(parser->featureName()) > 0) {
+                ++num_reused;
+            }
             return verify_type(*parser, old_feature->second, accept_type);
         }
         if ((resolve_stack.size() + 1) > BlueprintResolver::MAX_DEP_DEPTH) {
@@ -243,6 +250,12 @@ struct Compiler : public Blueprint::DependencyHandler {
     void fail(const vespalib::string &msg) override {
         fail_self(msg);
     }
+    void mark_shared_input(const vespalib::string &feature_name) override {
+        FeatureNameParser parser(feature_name);
+        if (parser.valid()) {
+            shared_set.insert(parser.featureName());
+        }
+    }
 };
 
 Compiler::~Compiler() = default;
@@ -266,7 +279,8 @@ BlueprintResolver::BlueprintResolver(const BlueprintFactory &factory,
       _executorSpecs(),
       _featureMap(),
       _seedMap(),
-      _warnings()
+      _warnings(),
+      _num_reused(0)
 {
 }
 
@@ -312,6 +326,7 @@ BlueprintResolver::compile()
     executor.execute(std::move(compile_task));
     executor.sync();
     executor.shutdown();
+    _num_reused = compiler.num_reused;
     size_t stack_usage = compiler.stack_usage();
     if (stack_usage > (128_Ki)) {
         _warnings.emplace_back(fmt("high stack usage: %zu bytes", stack_usage));
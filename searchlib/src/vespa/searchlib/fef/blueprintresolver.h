@@ -86,6 +86,7 @@ private:
     FeatureMap                    _featureMap;
     FeatureMap                    _seedMap;
     Warnings                        _warnings;
+    size_t                        _num_reused;
 
 public:
     BlueprintResolver(const BlueprintResolver &) = delete;
@@ -165,6 +166,17 @@ public:
      * @return list of warnings
      **/
     const Warnings & getWarnings() const { return _warnings; }
+
+    /**
+     * Obtain the number of times the result of a subexpression
+     * shared between features (see Blueprint::defineSharedInput)
+     * was needed again after already being resolved. Each such reuse
+     * is an evaluation saved compared to calculating the
+     * subexpression inside each feature using it.
+     *
+     * @return number of reused subexpression results
+     **/
+    size_t num_reused_expressions() const { return _num_reused; }
 };
 
 }
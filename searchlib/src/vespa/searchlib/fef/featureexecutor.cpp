@@ -20,6 +20,22 @@ FeatureExecutor::isPure()
     return false;
 }
 
+size_t
+FeatureExecutor::max_batch_size() const
+{
+    return 1;
+}
+
+void
+FeatureExecutor::handle_collect(uint32_t)
+{
+}
+
+void
+FeatureExecutor::handle_flush_batch()
+{
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
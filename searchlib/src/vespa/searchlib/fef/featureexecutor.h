@@ -110,6 +110,19 @@ protected:
      **/
     virtual void execute(uint32_t docId) = 0;
 
+    /**
+     * Prepare evaluation of the given document as part of a batch;
+     * see collect. Inputs are resolved for the given document while
+     * this function is called. The default is to do nothing.
+     **/
+    virtual void handle_collect(uint32_t docId);
+
+    /**
+     * Evaluate all documents collected since the last flush; see
+     * flush_batch. The default is to do nothing.
+     **/
+    virtual void handle_flush_batch();
+
 public:
     /**
      * Create a feature executor that has not yet been bound to neither
@@ -163,6 +176,36 @@ public:
         }
     }
 
+    /**
+     * The maximum number of documents this executor is able to
+     * evaluate together. Executors returning more than 1 will have
+     * their documents handed to them using collect before a call to
+     * flush_batch. Results for collected documents are still
+     * obtained by executing the documents one by one afterwards.
+     **/
+    virtual size_t max_batch_size() const;
+
+    /**
+     * Add a document to the current batch of this executor.
+     *
+     * @param docid the local document id to be evaluated later
+     **/
+    void collect(uint32_t docid) {
+        uint32_t old_docid = _inputs.get_docid();
+        _inputs.set_docid(docid);
+        handle_collect(docid);
+        _inputs.set_docid(old_docid);
+    }
+
+    /**
+     * Evaluate the current batch of this executor. Any document
+     * (collected or not) will be executed on the next access.
+     **/
+    void flush_batch() {
+        handle_flush_batch();
+        _inputs.set_docid(-1);
+    }
+
     /**
      * Virtual destructor to allow subclassing.
      **/
@@ -33,6 +33,15 @@ struct UseFastForest {
     static bool check(const Properties &props);
 };
 
+// calculate full tensor reductions nested inside ranking expressions
+// as separate features, shared by all expressions using them in the
+// same rank program. affects rank/summary/dump
+struct ShareSubexpressions {
+    static const vespalib::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -278,6 +287,17 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property to enable work-stealing between the search threads.
+     * When enabled, idle threads steal parts of the docid space from
+     * busy threads instead of using search partitions.
+     **/
+    struct WorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
 
     /**
      * Property to control fallback to not building a global filter
@@ -11,7 +11,8 @@ OnnxModel::OnnxModel(const vespalib::string &name_in,
       _file_path(file_path_in),
       _input_features(),
       _output_names(),
-      _dry_run_on_setup(false)
+      _dry_run_on_setup(false),
+      _batch_size(1)
 {
 }
 
@@ -38,6 +39,13 @@ OnnxModel::dry_run_on_setup(bool value)
     return *this;
 }
 
+OnnxModel &
+OnnxModel::batch_size(size_t value)
+{
+    _batch_size = value;
+    return *this;
+}
+
 std::optional<vespalib::string>
 OnnxModel::input_feature(const vespalib::string &model_input_name) const {
     auto pos = _input_features.find(model_input_name);
@@ -58,8 +66,8 @@ OnnxModel::output_name(const vespalib::string &model_output_name) const {
 
 bool
 OnnxModel::operator==(const OnnxModel &rhs) const {
-    return (std::tie(_name, _file_path, _input_features, _output_names, _dry_run_on_setup) ==
-            std::tie(rhs._name, rhs._file_path, rhs._input_features, rhs._output_names, rhs._dry_run_on_setup));
+    return (std::tie(_name, _file_path, _input_features, _output_names, _dry_run_on_setup, _batch_size) ==
+            std::tie(rhs._name, rhs._file_path, rhs._input_features, rhs._output_names, rhs._dry_run_on_setup, rhs._batch_size));
 }
 
 }
@@ -20,6 +20,7 @@ private:
     std::map<vespalib::string,vespalib::string> _input_features;
     std::map<vespalib::string,vespalib::string> _output_names;
     bool _dry_run_on_setup;
+    size_t _batch_size;
 
 public:
     OnnxModel(const vespalib::string &name_in,
@@ -35,9 +36,11 @@ public:
     OnnxModel &input_feature(const vespalib::string &model_input_name, const vespalib::string &input_feature);
     OnnxModel &output_name(const vespalib::string &model_output_name, const vespalib::string &output_name);
     OnnxModel &dry_run_on_setup(bool value);
+    OnnxModel &batch_size(size_t value);
     std::optional<vespalib::string> input_feature(const vespalib::string &model_input_name) const;
     std::optional<vespalib::string> output_name(const vespalib::string &model_output_name) const;
     bool dry_run_on_setup() const { return _dry_run_on_setup; }
+    size_t batch_size() const { return _batch_size; }
     bool operator==(const OnnxModel &rhs) const;
     const std::map<vespalib::string,vespalib::string> &inspect_input_features() const { return _input_features; }
     const std::map<vespalib::string,vespalib::string> &inspect_output_names() const { return _output_names; }
@@ -222,6 +222,7 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _hot_stash(32_Ki),
       _cold_stash(),
       _executors(),
+      _batch_executors(),
       _unboxed_seeds(),
       _is_const()
 {
@@ -265,6 +266,9 @@ RankProgram::setup(const MatchData &md,
                 inputs[input_idx] = LazyValue(input_value, input_executor);
             }
         }
+        if (!is_const && (executor->max_batch_size() > 1)) {
+            _batch_executors.push_back(executor);
+        }
         for (; (override < override_end) && (override->ref.executor == i); ++override) {
             FeatureExecutor *tmp = executor;
             executor = &(stash.get().create<FeatureOverrider>(*tmp, override->ref.output, override->number, std::move(override->object)));
@@ -306,6 +310,28 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+FeatureExecutor *
+RankProgram::get_batch_seed_executor() const
+{
+    const auto &seeds = _resolver->getSeedMap();
+    if (seeds.size() != 1) {
+        return nullptr;
+    }
+    auto seed = seeds.begin()->second;
+    if (_resolver->getExecutorSpecs()[seed.executor].output_types[seed.output].is_object()) {
+        return nullptr;
+    }
+    // wrapping executors share outputs with the executor they wrap
+    const NumberOrObject *seed_value = _executors[seed.executor]->outputs().get_raw(seed.output);
+    for (FeatureExecutor *executor: _batch_executors) {
+        const auto &outputs = executor->outputs();
+        if ((seed.output < outputs.size()) && (outputs.get_raw(seed.output) == seed_value)) {
+            return executor;
+        }
+    }
+    return nullptr;
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -40,6 +40,7 @@ private:
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
+    std::vector<FeatureExecutor *>   _batch_executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
 
@@ -63,6 +64,20 @@ public:
     size_t num_executors() const { return _executors.size(); }
     const FeatureExecutor &get_executor(size_t i) const { return *_executors[i]; }
 
+    /**
+     * Obtain the non-const executors in this program that are able
+     * to evaluate several documents at once (max_batch_size() > 1).
+     **/
+    const std::vector<FeatureExecutor *> &get_batch_executors() const { return _batch_executors; }
+
+    /**
+     * Obtain the batch executor calculating the single (number) seed
+     * of this program, or nullptr if the seed is calculated by some
+     * other executor. Evaluating a batch with this executor is
+     * enough to calculate the seed for all documents in the batch.
+     **/
+    FeatureExecutor *get_batch_seed_executor() const;
+
     /**
      * Set up this rank program by creating the needed feature
      * executors and wiring them together. This function will also
@@ -58,6 +58,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _compiled(false),
       _compileError(false),
       _degradationAscendingOrder(false),
+      _workStealing(false),
       _diversityAttribute(),
       _diversityMinGroups(1),
       _diversityCutoffFactor(10.0),
@@ -100,6 +101,7 @@ RankSetup::configure()
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    setWorkStealing(matching::WorkStealing::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -243,6 +245,16 @@ RankSetup::prepareSharedState(const IQueryEnvironment &queryEnv, IObjectStore &o
     }
 }
 
+size_t
+RankSetup::num_reused_expressions() const
+{
+    assert(_compiled);
+    return (_first_phase_resolver->num_reused_expressions() +
+            _second_phase_resolver->num_reused_expressions() +
+            _match_resolver->num_reused_expressions() +
+            _summary_resolver->num_reused_expressions());
+}
+
 vespalib::string
 RankSetup::getJoinedWarnings() const {
     vespalib::asciistream os;
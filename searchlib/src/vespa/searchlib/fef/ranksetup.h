@@ -68,6 +68,7 @@ private:
     bool                     _compiled;
     bool                     _compileError;
     bool                     _degradationAscendingOrder;
+    bool                     _workStealing;
     vespalib::string         _diversityAttribute;
     uint32_t                 _diversityMinGroups;
     double                   _diversityCutoffFactor;
@@ -182,6 +183,10 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void setWorkStealing(bool workStealing) { _workStealing = workStealing; }
+
+    bool useWorkStealing() const { return _workStealing; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -442,6 +447,16 @@ public:
      */
     vespalib::string getJoinedWarnings() const;
 
+    /**
+     * Obtain the number of subexpression evaluations saved per
+     * document by sharing subexpressions split out of ranking
+     * expressions within each of the first phase, second phase,
+     * match and summary programs. Only valid after compile.
+     *
+     * @return number of reused subexpression results
+     **/
+    size_t num_reused_expressions() const;
+
     // These functions create rank programs for different tasks. Note
     // that the setup function must be called on rank programs for
     // them to be ready to use. Also keep in mind that creating a rank
@@ -7,6 +7,23 @@
 
 namespace search::queryeval {
 
+namespace {
+
+constexpr size_t filter_block_size = 8;
+
+// Written as a branch free reduction over a fixed size block so that it is vectorized
+bool
+any_above(const feature_t *scores, feature_t threshold)
+{
+    bool any = false;
+    for (size_t i = 0; i < filter_block_size; ++i) {
+        any |= (scores[i] > threshold);
+    }
+    return any;
+}
+
+}
+
 void
 HitCollector::sortHitsByScore(size_t topn)
 {
@@ -76,6 +93,28 @@ HitCollector::RankedHitCollector::collect(uint32_t docId, feature_t score)
     }
 }
 
+size_t
+HitCollector::Collector::collectBatch(const uint32_t *docIds, const feature_t *scores, size_t)
+{
+    // collect may replace this collector, so only one hit is collected
+    collect(docIds[0], scores[0]);
+    return 1;
+}
+
+size_t
+HitCollector::RankedHitCollector::collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits)
+{
+    HitCollector & hc = this->_hc;
+    for (size_t i = 0; i < numHits; ++i) {
+        if (hc._hits.size() >= hc._maxHitsSize) {
+            collectAndChangeCollector(docIds[i], scores[i]); // note - self-destruct.
+            return i + 1;
+        }
+        collect(docIds[i], scores[i]);
+    }
+    return numHits;
+}
+
 template <bool CollectRankedHit>
 void
 HitCollector::BitVectorCollector<CollectRankedHit>::collect(uint32_t docId, feature_t score) {
@@ -85,6 +124,36 @@ HitCollector::BitVectorCollector<CollectRankedHit>::collect(uint32_t docId, feat
     }
 }
 
+template <bool CollectRankedHit>
+size_t
+HitCollector::BitVectorCollector<CollectRankedHit>::collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits) {
+    BitVector & bv = *this->_hc._bitVector;
+    for (size_t i = 0; i < numHits; ++i) {
+        bv.setBit(docIds[i]);
+    }
+    if (CollectRankedHit) {
+        this->considerBatchForHitVector(docIds, scores, numHits);
+    }
+    return numHits;
+}
+
+void
+HitCollector::CollectorBase::considerBatchForHitVector(const uint32_t *docIds, const feature_t *scores, size_t numHits) {
+    // The lowest score in the hit vector only increases, so blocks with no score
+    // above it can be skipped entirely.
+    size_t i = 0;
+    for (; i + filter_block_size <= numHits; i += filter_block_size) {
+        if (__builtin_expect(any_above(scores + i, _hc._hits[0].second), false)) {
+            for (size_t j = i; j < i + filter_block_size; ++j) {
+                considerForHitVector(docIds[j], scores[j]);
+            }
+        }
+    }
+    for (; i < numHits; ++i) {
+        considerForHitVector(docIds[i], scores[i]);
+    }
+}
+
 void
 HitCollector::CollectorBase::replaceHitInVector(uint32_t docId, feature_t score) {
     // replace lowest scored hit in hit vector
@@ -147,6 +216,31 @@ HitCollector::DocIdCollector<CollectRankedHit>::collect(uint32_t docId, feature_
     }
 }
 
+template<bool CollectRankedHit>
+size_t
+HitCollector::DocIdCollector<CollectRankedHit>::collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits)
+{
+    HitCollector & hc = this->_hc;
+    size_t numFit = std::min(numHits, hc._maxDocIdVectorSize - hc._docIdVector.size());
+    if (CollectRankedHit) {
+        this->considerBatchForHitVector(docIds, scores, numFit);
+    }
+    if (numFit > 0) {
+        if (__builtin_expect(((hc._unordered == false) &&
+                              ((hc._docIdVector.size() > 0 && docIds[0] < hc._docIdVector.back()) ||
+                               !std::is_sorted(docIds, docIds + numFit))), false))
+        {
+            hc._unordered = true;
+        }
+        hc._docIdVector.insert(hc._docIdVector.end(), docIds, docIds + numFit);
+    }
+    if (numFit < numHits) {
+        collect(docIds[numFit], scores[numFit]); // note - self-destruct.
+        return numFit + 1;
+    }
+    return numHits;
+}
+
 template<bool CollectRankedHit>
 void
 HitCollector::DocIdCollector<CollectRankedHit>::collectAndChangeCollector(uint32_t docId)
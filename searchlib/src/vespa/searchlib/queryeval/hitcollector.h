@@ -80,6 +80,12 @@ private:
         typedef std::unique_ptr<Collector> UP;
         virtual ~Collector() {}
         virtual void collect(uint32_t docId, feature_t score) = 0;
+        /**
+         * Collect hits from the given arrays. Returns the number of
+         * hits consumed, which may be less than numHits if the
+         * collector was replaced (and this object destroyed) on the way.
+         **/
+        virtual size_t collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits);
         virtual bool isDocIdCollector() const { return false; }
     };
 
@@ -93,6 +99,7 @@ private:
                 replaceHitInVector(docId, score);
             }
         }
+        void considerBatchForHitVector(const uint32_t *docIds, const feature_t *scores, size_t numHits);
     protected:
         void replaceHitInVector(uint32_t docId, feature_t score);
         HitCollector &_hc;
@@ -102,6 +109,7 @@ private:
     public:
         RankedHitCollector(HitCollector &hc) : CollectorBase(hc) { }
         void collect(uint32_t docId, feature_t score) override;
+        size_t collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits) override;
         void collectAndChangeCollector(uint32_t docId, feature_t score) __attribute__((noinline));
     };
 
@@ -110,6 +118,7 @@ private:
     public:
         DocIdCollector(HitCollector &hc) : CollectorBase(hc) { }
         void collect(uint32_t docId, feature_t score) override;
+        size_t collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits) override;
         void collectAndChangeCollector(uint32_t docId) __attribute__((noinline));
         bool isDocIdCollector() const override { return true; }
     };
@@ -119,6 +128,7 @@ private:
     public:
         BitVectorCollector(HitCollector &hc) : CollectorBase(hc) { }
         virtual void collect(uint32_t docId, feature_t score) override;
+        size_t collectBatch(const uint32_t *docIds, const feature_t *scores, size_t numHits) override;
     };
     
     HitRank getReScore(feature_t score) const {
@@ -154,6 +164,24 @@ public:
         _collector->collect(docId, score);
     }
 
+    /**
+     * Adds the given hits to this collector, with the same result as
+     * calling addHit for each of them in order. Once the hit vector
+     * is full, scores are filtered against the lowest score in the
+     * hit vector a block at a time, and only the hits scoring above
+     * it are considered for the hit vector.
+     *
+     * @param docIds the doc ids for the hits
+     * @param scores the first phase rank scores for the hits
+     * @param numHits the number of hits
+     **/
+    void addHits(const uint32_t *docIds, const feature_t *scores, size_t numHits) {
+        size_t done = 0;
+        while (done < numHits) {
+            done += _collector->collectBatch(docIds + done, scores + done, numHits - done);
+        }
+    }
+
     /**
      * Returns a sorted sequence of hits that reference internal
      * data. The number of hits returned in the sequence is controlled
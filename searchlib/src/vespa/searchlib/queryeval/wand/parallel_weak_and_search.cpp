@@ -41,10 +41,25 @@ private:
         }
     }
 
+    bool check_block_max_score(docid_t &next) {
+        if constexpr (VectorizedTerms::has_block_max) {
+            return _algo.check_block_max_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold), next);
+        } else {
+            (void) next;
+            return true;
+        }
+    }
+
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+            docid_t next = 0;
+            if (!check_block_max_score(next)) {
+                if (next >= getEndId()) {
+                    break;
+                }
+                _algo.set_candidate(_terms, _heaps, next);
+            } else if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
             } else {
@@ -57,7 +72,8 @@ private:
     void seek_unstrict(uint32_t docid) {
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
-            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            docid_t next = 0;
+            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold)) && check_block_max_score(next)) {
                 if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                     setDocId(_algo.get_candidate());
                 }
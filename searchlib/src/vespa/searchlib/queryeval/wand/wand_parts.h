@@ -180,7 +180,9 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
-    
+    int32_t get_block_max_weight(uint16_t ref) const { return _iteratorPack.get_block_max_weight(ref); }
+    docid_t get_block_last_docid(uint16_t ref) const { return _iteratorPack.get_block_last_docid(ref); }
+
     vespalib::string stringify_docid() const;
 };
 
@@ -239,6 +241,8 @@ private:
     Terms _terms; // TODO: want to get rid of this
 
 public:
+    static constexpr bool has_block_max = false;
+
     template <typename Scorer>
     VectorizedIteratorTerms(const Terms &t, const Scorer &, uint32_t docIdLimit,
                             fef::MatchData::UP childrenMatchData);
@@ -266,6 +270,9 @@ VectorizedIteratorTerms::VectorizedIteratorTerms(const Terms &t, const Scorer &,
 //-----------------------------------------------------------------------------
 
 struct VectorizedAttributeTerms : VectorizedState<AttributeIteratorPack> {
+    // posting list btree leaves carry the max weight of their postings
+    static constexpr bool has_block_max = true;
+
     template <typename Scorer>
     VectorizedAttributeTerms(const std::vector<int32_t> &weights,
                              const std::vector<IDocumentWeightAttribute::LookupResult> &dict_entries,
@@ -448,6 +455,12 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    // upper bound for the term score within the posting list block containing the current docid
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(VectorizedTerms &terms, ref_t ref) {
+        return std::min(terms.maxScore(ref), terms.weight(ref) * (score_t)terms.get_block_max_weight(ref));
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -619,6 +632,34 @@ public:
         return true;
     }
 
+    /**
+     * Check the candidate against an upper bound where the terms
+     * positioned at the candidate contribute with their max score within
+     * the current posting list block instead of their global max
+     * score. If the bound is too low, no document before the end of the
+     * shortest such block or the next future term position can score
+     * above the threshold either; 'next' is then set to the first
+     * document that can, and false is returned.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max_score(VectorizedTerms &terms, Heaps &heaps, const Scorer &, AboveThreshold &&aboveThreshold, docid_t &next) {
+        score_t bound = _maxUpperBound - _upperBound; // global max score for terms in the past
+        docid_t block_end = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            bound += Scorer::calculate_block_max_score(terms, *ref);
+            block_end = std::min(block_end, terms.get_block_last_docid(*ref) + 1);
+        }
+        if (aboveThreshold(bound)) {
+            return true;
+        }
+        if (heaps.has_future()) {
+            block_end = std::min(block_end, terms.docId(heaps.future()));
+        }
+        next = block_end;
+        return false;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
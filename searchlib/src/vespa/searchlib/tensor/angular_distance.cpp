@@ -48,5 +48,7 @@ AngularDistance::calc(const vespalib::eval::TypedCells& lhs,
 
 template class AngularDistanceHW<float>;
 template class AngularDistanceHW<double>;
+template class AngularDistanceHW<vespalib::BFloat16>;
+template class AngularDistanceHW<vespalib::eval::Int8Float>;
 
 }
@@ -5,10 +5,13 @@
 #include "random_level_generator.h"
 #include "inv_log_level_generator.h"
 #include "distance_function_factory.h"
+#include "quantized_vector_store.h"
 #include <vespa/searchcommon/attribute/config.h>
 
 namespace search::tensor {
 
+using search::attribute::DistanceMetric;
+using vespalib::eval::CellType;
 using vespalib::eval::ValueType;
 
 namespace {
@@ -23,6 +26,17 @@ make_random_level_generator(uint32_t m)
     return std::make_unique<InvLogLevelGenerator>(m);
 }
 
+bool
+supports_quantized_search(DistanceMetric distance_metric, CellType cell_type)
+{
+    if ((cell_type != CellType::FLOAT) && (cell_type != CellType::DOUBLE)) {
+        return false;
+    }
+    return (distance_metric == DistanceMetric::Euclidean) ||
+           (distance_metric == DistanceMetric::Angular) ||
+           (distance_metric == DistanceMetric::InnerProduct);
+}
+
 } // namespace <unnamed>
 
 std::unique_ptr<NearestNeighborIndex>
@@ -31,17 +45,21 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          vespalib::eval::CellType cell_type,
                                          const search::attribute::HnswIndexParams& params) const
 {
-    (void) vector_size;
     uint32_t m = params.max_links_per_node();
     HnswIndex::Config cfg(m * 2,
                           m,
                           params.neighbors_to_explore_at_insert(),
                           10000,
                           true);
+    std::unique_ptr<QuantizedVectorStore> quantized_vectors;
+    if (params.quantized_search() && supports_quantized_search(params.distance_metric(), cell_type)) {
+        quantized_vectors = std::make_unique<QuantizedVectorStore>(vector_size, params.distance_metric());
+    }
     return std::make_unique<HnswIndex>(vectors,
                                        make_distance_function(params.distance_metric(), cell_type),
                                        make_random_level_generator(m),
-                                       cfg);
+                                       cfg,
+                                       std::move(quantized_vectors));
 }
 
 }
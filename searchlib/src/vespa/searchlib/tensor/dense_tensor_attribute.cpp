@@ -11,10 +11,12 @@
 #include <vespa/searchlib/attribute/load_utils.h>
 #include <vespa/searchlib/attribute/readerbase.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <thread>
 
@@ -250,97 +252,83 @@ public:
 };
 }
 
+namespace {
+
+/**
+ * Thread bundle that runs the given targets as tasks in the shared executor used during load.
+ */
+class ExecutorThreadBundle : public vespalib::ThreadBundle {
+    vespalib::Executor& _executor;
+    size_t              _size;
+public:
+    ExecutorThreadBundle(vespalib::Executor& executor, size_t size) noexcept
+        : _executor(executor),
+          _size(size)
+    {}
+    size_t size() const override { return _size; }
+    void run(vespalib::Runnable* const* targets, size_t cnt) override {
+        assert(cnt <= _size);
+        if (cnt == 0) {
+            return;
+        }
+        vespalib::CountDownLatch latch(cnt - 1);
+        for (size_t i = 1; i < cnt; ++i) {
+            auto task = vespalib::makeLambdaTask([target = targets[i], &latch]() {
+                target->run();
+                latch.countDown();
+            });
+            auto rejected = _executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
+            if (rejected) {
+                rejected->run();
+            }
+        }
+        targets[0]->run();
+        latch.await();
+    }
+};
+
+}
+
 /**
- * Will load and index documents in parallel. Note that indexing order is not guaranteed,
- * but that is inline with the guarantees vespa already has.
+ * Will load and index documents in batches, where the prepare step of each batch is
+ * run in parallel using the shared executor (see NearestNeighborIndex::add_documents()).
+ * Documents are indexed in docid order.
  */
 class DenseTensorAttribute::ThreadedLoader : public Loader {
 public:
     ThreadedLoader(DenseTensorAttribute & attr, vespalib::Executor & shared_executor)
         : _attr(attr),
-          _shared_executor(shared_executor),
-          _queue(MAX_PENDING),
-          _pending(0)
-    {}
-    void load(uint32_t lid, vespalib::datastore::EntryRef ref) override;
-    void wait_complete() override {
-        drainUntilPending(0);
+          _thread_bundle(shared_executor, std::max(1u, std::thread::hardware_concurrency())),
+          _batch()
+    {
+        _batch.reserve(LOAD_BATCH_SIZE);
     }
-private:
-    using Entry = std::pair<uint32_t, std::unique_ptr<PrepareResult>>;
-    using Queue = vespalib::ArrayQueue<Entry>;
-
-    bool pop(Entry & entry) {
-        std::unique_lock guard(_mutex);
-        if (_queue.empty()) return false;
-        entry = std::move(_queue.front());
-        _queue.pop();
-        return true;
-    }
-    void drainQ() {
-        Queue queue(MAX_PENDING);
-        {
-            std::unique_lock guard(_mutex);
-            queue.swap(_queue);
-        }
-        while (!queue.empty()) {
-            auto item = std::move(queue.front());
-            queue.pop();
-            complete(item.first, std::move(item.second));
+    void load(uint32_t lid, vespalib::datastore::EntryRef) override {
+        _batch.push_back(lid);
+        if (_batch.size() >= LOAD_BATCH_SIZE) {
+            flush();
         }
     }
-
-    void complete(uint32_t lid, std::unique_ptr<PrepareResult> prepared) {
-        _attr.setCommittedDocIdLimit(std::max(_attr.getCommittedDocIdLimit(), lid + 1));
-        _attr._index->complete_add_document(lid, std::move(prepared));
-        --_pending;
-        if ((lid % LOAD_COMMIT_INTERVAL) == 0) {
-            _attr.commit();
-        };
-    }
-    void drainUntilPending(uint32_t maxPending) {
-        while (_pending > maxPending) {
-            {
-                std::unique_lock guard(_mutex);
-                while (_queue.empty()) {
-                    _cond.wait(guard);
-                }
-            }
-            drainQ();
+    void wait_complete() override {
+        flush();
+    }
+private:
+    void flush() {
+        if (_batch.empty()) {
+            return;
         }
+        // This ensures that get_vector() is able to find the tensors in the batch.
+        _attr.setCommittedDocIdLimit(std::max(_attr.getCommittedDocIdLimit(), _batch.back() + 1));
+        _attr._index->add_documents(_batch, _thread_bundle);
+        _attr.commit();
+        _batch.clear();
     }
-    static constexpr uint32_t MAX_PENDING = 1000;
-    DenseTensorAttribute  & _attr;
-    vespalib::Executor    & _shared_executor;
-    std::mutex              _mutex;
-    std::condition_variable _cond;
-    Queue                   _queue;
-    uint64_t                _pending; // _pending is only modified in forground thread
+    static constexpr uint32_t LOAD_BATCH_SIZE = 4096;
+    DenseTensorAttribute & _attr;
+    ExecutorThreadBundle   _thread_bundle;
+    std::vector<uint32_t>  _batch;
 };
 
-void
-DenseTensorAttribute::ThreadedLoader::load(uint32_t lid, vespalib::datastore::EntryRef ref) {
-    Entry item;
-    while (pop(item)) {
-        // First process items that are ready to complete
-        complete(item.first, std::move(item.second));
-    }
-    // Then ensure that there no mor ethan MAX_PENDING inflight
-    drainUntilPending(MAX_PENDING);
-
-    // Then we can issue a new one
-    ++_pending;
-    auto task = vespalib::makeLambdaTask([this, ref, lid]() {
-        auto prepared = _attr._index->prepare_add_document(lid, _attr._denseTensorStore.get_typed_cells(ref),
-                                                           _attr.getGenerationHandler().takeGuard());
-        std::unique_lock guard(_mutex);
-        _queue.push(std::make_pair(lid, std::move(prepared)));
-        if (_queue.size() == 1) {
-            _cond.notify_all();
-        }
-    });
-    _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
-}
 class DenseTensorAttribute::ForegroundLoader : public Loader {
 public:
     ForegroundLoader(DenseTensorAttribute & attr) : _attr(attr) {}
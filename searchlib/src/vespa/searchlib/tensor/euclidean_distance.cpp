@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "euclidean_distance.h"
+#include <algorithm>
 
 using vespalib::typify_invoke;
 using vespalib::eval::TypifyCellType;
@@ -27,6 +28,29 @@ struct CalcEuclidean {
     }
 };
 
+struct CalcEuclideanWithLimit {
+    template <typename LCT, typename RCT>
+    static double invoke(const vespalib::eval::TypedCells& lhs,
+                         const vespalib::eval::TypedCells& rhs,
+                         double limit)
+    {
+        constexpr size_t block_size = 64;
+        auto lhs_vector = lhs.unsafe_typify<LCT>();
+        auto rhs_vector = rhs.unsafe_typify<RCT>();
+        double sum = 0.0;
+        size_t sz = lhs_vector.size();
+        assert(sz == rhs_vector.size());
+        for (size_t i = 0; i < sz && sum <= limit; i += block_size) {
+            size_t block_end = std::min(sz, i + block_size);
+            for (size_t j = i; j < block_end; ++j) {
+                double diff = lhs_vector[j] - rhs_vector[j];
+                sum += diff*diff;
+            }
+        }
+        return sum;
+    }
+};
+
 }
 
 double
@@ -39,13 +63,13 @@ SquaredEuclideanDistance::calc(const vespalib::eval::TypedCells& lhs,
 double
 SquaredEuclideanDistance::calc_with_limit(const vespalib::eval::TypedCells& lhs,
                                           const vespalib::eval::TypedCells& rhs,
-                                          double) const
+                                          double limit) const
 {
-    // maybe optimize this:
-    return typify_invoke<2,TypifyCellType,CalcEuclidean>(lhs.type, rhs.type, lhs, rhs);
+    return typify_invoke<2,TypifyCellType,CalcEuclideanWithLimit>(lhs.type, rhs.type, lhs, rhs, limit);
 }
 
 template class SquaredEuclideanDistanceHW<float>;
 template class SquaredEuclideanDistanceHW<double>;
+template class SquaredEuclideanDistanceHW<vespalib::BFloat16>;
 
 }
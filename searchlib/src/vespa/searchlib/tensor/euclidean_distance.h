@@ -46,6 +46,7 @@ public:
 
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
     static const int8_t *cast(const vespalib::eval::Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
     double calc(const vespalib::eval::TypedCells& lhs, const vespalib::eval::TypedCells& rhs) const override {
         constexpr vespalib::eval::CellType expected = vespalib::eval::get_cell_type<FloatType>();
@@ -65,14 +66,9 @@ public:
         assert(lhs.type == expected && rhs.type == expected);
         auto lhs_vector = lhs.typify<FloatType>();
         auto rhs_vector = rhs.typify<FloatType>();
-        double sum = 0.0;
         size_t sz = lhs_vector.size();
         assert(sz == rhs_vector.size());
-        for (size_t i = 0; i < sz && sum <= limit; ++i) {
-            double diff = lhs_vector[i] - rhs_vector[i];
-            sum += diff*diff;
-        }
-        return sum;
+        return _computer.squaredEuclideanDistanceWithLimit(cast(&lhs_vector[0]), cast(&rhs_vector[0]), sz, limit);
     }
 private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
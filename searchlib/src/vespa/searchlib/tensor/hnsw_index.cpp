@@ -6,6 +6,7 @@
 #include "hash_set_visited_tracker.h"
 #include "hnsw_index_loader.hpp"
 #include "hnsw_index_saver.h"
+#include "quantized_vector_store.h"
 #include "random_level_generator.h"
 #include <vespa/searchlib/attribute/address_space_components.h>
 #include <vespa/searchlib/attribute/address_space_usage.h>
@@ -18,7 +19,10 @@
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/util/time.h>
+#include <optional>
+
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
@@ -42,6 +46,11 @@ constexpr float alloc_grow_factor = 0.3;
 constexpr size_t max_level_array_size = 16;
 constexpr size_t max_link_array_size = 193;
 constexpr vespalib::duration MAX_COUNT_DURATION(100ms);
+// Max number of documents prepared in parallel before their links are committed, see add_documents().
+constexpr uint32_t max_add_batch_size = 1024;
+// Documents in the same batch are not able to link to each other in the prepare step.
+// The batch size is therefore kept small compared to the size of the graph.
+constexpr uint32_t graph_size_to_add_batch_size_ratio = 16;
 
 bool has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t id) {
     for (uint32_t link : links) {
@@ -87,8 +96,10 @@ HnswIndex::max_links_for_level(uint32_t level) const
 bool
 HnswIndex::have_closer_distance(HnswCandidate candidate, const HnswCandidateVector& result) const
 {
+    auto candidate_vector = get_vector(candidate.docid);
     for (const auto & neighbor : result) {
-        double dist = calc_distance(candidate.docid, neighbor.docid);
+        // Only need to know whether the neighbor is closer, so the calculation can stop early.
+        double dist = _distance_func->calc_with_limit(candidate_vector, get_vector(neighbor.docid), candidate.distance);
         if (dist < candidate.distance) {
             return true;
         }
@@ -210,6 +221,9 @@ HnswIndex::calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const
 double
 HnswIndex::calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const
 {
+    if (_quantized_vectors && (lhs.type == vespalib::eval::CellType::INT8)) {
+        return _quantized_vectors->calc_distance(lhs, rhs_docid);
+    }
     auto rhs = get_vector(rhs_docid);
     return _distance_func->calc(lhs, rhs);
 }
@@ -331,16 +345,20 @@ HnswIndex::search_layer(const TypedCells& input, uint32_t neighbors_to_find,
 }
 
 HnswIndex::HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-                     RandomLevelGenerator::UP level_generator, const Config& cfg)
+                     RandomLevelGenerator::UP level_generator, const Config& cfg,
+                     std::unique_ptr<QuantizedVectorStore> quantized_vectors)
     : _graph(),
       _vectors(vectors),
       _distance_func(std::move(distance_func)),
       _level_generator(std::move(level_generator)),
       _cfg(cfg),
       _visited_set_pool(),
-      _compaction_spec()
+      _compaction_spec(),
+      _quantized_vectors(std::move(quantized_vectors))
 {
     assert(_distance_func);
+    // Quantized query vectors are recognized by their cell type, see calc_distance().
+    assert(!_quantized_vectors || (_distance_func->expected_cell_type() != vespalib::eval::CellType::INT8));
 }
 
 HnswIndex::~HnswIndex() = default;
@@ -358,7 +376,14 @@ HnswIndex::internal_prepare_add(uint32_t docid, TypedCells input_vector, vespali
 {
     // TODO: Add capping on num_levels
     int level = _level_generator->max_level();
-    PreparedAddDoc op(docid, level, std::move(read_guard));
+    return internal_prepare_add_at_level(docid, level, input_vector, std::move(read_guard));
+}
+
+HnswIndex::PreparedAddDoc
+HnswIndex::internal_prepare_add_at_level(uint32_t docid, int32_t max_level, TypedCells input_vector,
+                                         vespalib::GenerationHandler::Guard read_guard) const
+{
+    PreparedAddDoc op(docid, max_level, std::move(read_guard));
     auto entry = _graph.get_entry_node();
     if (entry.docid == 0) {
         // graph has no entry point
@@ -418,6 +443,10 @@ HnswIndex::filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neig
 void
 HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
 {
+    if (_quantized_vectors) {
+        // Must be stored before the node is reachable from the graph.
+        _quantized_vectors->set(docid, get_vector(docid));
+    }
     auto node_ref = _graph.make_node_for_document(docid, op.max_level + 1);
     for (int level = 0; level <= op.max_level; ++level) {
         auto neighbors = filter_valid_docids(level, op.connections[level], docid);
@@ -426,6 +455,25 @@ HnswIndex::internal_complete_add(uint32_t docid, PreparedAddDoc &op)
     if (op.max_level > get_entry_level()) {
         _graph.set_entry_node({docid, node_ref, op.max_level});
     }
+    consider_train_quantized_vectors();
+}
+
+void
+HnswIndex::consider_train_quantized_vectors()
+{
+    if (!_quantized_vectors || _quantized_vectors->is_trained() ||
+        (_graph.size() < std::max(1u, _cfg.min_size_before_two_phase())))
+    {
+        return;
+    }
+    std::vector<uint32_t> docids;
+    uint32_t doc_id_limit = _graph.size();
+    for (uint32_t docid = 1; docid < doc_id_limit; ++docid) {
+        if (_graph.get_node_ref(docid).valid()) {
+            docids.push_back(docid);
+        }
+    }
+    _quantized_vectors->train(docids, _vectors);
 }
 
 std::unique_ptr<PrepareResult>
@@ -460,6 +508,81 @@ HnswIndex::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult>
     }
 }
 
+/**
+ * Runs the prepare step for a contiguous part of a batch of documents, see HnswIndex::add_documents().
+ */
+class HnswIndex::PrepareAddBatchPart : public vespalib::Runnable {
+    const HnswIndex& _index;
+    vespalib::ConstArrayRef<uint32_t> _docids;
+    vespalib::ConstArrayRef<int32_t> _levels;
+    std::vector<std::optional<PreparedAddDoc>>& _prepared;
+    size_t _begin;
+    size_t _end;
+public:
+    PrepareAddBatchPart(const HnswIndex& index, vespalib::ConstArrayRef<uint32_t> docids,
+                        vespalib::ConstArrayRef<int32_t> levels, std::vector<std::optional<PreparedAddDoc>>& prepared,
+                        size_t begin, size_t end) noexcept
+        : _index(index),
+          _docids(docids),
+          _levels(levels),
+          _prepared(prepared),
+          _begin(begin),
+          _end(end)
+    {}
+    void run() override {
+        for (size_t i = _begin; i < _end; ++i) {
+            uint32_t docid = _docids[i];
+            // The graph is not modified while the batch is prepared, so no read guard is needed.
+            vespalib::GenerationHandler::Guard no_guard_needed;
+            _prepared[i].emplace(_index.internal_prepare_add_at_level(docid, _levels[i], _index.get_vector(docid),
+                                                                      std::move(no_guard_needed)));
+        }
+    }
+};
+
+uint32_t
+HnswIndex::calc_add_batch_size(size_t docids_left) const
+{
+    uint32_t batch_size = std::max(1u, uint32_t(_graph.size() / graph_size_to_add_batch_size_ratio));
+    batch_size = std::min(batch_size, max_add_batch_size);
+    return std::min(size_t(batch_size), docids_left);
+}
+
+void
+HnswIndex::add_documents(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ThreadBundle& thread_bundle)
+{
+    size_t pos = 0;
+    // The first documents added are linked together in the write thread, as done by prepare_add_document().
+    while ((pos < docids.size()) && (_graph.size() < _cfg.min_size_before_two_phase())) {
+        add_document(docids[pos++]);
+    }
+    std::vector<int32_t> levels;
+    std::vector<std::optional<PreparedAddDoc>> prepared;
+    std::vector<PrepareAddBatchPart> parts;
+    while (pos < docids.size()) {
+        vespalib::ConstArrayRef<uint32_t> batch(docids.data() + pos, calc_add_batch_size(docids.size() - pos));
+        // Levels are drawn in docid order by this thread, making the resulting graph
+        // independent of the number of threads in the bundle.
+        levels.clear();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            levels.push_back(_level_generator->max_level());
+        }
+        prepared.clear();
+        prepared.resize(batch.size());
+        parts.clear();
+        size_t num_parts = std::min(thread_bundle.size(), batch.size());
+        for (size_t i = 0; i < num_parts; ++i) {
+            parts.emplace_back(*this, batch, levels, prepared,
+                               (batch.size() * i) / num_parts, (batch.size() * (i + 1)) / num_parts);
+        }
+        thread_bundle.run(parts);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            internal_complete_add(batch[i], *prepared[i]);
+        }
+        pos += batch.size();
+    }
+}
+
 void
 HnswIndex::mutual_reconnect(const LinkArrayRef &cluster, uint32_t level)
 {
@@ -508,6 +631,9 @@ HnswIndex::remove_document(uint32_t docid)
         _graph.set_entry_node(entry);
     }
     _graph.remove_node_for_document(docid);
+    if (_quantized_vectors) {
+        _quantized_vectors->remove(docid);
+    }
 }
 
 void
@@ -518,6 +644,9 @@ HnswIndex::transfer_hold_lists(generation_t current_gen)
     _graph.node_refs.setGeneration(current_gen + 1);
     _graph.nodes.transferHoldLists(current_gen);
     _graph.links.transferHoldLists(current_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->transfer_hold_lists(current_gen);
+    }
 }
 
 void
@@ -526,6 +655,9 @@ HnswIndex::trim_hold_lists(generation_t first_used_gen)
     _graph.node_refs.removeOldGenerations(first_used_gen);
     _graph.nodes.trimHoldLists(first_used_gen);
     _graph.links.trimHoldLists(first_used_gen);
+    if (_quantized_vectors) {
+        _quantized_vectors->trim_hold_lists(first_used_gen);
+    }
 }
 
 void
@@ -598,6 +730,11 @@ HnswIndex::update_stat(const CompactionStrategy& compaction_strategy)
                                                compaction_strategy.should_compact(link_arrays_memory_usage, link_arrays_address_space_usage));
     result.merge(link_arrays_memory_usage);
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        // The graph might have been loaded from file without the quantized vectors being trained.
+        consider_train_quantized_vectors();
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -609,6 +746,9 @@ HnswIndex::memory_usage() const
     result.merge(_graph.nodes.getMemoryUsage());
     result.merge(_graph.links.getMemoryUsage());
     result.merge(_visited_set_pool.memory_usage());
+    if (_quantized_vectors) {
+        result.merge(_quantized_vectors->memory_usage());
+    }
     return result;
 }
 
@@ -629,6 +769,9 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     StateExplorerUtils::memory_usage_to_slime(_graph.nodes.getMemoryUsage(), memUsageObj.setObject("nodes"));
     StateExplorerUtils::memory_usage_to_slime(_graph.links.getMemoryUsage(), memUsageObj.setObject("links"));
     StateExplorerUtils::memory_usage_to_slime(_visited_set_pool.memory_usage(), memUsageObj.setObject("visited_set_pool"));
+    if (_quantized_vectors) {
+        StateExplorerUtils::memory_usage_to_slime(_quantized_vectors->memory_usage(), memUsageObj.setObject("quantized_vectors"));
+    }
     auto& visitedObj = object.setObject("visited_set");
     visitedObj.setLong("create_count", _visited_set_pool.create_count());
     visitedObj.setLong("reuse_count", _visited_set_pool.reuse_count());
@@ -660,6 +803,9 @@ HnswIndex::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    if (_quantized_vectors) {
+        object.setBool("quantized_vectors_trained", _quantized_vectors->is_trained());
+    }
 }
 
 void
@@ -733,6 +879,28 @@ HnswIndex::find_top_k_with_filter(uint32_t k, TypedCells vector,
 
 FurthestPriQ
 HnswIndex::top_k_candidates(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const
+{
+    if (_quantized_vectors && _quantized_vectors->is_trained()) {
+        QuantizedVectorStore::QueryCodes codes;
+        auto quantized_vector = _quantized_vectors->quantize(vector, codes);
+        auto candidates = top_k_candidates_helper(quantized_vector, k, filter);
+        return rerank_with_full_precision(vector, candidates);
+    }
+    return top_k_candidates_helper(vector, k, filter);
+}
+
+FurthestPriQ
+HnswIndex::rerank_with_full_precision(const TypedCells &vector, const FurthestPriQ& candidates) const
+{
+    FurthestPriQ result;
+    for (const auto& candidate : candidates.peek()) {
+        result.emplace(candidate.docid, candidate.node_ref, calc_distance(vector, candidate.docid));
+    }
+    return result;
+}
+
+FurthestPriQ
+HnswIndex::top_k_candidates_helper(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const
 {
     FurthestPriQ best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -20,12 +20,19 @@
 
 namespace search::tensor {
 
+class QuantizedVectorStore;
+
 /**
  * Implementation of a hierarchical navigable small world graph (HNSW)
  * that is used for approximate K-nearest neighbor search.
  *
  * The implementation supports 1 write thread and multiple search threads without the use of mutexes.
  * This is achieved by using data stores that use generation tracking and associated memory management.
+ * When adding a batch of documents (see add_documents()) the non-modifying prepare step is run
+ * by a thread bundle while the write thread waits, and the resulting links are committed by the write thread.
+ *
+ * Optionally, int8 quantized vectors (see QuantizedVectorStore) are used to calculate distances while
+ * traversing the graph during search, and the final candidates are re-ranked using the full precision vectors.
  *
  * The implementation is mainly based on the algorithms described in
  * "Efficient and robust approximate nearest neighbor search using Hierarchical Navigable Small World graphs" (Yu. A. Malkov, D. A. Yashunin),
@@ -100,6 +107,7 @@ protected:
     Config _cfg;
     mutable vespalib::ReusableSetPool _visited_set_pool;
     HnswIndexCompactionSpec _compaction_spec;
+    std::unique_ptr<QuantizedVectorStore> _quantized_vectors;
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t docid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -134,6 +142,11 @@ protected:
     }
 
     double calc_distance(uint32_t lhs_docid, uint32_t rhs_docid) const;
+    /**
+     * Calculates the distance between the input vector and the vector of the given document.
+     * Input vectors quantized by the quantized vector store (int8 cells) are compared
+     * against the quantized vector of the document.
+     */
     double calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const;
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t doc_id_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const;
 
@@ -148,6 +161,9 @@ protected:
                              uint32_t estimated_visited_nodes) const;
     void search_layer(const TypedCells& input, uint32_t neighbors_to_find, FurthestPriQ& found_neighbors,
                       uint32_t level, const GlobalFilter *filter = nullptr) const;
+    FurthestPriQ top_k_candidates_helper(const TypedCells &vector, uint32_t k, const GlobalFilter *filter) const;
+    FurthestPriQ rerank_with_full_precision(const TypedCells &vector, const FurthestPriQ& candidates) const;
+    void consider_train_quantized_vectors();
     std::vector<Neighbor> top_k_by_docid(uint32_t k, TypedCells vector,
                                          const GlobalFilter *filter, uint32_t explore_k,
                                          double distance_threshold) const;
@@ -171,11 +187,16 @@ protected:
     };
     PreparedAddDoc internal_prepare_add(uint32_t docid, TypedCells input_vector,
                                         vespalib::GenerationHandler::Guard read_guard) const;
+    PreparedAddDoc internal_prepare_add_at_level(uint32_t docid, int32_t max_level, TypedCells input_vector,
+                                                 vespalib::GenerationHandler::Guard read_guard) const;
+    class PrepareAddBatchPart;
+    uint32_t calc_add_batch_size(size_t docids_left) const;
     LinkArray filter_valid_docids(uint32_t level, const PreparedAddDoc::Links &neighbors, uint32_t me);
     void internal_complete_add(uint32_t docid, PreparedAddDoc &op);
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunction::UP distance_func,
-              RandomLevelGenerator::UP level_generator, const Config& cfg);
+              RandomLevelGenerator::UP level_generator, const Config& cfg,
+              std::unique_ptr<QuantizedVectorStore> quantized_vectors = {});
     ~HnswIndex() override;
 
     const Config& config() const { return _cfg; }
@@ -186,6 +207,7 @@ public:
             TypedCells vector,
             vespalib::GenerationHandler::Guard read_guard) const override;
     void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    void add_documents(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ThreadBundle& thread_bundle) override;
     void remove_document(uint32_t docid) override;
     void transfer_hold_lists(generation_t current_gen) override;
     void trim_hold_lists(generation_t first_used_gen) override;
@@ -222,6 +244,7 @@ public:
     std::pair<uint32_t, bool> count_reachable_nodes() const;
     HnswGraph& get_graph() { return _graph; }
     vespalib::ReusableSetPool& get_visited_set_pool() const noexcept { return _visited_set_pool; }
+    const QuantizedVectorStore* get_quantized_vectors() const noexcept { return _quantized_vectors.get(); }
 
     static vespalib::datastore::ArrayStoreConfig make_default_node_store_config();
     static vespalib::datastore::ArrayStoreConfig make_default_link_store_config();
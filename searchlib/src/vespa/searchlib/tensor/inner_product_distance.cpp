@@ -40,5 +40,6 @@ InnerProductDistance::calc(const vespalib::eval::TypedCells& lhs,
 
 template class InnerProductDistanceHW<float>;
 template class InnerProductDistanceHW<double>;
+template class InnerProductDistanceHW<vespalib::BFloat16>;
 
 }
@@ -1,3 +1,15 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "nearest_neighbor_index.h"
+
+namespace search::tensor {
+
+void
+NearestNeighborIndex::add_documents(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ThreadBundle&)
+{
+    for (uint32_t docid : docids) {
+        add_document(docid);
+    }
+}
+
+}
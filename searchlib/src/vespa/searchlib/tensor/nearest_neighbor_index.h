@@ -4,6 +4,7 @@
 
 #include "distance_function.h"
 #include "prepare_result.h"
+#include <vespa/vespalib/util/arrayref.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/util/memoryusage.h>
 #include <cstdint>
@@ -17,6 +18,7 @@ class CompactionSpec;
 class CompactionStrategy;
 }
 namespace vespalib::slime { struct Inserter; }
+namespace vespalib { struct ThreadBundle; }
 
 namespace search::fileutil { class LoadedBuffer; }
 
@@ -67,6 +69,16 @@ public:
      */
     virtual void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) = 0;
 
+    /**
+     * Adds a batch of documents to the index (e.g. during initial load or reprocessing).
+     *
+     * This function is only called by the attribute writer thread.
+     * The vectors for the given documents must already be available via the DocVectorAccess used by the index.
+     * The given thread bundle can be used to run the costly and non-modifying part of the operation in parallel.
+     * The default implementation adds the documents one by one in the calling thread.
+     */
+    virtual void add_documents(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ThreadBundle& thread_bundle);
+
     virtual void remove_document(uint32_t docid) = 0;
     virtual void transfer_hold_lists(generation_t current_gen) = 0;
     virtual void trim_hold_lists(generation_t first_used_gen) = 0;
@@ -0,0 +1,175 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include "distance_function_factory.h"
+#include "doc_vector_access.h"
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/util/memory_allocator.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <vespa/vespalib/util/typify.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using search::attribute::DistanceMetric;
+using vespalib::eval::TypifyCellType;
+using vespalib::eval::ValueType;
+using vespalib::typify_invoke;
+
+namespace search::tensor {
+
+namespace {
+
+constexpr double max_code = 127.0;
+
+struct CalcMaxAbs {
+    template <typename CT>
+    static double invoke(const vespalib::eval::TypedCells& cells) {
+        double result = 0.0;
+        for (auto cell : cells.unsafe_typify<CT>()) {
+            result = std::max(result, std::abs(double(cell)));
+        }
+        return result;
+    }
+};
+
+struct Encode {
+    template <typename CT>
+    static void invoke(const vespalib::eval::TypedCells& cells, double scale, vespalib::eval::Int8Float* codes) {
+        for (auto cell : cells.unsafe_typify<CT>()) {
+            double code = std::round(double(cell) * scale);
+            *codes++ = float(std::clamp(code, -max_code, max_code));
+        }
+    }
+};
+
+ValueType
+make_codes_type(size_t vector_size)
+{
+    return ValueType::make_type(vespalib::eval::CellType::INT8, {{"x", uint32_t(vector_size)}});
+}
+
+}
+
+QuantizedVectorStore::QuantizedVectorStore(size_t vector_size, DistanceMetric distance_metric)
+    : _vector_size(vector_size),
+      _codes(make_codes_type(vector_size), {}),
+      _refs(),
+      _refs_size(0u),
+      _scale(0.0),
+      _distance_func()
+{
+    if (distance_metric != DistanceMetric::InnerProduct) {
+        _distance_func = make_distance_function(distance_metric, CellType::INT8);
+    }
+}
+
+QuantizedVectorStore::~QuantizedVectorStore()
+{
+    _refs.reset();
+}
+
+void
+QuantizedVectorStore::encode(const TypedCells& vector, double scale, Int8Float* codes) const
+{
+    assert(vector.size == _vector_size);
+    typify_invoke<1,TypifyCellType,Encode>(vector.type, vector, scale, codes);
+}
+
+void
+QuantizedVectorStore::train(const std::vector<uint32_t>& docids, const DocVectorAccess& vectors)
+{
+    assert(!is_trained());
+    double max_abs = 0.0;
+    for (uint32_t docid : docids) {
+        auto vector = vectors.get_vector(docid);
+        max_abs = std::max(max_abs, typify_invoke<1,TypifyCellType,CalcMaxAbs>(vector.type, vector));
+    }
+    double scale = (max_abs > 0.0) ? (max_code / max_abs) : 1.0;
+    for (uint32_t docid : docids) {
+        store_codes(docid, vectors.get_vector(docid), scale);
+    }
+    // Readers only use the codes when the store is trained, so the scale is published last.
+    _scale.store(scale, std::memory_order_release);
+}
+
+void
+QuantizedVectorStore::set(uint32_t docid, const TypedCells& vector)
+{
+    double scale = _scale.load(std::memory_order_relaxed);
+    if (scale > 0.0) {
+        store_codes(docid, vector, scale);
+    }
+}
+
+void
+QuantizedVectorStore::store_codes(uint32_t docid, const TypedCells& vector, double scale)
+{
+    auto raw = _codes.allocRawBuffer();
+    encode(vector, scale, reinterpret_cast<Int8Float*>(raw.data));
+    if (docid >= _refs.size()) {
+        _refs.ensure_size(docid + 1, AtomicEntryRef());
+        _refs_size.store(_refs.size(), std::memory_order_release);
+    }
+    auto old_ref = _refs[docid].load_relaxed();
+    _refs[docid].store_release(raw.ref);
+    _codes.holdTensor(old_ref);
+}
+
+double
+QuantizedVectorStore::calc_inner_product_distance(const TypedCells& lhs, const TypedCells& rhs) const
+{
+    static const auto& hw = vespalib::hwaccelrated::IAccelrated::getAccelerator();
+    assert((lhs.type == CellType::INT8) && (rhs.type == CellType::INT8));
+    assert(lhs.size == rhs.size);
+    double scale = _scale.load(std::memory_order_relaxed);
+    double dot = hw.dotProduct(static_cast<const int8_t*>(lhs.data), static_cast<const int8_t*>(rhs.data), lhs.size);
+    return 1.0 - (dot / (scale * scale));
+}
+
+void
+QuantizedVectorStore::remove(uint32_t docid)
+{
+    if (docid >= _refs.size()) {
+        return;
+    }
+    auto old_ref = _refs[docid].load_relaxed();
+    _refs[docid].store_release(EntryRef());
+    _codes.holdTensor(old_ref);
+}
+
+QuantizedVectorStore::TypedCells
+QuantizedVectorStore::quantize(const TypedCells& vector, QueryCodes& codes) const
+{
+    codes.resize(_vector_size);
+    encode(vector, _scale.load(std::memory_order_acquire), codes.data());
+    return TypedCells(vespalib::ConstArrayRef<Int8Float>(codes));
+}
+
+void
+QuantizedVectorStore::transfer_hold_lists(generation_t current_gen)
+{
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+    _refs.setGeneration(current_gen + 1);
+    _codes.transferHoldLists(current_gen);
+}
+
+void
+QuantizedVectorStore::trim_hold_lists(generation_t first_used_gen)
+{
+    _refs.removeOldGenerations(first_used_gen);
+    _codes.trimHoldLists(first_used_gen);
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    vespalib::MemoryUsage result;
+    result.merge(_refs.getMemoryUsage());
+    result.merge(_codes.getMemoryUsage());
+    return result;
+}
+
+}
@@ -0,0 +1,95 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "dense_tensor_store.h"
+#include "distance_function.h"
+#include <vespa/eval/eval/int8float.h>
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+#include <vector>
+
+namespace search::tensor {
+
+class DocVectorAccess;
+
+/**
+ * Stores int8 scalar quantized versions of the vectors indexed by a HnswIndex.
+ * They are used to calculate approximate distances while traversing the graph,
+ * while the full precision vectors are used to re-rank the final candidates.
+ *
+ * All cells are quantized using a common scale and no offset.
+ * This keeps the ordering of euclidean and inner product distances, and the angles between vectors.
+ * Inner product distances are not clamped, and are rescaled by 1/scale^2, as the dot product
+ * of the codes is much larger than the dot product of the original (normalized) vectors.
+ * The scale is selected when the store is trained, based on the vectors present at that time.
+ * Cells outside the trained range are clamped.
+ *
+ * Supports 1 write thread and multiple reader threads, using generation tracking.
+ */
+class QuantizedVectorStore {
+public:
+    using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
+    using EntryRef = vespalib::datastore::EntryRef;
+    using CellType = vespalib::eval::CellType;
+    using Int8Float = vespalib::eval::Int8Float;
+    using TypedCells = vespalib::eval::TypedCells;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using QueryCodes = std::vector<Int8Float>;
+
+private:
+    using RefVector = vespalib::RcuVector<AtomicEntryRef>;
+
+    size_t                 _vector_size;
+    DenseTensorStore       _codes;
+    RefVector              _refs;
+    std::atomic<uint32_t>  _refs_size;
+    std::atomic<double>    _scale; // 0.0 until trained
+    DistanceFunction::UP   _distance_func; // not used for inner product
+
+    void encode(const TypedCells& vector, double scale, Int8Float* codes) const;
+    void store_codes(uint32_t docid, const TypedCells& vector, double scale);
+    double calc_inner_product_distance(const TypedCells& lhs, const TypedCells& rhs) const;
+
+public:
+    QuantizedVectorStore(size_t vector_size, search::attribute::DistanceMetric distance_metric);
+    ~QuantizedVectorStore();
+
+    bool is_trained() const noexcept { return _scale.load(std::memory_order_acquire) > 0.0; }
+
+    /**
+     * Selects the scale based on the vectors for the given docids, and stores codes for all of them.
+     * Called by the write thread.
+     */
+    void train(const std::vector<uint32_t>& docids, const DocVectorAccess& vectors);
+
+    // Called by the write thread. No-op until the store is trained.
+    void set(uint32_t docid, const TypedCells& vector);
+    void remove(uint32_t docid);
+
+    // Quantizes a query vector (using the trained scale) into the given codes.
+    TypedCells quantize(const TypedCells& vector, QueryCodes& codes) const;
+
+    TypedCells get_codes(uint32_t docid) const {
+        EntryRef ref;
+        if (docid < _refs_size.load(std::memory_order_acquire)) {
+            ref = _refs.acquire_elem_ref(docid).load_acquire();
+        }
+        return _codes.get_typed_cells(ref);
+    }
+    double calc_distance(const TypedCells& lhs, uint32_t rhs_docid) const {
+        if (_distance_func) {
+            return _distance_func->calc(lhs, get_codes(rhs_docid));
+        }
+        return calc_inner_product_distance(lhs, get_codes(rhs_docid));
+    }
+
+    void transfer_hold_lists(generation_t current_gen);
+    void trim_hold_lists(generation_t first_used_gen);
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+}
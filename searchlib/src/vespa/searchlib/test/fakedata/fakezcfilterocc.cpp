@@ -173,6 +173,7 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_doc_ids", _posting_params._block_doc_ids);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -861,6 +862,39 @@ public:
     }
 };
 
+template <bool bigEndian>
+class FakeZc4BlockPosOccCf : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc4BlockPosOccCf(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
+                                       (bigEndian ? ".zc4blockposoccbe.cf" : ".zc4blockposoccle.cf"))
+    {
+    }
+};
+
+class FakeZc4BlockPosOccCfNoCheapUnpack : public FakeZc4SkipPosOcc<true>
+{
+public:
+    FakeZc4BlockPosOccCfNoCheapUnpack(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<true>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, false, true, true, true),
+                                  ".zc4blockposoccbe.cf.ncu")
+    {
+        _unpack_interleaved_features = false;
+    }
+};
+
+template <bool bigEndian>
+class FakeZc5BlockPosOcc : public FakeZc4SkipPosOcc<bigEndian>
+{
+public:
+    FakeZc5BlockPosOcc(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<bigEndian>(fw, Zc4PostingParams(force_skip, disable_chunking, fw._docIdLimit, true, true, false, true),
+                                       (bigEndian ? ".zc5blockposoccbe" : ".zc5blockposoccle"))
+    {
+    }
+};
+
 static FPFactoryInit
 initPosbe(std::make_pair("EGCompr64PosOccBE",
                          makeFPFactory<FPFactoryT<FakeEGCompr64PosOcc<true> > >));
@@ -948,4 +982,29 @@ static FPFactoryInit
 initNoSkipPoslecf(std::make_pair("Zc5NoSkipPosOccLE.cf",
                                  makeFPFactory<FPFactoryT<FakeZc5NoSkipPosOccCf<false> > >));
 
+
+static FPFactoryInit
+initBlockPos0becf(std::make_pair("Zc4BlockPosOccBE.cf",
+                                 makeFPFactory<FPFactoryT<FakeZc4BlockPosOccCf<true> > >));
+
+
+static FPFactoryInit
+initBlockPos0lecf(std::make_pair("Zc4BlockPosOccLE.cf",
+                                 makeFPFactory<FPFactoryT<FakeZc4BlockPosOccCf<false> > >));
+
+
+static FPFactoryInit
+initBlockPos0becfncu(std::make_pair("Zc4BlockPosOccBE.cf.ncu",
+                                    makeFPFactory<FPFactoryT<FakeZc4BlockPosOccCfNoCheapUnpack > >));
+
+
+static FPFactoryInit
+initBlockPosbe(std::make_pair("Zc5BlockPosOccBE",
+                              makeFPFactory<FPFactoryT<FakeZc5BlockPosOcc<true> > >));
+
+
+static FPFactoryInit
+initBlockPosle(std::make_pair("Zc5BlockPosOccLE",
+                              makeFPFactory<FPFactoryT<FakeZc5BlockPosOcc<false> > >));
+
 }
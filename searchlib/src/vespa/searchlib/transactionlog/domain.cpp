@@ -2,6 +2,7 @@
 
 #include "domain.h"
 #include "domainpart.h"
+#include "group_committer.h"
 #include "session.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/io/fileutil.h>
@@ -38,10 +39,16 @@ createCommitChunk(const DomainConfig &cfg) {
 
 Domain::Domain(const string &domainName, const string & baseDir, vespalib::Executor & executor,
                const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
+    : Domain(domainName, baseDir, executor, cfg, fileHeaderContext, {})
+{}
+
+Domain::Domain(const string &domainName, const string & baseDir, vespalib::Executor & executor,
+               const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext, GroupCommitterSP groupCommitter)
     : _config(cfg),
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, 128_Ki)),
+      _groupCommitter(std::move(groupCommitter)),
       _executor(executor),
       _sessionId(1),
       _name(domainName),
@@ -117,6 +124,9 @@ Domain::~Domain() {
     vespalib::Gate gate;
     _singleCommitter->execute(makeLambdaTask([callback=std::make_unique<vespalib::GateCallback>(gate)]() { (void) callback;}));
     gate.await();
+    if (_groupCommitter) {
+        _groupCommitter->drain();
+    }
 }
 
 DomainInfo
@@ -214,9 +224,12 @@ Domain::triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync
         std::unique_lock guard(_currentChunkMutex);
         commitAndTransferResponses(guard);
     }
-    _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() {
-        (void) after_sync;
-        getActivePart()->sync();
+    _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() mutable {
+        if (_groupCommitter) {
+            _groupCommitter->syncNow(*this, std::move(after_sync));
+        } else {
+            getActivePart()->sync();
+        }
     }));
 }
 
@@ -378,11 +391,12 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
 
 
 void
-Domain::doCommit(const SerializedChunk & serialized) {
-
-    SerialNumRange range = serialized.range();
-    DomainPart::SP dp = optionallyRotateFile(range.from());
-    dp->commit(serialized);
+Domain::doCommit(SerializedChunk serialized) {
+    if (_groupCommitter) {
+        _groupCommitter->commit(*this, std::move(serialized), _config.getFSyncOnCommit());
+        return;
+    }
+    DomainPart::SP dp = writeChunk(serialized);
     if (_config.getFSyncOnCommit()) {
         dp->sync();
     }
@@ -391,6 +405,13 @@ Domain::doCommit(const SerializedChunk & serialized) {
         serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
 }
 
+DomainPart::SP
+Domain::writeChunk(const SerializedChunk & serialized) {
+    DomainPart::SP dp = optionallyRotateFile(serialized.range().from());
+    dp->commit(serialized);
+    return dp;
+}
+
 bool
 Domain::erase(SerialNum to)
 {
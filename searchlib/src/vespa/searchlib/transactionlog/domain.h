@@ -11,6 +11,7 @@ namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
 
 class DomainPart;
+class GroupCommitter;
 class Session;
 
 class Domain : public Writer
@@ -19,8 +20,15 @@ public:
     using SP = std::shared_ptr<Domain>;
     using DomainPartSP = std::shared_ptr<DomainPart>;
     using FileHeaderContext = common::FileHeaderContext;
+    using GroupCommitterSP = std::shared_ptr<GroupCommitter>;
     Domain(const vespalib::string &name, const vespalib::string &baseDir, vespalib::Executor & executor,
            const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext);
+    /**
+     * If a group committer is given, chunks are written and synced by it
+     * together with those of other domains instead of by this domain.
+     */
+    Domain(const vespalib::string &name, const vespalib::string &baseDir, vespalib::Executor & executor,
+           const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext, GroupCommitterSP groupCommitter);
 
     ~Domain() override;
 
@@ -55,6 +63,7 @@ public:
     uint64_t size() const;
     Domain & setConfig(const DomainConfig & cfg);
 private:
+    friend class GroupCommitter;
     using UniqueLock = std::unique_lock<std::mutex>;
     DomainPartSP getActivePart();
     void verifyLock(const UniqueLock & guard) const;
@@ -63,7 +72,8 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized);
+    DomainPartSP writeChunk(const SerializedChunk & serialized);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -86,6 +96,7 @@ private:
     std::unique_ptr<CommitChunk> _currentChunk;
     SerialNum                    _lastSerial;
     std::unique_ptr<Executor>    _singleCommitter;
+    GroupCommitterSP             _groupCommitter;
     Executor                    &_executor;
     std::atomic<int>             _sessionId;
     vespalib::string             _name;
@@ -9,6 +9,8 @@ DomainConfig::DomainConfig()
     : _encoding(Encoding::Crc::xxh64, Encoding::Compression::zstd),
       _compressionLevel(9),
       _fSyncOnCommit(false),
+      _groupCommit(false),
+      _groupCommitInterval(vespalib::duration::zero()),
       _partSizeLimit(0x10000000), // 256M
       _chunkSizeLimit(0x40000)   // 256k
 { }
@@ -16,15 +16,21 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommit(bool v)           { _groupCommit = v; return *this; }
+    DomainConfig & setGroupCommitInterval(duration v) { _groupCommitInterval = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    bool          getGroupCommit() const { return _groupCommit; }
+    duration getGroupCommitInterval() const { return _groupCommitInterval; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
+    bool         _groupCommit;
+    duration     _groupCommitInterval;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
 };
@@ -0,0 +1,178 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "group_committer.h"
+#include "domain.h"
+#include "domainpart.h"
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".transactionlog.group_committer");
+
+namespace search::transactionlog {
+
+GroupCommitter::Stats::Stats() noexcept
+    : rounds(0),
+      chunks(0),
+      syncs(0),
+      last_round_chunks(0),
+      max_round_chunks(0),
+      last_sync_time(),
+      max_sync_time(),
+      total_sync_time()
+{}
+
+GroupCommitter::Entry::Entry(Domain &domain_in, std::unique_ptr<SerializedChunk> chunk_in,
+                             std::unique_ptr<vespalib::IDestructorCallback> after_sync_in, bool sync_in) noexcept
+    : domain(&domain_in),
+      chunk(std::move(chunk_in)),
+      after_sync(std::move(after_sync_in)),
+      sync(sync_in)
+{}
+
+GroupCommitter::Entry::Entry(Entry &&) noexcept = default;
+GroupCommitter::Entry & GroupCommitter::Entry::operator=(Entry &&) noexcept = default;
+GroupCommitter::Entry::~Entry() = default;
+
+GroupCommitter::GroupCommitter(vespalib::duration interval)
+    : _lock(),
+      _cond(),
+      _queue(),
+      _queued(0),
+      _completed(0),
+      _interval(interval),
+      _stopped(false),
+      _stats(),
+      _thread()
+{
+    _thread = std::thread([this]() { run(); });
+}
+
+GroupCommitter::~GroupCommitter()
+{
+    {
+        std::lock_guard guard(_lock);
+        _stopped = true;
+    }
+    _cond.notify_all();
+    _thread.join();
+}
+
+void
+GroupCommitter::setInterval(vespalib::duration interval)
+{
+    std::lock_guard guard(_lock);
+    _interval = interval;
+}
+
+void
+GroupCommitter::enqueue(Entry entry)
+{
+    {
+        std::lock_guard guard(_lock);
+        _queue.push_back(std::move(entry));
+        ++_queued;
+    }
+    _cond.notify_all();
+}
+
+void
+GroupCommitter::commit(Domain & domain, SerializedChunk chunk, bool sync)
+{
+    enqueue(Entry(domain, std::make_unique<SerializedChunk>(std::move(chunk)), {}, sync));
+}
+
+void
+GroupCommitter::syncNow(Domain & domain, std::unique_ptr<vespalib::IDestructorCallback> after_sync)
+{
+    enqueue(Entry(domain, {}, std::move(after_sync), true));
+}
+
+void
+GroupCommitter::drain()
+{
+    std::unique_lock guard(_lock);
+    uint64_t wanted = _queued;
+    _cond.wait(guard, [&]() { return _completed >= wanted; });
+}
+
+GroupCommitter::Stats
+GroupCommitter::getStats() const
+{
+    std::lock_guard guard(_lock);
+    return _stats;
+}
+
+void
+GroupCommitter::run()
+{
+    Round round;
+    std::unique_lock guard(_lock);
+    while (true) {
+        _cond.wait(guard, [this]() { return _stopped || !_queue.empty(); });
+        if (_queue.empty()) {
+            break;
+        }
+        vespalib::steady_time roundStart = vespalib::steady_clock::now();
+        round.swap(_queue);
+        guard.unlock();
+        doRound(round);
+        size_t numEntries = round.size();
+        // Releases the chunks, and thereby their callbacks, in queue order.
+        round.clear();
+        guard.lock();
+        _completed += numEntries;
+        _cond.notify_all();
+        if (_interval > vespalib::duration::zero()) {
+            _cond.wait_until(guard, roundStart + _interval, [this]() { return _stopped; });
+        }
+    }
+}
+
+void
+GroupCommitter::doRound(Round & round)
+{
+    std::vector<std::shared_ptr<DomainPart>> toSync;
+    std::vector<Domain *> domains;
+    uint32_t numChunks = 0;
+    for (Entry & entry : round) {
+        std::shared_ptr<DomainPart> part;
+        if (entry.chunk) {
+            part = entry.domain->writeChunk(*entry.chunk);
+            ++numChunks;
+        } else {
+            part = entry.domain->getActivePart();
+        }
+        if (entry.sync && (std::find(toSync.begin(), toSync.end(), part) == toSync.end())) {
+            toSync.push_back(std::move(part));
+        }
+        if (std::find(domains.begin(), domains.end(), entry.domain) == domains.end()) {
+            domains.push_back(entry.domain);
+        }
+    }
+    uint32_t numSyncs = 0;
+    vespalib::steady_time syncStart = vespalib::steady_clock::now();
+    for (const auto & part : toSync) {
+        // A part rotated away during the round has already been synced and closed.
+        if ( ! part->isClosed()) {
+            part->sync();
+            ++numSyncs;
+        }
+    }
+    vespalib::duration syncTime = vespalib::steady_clock::now() - syncStart;
+    for (Domain * domain : domains) {
+        domain->cleanSessions();
+    }
+    LOG(debug, "Group commit round: %zu entries, %u chunks from %zu domains, %u syncs in %1.3f ms",
+        round.size(), numChunks, domains.size(), numSyncs, vespalib::count_ns(syncTime) / 1000000.0);
+    std::lock_guard guard(_lock);
+    _stats.rounds++;
+    _stats.chunks += numChunks;
+    _stats.syncs += numSyncs;
+    _stats.last_round_chunks = numChunks;
+    _stats.max_round_chunks = std::max(_stats.max_round_chunks, numChunks);
+    _stats.last_sync_time = syncTime;
+    _stats.max_sync_time = std::max(_stats.max_sync_time, syncTime);
+    _stats.total_sync_time += syncTime;
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "ichunk.h"
+#include <vespa/vespalib/util/idestructorcallback.h>
+#include <vespa/vespalib/util/time.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace search::transactionlog {
+
+class Domain;
+
+/**
+ * Coordinates commits of serialized chunks from all domains of a transaction
+ * log server. Chunks are queued by the domains in serial number order, and
+ * written in rounds. Each domain part written to during a round is synced
+ * once at the end of the round, after which the chunks, and thereby the
+ * callbacks waiting for them to be committed, are released in queue order.
+ *
+ * With a non-zero interval, rounds are started at most once per interval,
+ * trading commit latency for larger rounds and fewer syncs.
+ */
+class GroupCommitter {
+public:
+    struct Stats {
+        uint64_t           rounds;
+        uint64_t           chunks;
+        uint64_t           syncs;
+        uint32_t           last_round_chunks;
+        uint32_t           max_round_chunks;
+        vespalib::duration last_sync_time;
+        vespalib::duration max_sync_time;
+        vespalib::duration total_sync_time;
+        Stats() noexcept;
+    };
+    explicit GroupCommitter(vespalib::duration interval);
+    GroupCommitter(const GroupCommitter &) = delete;
+    GroupCommitter & operator=(const GroupCommitter &) = delete;
+    ~GroupCommitter();
+
+    void setInterval(vespalib::duration interval);
+    /**
+     * Queue a chunk to be written to the active part of the given domain,
+     * and synced if requested. Must be called in serial number order for
+     * each domain.
+     */
+    void commit(Domain & domain, SerializedChunk chunk, bool sync);
+    /**
+     * Queue a sync of the active part of the given domain after all chunks
+     * queued so far. The callback is released when the sync is done.
+     */
+    void syncNow(Domain & domain, std::unique_ptr<vespalib::IDestructorCallback> after_sync);
+    /// Wait until everything queued before this call is done.
+    void drain();
+    Stats getStats() const;
+private:
+    struct Entry {
+        Domain                                       *domain;
+        std::unique_ptr<SerializedChunk>              chunk;
+        std::unique_ptr<vespalib::IDestructorCallback> after_sync;
+        bool                                          sync;
+        Entry(Domain &domain_in, std::unique_ptr<SerializedChunk> chunk_in,
+              std::unique_ptr<vespalib::IDestructorCallback> after_sync_in, bool sync_in) noexcept;
+        Entry(Entry &&) noexcept;
+        Entry & operator=(Entry &&) noexcept;
+        ~Entry();
+    };
+    using Round = std::vector<Entry>;
+
+    void enqueue(Entry entry);
+    void run();
+    void doRound(Round & round);
+
+    mutable std::mutex       _lock;
+    std::condition_variable  _cond;
+    Round                    _queue;
+    uint64_t                 _queued;
+    uint64_t                 _completed;
+    vespalib::duration       _interval;
+    bool                     _stopped;
+    Stats                    _stats;
+    std::thread              _thread;
+};
+
+}
@@ -3,6 +3,7 @@
 #include "trans_log_server_explorer.h"
 #include "translogserver.h"
 #include "domain.h"
+#include "group_committer.h"
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/time.h>
 #include <vespa/fastos/file.h>
@@ -51,7 +52,20 @@ void
 TransLogServerExplorer::get_state(const Inserter &inserter, bool full) const
 {
     (void) full;
-    inserter.insertObject();
+    Cursor &state = inserter.insertObject();
+    const GroupCommitter *groupCommitter = _server->getGroupCommitter();
+    if (groupCommitter != nullptr) {
+        GroupCommitter::Stats stats = groupCommitter->getStats();
+        Cursor &object = state.setObject("groupCommit");
+        object.setLong("rounds", stats.rounds);
+        object.setLong("chunks", stats.chunks);
+        object.setLong("syncs", stats.syncs);
+        object.setLong("lastRoundChunks", stats.last_round_chunks);
+        object.setLong("maxRoundChunks", stats.max_round_chunks);
+        object.setDouble("lastSyncTime", vespalib::to_s(stats.last_sync_time));
+        object.setDouble("maxSyncTime", vespalib::to_s(stats.max_sync_time));
+        object.setDouble("totalSyncTime", vespalib::to_s(stats.total_sync_time));
+    }
 }
 
 std::vector<vespalib::string>
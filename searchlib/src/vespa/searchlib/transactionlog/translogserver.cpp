@@ -1,6 +1,7 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "translogserver.h"
 #include "domain.h"
+#include "group_committer.h"
 #include "client_common.h"
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/fnet/frt/supervisor.h>
@@ -99,6 +100,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const vespalib::strin
       _baseDir(baseDir),
       _domainConfig(cfg),
       _executor(maxThreads, 128_Ki, CpuUsage::wrap(tls_executor, CpuUsage::Category::WRITE)),
+      _groupCommitter(cfg.getGroupCommit() ? std::make_shared<GroupCommitter>(cfg.getGroupCommitInterval()) : nullptr),
       _threadPool(std::make_unique<FastOS_ThreadPool>(120_Ki)),
       _supervisor(std::make_unique<FRT_Supervisor>(&transport)),
       _domains(),
@@ -115,7 +117,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const vespalib::strin
                 domainDir >> domainName;
                 if ( ! domainName.empty()) {
                     try {
-                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext);
+                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext, _groupCommitter);
                         _domains[domain->name()] = domain;
                     } catch (const std::exception & e) {
                         LOG(warning, "Failed creating %s domain on startup. Exception = %s", domainName.c_str(), e.what());
@@ -213,6 +215,9 @@ TransLogServer::setDomainConfig(const DomainConfig & cfg) {
     for(auto &domain: _domains) {
         domain.second->setConfig(cfg);
     }
+    if (_groupCommitter) {
+        _groupCommitter->setInterval(cfg.getGroupCommitInterval());
+    }
     return *this;
 }
 
@@ -440,7 +445,7 @@ TransLogServer::createDomain(FRT_RPCRequest *req)
     Domain::SP domain(findDomain(domainName));
     if ( !domain ) {
         try {
-            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext);
+            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext, _groupCommitter);
             {
                 WriteGuard domainGuard(_domainMutex);
                 _domains[domain->name()] = domain;
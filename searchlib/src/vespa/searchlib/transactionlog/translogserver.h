@@ -17,6 +17,7 @@ namespace search::transactionlog {
 
 class TransLogServerExplorer;
 class Domain;
+class GroupCommitter;
 
 class TransLogServer : private FRT_Invokable, public document::Runnable, public WriterFactory
 {
@@ -32,6 +33,7 @@ public:
                    const common::FileHeaderContext &fileHeaderContext);
     ~TransLogServer() override;
     DomainStats getDomainStats() const;
+    const GroupCommitter * getGroupCommitter() const { return _groupCommitter.get(); }
     std::shared_ptr<Writer> getWriter(const vespalib::string & domainName) const override;
     TransLogServer & setDomainConfig(const DomainConfig & cfg);
 
@@ -67,6 +69,7 @@ private:
     vespalib::string                    _baseDir;
     DomainConfig                        _domainConfig;
     vespalib::ThreadStackExecutor       _executor;
+    std::shared_ptr<GroupCommitter>     _groupCommitter; // Shared by all domains when group commit is enabled
     std::unique_ptr<FastOS_ThreadPool>  _threadPool;
     std::unique_ptr<FRT_Supervisor>     _supervisor;
     DomainList                          _domains;
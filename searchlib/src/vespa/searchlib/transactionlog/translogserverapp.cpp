@@ -66,7 +66,9 @@ getDomainConfig(const searchlib::TranslogserverConfig & cfg) {
         .setCompressionLevel(cfg.compression.level)
         .setPartSizeLimit(cfg.filesizemax)
         .setChunkSizeLimit(cfg.chunk.sizelimit)
-        .setFSyncOnCommit(cfg.usefsync);
+        .setFSyncOnCommit(cfg.usefsync)
+        .setGroupCommit(cfg.groupcommit.enabled)
+        .setGroupCommitInterval(vespalib::from_s(cfg.groupcommit.interval));
     return dcfg;
 }
 
@@ -6,12 +6,20 @@
 #include <vespa/document/base/exceptions.h>
 #include <vespa/document/datatype/datatype.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/serialization/lazydocumentview.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 
 namespace search::docsummary {
 
 DocsumStoreDocument::DocsumStoreDocument(std::unique_ptr<document::Document> document)
-    : _document(std::move(document))
+    : _document(std::move(document)),
+      _view()
+{
+}
+
+DocsumStoreDocument::DocsumStoreDocument(std::unique_ptr<document::LazyDocumentView> view)
+    : _document(),
+      _view(std::move(view))
 {
 }
 
@@ -32,6 +40,15 @@ DocsumStoreDocument::get_field_value(const vespalib::string& field_name) const
         } catch (document::FieldNotFoundException&) {
             // Field was not found in document type. Return empty value.
         }
+    } else if (_view) {
+        try {
+            auto value = _view->getValue(_view->getField(field_name));
+            if (value) {
+                return DocsumStoreFieldValue(std::move(value));
+            }
+        } catch (document::FieldNotFoundException&) {
+            // Field was not found in document type. Return empty value.
+        }
     }
     return DocsumStoreFieldValue();
 }
@@ -58,8 +75,8 @@ DocsumStoreDocument::insert_juniper_field(const vespalib::string& field_name, ve
 void
 DocsumStoreDocument::insert_document_id(vespalib::slime::Inserter& inserter) const
 {
-    if (_document) {
-        auto id = _document->getId().toString();
+    if (_document || _view) {
+        auto id = (_document ? _document->getId() : _view->getId()).toString();
         vespalib::Memory id_view(id.data(), id.size());
         inserter.insertString(id_view);
     }
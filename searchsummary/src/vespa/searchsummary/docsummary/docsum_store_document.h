@@ -4,18 +4,25 @@
 
 #include "i_docsum_store_document.h"
 
-namespace document { class Document; }
+namespace document {
+class Document;
+class LazyDocumentView;
+}
 
 namespace search::docsummary {
 
 /**
  * Class providing access to a document retrieved from an IDocsumStore.
+ * When backed by a lazy document view, only the fields used by the
+ * summary are decoded from the serialized document.
  **/
 class DocsumStoreDocument : public IDocsumStoreDocument
 {
     std::unique_ptr<document::Document> _document;
+    std::unique_ptr<document::LazyDocumentView> _view;
 public:
     explicit DocsumStoreDocument(std::unique_ptr<document::Document> document);
+    explicit DocsumStoreDocument(std::unique_ptr<document::LazyDocumentView> view);
     ~DocsumStoreDocument() override;
     DocsumStoreFieldValue get_field_value(const vespalib::string& field_name) const override;
     void insert_summary_field(const vespalib::string& field_name, vespalib::slime::Inserter& inserter) const override;
@@ -786,4 +786,26 @@ TYPED_TEST(LockableMapTest, entry_changes_not_visible_if_write_not_invoked_on_gu
     EXPECT_EQ(*entry, A());
 }
 
+TYPED_TEST(LockableMapTest, snapshot_get_does_not_require_bucket_lock) {
+    TypeParam map;
+    BucketId id(16, 0x00001);
+    BucketId other(16, 0x00002);
+    bool pre_existed;
+    map.insert(id.toKey(), A(1, 2, 3), "foo", pre_existed);
+
+    // Holding the bucket lock does not block snapshot reads of the bucket.
+    auto entry = map.get(id.toKey(), "foo", false);
+    ASSERT_TRUE(entry.locked());
+    auto snapshot_entry = map.snapshot_get(id.toKey());
+    ASSERT_TRUE(snapshot_entry.has_value());
+    EXPECT_EQ(*snapshot_entry, A(1, 2, 3));
+    EXPECT_FALSE(map.snapshot_get(other.toKey()).has_value());
+
+    // Changes are only visible once written back.
+    *entry = A(4, 5, 6);
+    EXPECT_EQ(*map.snapshot_get(id.toKey()), A(1, 2, 3));
+    entry.write();
+    EXPECT_EQ(*map.snapshot_get(id.toKey()), A(4, 5, 6));
+}
+
 } // storage
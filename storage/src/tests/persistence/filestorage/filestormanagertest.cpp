@@ -2087,4 +2087,35 @@ TEST_F(FileStorHandlerTest, inhibited_operations_are_skipped)
     EXPECT_EQ(30, get_next_message().msg->getPriority());
 }
 
+TEST_F(FileStorHandlerTest, feed_ops_to_same_bucket_are_not_batched_by_default)
+{
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::a", 100));
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::a", 101));
+    auto locked_msg = get_next_message();
+    ASSERT_TRUE(locked_msg.msg);
+    EXPECT_TRUE(locked_msg.batch.empty());
+}
+
+TEST_F(FileStorHandlerTest, feed_ops_to_same_bucket_are_batched_until_non_batchable_op)
+{
+    std::string docid_a = "id:foo:testdoctype1::a";
+    std::string docid_b = "id:foo:testdoctype1::b";
+    handler->set_max_feed_op_batch_size(3);
+    handler->schedule(make_put_command(20, docid_a, 100));
+    handler->schedule(make_put_command(20, docid_b, 200));
+    handler->schedule(make_put_command(20, docid_a, 101));
+    handler->schedule(make_get_command(20, docid_a));
+    handler->schedule(make_put_command(20, docid_a, 102));
+    {
+        auto locked_msg = get_next_message();
+        ASSERT_TRUE(locked_msg.msg);
+        EXPECT_EQ(100, static_cast<api::PutCommand&>(*locked_msg.msg).getTimestamp());
+        ASSERT_EQ(1u, locked_msg.batch.size());
+        EXPECT_EQ(101, static_cast<api::PutCommand&>(*locked_msg.batch[0].msg).getTimestamp());
+    }
+    EXPECT_EQ(200, static_cast<api::PutCommand&>(*get_next_message().msg).getTimestamp());
+    EXPECT_EQ(api::MessageType::GET_ID, get_next_message().msg->getType().getId());
+    EXPECT_EQ(102, static_cast<api::PutCommand&>(*get_next_message().msg).getTimestamp());
+}
+
 } // storage
@@ -168,9 +168,10 @@ struct MergeHandlerTest : PersistenceTestUtils {
                        HandlerInvoker& invoker,
                        const ExpectedExceptionSpec& spec);
 
-    MergeHandler createHandler(size_t maxChunkSize = 0x400000) {
+    MergeHandler createHandler(size_t maxChunkSize = 0x400000, uint32_t maxFetchWindowSize = 1048576) {
         return MergeHandler(getEnv(), getPersistenceProvider(),
-                            getEnv()._component.cluster_context(), getEnv()._component.getClock(), *_sequenceTaskExecutor, maxChunkSize, 64);
+                            getEnv()._component.cluster_context(), getEnv()._component.getClock(), *_sequenceTaskExecutor,
+                            maxChunkSize, 64, maxFetchWindowSize);
     }
     MergeHandler createHandler(spi::PersistenceProvider & spi) {
         return MergeHandler(getEnv(), spi,
@@ -546,6 +547,41 @@ TEST_F(MergeHandlerTest, chunk_limit_partially_filled_diff) {
     EXPECT_LE(getFilledDataSize(fwdDiffCmd->getDiff()), maxChunkSize);
 }
 
+TEST_F(MergeHandlerTest, diff_is_filled_across_multiple_fetch_windows) {
+    setUpChain(FRONT);
+
+    uint32_t docSize = 1024;
+    uint32_t docCount = 5;
+
+    for (uint32_t i = 0; i < docCount; ++i) {
+        doPut(1234, spi::Timestamp(4000 + i), docSize, docSize);
+    }
+
+    std::vector<api::ApplyBucketDiffCommand::Entry> applyDiff;
+    for (uint32_t i = 0; i < docCount; ++i) {
+        api::ApplyBucketDiffCommand::Entry e;
+        e._entry._timestamp = 4000 + i;
+        e._entry._hasMask = 0x3;
+        e._entry._flags = MergeHandler::IN_USE;
+        applyDiff.push_back(e);
+    }
+
+    setUpChain(MIDDLE);
+    auto applyBucketDiffCmd = std::make_shared<api::ApplyBucketDiffCommand>(_bucket, _nodes);
+    applyBucketDiffCmd->getDiff() = applyDiff;
+
+    // Window only fits a single document per iteration
+    MergeHandler handler = createHandler(0x400000, docSize);
+    handler.handleApplyBucketDiff(*applyBucketDiffCmd, createTracker(applyBucketDiffCmd, _bucket));
+
+    auto fwdDiffCmd = fetchSingleMessage<api::ApplyBucketDiffCommand>();
+    EXPECT_EQ(docCount, getFilledCount(fwdDiffCmd->getDiff()));
+    for (const auto& e : fwdDiffCmd->getDiff()) {
+        EXPECT_EQ(0x3, e._entry._hasMask);
+        EXPECT_FALSE(e._docName.empty());
+    }
+}
+
 TEST_F(MergeHandlerTest, max_timestamp) {
     doPut(1234, spi::Timestamp(_maxTimestamp + 10), 1024, 1024);
 
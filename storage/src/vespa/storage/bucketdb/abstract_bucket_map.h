@@ -11,6 +11,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <optional>
 
 namespace storage::bucketdb {
 
@@ -185,6 +186,16 @@ public:
         return do_acquire_read_guard();
     }
 
+    /**
+     * Returns a copy of the entry stored for the given key, if any, without
+     * taking the database mutex or the bucket lock. The lookup is done on a
+     * read snapshot, so the returned value may be stale as soon as it is
+     * returned, and must only be used for decisions that tolerate this.
+     */
+    [[nodiscard]] std::optional<ValueT> snapshot_get(const key_type& key) const {
+        return do_snapshot_get(key);
+    }
+
     [[nodiscard]] virtual size_type size() const noexcept = 0;
     [[nodiscard]] virtual size_type getMemoryUsage() const noexcept = 0;
     [[nodiscard]] virtual vespalib::MemoryUsage detailed_memory_usage() const noexcept = 0;
@@ -204,6 +215,7 @@ private:
     virtual void do_for_each(std::function<Decision(uint64_t, const ValueT&)> func,
                              const char* clientId) = 0;
     virtual std::unique_ptr<bucketdb::ReadGuard<ValueT>> do_acquire_read_guard() const = 0;
+    virtual std::optional<ValueT> do_snapshot_get(const key_type& key) const = 0;
 };
 
 template <typename ValueT>
@@ -131,6 +131,7 @@ private:
                              uint32_t chunk_size) override;
 
     std::unique_ptr<ReadGuard<T>> do_acquire_read_guard() const override;
+    std::optional<T> do_snapshot_get(const key_type& key) const override;
 
     /**
      * Process up to `chunk_size` bucket database entries from--and possibly
@@ -420,6 +420,17 @@ std::unique_ptr<ReadGuard<T>> BTreeLockableMap<T>::do_acquire_read_guard() const
     return std::make_unique<ReadGuardImpl>(*this);
 }
 
+template <typename T>
+std::optional<T> BTreeLockableMap<T>::do_snapshot_get(const key_type& key) const {
+    // The snapshot only holds a generation guard, so neither _lock nor the bucket lock is taken.
+    typename ImplType::ReadSnapshot snapshot(*_impl);
+    std::optional<T> result;
+    snapshot.template find_by_raw_key<ByValue>(key, [&result]([[maybe_unused]] uint64_t raw_key, T value) {
+        result = std::move(value);
+    });
+    return result;
+}
+
 template <typename T>
 void BTreeLockableMap<T>::print(std::ostream& out, bool verbose,
                                 const std::string& indent) const
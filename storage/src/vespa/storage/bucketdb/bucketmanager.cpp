@@ -212,8 +212,9 @@ namespace {
 StorBucketDatabase::Entry
 BucketManager::getBucketInfo(const document::Bucket &bucket) const
 {
-    StorBucketDatabase::WrappedEntry entry(
-            _component.getBucketDatabase(bucket.getBucketSpace()).get(bucket.getBucketId(), "BucketManager::getBucketInfo"));
+    // Read-only lookup; no need to take the bucket lock.
+    auto entry = _component.getBucketDatabase(bucket.getBucketSpace()).snapshot_get(bucket.getBucketId());
+    assert(entry.has_value());
     return *entry;
 }
 
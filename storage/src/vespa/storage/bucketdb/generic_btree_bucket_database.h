@@ -151,6 +151,9 @@ public:
         void find_parents_self_and_children(const document::BucketId& bucket, Func func) const;
         template <typename IterValueExtractor, typename Func>
         void for_each(Func func) const;
+        // Functor is called with raw u64 key and value iff the exact key is present in the snapshot.
+        template <typename IterValueExtractor, typename Func>
+        bool find_by_raw_key(uint64_t key, Func func) const;
         std::unique_ptr<ConstIterator<ConstValueRef>> create_iterator() const;
         [[nodiscard]] uint64_t generation() const noexcept;
     };
@@ -594,6 +594,17 @@ void GenericBTreeBucketDatabase<DataStoreTraitsT>::ReadSnapshot::for_each(Func f
     }
 }
 
+template <typename DataStoreTraitsT>
+template <typename IterValueExtractor, typename Func>
+bool GenericBTreeBucketDatabase<DataStoreTraitsT>::ReadSnapshot::find_by_raw_key(uint64_t key, Func func) const {
+    auto iter = _frozen_view.find(key);
+    if (!iter.valid()) {
+        return false;
+    }
+    func(iter.getKey(), IterValueExtractor::apply(*_db, iter));
+    return true;
+}
+
 template <typename DataStoreTraitsT>
 class GenericBTreeBucketDatabase<DataStoreTraitsT>::ReadSnapshot::ConstIteratorImpl
     : public ConstIterator<typename DataStoreTraitsT::ConstValueRef>
@@ -82,6 +82,12 @@ StorBucketDatabase::get(const document::BucketId& bucket,
     return _impl->get(bucket.stripUnused().toKey(), clientId, createIfNonExisting);
 }
 
+std::optional<StorBucketDatabase::Entry>
+StorBucketDatabase::snapshot_get(const document::BucketId& bucket) const
+{
+    return _impl->snapshot_get(bucket.stripUnused().toKey());
+}
+
 size_t StorBucketDatabase::size() const {
     return _impl->size();
 }
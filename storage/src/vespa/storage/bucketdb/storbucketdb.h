@@ -36,6 +36,13 @@ public:
 
     WrappedEntry get(const document::BucketId& bucket, const char* clientId, Flag flags = NONE);
 
+    /**
+     * Returns a copy of the bucket's entry, if it exists, without taking the
+     * bucket lock. The entry may be stale, so it must only be used for
+     * read-only decisions such as whether the bucket is present.
+     */
+    [[nodiscard]] std::optional<Entry> snapshot_get(const document::BucketId& bucket) const;
+
     size_t size() const;
 
     /**
@@ -80,6 +80,7 @@ private:
                              uint32_t chunk_size) override;
 
     std::unique_ptr<ReadGuard<T>> do_acquire_read_guard() const override;
+    std::optional<T> do_snapshot_get(const key_type& key) const override;
 
     [[nodiscard]] size_t stripe_of(key_type) const noexcept;
     [[nodiscard]] StripedDBType& db_for(key_type) noexcept;
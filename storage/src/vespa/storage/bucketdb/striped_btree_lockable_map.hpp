@@ -230,6 +230,11 @@ std::unique_ptr<ReadGuard<T>> StripedBTreeLockableMap<T>::do_acquire_read_guard(
     return std::make_unique<ReadGuardImpl>(*this);
 }
 
+template <typename T>
+std::optional<T> StripedBTreeLockableMap<T>::do_snapshot_get(const key_type& key) const {
+    return db_for(key).snapshot_get(key);
+}
+
 namespace {
 
 template <typename T> using Iter = ConstIterator<const T&>;
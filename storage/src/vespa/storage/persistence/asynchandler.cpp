@@ -167,14 +167,20 @@ AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP) cons
     }
 
     spi::Bucket bucket = _env.getBucket(cmd.getDocumentId(), cmd.getBucket());
+    _spi.putAsync(bucket, spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getDocument()),
+                  makePutComplete(cmd, std::move(trackerUP)));
+
+    return trackerUP;
+}
+
+std::unique_ptr<spi::OperationComplete>
+AsyncHandler::makePutComplete(api::PutCommand& cmd, MessageTracker::UP trackerUP) const
+{
     auto task = makeResultTask([tracker = std::move(trackerUP)](spi::Result::UP response) {
         tracker->checkForError(*response);
         tracker->sendReply();
     });
-    _spi.putAsync(bucket, spi::Timestamp(cmd.getTimestamp()), std::move(cmd.getDocument()),
-                  std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
-
-    return trackerUP;
+    return std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
 }
 
 MessageTracker::UP
@@ -319,7 +325,15 @@ AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP
     }
 
     spi::Bucket bucket = _env.getBucket(cmd.getDocumentId(), cmd.getBucket());
+    _spi.removeIfFoundAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(),
+                            makeRemoveComplete(cmd, std::move(trackerUP)));
+    return trackerUP;
+}
 
+std::unique_ptr<spi::OperationComplete>
+AsyncHandler::makeRemoveComplete(api::RemoveCommand& cmd, MessageTracker::UP trackerUP) const
+{
+    auto& metrics = _env._metrics.remove;
     // Note that the &cmd capture is OK since its lifetime is guaranteed by the tracker
     auto task = makeResultTask([&metrics, &cmd, tracker = std::move(trackerUP)](spi::Result::UP responseUP) {
         auto & response = dynamic_cast<const spi::RemoveResult &>(*responseUP);
@@ -331,9 +345,43 @@ AsyncHandler::handleRemove(api::RemoveCommand& cmd, MessageTracker::UP trackerUP
         }
         tracker->sendReply();
     });
-    _spi.removeIfFoundAsync(bucket, spi::Timestamp(cmd.getTimestamp()), cmd.getDocumentId(),
-                            std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task)));
-    return trackerUP;
+    return std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd.getBucketId(), std::move(task));
+}
+
+void
+AsyncHandler::handlePutOrRemoveBatch(std::vector<std::pair<api::TestAndSetCommand*, MessageTrackerUP>> batch) const
+{
+    assert(!batch.empty());
+    // All operations are towards the same (locked) bucket and have no test-and-set condition.
+    spi::Bucket bucket(batch.front().first->getBucket());
+    std::vector<spi::BatchOperation> ops;
+    ops.reserve(batch.size());
+    for (auto & [cmd, tracker] : batch) {
+        try {
+            if (cmd->getType().getId() == api::MessageType::PUT_ID) {
+                auto & put = static_cast<api::PutCommand&>(*cmd);
+                tracker->setMetric(_env._metrics.put);
+                _env._metrics.put.request_size.addValue(put.getApproxByteSize());
+                _env.getBucket(put.getDocumentId(), put.getBucket());
+                ops.emplace_back(spi::Timestamp(put.getTimestamp()), std::move(put.getDocument()),
+                                 makePutComplete(put, std::move(tracker)));
+            } else {
+                auto & remove = static_cast<api::RemoveCommand&>(*cmd);
+                tracker->setMetric(_env._metrics.remove);
+                _env._metrics.remove.request_size.addValue(remove.getApproxByteSize());
+                _env.getBucket(remove.getDocumentId(), remove.getBucket());
+                ops.emplace_back(spi::Timestamp(remove.getTimestamp()), remove.getDocumentId(),
+                                 makeRemoveComplete(remove, std::move(tracker)));
+            }
+        } catch (std::exception& e) {
+            LOG(debug, "Caught exception for %s: %s", cmd->toString().c_str(), e.what());
+            tracker->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+            tracker->sendReply();
+        }
+    }
+    if (!ops.empty()) {
+        _spi.putOrRemoveBatchAsync(bucket, std::move(ops));
+    }
 }
 
 bool
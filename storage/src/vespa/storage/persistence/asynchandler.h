@@ -12,6 +12,7 @@ namespace storage {
 namespace spi {
     struct PersistenceProvider;
     class Context;
+    class OperationComplete;
 }
 class PersistenceUtil;
 class BucketOwnershipNotifier;
@@ -34,9 +35,16 @@ public:
     MessageTrackerUP handleDeleteBucket(api::DeleteBucketCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleCreateBucket(api::CreateBucketCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleRemoveLocation(api::RemoveLocationCommand& cmd, MessageTrackerUP tracker) const;
+    /**
+     * Handle puts and removes towards the same bucket, none of them having a
+     * test-and-set condition, with a single batch call to the persistence provider.
+     */
+    void handlePutOrRemoveBatch(std::vector<std::pair<api::TestAndSetCommand*, MessageTrackerUP>> batch) const;
     static bool is_async_message(api::MessageType::Id type_id) noexcept;
 private:
     bool checkProviderBucketInfoMatches(const spi::Bucket&, const api::BucketInfo&) const;
+    std::unique_ptr<spi::OperationComplete> makePutComplete(api::PutCommand& cmd, MessageTrackerUP tracker) const;
+    std::unique_ptr<spi::OperationComplete> makeRemoveComplete(api::RemoveCommand& cmd, MessageTrackerUP tracker) const;
     static bool tasConditionExists(const api::TestAndSetCommand & cmd);
     bool tasConditionMatches(const api::TestAndSetCommand & cmd, MessageTracker & tracker,
                              spi::Context & context, bool missingDocumentImpliesMatch = false) const;
@@ -13,6 +13,11 @@
 
 namespace storage {
 
+/**
+ * Collects the fields referenced by a document selection. The resulting field set is
+ * used to fetch a partial document, letting the persistence provider decode only these
+ * fields from the serialized document (see document::LazyDocumentView).
+ */
 class FieldVisitor : public document::select::Visitor {
 private:
     const document::DocumentType & _docType;
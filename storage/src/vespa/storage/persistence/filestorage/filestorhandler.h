@@ -18,6 +18,7 @@
 #include <vespa/storage/common/messagesender.h>
 #include <vespa/storage/persistence/shared_operation_throttler.h>
 #include <vespa/storageapi/messageapi/storagemessage.h>
+#include <vector>
 
 namespace storage {
 namespace api {
@@ -75,24 +76,34 @@ public:
         [[nodiscard]] virtual api::LockingRequirements lockingRequirements() const noexcept = 0;
     };
 
+    struct BatchedMessage {
+        std::shared_ptr<api::StorageMessage> msg;
+        ThrottleToken                        throttle_token;
+    };
+
     struct LockedMessage {
         std::shared_ptr<BucketLockInterface> lock;
         std::shared_ptr<api::StorageMessage> msg;
         ThrottleToken                        throttle_token;
+        // Additional put/remove operations towards the same bucket, dequeued together
+        // with msg (itself a put or remove) and covered by the same bucket lock.
+        std::vector<BatchedMessage>          batch;
 
         LockedMessage() noexcept = default;
         LockedMessage(std::shared_ptr<BucketLockInterface> lock_,
                       std::shared_ptr<api::StorageMessage> msg_) noexcept
             : lock(std::move(lock_)),
               msg(std::move(msg_)),
-              throttle_token()
+              throttle_token(),
+              batch()
         {}
         LockedMessage(std::shared_ptr<BucketLockInterface> lock_,
                       std::shared_ptr<api::StorageMessage> msg_,
                       ThrottleToken token) noexcept
                 : lock(std::move(lock_)),
                   msg(std::move(msg_)),
-                  throttle_token(std::move(token))
+                  throttle_token(std::move(token)),
+                  batch()
         {}
         LockedMessage(LockedMessage&&) noexcept = default;
         ~LockedMessage();
@@ -287,6 +298,12 @@ public:
     virtual void use_dynamic_operation_throttling(bool use_dynamic) noexcept = 0;
 
     virtual void set_throttle_apply_bucket_diff_ops(bool throttle_apply_bucket_diff) noexcept = 0;
+
+    /**
+     * Sets the maximum number of put/remove operations towards the same bucket that
+     * are dequeued together as a single batch. A value of 1 (or less) disables batching.
+     */
+    virtual void set_max_feed_op_batch_size(uint32_t max_batch_size) noexcept = 0;
 private:
     vespalib::duration _getNextMessageTimout;
 };
@@ -62,6 +62,7 @@ FileStorHandlerImpl::FileStorHandlerImpl(uint32_t numThreads, uint32_t numStripe
       _max_active_merges_per_stripe(per_stripe_merge_limit(numThreads, numStripes)),
       _paused(false),
       _throttle_apply_bucket_diff_ops(false),
+      _max_feed_op_batch_size(1),
       _last_active_operations_stats()
 {
     assert(numStripes > 0);
@@ -1041,8 +1042,16 @@ FileStorHandlerImpl::Stripe::getMessage(monitor_guard & guard, PriorityIdx & idx
         auto locker = std::make_unique<BucketLock>(guard, *this, bucket, msg->getPriority(),
                                                    msg->getType().getId(), msg->getMsgId(),
                                                    msg->lockingRequirements());
+        FileStorHandler::LockedMessage locked(std::move(locker), std::move(msg), std::move(throttle_token));
+        auto timed_out = collect_feed_op_batch(guard, bucket, locked);
         guard.unlock();
-        return {std::move(locker), std::move(msg), std::move(throttle_token)};
+        if (!timed_out.empty()) {
+            _cond->notify_all();
+            for (auto & reply : timed_out) {
+                _messageSender.sendReply(reply);
+            }
+        }
+        return locked;
     } else {
         std::shared_ptr<api::StorageReply> msgReply(makeQueueTimeoutReply(*msg));
         guard.unlock();
@@ -1052,6 +1061,57 @@ FileStorHandlerImpl::Stripe::getMessage(monitor_guard & guard, PriorityIdx & idx
     }
 }
 
+namespace {
+
+bool
+is_batchable_feed_op(const api::StorageMessage & msg) noexcept
+{
+    auto type_id = msg.getType().getId();
+    if ((type_id != api::MessageType::PUT_ID) && (type_id != api::MessageType::REMOVE_ID)) {
+        return false;
+    }
+    // Test-and-set conditions must be evaluated against the result of all preceding operations.
+    return !static_cast<const api::TestAndSetCommand &>(msg).getCondition().isPresent();
+}
+
+}
+
+std::vector<std::shared_ptr<api::StorageReply>>
+FileStorHandlerImpl::Stripe::collect_feed_op_batch(monitor_guard & guard, const document::Bucket & bucket,
+                                                   FileStorHandler::LockedMessage & locked)
+{
+    std::vector<std::shared_ptr<api::StorageReply>> timed_out;
+    const uint32_t max_batch_size = _owner.max_feed_op_batch_size();
+    if ((max_batch_size <= 1) || !is_batchable_feed_op(*locked.msg)) {
+        return timed_out;
+    }
+    // Queued operations towards the same bucket are visited in arrival order. Stop at the first
+    // operation that cannot be part of the batch, to avoid reordering operations to the bucket.
+    BucketIdx& idx(bmi::get<2>(*_queue));
+    auto range = idx.equal_range(bucket);
+    auto iter = range.first;
+    while ((iter != range.second) && (locked.batch.size() + 1 < max_batch_size)) {
+        const api::StorageMessage & cmd = *iter->_command;
+        if (!is_batchable_feed_op(cmd) || (cmd.getPriority() != locked.msg->getPriority())) {
+            break;
+        }
+        auto throttle_token = _owner.operation_throttler().try_acquire_one();
+        if (!throttle_token.valid()) {
+            break;
+        }
+        std::chrono::milliseconds waitTime(uint64_t(iter->_timer.stop(_metrics->averageQueueWaitingTime)));
+        std::shared_ptr<api::StorageMessage> msg = std::move(iter->_command);
+        iter = idx.erase(iter);
+        if (messageTimedOutInQueue(*msg, waitTime)) {
+            timed_out.emplace_back(makeQueueTimeoutReply(*msg));
+        } else {
+            locked.batch.push_back({std::move(msg), std::move(throttle_token)});
+        }
+    }
+    update_cached_queue_size(guard);
+    return timed_out;
+}
+
 void
 FileStorHandlerImpl::Stripe::waitUntilNoLocks() const
 {
@@ -179,6 +179,10 @@ public:
         FileStorHandler::LockedMessage getMessage(monitor_guard & guard, PriorityIdx & idx,
                                                   PriorityIdx::iterator iter,
                                                   ThrottleToken throttle_token);
+        // Precondition: `locked` holds the lock of `bucket`. Returns replies for timed out operations.
+        std::vector<std::shared_ptr<api::StorageReply>> collect_feed_op_batch(monitor_guard & guard,
+                                                                              const document::Bucket & bucket,
+                                                                              FileStorHandler::LockedMessage & locked);
         using LockedBuckets = vespalib::hash_map<document::Bucket, MultiLockEntry, document::Bucket::hash>;
         const FileStorHandlerImpl      &_owner;
         MessageSender                  &_messageSender;
@@ -295,6 +299,10 @@ public:
     // Implements ResumeGuard::Callback
     void resume() override;
 
+    void set_max_feed_op_batch_size(uint32_t max_batch_size) noexcept override {
+        _max_feed_op_batch_size.store(max_batch_size, std::memory_order_relaxed);
+    }
+
     // Use only for testing
     framework::MetricUpdateHook& get_metric_update_hook_for_testing() { return *this; }
 
@@ -315,6 +323,7 @@ private:
     mutable std::condition_variable _pauseCond;
     std::atomic<bool>               _paused;
     std::atomic<bool>               _throttle_apply_bucket_diff_ops;
+    std::atomic<uint32_t>           _max_feed_op_batch_size;
     std::optional<ActiveOperationsStats> _last_active_operations_stats;
 
     // Returns the index in the targets array we are sending to, or -1 if none of them match.
@@ -338,6 +347,10 @@ private:
         return _throttle_apply_bucket_diff_ops.load(std::memory_order_relaxed);
     }
 
+    [[nodiscard]] uint32_t max_feed_op_batch_size() const noexcept {
+        return _max_feed_op_batch_size.load(std::memory_order_relaxed);
+    }
+
     /**
      * Return whether msg has timed out based on waitTime and the message's
      * specified timeout.
@@ -215,6 +215,7 @@ FileStorManager::configure(std::unique_ptr<StorFilestorConfig> config)
     const bool use_dynamic_throttling = ((config->asyncOperationThrottlerType  == StorFilestorConfig::AsyncOperationThrottlerType::DYNAMIC) ||
                                          (config->asyncOperationThrottler.type == StorFilestorConfig::AsyncOperationThrottler::Type::DYNAMIC));
     const bool throttle_merge_feed_ops = config->asyncOperationThrottler.throttleIndividualMergeFeedOps;
+    const uint32_t max_feed_op_batch_size = std::max(1, config->maxFeedOpBatchSize);
 
     if (!liveUpdate) {
         _config = std::move(config);
@@ -245,6 +246,7 @@ FileStorManager::configure(std::unique_ptr<StorFilestorConfig> config)
     {
         _filestorHandler->use_dynamic_operation_throttling(use_dynamic_throttling);
         _filestorHandler->set_throttle_apply_bucket_diff_ops(!throttle_merge_feed_ops);
+        _filestorHandler->set_max_feed_op_batch_size(max_feed_op_batch_size);
         std::lock_guard guard(_lock);
         for (auto& ph : _persistenceHandlers) {
             ph->set_throttle_merge_feed_ops(throttle_merge_feed_ops);
@@ -284,6 +286,16 @@ FileStorManager::mapOperationToDisk(api::StorageMessage& msg, const document::Bu
     return entry;
 }
 
+bool
+FileStorManager::mapReadOnlyOperationToDisk(api::StorageMessage& msg, const document::Bucket& bucket)
+{
+    if (_component.getBucketDatabase(bucket.getBucketSpace()).snapshot_get(bucket.getBucketId())) {
+        return true;
+    }
+    replyWithBucketNotFound(msg, bucket);
+    return false;
+}
+
 StorBucketDatabase::WrappedEntry
 FileStorManager::mapOperationToBucketAndDisk(api::BucketCommand& cmd, const document::DocumentId* docId)
 {
@@ -414,6 +426,12 @@ FileStorManager::onUpdate(const shared_ptr<api::UpdateCommand>& cmd)
 bool
 FileStorManager::onGet(const shared_ptr<api::GetCommand>& cmd)
 {
+    // Common case: bucket exists as addressed, so there is no need to take its lock.
+    // Otherwise fall back to the locked lookup, which may remap the operation.
+    if (_component.getBucketDatabase(cmd->getBucket().getBucketSpace()).snapshot_get(cmd->getBucketId())) {
+        handlePersistenceMessage(cmd);
+        return true;
+    }
     StorBucketDatabase::WrappedEntry entry(mapOperationToBucketAndDisk(*cmd, &cmd->getDocumentId()));
     if (entry.exist()) {
         handlePersistenceMessage(cmd);
@@ -463,8 +481,7 @@ FileStorManager::onRemoveLocation(const std::shared_ptr<api::RemoveLocationComma
 bool
 FileStorManager::onStatBucket(const std::shared_ptr<api::StatBucketCommand>& cmd)
 {
-    StorBucketDatabase::WrappedEntry entry(mapOperationToDisk(*cmd, cmd->getBucket()));
-    if (entry.exist()) {
+    if (mapReadOnlyOperationToDisk(*cmd, cmd->getBucket())) {
         handlePersistenceMessage(cmd);
     }
     return true;
@@ -725,8 +742,7 @@ FileStorManager::onInternal(const shared_ptr<api::InternalCommand>& msg)
     case GetIterCommand::ID:
     {
         shared_ptr<GetIterCommand> cmd(std::static_pointer_cast<GetIterCommand>(msg));
-        StorBucketDatabase::WrappedEntry entry(mapOperationToDisk(*cmd, cmd->getBucket()));
-        if (entry.exist()) {
+        if (mapReadOnlyOperationToDisk(*cmd, cmd->getBucket())) {
             handlePersistenceMessage(cmd);
         }
         return true;
@@ -734,8 +750,7 @@ FileStorManager::onInternal(const shared_ptr<api::InternalCommand>& msg)
     case CreateIteratorCommand::ID:
     {
         shared_ptr<CreateIteratorCommand> cmd(std::static_pointer_cast<CreateIteratorCommand>(msg));
-        StorBucketDatabase::WrappedEntry entry(mapOperationToDisk(*cmd, cmd->getBucket()));
-        if (entry.exist()) {
+        if (mapReadOnlyOperationToDisk(*cmd, cmd->getBucket())) {
             handlePersistenceMessage(cmd);
         }
         return true;
@@ -757,8 +772,7 @@ FileStorManager::onInternal(const shared_ptr<api::InternalCommand>& msg)
     case ReadBucketInfo::ID:
     {
         shared_ptr<ReadBucketInfo> cmd(std::static_pointer_cast<ReadBucketInfo>(msg));
-        StorBucketDatabase::WrappedEntry entry(mapOperationToDisk(*cmd, cmd->getBucket()));
-        if (entry.exist()) {
+        if (mapReadOnlyOperationToDisk(*cmd, cmd->getBucket())) {
             handlePersistenceMessage(cmd);
         }
         return true;
@@ -141,6 +141,12 @@ private:
 
     StorBucketDatabase::WrappedEntry mapOperationToDisk(api::StorageMessage&, const document::Bucket&);
     StorBucketDatabase::WrappedEntry mapOperationToBucketAndDisk(api::BucketCommand&, const document::DocumentId*);
+    /**
+     * Lock-free variant of mapOperationToDisk for operations that only read
+     * the bucket. Replies with bucket not found and returns false if the
+     * bucket does not exist in a snapshot of the bucket database.
+     */
+    bool mapReadOnlyOperationToDisk(api::StorageMessage&, const document::Bucket&);
     bool handlePersistenceMessage(const std::shared_ptr<api::StorageMessage>&);
 
     // Document operations
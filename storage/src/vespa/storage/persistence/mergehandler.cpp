@@ -28,7 +28,8 @@ MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
                            const ClusterContext& cluster_context, const framework::Clock & clock,
                            vespalib::ISequencedTaskExecutor& executor,
                            uint32_t maxChunkSize,
-                           uint32_t commonMergeChainOptimalizationMinimumSize)
+                           uint32_t commonMergeChainOptimalizationMinimumSize,
+                           uint32_t maxFetchWindowSize)
     : _clock(clock),
       _cluster_context(cluster_context),
       _env(env),
@@ -36,6 +37,7 @@ MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
       _monitored_ref_count(std::make_unique<MonitoredRefCount>()),
       _maxChunkSize(maxChunkSize),
       _commonMergeChainOptimalizationMinimumSize(commonMergeChainOptimalizationMinimumSize),
+      _maxFetchWindowSize(std::max(1u, maxFetchWindowSize)),
       _executor(executor),
       _throttle_merge_feed_ops(true)
 {
@@ -391,13 +393,15 @@ MergeHandler::fetchLocalData(
     spi::IteratorId iteratorId(createIterResult.getIteratorId());
     IteratorGuard iteratorGuard(_spi, iteratorId);
 
-    // Fetch all entries
-    DocEntryList entries;
-    entries.reserve(slots.size());
+    // Serialize entries into the diff as they are iterated, so that at most
+    // one iteration window of documents is held in memory at a time.
+    document::BucketIdFactory idFactory;
+    const document::DocumentTypeRepo & repo = _env.getDocumentTypeRepo();
+    uint32_t fetchedCount = 0;
     bool fetchedAllLocalData = false;
     bool chunkLimitReached = false;
     while (true) {
-        spi::IterateResult result(_spi.iterate(iteratorId, remainingSize));
+        spi::IterateResult result(_spi.iterate(iteratorId, std::min(remainingSize, _maxFetchWindowSize)));
         if (result.getErrorCode() != spi::Result::ErrorType::NONE) {
             std::ostringstream ss;
             ss << "Failed to iterate for "
@@ -409,12 +413,14 @@ MergeHandler::fetchLocalData(
         auto list = result.steal_entries();
         for (auto& entry : list) {
             if (entry->getSize() <= remainingSize
-                || (entries.empty() && alreadyFilled == 0))
+                || (fetchedCount == 0 && alreadyFilled == 0))
             {
                 remainingSize -= entry->getSize();
-                entries.push_back(std::move(entry));
-                LOG(spam, "Added %s, remainingSize is %u",
-                    entries.back()->toString().c_str(), remainingSize);
+                LOG(spam, "Adding %s, remainingSize is %u",
+                    entry->toString().c_str(), remainingSize);
+                fillDiffEntry(bucket, *entry, diff, repo, idFactory);
+                entry.reset();
+                ++fetchedCount;
             } else {
                 LOG(spam, "Adding %s would exceed chunk size limit of %u; "
                     "not filling up any more diffs for current round",
@@ -431,45 +437,6 @@ MergeHandler::fetchLocalData(
         }
     }
 
-    document::BucketIdFactory idFactory;
-    const document::DocumentTypeRepo & repo = _env.getDocumentTypeRepo();
-
-    for (const auto& entry_ptr : entries) {
-        const auto& docEntry = *entry_ptr;
-        LOG(spam, "fetchLocalData: processing %s", docEntry.toString().c_str());
-
-        auto iter = std::lower_bound(diff.begin(), diff.end(),
-                                     api::Timestamp(docEntry.getTimestamp()),
-                                     DiffEntryTimestampPredicate());
-        assert(iter != diff.end());
-        assert(iter->_entry._timestamp == docEntry.getTimestamp());
-        api::ApplyBucketDiffCommand::Entry& e(*iter);
-
-        if (!docEntry.isRemove()) {
-            const document::Document* doc = docEntry.getDocument();
-            assert(doc != nullptr);
-            assertContainedInBucket(doc->getId(), bucket, idFactory);
-            e._docName = doc->getId().toString();
-            vespalib::nbostream stream;
-            doc->serialize(stream);
-            e._headerBlob.resize(stream.size());
-            memcpy(&e._headerBlob[0], stream.peek(), stream.size());
-            e._bodyBlob.clear();
-        } else {
-            const document::DocumentId* docId = docEntry.getDocumentId();
-            assert(docId != nullptr);
-            assertContainedInBucket(*docId, bucket, idFactory);
-            if (e._entry._flags & DELETED) {
-                e._docName = docId->toString();
-            } else {
-                LOG(debug, "Diff contains non-remove entry %s, but local entry "
-                    "was remove entry %s. Node will be removed from hasmask",
-                    e.toString().c_str(), docEntry.toString().c_str());
-            }
-        }
-        e._repo = &repo;
-     }
-
     for (auto& e : diff) {
         if ((e._entry._hasMask & nodeMask) == 0 || e.filled()) {
             continue;
@@ -482,9 +449,49 @@ MergeHandler::fetchLocalData(
         }
      }
 
-    LOG(spam, "Fetched %zu entries locally to fill out diff for %s. "
+    LOG(spam, "Fetched %u entries locally to fill out diff for %s. "
         "Still %d unfilled entries",
-        entries.size(), bucket.toString().c_str(), countUnfilledEntries(diff));
+        fetchedCount, bucket.toString().c_str(), countUnfilledEntries(diff));
+}
+
+void
+MergeHandler::fillDiffEntry(const spi::Bucket& bucket,
+                            const spi::DocEntry& docEntry,
+                            std::vector<api::ApplyBucketDiffCommand::Entry>& diff,
+                            const document::DocumentTypeRepo& repo,
+                            const document::BucketIdFactory& idFactory) const
+{
+    LOG(spam, "fetchLocalData: processing %s", docEntry.toString().c_str());
+
+    auto iter = std::lower_bound(diff.begin(), diff.end(),
+                                 api::Timestamp(docEntry.getTimestamp()),
+                                 DiffEntryTimestampPredicate());
+    assert(iter != diff.end());
+    assert(iter->_entry._timestamp == docEntry.getTimestamp());
+    api::ApplyBucketDiffCommand::Entry& e(*iter);
+
+    if (!docEntry.isRemove()) {
+        const document::Document* doc = docEntry.getDocument();
+        assert(doc != nullptr);
+        assertContainedInBucket(doc->getId(), bucket, idFactory);
+        e._docName = doc->getId().toString();
+        vespalib::nbostream stream(docEntry.getSize());
+        doc->serialize(stream);
+        e._headerBlob.assign(stream.peek(), stream.peek() + stream.size());
+        e._bodyBlob.clear();
+    } else {
+        const document::DocumentId* docId = docEntry.getDocumentId();
+        assert(docId != nullptr);
+        assertContainedInBucket(*docId, bucket, idFactory);
+        if (e._entry._flags & DELETED) {
+            e._docName = docId->toString();
+        } else {
+            LOG(debug, "Diff contains non-remove entry %s, but local entry "
+                "was remove entry %s. Node will be removed from hasmask",
+                e.toString().c_str(), docEntry.toString().c_str());
+        }
+    }
+    e._repo = &repo;
 }
 
 document::Document::UP
@@ -23,7 +23,10 @@
 #include <atomic>
 
 namespace vespalib { class ISequencedTaskExecutor; }
-namespace document { class Document; }
+namespace document {
+    class BucketIdFactory;
+    class Document;
+}
 namespace storage {
 
 namespace spi {
@@ -51,7 +54,8 @@ public:
                  const ClusterContext& cluster_context, const framework::Clock & clock,
                  vespalib::ISequencedTaskExecutor& executor,
                  uint32_t maxChunkSize = 4190208,
-                 uint32_t commonMergeChainOptimalizationMinimumSize = 64);
+                 uint32_t commonMergeChainOptimalizationMinimumSize = 64,
+                 uint32_t maxFetchWindowSize = 1048576);
 
     ~MergeHandler() override;
 
@@ -98,6 +102,7 @@ private:
     std::unique_ptr<vespalib::MonitoredRefCount> _monitored_ref_count;
     const uint32_t            _maxChunkSize;
     const uint32_t            _commonMergeChainOptimalizationMinimumSize;
+    const uint32_t            _maxFetchWindowSize;
     vespalib::ISequencedTaskExecutor& _executor;
     std::atomic<bool>         _throttle_merge_feed_ops;
 
@@ -128,6 +133,16 @@ private:
                           DocEntryList & entries,
                           spi::Context& context) const;
 
+    /**
+     * Serialize a document entry read from the persistence provider into
+     * the diff entry with the same timestamp.
+     */
+    void fillDiffEntry(const spi::Bucket&,
+                       const spi::DocEntry&,
+                       std::vector<api::ApplyBucketDiffCommand::Entry>& diff,
+                       const document::DocumentTypeRepo& repo,
+                       const document::BucketIdFactory& idFactory) const;
+
     std::unique_ptr<document::Document>
     deserializeDiffDocument(const api::ApplyBucketDiffCommand::Entry& e, const document::DocumentTypeRepo& repo) const;
 };
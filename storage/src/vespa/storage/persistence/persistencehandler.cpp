@@ -21,7 +21,8 @@ PersistenceHandler::PersistenceHandler(vespalib::ISequencedTaskExecutor & sequen
       _processAllHandler(_env, provider),
       _mergeHandler(_env, provider, component.cluster_context(), _clock, sequencedExecutor,
                     cfg.bucketMergeChunkSize,
-                    cfg.commonMergeChainOptimalizationMinimumSize),
+                    cfg.commonMergeChainOptimalizationMinimumSize,
+                    cfg.bucketMergeFetchWindowSize),
       _asyncHandler(_env, provider, bucketOwnershipNotifier, sequencedExecutor, component.getBucketIdFactory()),
       _splitJoinHandler(_env, provider, bucketOwnershipNotifier, cfg.enableMultibitSplitOptimalization),
       _simpleHandler(_env, provider)
@@ -169,6 +170,9 @@ PersistenceHandler::processMessage(api::StorageMessage& msg, MessageTracker::UP
 void
 PersistenceHandler::processLockedMessage(FileStorHandler::LockedMessage lock) const {
     LOG(debug, "NodeIndex %d, ptr=%p", _env._nodeIndex, lock.msg.get());
+    if ( ! lock.batch.empty()) {
+        return processLockedBatch(std::move(lock));
+    }
     api::StorageMessage & msg(*lock.msg);
 
     // Important: we _copy_ the message shared_ptr instead of moving to ensure that `msg` remains
@@ -181,6 +185,26 @@ PersistenceHandler::processLockedMessage(FileStorHandler::LockedMessage lock) co
     }
 }
 
+void
+PersistenceHandler::processLockedBatch(FileStorHandler::LockedMessage lock) const {
+    LOG(debug, "Handling batch of %zu feed operations to %s", lock.batch.size() + 1, lock.lock->getBucket().toString().c_str());
+    std::vector<std::pair<api::TestAndSetCommand*, MessageTracker::UP>> batch;
+    batch.reserve(lock.batch.size() + 1);
+    auto add = [&](std::shared_ptr<api::StorageMessage> msg, ThrottleToken throttle_token) {
+        MBUS_TRACE(msg->getTrace(), 5, "PersistenceHandler: Processing message in persistence layer as part of a batch");
+        _env._metrics.operations.inc();
+        auto * cmd = static_cast<api::TestAndSetCommand*>(msg.get());
+        batch.emplace_back(cmd, std::make_unique<MessageTracker>(framework::MilliSecTimer(_clock), _env, _env._fileStorHandler,
+                                                                 lock.lock, std::move(msg), std::move(throttle_token)));
+    };
+    add(std::move(lock.msg), std::move(lock.throttle_token));
+    for (auto & batched : lock.batch) {
+        add(std::move(batched.msg), std::move(batched.throttle_token));
+    }
+    OperationSyncPhaseTrackingGuard sync_guard(*batch.front().second);
+    _asyncHandler.handlePutOrRemoveBatch(std::move(batch));
+}
+
 void
 PersistenceHandler::set_throttle_merge_feed_ops(bool throttle) noexcept
 {
@@ -43,6 +43,7 @@ private:
     MessageTracker::UP handleReply(api::StorageReply&, MessageTracker::UP) const;
 
     MessageTracker::UP processMessage(api::StorageMessage& msg, MessageTracker::UP tracker) const;
+    void processLockedBatch(FileStorHandler::LockedMessage lock) const;
 
     const framework::Clock  & _clock;
     PersistenceUtil           _env;
@@ -159,6 +159,15 @@ ProviderErrorWrapper::removeAsync(const spi::Bucket &bucket, std::vector<spi::Id
     _impl.removeAsync(bucket, std::move(ids), std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::putOrRemoveBatchAsync(const spi::Bucket &bucket, std::vector<spi::BatchOperation> ops)
+{
+    for (auto & op : ops) {
+        op.getOnComplete().addResultHandler(this);
+    }
+    _impl.putOrRemoveBatchAsync(bucket, std::move(ops));
+}
+
 void
 ProviderErrorWrapper::removeIfFoundAsync(const spi::Bucket &bucket, spi::Timestamp ts, const document::DocumentId &docId,
                                          spi::OperationComplete::UP onComplete)
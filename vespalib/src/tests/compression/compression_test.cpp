@@ -3,6 +3,9 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +70,34 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+TEST("require that zstd compression/decompression with a trained dictionary works") {
+    vespalib::string samples;
+    std::vector<size_t> sampleSizes;
+    for (size_t i(0); i < 1000; i++) {
+        vespalib::string sample = make_string("{\"name\":\"user%zu\",\"email\":\"user%zu@example.com\",\"age\":%zu}", i, i, 20 + i % 50);
+        samples += sample;
+        sampleSizes.push_back(sample.size());
+    }
+    ZStdDictionary::SP dictionary = ZStdDictionary::train(samples.data(), sampleSizes, 4_Ki, 9);
+    ASSERT_TRUE(dictionary);
+    EXPECT_LESS_EQUAL(dictionary->getData().size(), 4_Ki);
+    ZStdDictionary copy(dictionary->getData().data(), dictionary->getData().size(), 9);
+    EXPECT_EQUAL(dictionary->getId(), copy.getId());
+
+    vespalib::string text = make_string("{\"name\":\"user%d\",\"email\":\"user%d@example.com\",\"age\":%d}", 4321, 4321, 33);
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 9, 100);
+    DataBuffer withDictionary;
+    DataBuffer withoutDictionary;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, dictionary.get(), ConstBufferRef(text.data(), text.size()), withDictionary, false));
+    compress(cfg, ConstBufferRef(text.data(), text.size()), withoutDictionary, false);
+    EXPECT_LESS(withDictionary.getDataLen(), withoutDictionary.getDataLen());
+    EXPECT_EQUAL(dictionary->getId(), ZStdCompressor::getDictionaryId(withDictionary.getData(), withDictionary.getDataLen()));
+
+    DataBuffer decompressed;
+    decompress(CompressionConfig::Type::ZSTD, &copy, text.size(), ConstBufferRef(withDictionary.getData(), withDictionary.getDataLen()), decompressed, false);
+    EXPECT_EQUAL(text, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
@@ -77,4 +77,24 @@ TEST(FuzzyMatcherTest, get_prefix_non_empty) {
     EXPECT_EQ(fuzzy.getPrefix(), "ab");
 }
 
+TEST(FuzzyMatcherTest, successor_for_non_matching_term) {
+    FuzzyMatcher fuzzy("abcd", 1, 2, false);
+    EXPECT_TRUE(fuzzy.supportsSuccessor());
+    vespalib::string successor;
+    EXPECT_TRUE(fuzzy.isMatch("ABxd", successor));
+    EXPECT_FALSE(fuzzy.isMatch("abzz", successor));
+    EXPECT_EQ(successor, "ab{cd");
+    EXPECT_FALSE(fuzzy.isMatch("aa", successor));
+    EXPECT_EQ(successor, "ab");
+    EXPECT_FALSE(fuzzy.isMatch("ac", successor));
+    EXPECT_EQ(successor, "");
+}
+
+TEST(FuzzyMatcherTest, successor_requires_max_edits_1_or_2) {
+    EXPECT_FALSE(FuzzyMatcher("abc", 0, 0, false).supportsSuccessor());
+    EXPECT_TRUE(FuzzyMatcher("abc", 1, 0, false).supportsSuccessor());
+    EXPECT_TRUE(FuzzyMatcher("abc", 2, 0, true).supportsSuccessor());
+    EXPECT_FALSE(FuzzyMatcher("abc", 3, 0, false).supportsSuccessor());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,138 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
+#include <vespa/vespalib/fuzzy/levenshtein_distance.h>
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+
+using namespace vespalib;
+using Codepoints = std::vector<uint32_t>;
+
+namespace {
+
+Codepoints ucs4(std::string_view str) {
+    return LowerCase::convert_to_ucs4(str);
+}
+
+void all_strings(std::vector<Codepoints>& out, Codepoints& current, size_t max_length, const Codepoints& alphabet) {
+    out.push_back(current);
+    if (current.size() == max_length) {
+        return;
+    }
+    for (uint32_t c : alphabet) {
+        current.push_back(c);
+        all_strings(out, current, max_length, alphabet);
+        current.pop_back();
+    }
+}
+
+std::vector<Codepoints> sorted_strings(size_t max_length, const Codepoints& alphabet) {
+    std::vector<Codepoints> result;
+    Codepoints current;
+    all_strings(result, current, max_length, alphabet);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}
+
+TEST(LevenshteinDfaTest, only_max_edits_1_and_2_are_supported) {
+    EXPECT_THROW(LevenshteinDfa(ucs4("abc"), 0, LevenshteinDfa::Casing::Uncased), IllegalArgumentException);
+    EXPECT_THROW(LevenshteinDfa(ucs4("abc"), 3, LevenshteinDfa::Casing::Uncased), IllegalArgumentException);
+}
+
+TEST(LevenshteinDfaTest, match_reports_edit_distance) {
+    LevenshteinDfa dfa(ucs4("abc"), 2, LevenshteinDfa::Casing::Uncased);
+    EXPECT_EQ(dfa.match(ucs4("abc")).edits(), 0u);
+    EXPECT_EQ(dfa.match(ucs4("ABC")).edits(), 0u);
+    EXPECT_EQ(dfa.match(ucs4("ab")).edits(), 1u);
+    EXPECT_EQ(dfa.match(ucs4("a1c")).edits(), 1u);
+    EXPECT_EQ(dfa.match(ucs4("xabcy")).edits(), 2u);
+    EXPECT_FALSE(dfa.match(ucs4("a12x")).matches());
+    EXPECT_FALSE(dfa.match(ucs4("abcdefgh")).matches());
+}
+
+TEST(LevenshteinDfaTest, cased_match_does_not_fold_source) {
+    LevenshteinDfa dfa(ucs4("abc"), 1, LevenshteinDfa::Casing::Cased);
+    EXPECT_TRUE(dfa.match(ucs4("abc")).matches());
+    EXPECT_TRUE(dfa.match(Codepoints{'a', 'B', 'c'}).matches());
+    EXPECT_FALSE(dfa.match(Codepoints{'A', 'B', 'c'}).matches());
+}
+
+TEST(LevenshteinDfaTest, successor_is_next_matching_string) {
+    LevenshteinDfa dfa(ucs4("cd"), 1, LevenshteinDfa::Casing::Uncased);
+    Codepoints successor;
+    EXPECT_FALSE(dfa.match(ucs4("zz"), &successor).matches());
+    EXPECT_EQ(successor, ucs4("{cd"));
+    EXPECT_FALSE(dfa.match(ucs4("aa"), &successor).matches());
+    EXPECT_EQ(successor, ucs4("acd"));
+    EXPECT_TRUE(dfa.match(ucs4("ced"), &successor).matches());
+    EXPECT_TRUE(successor.empty());
+}
+
+TEST(LevenshteinDfaTest, successor_can_extend_source) {
+    LevenshteinDfa dfa(ucs4("abcd"), 1, LevenshteinDfa::Casing::Uncased);
+    Codepoints successor;
+    EXPECT_FALSE(dfa.match(ucs4("a"), &successor).matches());
+    EXPECT_EQ(successor, ucs4("a\x01" "bcd"));
+}
+
+TEST(LevenshteinDfaTest, uncased_successor_skips_uppercase_codepoints) {
+    LevenshteinDfa dfa(ucs4("bc"), 1, LevenshteinDfa::Casing::Uncased);
+    Codepoints successor;
+    EXPECT_FALSE(dfa.match(ucs4("@zz"), &successor).matches());
+    EXPECT_EQ(successor, ucs4("[bc"));
+}
+
+TEST(LevenshteinDfaTest, successor_is_empty_when_no_greater_string_matches) {
+    LevenshteinDfa dfa(Codepoints{0x10ffff}, 1, LevenshteinDfa::Casing::Cased);
+    Codepoints successor;
+    EXPECT_FALSE(dfa.match(Codepoints{0x10ffff, 0x10ffff, 0x10ffff}, &successor).matches());
+    EXPECT_TRUE(successor.empty());
+}
+
+TEST(LevenshteinDfaTest, exhaustive_comparison_with_levenshtein_distance) {
+    Codepoints alphabet = ucs4("abcd");
+    auto sources = sorted_strings(5, alphabet);
+    auto targets = sorted_strings(3, alphabet);
+    for (uint8_t max_edits = 1; max_edits <= 2; ++max_edits) {
+        for (const auto& target : targets) {
+            LevenshteinDfa dfa(target, max_edits, LevenshteinDfa::Casing::Cased);
+            std::vector<bool> matches;
+            for (const auto& source : sources) {
+                auto expected = LevenshteinDistance::calculate(target, source, max_edits);
+                auto result = dfa.match(source);
+                ASSERT_EQ(expected.has_value(), result.matches());
+                if (expected.has_value()) {
+                    ASSERT_EQ(expected.value(), result.edits());
+                }
+                matches.push_back(result.matches());
+            }
+            Codepoints successor;
+            for (size_t i = 0; i < sources.size(); ++i) {
+                ASSERT_EQ(matches[i], dfa.match(sources[i], &successor).matches());
+                if (matches[i]) {
+                    continue;
+                }
+                size_t next = i + 1;
+                while (next < sources.size() && !matches[next]) {
+                    ++next;
+                }
+                if (successor.empty()) {
+                    ASSERT_EQ(next, sources.size());
+                    continue;
+                }
+                // successor is the smallest matching string greater than source
+                ASSERT_GT(successor, sources[i]);
+                ASSERT_TRUE(dfa.match(successor).matches());
+                if (next < sources.size()) {
+                    ASSERT_LE(successor, sources[next]);
+                }
+            }
+        }
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/time.h>
 #include <cinttypes>
 
@@ -38,6 +39,8 @@ benchMarkEuclidianDistance(const hwaccelrated::IAccelrated & accelrator, size_t
     benchmarkEuclideanDistance<double>(accelrator, sz, count);
     printf("float  : ");
     benchmarkEuclideanDistance<float>(accelrator, sz, count);
+    printf("bf16   : ");
+    benchmarkEuclideanDistance<BFloat16>(accelrator, sz, count);
     printf("int8_t : ");
     benchmarkEuclideanDistance<int8_t>(accelrator, sz, count);
 }
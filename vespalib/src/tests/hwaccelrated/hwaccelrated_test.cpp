@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/log/log.h>
 LOG_SETUP("hwaccelrated_test");
 
@@ -38,6 +39,62 @@ verifyEuclideanDistance(const hwaccelrated::IAccelrated & accelrator, size_t tes
     verifyEuclideanDistance<int8_t, double>(accelrator, testLength, 0.0);
     verifyEuclideanDistance<float, double>(accelrator, testLength, 0.0001); // Small deviation requiring EXPECT_APPROX
     verifyEuclideanDistance<double, double>(accelrator, testLength, 0.0);
+    verifyEuclideanDistance<BFloat16, double>(accelrator, testLength, 0.001);
+}
+
+void
+verifyBFloat16DotProduct(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<BFloat16> a = createAndFill<BFloat16>(testLength);
+    std::vector<BFloat16> b = createAndFill<BFloat16>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        double sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += double(a[i].to_float()) * double(b[i].to_float());
+        }
+        double hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        EXPECT_APPROX(sum, hwComputedSum, sum*0.001);
+    }
+}
+
+void
+verifyInt8DotProduct(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<int8_t> a = createAndFill<int8_t>(testLength);
+    std::vector<int8_t> b = createAndFill<int8_t>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += int64_t(a[i]) * int64_t(b[i]);
+        }
+        EXPECT_EQUAL(sum, accel.dotProduct(&a[j], &b[j], testLength - j));
+    }
+    std::vector<int8_t> min(testLength, -128);
+    std::vector<int8_t> max(testLength, 127);
+    EXPECT_EQUAL(int64_t(testLength) * 128 * 128, accel.dotProduct(&min[0], &min[0], testLength));
+    EXPECT_EQUAL(int64_t(testLength) * -128 * 127, accel.dotProduct(&min[0], &max[0], testLength));
+    EXPECT_EQUAL(int64_t(testLength) * 127 * -128, accel.dotProduct(&max[0], &min[0], testLength));
+}
+
+template<typename T>
+void verifyEuclideanDistanceWithLimit(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<T> a = createAndFill<T>(testLength);
+    std::vector<T> b = createAndFill<T>(testLength);
+    double full = accel.squaredEuclideanDistance(&a[0], &b[0], testLength);
+    EXPECT_APPROX(full, accel.squaredEuclideanDistanceWithLimit(&a[0], &b[0], testLength, 2*full), full*0.0001);
+    double limit = full / 10;
+    double partial = accel.squaredEuclideanDistanceWithLimit(&a[0], &b[0], testLength, limit);
+    EXPECT_GREATER(partial, limit);
+    EXPECT_LESS(partial, full);
+}
+
+void
+verifyEuclideanDistanceWithLimit(const hwaccelrated::IAccelrated & accelrator, size_t testLength) {
+    verifyEuclideanDistanceWithLimit<int8_t>(accelrator, testLength);
+    verifyEuclideanDistanceWithLimit<float>(accelrator, testLength);
+    verifyEuclideanDistanceWithLimit<double>(accelrator, testLength);
+    verifyEuclideanDistanceWithLimit<BFloat16>(accelrator, testLength);
 }
 
 TEST("test euclidean distance") {
@@ -47,4 +104,22 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
 }
 
+TEST("test euclidean distance with limit") {
+    constexpr size_t TEST_LENGTH = 1000;
+    TEST_DO(verifyEuclideanDistanceWithLimit(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyEuclideanDistanceWithLimit(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
+TEST("test bfloat16 dot product") {
+    constexpr size_t TEST_LENGTH = 140000;
+    TEST_DO(verifyBFloat16DotProduct(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyBFloat16DotProduct(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
+TEST("test int8 dot product") {
+    constexpr size_t TEST_LENGTH = 1100000; // must be longer than 1M to flush the 32-bit accumulators
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,86 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/io/io_uring_reader.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using vespalib::IoUringReader;
+using Request = IoUringReader::Request;
+
+namespace {
+
+const char *file_name = "io_uring_reader_test.dat";
+constexpr size_t file_size = 300000;
+
+class IoUringReaderTest : public ::testing::TestWithParam<uint32_t> {
+protected:
+    std::string _data;
+    int         _fd;
+
+    IoUringReaderTest()
+        : _data(),
+          _fd(-1)
+    {
+        for (size_t i = 0; i < file_size; ++i) {
+            _data.push_back(char('a' + (i * 7) % 26));
+        }
+        int fd = open(file_name, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        EXPECT_EQ(ssize_t(file_size), write(fd, _data.data(), _data.size()));
+        close(fd);
+        _fd = open(file_name, O_RDONLY);
+    }
+    ~IoUringReaderTest() override {
+        close(_fd);
+        unlink(file_name);
+    }
+};
+
+}
+
+TEST_P(IoUringReaderTest, reads_are_performed_for_all_requests_in_batch)
+{
+    IoUringReader reader(GetParam());
+    std::vector<std::vector<char>> bufs;
+    std::vector<Request> requests;
+    for (size_t i = 0; i < 200; ++i) {
+        bufs.emplace_back(1 + (i * 97) % 20000);
+    }
+    for (size_t i = 0; i < bufs.size(); ++i) {
+        requests.emplace_back(_fd, bufs[i].data(), bufs[i].size(), (i * 2917) % (file_size - 20000));
+    }
+    reader.read(requests);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        ASSERT_EQ(ssize_t(bufs[i].size()), requests[i].result);
+        EXPECT_EQ(0, memcmp(bufs[i].data(), _data.data() + requests[i].offset, bufs[i].size()));
+    }
+}
+
+TEST_P(IoUringReaderTest, short_reads_and_errors_are_reported_per_request)
+{
+    IoUringReader reader(GetParam());
+    std::vector<char> buf(100);
+    std::vector<Request> requests;
+    requests.emplace_back(_fd, buf.data(), 100, file_size - 10);
+    requests.emplace_back(_fd, buf.data(), 10, file_size);
+    requests.emplace_back(-1, buf.data(), 10, 0);
+    requests.emplace_back(_fd, buf.data(), 0, 0);
+    reader.read(requests);
+    EXPECT_EQ(10, requests[0].result);
+    EXPECT_EQ(0, requests[1].result);
+    EXPECT_EQ(-EBADF, requests[2].result);
+    EXPECT_EQ(0, requests[3].result);
+}
+
+// A queue depth of 0 is rejected by io_uring_setup, exercising the pread fallback.
+INSTANTIATE_TEST_SUITE_P(QueueDepths, IoUringReaderTest, ::testing::Values(0u, 4u, IoUringReader::default_queue_depth));
+
+TEST(IoUringReaderThreadLocalTest, thread_local_instance_is_reused)
+{
+    EXPECT_EQ(&IoUringReader::thread_local_instance(), &IoUringReader::thread_local_instance());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -82,6 +82,8 @@ TEST("testCacheEntriesHonoured") {
     EXPECT_TRUE( cache.hasKey(2) );
     EXPECT_FALSE( cache.hasKey(1) );
     EXPECT_EQUAL(96u, cache.sizeBytes());
+    EXPECT_EQUAL(1u, cache.getEvict());
+    EXPECT_EQUAL(0u, cache.getInvalidate());
 }
 
 TEST("testCacheMaxSizeHonoured") {
@@ -99,6 +101,7 @@ TEST("testCacheMaxSizeHonoured") {
     cache.write(4, "18 bytes stringggg");
     EXPECT_EQUAL(3u, cache.size());
     EXPECT_EQUAL(291u, cache.sizeBytes());
+    EXPECT_EQUAL(1u, cache.getEvict());
 }
 
 TEST("testThatMultipleRemoveOnOverflowIsFine") {
@@ -490,6 +490,27 @@ public:
     const AggrT &
     getAggregated() const;
 
+    /*
+     * Get aggregated values for the leaf node at the current iterator
+     * location, i.e. for a block of keys containing the current key.
+     * Only valid when the iterator is valid.
+     */
+    const AggrT &
+    getLeafAggregated() const
+    {
+        return _leaf.getNode()->getAggregated();
+    }
+
+    /*
+     * Get the last key in the leaf node at the current iterator location.
+     * Only valid when the iterator is valid.
+     */
+    const KeyType &
+    getLeafLastKey() const
+    {
+        return _leaf.getNode()->getLastKey();
+    }
+
     bool
     identical(const BTreeIteratorBase &rhs) const;
 
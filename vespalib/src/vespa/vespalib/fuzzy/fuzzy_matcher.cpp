@@ -5,6 +5,8 @@
 
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/vespalib/text/utf8.h>
+#include <algorithm>
+#include <cassert>
 
 namespace {
 
@@ -18,6 +20,22 @@ namespace {
         return result;
     }
 
+    std::optional<vespalib::LevenshteinDfa> make_dfa(std::span<const uint32_t> suffix, uint32_t max_edit_distance, bool is_cased) {
+        if (max_edit_distance < 1 || max_edit_distance > vespalib::LevenshteinDfa::max_supported_edits) {
+            return std::nullopt;
+        }
+        return vespalib::LevenshteinDfa(std::vector<uint32_t>(suffix.begin(), suffix.end()), max_edit_distance,
+                                        is_cased ? vespalib::LevenshteinDfa::Casing::Cased
+                                                 : vespalib::LevenshteinDfa::Casing::Uncased);
+    }
+
+    void append_utf8(vespalib::string& dst, std::span<const uint32_t> codepoints) {
+        vespalib::Utf8Writer writer(dst);
+        for (uint32_t code : codepoints) {
+            writer.putChar(code);
+        }
+    }
+
 } // anonymous
 
 vespalib::FuzzyMatcher::FuzzyMatcher():
@@ -26,7 +44,8 @@ vespalib::FuzzyMatcher::FuzzyMatcher():
         _is_cased(false),
         _folded_term_codepoints(),
         _folded_term_codepoints_prefix(),
-        _folded_term_codepoints_suffix()
+        _folded_term_codepoints_suffix(),
+        _dfa()
 {}
 
 vespalib::FuzzyMatcher::FuzzyMatcher(std::string_view term, uint32_t max_edit_distance, uint32_t prefix_size, bool is_cased):
@@ -35,7 +54,8 @@ vespalib::FuzzyMatcher::FuzzyMatcher(std::string_view term, uint32_t max_edit_di
         _is_cased(is_cased),
         _folded_term_codepoints(_is_cased ? cased_convert_to_ucs4(term) : LowerCase::convert_to_ucs4(term)),
         _folded_term_codepoints_prefix(get_prefix(_folded_term_codepoints, _prefix_size)),
-        _folded_term_codepoints_suffix(get_suffix(_folded_term_codepoints, _prefix_size))
+        _folded_term_codepoints_suffix(get_suffix(_folded_term_codepoints, _prefix_size)),
+        _dfa(make_dfa(_folded_term_codepoints_suffix, _max_edit_distance, _is_cased))
 {}
 
 std::span<const uint32_t> vespalib::FuzzyMatcher::get_prefix(const std::vector<uint32_t>& termCodepoints, uint32_t prefixLength) {
@@ -74,11 +94,38 @@ bool vespalib::FuzzyMatcher::isMatch(std::string_view target) const {
             _max_edit_distance).has_value();
 }
 
+bool vespalib::FuzzyMatcher::isMatch(std::string_view target, vespalib::string& successor) const {
+    assert(_dfa.has_value());
+    successor.clear();
+    std::vector<uint32_t> targetCodepoints = _is_cased ? cased_convert_to_ucs4(target) : LowerCase::convert_to_ucs4(target);
+
+    if (_prefix_size > 0) {
+        std::span<const uint32_t> targetPrefix = get_prefix(targetCodepoints, _prefix_size);
+        if (std::lexicographical_compare(targetPrefix.begin(), targetPrefix.end(),
+                                         _folded_term_codepoints_prefix.begin(), _folded_term_codepoints_prefix.end())) {
+            // every match starts with the term prefix, which sorts after target
+            append_utf8(successor, _folded_term_codepoints_prefix);
+            return false;
+        }
+        if (!std::equal(_folded_term_codepoints_prefix.begin(), _folded_term_codepoints_prefix.end(),
+                        targetPrefix.begin(), targetPrefix.end())) {
+            return false;
+        }
+    }
+
+    std::vector<uint32_t> suffix_successor;
+    if (_dfa->match(get_suffix(targetCodepoints, _prefix_size), &suffix_successor).matches()) {
+        return true;
+    }
+    if (!suffix_successor.empty()) {
+        append_utf8(successor, _folded_term_codepoints_prefix);
+        append_utf8(successor, suffix_successor);
+    }
+    return false;
+}
+
 vespalib::string vespalib::FuzzyMatcher::getPrefix() const {
     vespalib::string prefix;
-    Utf8Writer writer(prefix);
-    for (const uint32_t& code: _folded_term_codepoints_prefix) {
-        writer.putChar(code);
-    }
+    append_utf8(prefix, _folded_term_codepoints_prefix);
     return prefix;
 }
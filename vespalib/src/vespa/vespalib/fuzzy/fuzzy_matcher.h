@@ -1,6 +1,9 @@
 // Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "levenshtein_dfa.h"
+
+#include <optional>
 #include <string_view>
 #include <vector>
 #include <span>
@@ -17,6 +20,10 @@ namespace vespalib {
  * Prefix size dictates of how match of a prefix is frozen,
  * i.e. if prefixes between the document and the query do not match (after lowercase)
  * matcher would return false early, without fuzzy match.
+ *
+ * For max edit distance 1 and 2 a Levenshtein automaton is used, which in addition to
+ * matching can tell the smallest string greater than a non-matching target that may match.
+ * This lets dictionary scans skip entries that can never match.
  */
 class FuzzyMatcher {
 private:
@@ -32,6 +39,8 @@ private:
     std::span<const uint32_t> _folded_term_codepoints_prefix;
     std::span<const uint32_t> _folded_term_codepoints_suffix;
 
+    std::optional<LevenshteinDfa> _dfa; // matching the suffix
+
 public:
     FuzzyMatcher();
 
@@ -39,6 +48,16 @@ public:
 
     [[nodiscard]] bool isMatch(std::string_view target) const;
 
+    /**
+     * Match target against the term. If target does not match, successor is set to the UTF-8
+     * encoded smallest string greater than target that may match, or cleared if there is none.
+     * For uncased matching strings are ordered by their lowercased codepoints, otherwise by
+     * their codepoints. Only available when supportsSuccessor() returns true.
+     */
+    [[nodiscard]] bool isMatch(std::string_view target, vespalib::string& successor) const;
+
+    [[nodiscard]] bool supportsSuccessor() const noexcept { return _dfa.has_value(); }
+
     [[nodiscard]] vespalib::string getPrefix() const;
 
     static std::span<const uint32_t> get_prefix(const std::vector<uint32_t>& termCodepoints, uint32_t prefixLength);
@@ -0,0 +1,210 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "levenshtein_dfa.h"
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib {
+
+namespace {
+
+constexpr uint32_t max_codepoint = 0x10ffff;
+constexpr uint32_t surrogate_first = 0xd800;
+constexpr uint32_t surrogate_last = 0xdfff;
+
+}
+
+LevenshteinDfa::LevenshteinDfa(std::vector<uint32_t> target, uint8_t max_edits, Casing casing)
+    : _target(std::move(target)),
+      _max_edits(max_edits),
+      _casing(casing)
+{
+    if (max_edits < 1 || max_edits > max_supported_edits) {
+        throw IllegalArgumentException("LevenshteinDfa only supports max edits 1 or 2");
+    }
+}
+
+LevenshteinDfa::LevenshteinDfa(LevenshteinDfa&&) noexcept = default;
+LevenshteinDfa& LevenshteinDfa::operator=(LevenshteinDfa&&) noexcept = default;
+LevenshteinDfa::LevenshteinDfa(const LevenshteinDfa&) = default;
+LevenshteinDfa& LevenshteinDfa::operator=(const LevenshteinDfa&) = default;
+LevenshteinDfa::~LevenshteinDfa() = default;
+
+uint32_t
+LevenshteinDfa::fold(uint32_t c) const noexcept
+{
+    return (_casing == Casing::Uncased) ? LowerCase::convert(c) : c;
+}
+
+LevenshteinDfa::State
+LevenshteinDfa::start() const noexcept
+{
+    const int64_t k = _max_edits;
+    const int64_t n = _target.size();
+    const uint8_t inf = _max_edits + 1;
+    State state;
+    state.index = 0;
+    state.cost.fill(inf);
+    for (int64_t t = 0; t <= 2 * k; ++t) {
+        int64_t j = t - k;
+        if (j >= 0 && j <= n) {
+            state.cost[t] = static_cast<uint8_t>(std::min(j, k + 1));
+        }
+    }
+    return state;
+}
+
+LevenshteinDfa::State
+LevenshteinDfa::step(const State& state, uint32_t c) const noexcept
+{
+    const int64_t k = _max_edits;
+    const int64_t n = _target.size();
+    const uint32_t inf = _max_edits + 1;
+    const int64_t band = 2 * k + 1;
+    State next;
+    next.index = state.index + 1;
+    next.cost.fill(inf);
+    // Entry t of both bands refers to target prefix length j = index - k + t,
+    // thus old entry t is the diagonal predecessor of new entry t.
+    for (int64_t t = 0; t < band; ++t) {
+        int64_t j = int64_t(next.index) - k + t;
+        if (j < 0 || j > n) {
+            continue;
+        }
+        uint32_t cost = inf;
+        if (j > 0) {
+            cost = state.cost[t] + ((_target[j - 1] == c) ? 0u : 1u);
+        }
+        if (t + 1 < band) {
+            cost = std::min(cost, state.cost[t + 1] + 1u);
+        }
+        if (t > 0) {
+            cost = std::min(cost, next.cost[t - 1] + 1u);
+        }
+        next.cost[t] = static_cast<uint8_t>(std::min(cost, inf));
+    }
+    return next;
+}
+
+bool
+LevenshteinDfa::can_match(const State& state) const noexcept
+{
+    const uint32_t band = 2 * _max_edits + 1;
+    return *std::min_element(state.cost.begin(), state.cost.begin() + band) <= _max_edits;
+}
+
+uint8_t
+LevenshteinDfa::edits(const State& state) const noexcept
+{
+    int64_t t = int64_t(_target.size()) - int64_t(state.index) + _max_edits;
+    if (t < 0 || t > 2 * _max_edits) {
+        return _max_edits + 1;
+    }
+    return state.cost[t];
+}
+
+/*
+ * Find the smallest codepoint above c that keeps the automaton in a state
+ * that can still match. Any codepoint not present in the target window of
+ * the state behaves identically (as an edit), so it is sufficient to test
+ * c + 1 and the target codepoints above it. Returns 0 if there is none.
+ */
+uint32_t
+LevenshteinDfa::smallest_transition_above(const State& state, uint32_t c) const noexcept
+{
+    std::array<uint32_t, max_band_size + 1> candidates;
+    uint32_t num_candidates = 0;
+    uint32_t next = c + 1;
+    while (next <= max_codepoint && ((next >= surrogate_first && next <= surrogate_last) || fold(next) != next)) {
+        ++next;
+    }
+    if (next <= max_codepoint) {
+        candidates[num_candidates++] = next;
+    }
+    const int64_t k = _max_edits;
+    for (int64_t t = 0; t < 2 * k + 1; ++t) {
+        int64_t j = int64_t(state.index) - k + t;
+        if (j >= 0 && j < int64_t(_target.size()) && _target[j] > c) {
+            candidates[num_candidates++] = _target[j];
+        }
+    }
+    std::sort(candidates.begin(), candidates.begin() + num_candidates);
+    for (uint32_t i = 0; i < num_candidates; ++i) {
+        if (can_match(step(state, candidates[i]))) {
+            return candidates[i];
+        }
+    }
+    return 0;
+}
+
+void
+LevenshteinDfa::append_smallest_match_suffix(State state, std::vector<uint32_t>& out) const
+{
+    while (edits(state) > _max_edits) {
+        uint32_t c = smallest_transition_above(state, 0);
+        assert(c != 0);
+        out.push_back(c);
+        state = step(state, c);
+    }
+}
+
+LevenshteinDfa::MatchResult
+LevenshteinDfa::match(std::span<const uint32_t> source, std::vector<uint32_t>* successor_out) const
+{
+    if (successor_out == nullptr) {
+        State state = start();
+        for (uint32_t c : source) {
+            state = step(state, fold(c));
+            if (!can_match(state)) {
+                return MatchResult::make_mismatch(_max_edits);
+            }
+        }
+        uint8_t state_edits = edits(state);
+        return (state_edits <= _max_edits)
+            ? MatchResult::make_match(_max_edits, state_edits)
+            : MatchResult::make_mismatch(_max_edits);
+    }
+    std::vector<State> path;
+    path.reserve(source.size() + 1);
+    path.push_back(start());
+    for (uint32_t c : source) {
+        State next = step(path.back(), fold(c));
+        if (!can_match(next)) {
+            break;
+        }
+        path.push_back(next);
+    }
+    size_t consumed = path.size() - 1;
+    auto& out = *successor_out;
+    out.clear();
+    if (consumed == source.size()) {
+        uint8_t state_edits = edits(path.back());
+        if (state_edits <= _max_edits) {
+            return MatchResult::make_match(_max_edits, state_edits);
+        }
+        // All of source can be extended into a match, the smallest such extension is the successor.
+        for (uint32_t c : source) {
+            out.push_back(fold(c));
+        }
+        append_smallest_match_suffix(path.back(), out);
+        return MatchResult::make_mismatch(_max_edits);
+    }
+    // Find the longest source prefix that can be followed by a codepoint greater than
+    // the one in source while still being able to match.
+    for (size_t depth = consumed + 1; depth-- > 0;) {
+        uint32_t c = smallest_transition_above(path[depth], fold(source[depth]));
+        if (c != 0) {
+            for (size_t i = 0; i < depth; ++i) {
+                out.push_back(fold(source[i]));
+            }
+            out.push_back(c);
+            append_smallest_match_suffix(step(path[depth], c), out);
+            break;
+        }
+    }
+    return MatchResult::make_mismatch(_max_edits);
+}
+
+}
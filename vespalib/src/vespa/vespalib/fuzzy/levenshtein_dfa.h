@@ -0,0 +1,104 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Levenshtein automaton matching source strings within a maximum edit
+ * distance (1 or 2) of a fixed target string. Both strings are given as
+ * UCS-4 codepoints.
+ *
+ * The automaton state after consuming a source prefix is the band of the
+ * Levenshtein distance matrix row that can still be within max edits of
+ * the target, i.e. at most 2 * max_edits + 1 entries. States are evaluated
+ * lazily one codepoint at a time, so matching is linear in the source length
+ * and terminates as soon as no completion of the source prefix can match.
+ *
+ * In addition to plain matching, the automaton can produce the successor of
+ * a non-matching source string: the lexicographically (codepoint order)
+ * smallest string greater than the source that matches the target. This
+ * allows a caller scanning a sorted dictionary to skip directly to the next
+ * possible candidate instead of testing every entry in between.
+ *
+ * With uncased matching the target is expected to be lowercased, source
+ * strings are lowercased while matching and successor strings only contain
+ * codepoints that are unchanged by lowercasing, so that they can be used for
+ * seeking in a dictionary ordered by lowercased values.
+ */
+class LevenshteinDfa {
+public:
+    enum class Casing { Uncased, Cased };
+
+    class MatchResult {
+        uint8_t _max_edits;
+        uint8_t _edits;
+    public:
+        constexpr MatchResult(uint8_t max_edits, uint8_t edits) noexcept
+            : _max_edits(max_edits),
+              _edits(edits)
+        {}
+        static constexpr MatchResult make_match(uint8_t max_edits, uint8_t edits) noexcept {
+            return {max_edits, edits};
+        }
+        static constexpr MatchResult make_mismatch(uint8_t max_edits) noexcept {
+            return {max_edits, static_cast<uint8_t>(max_edits + 1)};
+        }
+        [[nodiscard]] constexpr bool matches() const noexcept { return _edits <= _max_edits; }
+        [[nodiscard]] constexpr uint8_t edits() const noexcept { return _edits; }
+        [[nodiscard]] constexpr uint8_t max_edits() const noexcept { return _max_edits; }
+    };
+
+    static constexpr uint8_t max_supported_edits = 2;
+
+private:
+    static constexpr uint32_t max_band_size = 2 * max_supported_edits + 1;
+
+    // Band of the distance matrix row after consuming 'index' source codepoints.
+    // cost[i] holds the (capped) distance to the target prefix of length
+    // index - max_edits + i.
+    struct State {
+        uint32_t index;
+        std::array<uint8_t, max_band_size> cost;
+    };
+
+    std::vector<uint32_t> _target;
+    uint8_t               _max_edits;
+    Casing                _casing;
+
+    [[nodiscard]] State start() const noexcept;
+    [[nodiscard]] State step(const State& state, uint32_t c) const noexcept;
+    [[nodiscard]] bool can_match(const State& state) const noexcept;
+    [[nodiscard]] uint8_t edits(const State& state) const noexcept;
+    [[nodiscard]] uint32_t fold(uint32_t c) const noexcept;
+    [[nodiscard]] uint32_t smallest_transition_above(const State& state, uint32_t c) const noexcept;
+    void append_smallest_match_suffix(State state, std::vector<uint32_t>& out) const;
+
+public:
+    LevenshteinDfa(std::vector<uint32_t> target, uint8_t max_edits, Casing casing);
+    LevenshteinDfa(LevenshteinDfa&&) noexcept;
+    LevenshteinDfa& operator=(LevenshteinDfa&&) noexcept;
+    LevenshteinDfa(const LevenshteinDfa&);
+    LevenshteinDfa& operator=(const LevenshteinDfa&);
+    ~LevenshteinDfa();
+
+    [[nodiscard]] uint8_t max_edits() const noexcept { return _max_edits; }
+    [[nodiscard]] Casing casing() const noexcept { return _casing; }
+
+    /**
+     * Match source against the target. If source does not match and
+     * successor_out is non-null, it is set to the smallest matching string
+     * that is greater than source, or cleared if no such string exists.
+     */
+    [[nodiscard]] MatchResult match(std::span<const uint32_t> source, std::vector<uint32_t>* successor_out) const;
+
+    [[nodiscard]] MatchResult match(std::span<const uint32_t> source) const {
+        return match(source, nullptr);
+    }
+};
+
+}
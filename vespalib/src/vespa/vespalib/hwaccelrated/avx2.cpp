@@ -5,6 +5,12 @@
 
 namespace vespalib::hwaccelrated {
 
+float
+Avx2Accelrator::dotProduct(const BFloat16 * af, const BFloat16 * bf, size_t sz) const
+{
+    return avx::bfloat16DotProductT<32>(af, bf, sz);
+}
+
 size_t
 Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const {
     return helper::populationCount(a, sz);
@@ -25,6 +31,11 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+double
+Avx2Accelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return avx::bfloat16EuclideanDistanceT<32>(a, b, sz);
+}
+
 void
 Avx2Accelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<32u, 2u>(offset, src, dest);
@@ -0,0 +1,44 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "avx512_bf16.h"
+#include <vespa/vespalib/util/bfloat16.h>
+#include <immintrin.h>
+
+namespace vespalib::hwaccelrated {
+
+namespace {
+
+inline __m512bh
+loadBFloat16(const BFloat16 * p) {
+    return (__m512bh)_mm512_loadu_si512(p);
+}
+
+}
+
+float
+Avx512Bf16Accelrator::dotProduct(const BFloat16 * af, const BFloat16 * bf, size_t sz) const
+{
+    // vdpbf16ps multiplies 32 pairs of bfloat16 values exactly and accumulates them pairwise into 16 floats.
+    constexpr size_t ElemsPerVector = 32;
+    constexpr size_t VectorsPerChunk = 4;
+    constexpr size_t ChunkSize = ElemsPerVector*VectorsPerChunk;
+    __m512 partial[VectorsPerChunk];
+    for (size_t j(0); j < VectorsPerChunk; j++) {
+        partial[j] = _mm512_setzero_ps();
+    }
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            const size_t offset = i*ChunkSize + j*ElemsPerVector;
+            partial[j] = _mm512_dpbf16_ps(partial[j], loadBFloat16(af + offset), loadBFloat16(bf + offset));
+        }
+    }
+    float sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        sum += af[i].to_float() * bf[i].to_float();
+    }
+    __m512 total = _mm512_add_ps(_mm512_add_ps(partial[0], partial[1]), _mm512_add_ps(partial[2], partial[3]));
+    return sum + _mm512_reduce_add_ps(total);
+}
+
+}
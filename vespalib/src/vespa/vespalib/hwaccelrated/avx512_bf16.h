@@ -0,0 +1,18 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "avx512_vnni.h"
+
+namespace vespalib::hwaccelrated {
+
+/**
+ * Avx-512 implementation for cpus also supporting the AVX512_BF16 extension.
+ */
+class Avx512Bf16Accelrator : public Avx512VnniAccelrator
+{
+public:
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const override;
+};
+
+}
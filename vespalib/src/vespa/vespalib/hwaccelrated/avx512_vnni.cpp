@@ -0,0 +1,61 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "avx512_vnni.h"
+#include <immintrin.h>
+#include <algorithm>
+
+namespace vespalib::hwaccelrated {
+
+namespace {
+
+inline int64_t
+reduceAddWide(__m512i v) {
+    __m512i lo = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v));
+    __m512i hi = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1));
+    return _mm512_reduce_add_epi64(_mm512_add_epi64(lo, hi));
+}
+
+}
+
+int64_t
+Avx512VnniAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    // vpdpbusd multiplies unsigned with signed bytes and accumulates 4 products into each 32-bit lane.
+    // a is moved into unsigned range by adding 128, which is compensated for by subtracting 128*sum(b).
+    // A lane grows by less than 2^17 per chunk, so lanes are flushed into a 64-bit sum well before overflow.
+    constexpr size_t ElemsPerVector = 64;
+    constexpr size_t VectorsPerChunk = 4;
+    constexpr size_t ChunkSize = ElemsPerVector*VectorsPerChunk;
+    constexpr size_t ChunksPerBlock = 4096;
+    const __m512i signBit = _mm512_set1_epi8(-128);
+    const __m512i ones = _mm512_set1_epi8(1);
+    const size_t numChunks(sz/ChunkSize);
+    int64_t sum(0);
+    for (size_t i(0); i < numChunks;) {
+        __m512i product[VectorsPerChunk];
+        __m512i bSum[VectorsPerChunk];
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            product[j] = _mm512_setzero_si512();
+            bSum[j] = _mm512_setzero_si512();
+        }
+        const size_t blockEnd(std::min(numChunks, i + ChunksPerBlock));
+        for (; i < blockEnd; i++) {
+            for (size_t j(0); j < VectorsPerChunk; j++) {
+                const size_t offset = i*ChunkSize + j*ElemsPerVector;
+                __m512i av = _mm512_xor_si512(_mm512_loadu_si512(a + offset), signBit);
+                __m512i bv = _mm512_loadu_si512(b + offset);
+                product[j] = _mm512_dpbusd_epi32(product[j], av, bv);
+                bSum[j] = _mm512_dpbusd_epi32(bSum[j], ones, bv);
+            }
+        }
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            sum += reduceAddWide(product[j]) - 128 * reduceAddWide(bSum[j]);
+        }
+    }
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        sum += int32_t(a[i]) * int32_t(b[i]);
+    }
+    return sum;
+}
+
+}
@@ -0,0 +1,18 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "avx512.h"
+
+namespace vespalib::hwaccelrated {
+
+/**
+ * Avx-512 implementation for cpus also supporting the AVX512_VNNI extension.
+ */
+class Avx512VnniAccelrator : public Avx512Accelrator
+{
+public:
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+};
+
+}
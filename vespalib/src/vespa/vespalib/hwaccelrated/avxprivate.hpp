@@ -3,7 +3,9 @@
 #pragma once
 
 #include "private_helpers.hpp"
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/fastos/types.h>
+#include <cstring>
 
 namespace vespalib::hwaccelrated::avx {
 
@@ -134,4 +136,92 @@ double euclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz)
     }
 }
 
+template <unsigned VLEN> struct BFloat16Vectors;
+
+template <> struct BFloat16Vectors<32> {
+    typedef float F __attribute__ ((vector_size (32)));
+    typedef uint32_t U __attribute__ ((vector_size (32)));
+    typedef uint16_t H __attribute__ ((vector_size (16)));
+};
+
+template <> struct BFloat16Vectors<64> {
+    typedef float F __attribute__ ((vector_size (64)));
+    typedef uint32_t U __attribute__ ((vector_size (64)));
+    typedef uint16_t H __attribute__ ((vector_size (32)));
+};
+
+/**
+ * Widens VLEN/sizeof(float) consecutive bfloat16 values to a vector of floats.
+ * A bfloat16 is the upper half of the float with the same value, so a zero extend
+ * and a shift is all that is needed.
+ */
+template <unsigned VLEN>
+inline typename BFloat16Vectors<VLEN>::F
+loadBFloat16(const BFloat16 * p)
+{
+    using V = typename BFloat16Vectors<VLEN>::F;
+    using U = typename BFloat16Vectors<VLEN>::U;
+    using H = typename BFloat16Vectors<VLEN>::H;
+    H h;
+    memcpy(&h, p, sizeof(H));
+    U u = __builtin_convertvector(h, U) << 16;
+    return (V)u;
+}
+
+template <unsigned VLEN>
+float
+bfloat16DotProductT(const BFloat16 * af, const BFloat16 * bf, size_t sz)
+{
+    constexpr unsigned VectorsPerChunk = 4;
+    constexpr unsigned ElemsPerVector = VLEN/sizeof(float);
+    constexpr unsigned ChunkSize = ElemsPerVector*VectorsPerChunk;
+    using V = typename BFloat16Vectors<VLEN>::F;
+    V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            const size_t offset = (VectorsPerChunk*i + j) * ElemsPerVector;
+            partial[j] += loadBFloat16<VLEN>(af + offset) * loadBFloat16<VLEN>(bf + offset);
+        }
+    }
+    float sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        sum += af[i].to_float() * bf[i].to_float();
+    }
+    partial[0] = sumR<V, VectorsPerChunk>(partial);
+
+    return sum + sumT<float, V>(partial[0]);
+}
+
+template <unsigned VLEN>
+double
+bfloat16EuclideanDistanceT(const BFloat16 * af, const BFloat16 * bf, size_t sz)
+{
+    constexpr unsigned VectorsPerChunk = 4;
+    constexpr unsigned ElemsPerVector = VLEN/sizeof(float);
+    constexpr unsigned ChunkSize = ElemsPerVector*VectorsPerChunk;
+    using V = typename BFloat16Vectors<VLEN>::F;
+    V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            const size_t offset = (VectorsPerChunk*i + j) * ElemsPerVector;
+            V d = loadBFloat16<VLEN>(af + offset) - loadBFloat16<VLEN>(bf + offset);
+            partial[j] += d * d;
+        }
+    }
+    double sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        float d = af[i].to_float() - bf[i].to_float();
+        sum += d * d;
+    }
+    partial[0] = sumR<V, VectorsPerChunk>(partial);
+
+    return sum + sumT<float, V>(partial[0]);
+}
+
 }
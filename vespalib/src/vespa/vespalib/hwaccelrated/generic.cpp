@@ -2,7 +2,9 @@
 
 #include "generic.h"
 #include "private_helpers.hpp"
+#include <vespa/vespalib/util/bfloat16.h>
 #include <cblas.h>
+#include <algorithm>
 
 namespace vespalib::hwaccelrated {
 
@@ -32,23 +34,23 @@ multiplyAdd(const T * a, const T * b, size_t sz)
     return sum;
 }
 
-template <typename T, size_t UNROLL>
+template <typename T, size_t UNROLL, typename ACCUM = T>
 double
 squaredEuclideanDistanceT(const T * a, const T * b, size_t sz)
 {
-    T partial[UNROLL];
+    ACCUM partial[UNROLL];
     for (size_t i(0); i < UNROLL; i++) {
         partial[i] = 0;
     }
     size_t i(0);
     for (; i + UNROLL <= sz; i += UNROLL) {
         for (size_t j(0); j < UNROLL; j++) {
-            T d = a[i+j] - b[i+j];
+            ACCUM d = ACCUM(a[i+j]) - ACCUM(b[i+j]);
             partial[j] += d * d;
         }
     }
     for (;i < sz; i++) {
-        T d = a[i] - b[i];
+        ACCUM d = ACCUM(a[i]) - ACCUM(b[i]);
         partial[i%UNROLL] += d * d;
     }
     double sum(0);
@@ -58,6 +60,22 @@ squaredEuclideanDistanceT(const T * a, const T * b, size_t sz)
     return sum;
 }
 
+/**
+ * Calculates the squared euclidean distance in blocks of BLOCK_SIZE cells using the
+ * (possibly cpu specific) full distance kernel, checking the limit between blocks.
+ */
+template <typename T>
+double
+squaredEuclideanDistanceWithLimitT(const IAccelrated & accel, const T * a, const T * b, size_t sz, double limit)
+{
+    constexpr size_t BLOCK_SIZE = 128;
+    double sum(0);
+    for (size_t i(0); (i < sz) && (sum <= limit); i += BLOCK_SIZE) {
+        sum += accel.squaredEuclideanDistance(a + i, b + i, std::min(BLOCK_SIZE, sz - i));
+    }
+    return sum;
+}
+
 template<size_t UNROLL, typename Operation>
 void
 bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes) {
@@ -121,6 +139,12 @@ GenericAccelrator::dotProduct(const int64_t * a, const int64_t * b, size_t sz) c
     return multiplyAdd<long long, int64_t, 8>(a, b, sz);
 }
 
+float
+GenericAccelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const
+{
+    return multiplyAdd<float, BFloat16, 8>(a, b, sz);
+}
+
 void
 GenericAccelrator::orBit(void * aOrg, const void * bOrg, size_t bytes) const
 {
@@ -172,6 +196,31 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return squaredEuclideanDistanceT<double, 2>(a, b, sz);
 }
 
+double
+GenericAccelrator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const {
+    return squaredEuclideanDistanceT<BFloat16, 2, float>(a, b, sz);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistanceWithLimit(const int8_t * a, const int8_t * b, size_t sz, double limit) const {
+    return squaredEuclideanDistanceWithLimitT(*this, a, b, sz, limit);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistanceWithLimit(const float * a, const float * b, size_t sz, double limit) const {
+    return squaredEuclideanDistanceWithLimitT(*this, a, b, sz, limit);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistanceWithLimit(const double * a, const double * b, size_t sz, double limit) const {
+    return squaredEuclideanDistanceWithLimitT(*this, a, b, sz, limit);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistanceWithLimit(const BFloat16 * a, const BFloat16 * b, size_t sz, double limit) const {
+    return squaredEuclideanDistanceWithLimitT(*this, a, b, sz, limit);
+}
+
 void
 GenericAccelrator::and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const {
     helper::andChunks<16, 4>(offset, src, dest);
@@ -5,7 +5,10 @@
 #ifdef __x86_64__
 #include "avx2.h"
 #include "avx512.h"
+#include "avx512_vnni.h"
+#include "avx512_bf16.h"
 #endif
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/memory.h>
 #include <cstdio>
 #include <vector>
@@ -20,6 +23,12 @@ namespace {
 IAccelrated::UP create_accelerator() {
 #ifdef __x86_64__
     __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bf16") && __builtin_cpu_supports("avx512vnni")) {
+        return std::make_unique<Avx512Bf16Accelrator>();
+    }
+    if (__builtin_cpu_supports("avx512vnni")) {
+        return std::make_unique<Avx512VnniAccelrator>();
+    }
     if (__builtin_cpu_supports("avx512f")) {
         return std::make_unique<Avx512Accelrator>();
     }
@@ -80,6 +89,31 @@ verifyEuclideanDistance(const IAccelrated & accel) {
     }
 }
 
+void
+verifyBFloat16(const IAccelrated & accel) {
+    const size_t testLength(255);
+    srand(1);
+    std::vector<BFloat16> a = createAndFill<BFloat16>(testLength);
+    std::vector<BFloat16> b = createAndFill<BFloat16>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        float dotProduct(0);
+        float distance(0);
+        for (size_t i(j); i < testLength; i++) {
+            dotProduct += a[i].to_float() * b[i].to_float();
+            float d = a[i].to_float() - b[i].to_float();
+            distance += d * d;
+        }
+        if (dotProduct != accel.dotProduct(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing bfloat16 dotproduct correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+        if (distance != float(accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j))) {
+            fprintf(stderr, "Accelrator is not computing bfloat16 euclidean distance correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
 void
 verifyPopulationCount(const IAccelrated & accel)
 {
@@ -222,6 +256,7 @@ private:
         verifyDotproduct<int64_t>(accelrated);
         verifyEuclideanDistance<float>(accelrated);
         verifyEuclideanDistance<double>(accelrated);
+        verifyBFloat16(accelrated);
         verifyPopulationCount(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <vector>
 
+namespace vespalib { class BFloat16; }
+
 namespace vespalib::hwaccelrated {
 
 /**
@@ -23,6 +25,7 @@ public:
     virtual int64_t dotProduct(const int16_t * a, const int16_t * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const = 0;
+    virtual float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
@@ -31,6 +34,13 @@ public:
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const = 0;
+    // Accumulates the squared euclidean distance in blocks and stops as soon as the sum exceeds limit.
+    // In that case the returned value is larger than limit, but smaller than the full distance.
+    virtual double squaredEuclideanDistanceWithLimit(const int8_t * a, const int8_t * b, size_t sz, double limit) const = 0;
+    virtual double squaredEuclideanDistanceWithLimit(const float * a, const float * b, size_t sz, double limit) const = 0;
+    virtual double squaredEuclideanDistanceWithLimit(const double * a, const double * b, size_t sz, double limit) const = 0;
+    virtual double squaredEuclideanDistanceWithLimit(const BFloat16 * a, const BFloat16 * b, size_t sz, double limit) const = 0;
     // AND 64 bytes from multiple, optionally inverted sources
     virtual void and64(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const = 0;
     // OR 64 bytes from multiple, optionally inverted sources
@@ -0,0 +1,294 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "io_uring_reader.h"
+#include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.io.io_uring_reader");
+
+namespace vespalib {
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+
+/**
+ * The shared memory rings of a single io_uring instance, set up with
+ * the raw system calls to avoid depending on liburing.
+ */
+class IoUringReader::Ring {
+    int           _fd;
+    uint32_t      _sq_entries;
+    uint32_t      _cq_entries;
+    void         *_sq_ptr;
+    size_t        _sq_size;
+    void         *_cq_ptr;
+    size_t        _cq_size;
+    io_uring_sqe *_sqes;
+    size_t        _sqes_size;
+    uint32_t     *_sq_tail;
+    uint32_t      _sq_mask;
+    uint32_t     *_sq_array;
+    uint32_t     *_cq_head;
+    uint32_t     *_cq_tail;
+    uint32_t      _cq_mask;
+    io_uring_cqe *_cqes;
+
+    // Largest length of a single read; longer requests are completed by resubmission.
+    static constexpr size_t max_read_len = size_t(1) << 30;
+
+    static uint32_t * at(void *base, uint32_t offset) noexcept {
+        return reinterpret_cast<uint32_t *>(static_cast<char *>(base) + offset);
+    }
+    Ring(int fd, const io_uring_params &p) noexcept;
+    bool map() noexcept;
+    bool supports_read() const;
+    int enter(uint32_t to_submit, uint32_t min_complete) noexcept {
+        return syscall(__NR_io_uring_enter, _fd, to_submit, min_complete, IORING_ENTER_GETEVENTS, nullptr, 0);
+    }
+public:
+    static std::unique_ptr<Ring> create(uint32_t queue_depth);
+    ~Ring();
+    void read(std::span<Request> requests);
+};
+
+IoUringReader::Ring::Ring(int fd, const io_uring_params &p) noexcept
+    : _fd(fd),
+      _sq_entries(p.sq_entries),
+      _cq_entries(p.cq_entries),
+      _sq_ptr(MAP_FAILED),
+      _sq_size(p.sq_off.array + p.sq_entries * sizeof(uint32_t)),
+      _cq_ptr(MAP_FAILED),
+      _cq_size(p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe)),
+      _sqes(static_cast<io_uring_sqe *>(MAP_FAILED)),
+      _sqes_size(p.sq_entries * sizeof(io_uring_sqe)),
+      _sq_tail(nullptr),
+      _sq_mask(0),
+      _sq_array(nullptr),
+      _cq_head(nullptr),
+      _cq_tail(nullptr),
+      _cq_mask(0),
+      _cqes(nullptr)
+{
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        _sq_size = _cq_size = std::max(_sq_size, _cq_size);
+    }
+    if (map()) {
+        _sq_tail = at(_sq_ptr, p.sq_off.tail);
+        _sq_mask = *at(_sq_ptr, p.sq_off.ring_mask);
+        _sq_array = at(_sq_ptr, p.sq_off.array);
+        _cq_head = at(_cq_ptr, p.cq_off.head);
+        _cq_tail = at(_cq_ptr, p.cq_off.tail);
+        _cq_mask = *at(_cq_ptr, p.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe *>(static_cast<char *>(_cq_ptr) + p.cq_off.cqes);
+    }
+}
+
+bool
+IoUringReader::Ring::map() noexcept
+{
+    _sq_ptr = mmap(nullptr, _sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_sq_ptr == MAP_FAILED) {
+        return false;
+    }
+    _cq_ptr = (_cq_size == _sq_size)
+        ? _sq_ptr
+        : mmap(nullptr, _cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+    if (_cq_ptr == MAP_FAILED) {
+        return false;
+    }
+    _sqes = static_cast<io_uring_sqe *>(mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES));
+    return (_sqes != MAP_FAILED);
+}
+
+bool
+IoUringReader::Ring::supports_read() const
+{
+    // IORING_OP_READ and IORING_REGISTER_PROBE were both added in Linux 5.6,
+    // so a kernel rejecting the probe does not support the read opcode either.
+    constexpr uint32_t num_ops = IORING_OP_READ + 1;
+    std::vector<char> storage(sizeof(io_uring_probe) + num_ops * sizeof(io_uring_probe_op), 0);
+    auto *probe = reinterpret_cast<io_uring_probe *>(storage.data());
+    if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PROBE, probe, num_ops) < 0) {
+        return false;
+    }
+    return (probe->ops_len > IORING_OP_READ) && ((probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0);
+}
+
+IoUringReader::Ring::~Ring()
+{
+    if (_sqes != MAP_FAILED) {
+        munmap(_sqes, _sqes_size);
+    }
+    if ((_cq_ptr != MAP_FAILED) && (_cq_ptr != _sq_ptr)) {
+        munmap(_cq_ptr, _cq_size);
+    }
+    if (_sq_ptr != MAP_FAILED) {
+        munmap(_sq_ptr, _sq_size);
+    }
+    close(_fd);
+}
+
+std::unique_ptr<IoUringReader::Ring>
+IoUringReader::Ring::create(uint32_t queue_depth)
+{
+    io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    int fd = syscall(__NR_io_uring_setup, queue_depth, &p);
+    if (fd < 0) {
+        LOG(debug, "io_uring_setup(%u) failed: %s, using pread", queue_depth, getErrorString(errno).c_str());
+        return {};
+    }
+    std::unique_ptr<Ring> ring(new Ring(fd, p));
+    if (ring->_cqes == nullptr) {
+        LOG(debug, "Mapping io_uring queues failed: %s, using pread", getErrorString(errno).c_str());
+        return {};
+    }
+    if (!ring->supports_read()) {
+        LOG(debug, "io_uring does not support IORING_OP_READ, using pread");
+        return {};
+    }
+    return ring;
+}
+
+void
+IoUringReader::Ring::read(std::span<Request> requests)
+{
+    std::vector<size_t> done(requests.size(), 0);
+    std::vector<uint32_t> pending;
+    pending.reserve(requests.size());
+    for (uint32_t i = requests.size(); i-- > 0; ) {
+        if (requests[i].len > 0) {
+            pending.push_back(i);
+        } else {
+            requests[i].result = 0;
+        }
+    }
+    // The completion queue is at least as large as the submission queue,
+    // so limiting the number of reads in flight to the latter avoids overflow.
+    uint32_t in_flight = 0;
+    uint32_t unsubmitted = 0;
+    while (!pending.empty() || (in_flight > 0)) {
+        uint32_t sq_tail = *_sq_tail;
+        while (!pending.empty() && (in_flight < _sq_entries)) {
+            uint32_t i = pending.back();
+            pending.pop_back();
+            const Request &req = requests[i];
+            uint32_t idx = sq_tail & _sq_mask;
+            io_uring_sqe &sqe = _sqes[idx];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = req.fd;
+            sqe.addr = reinterpret_cast<uint64_t>(static_cast<char *>(req.buf) + done[i]);
+            sqe.len = std::min(req.len - done[i], max_read_len);
+            sqe.off = req.offset + done[i];
+            sqe.user_data = i;
+            _sq_array[idx] = idx;
+            ++sq_tail;
+            ++in_flight;
+            ++unsubmitted;
+        }
+        __atomic_store_n(_sq_tail, sq_tail, __ATOMIC_RELEASE);
+        int ret = enter(unsubmitted, 1);
+        if (ret < 0) {
+            if ((errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY)) {
+                continue;
+            }
+            throw IllegalStateException(make_string("io_uring_enter failed: %s", getErrorString(errno).c_str()), VESPA_STRLOC);
+        }
+        unsubmitted -= ret;
+        uint32_t cq_head = *_cq_head;
+        uint32_t cq_tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+        for (; cq_head != cq_tail; ++cq_head) {
+            const io_uring_cqe &cqe = _cqes[cq_head & _cq_mask];
+            uint32_t i = cqe.user_data;
+            Request &req = requests[i];
+            --in_flight;
+            if ((cqe.res == -EAGAIN) || (cqe.res == -EINTR)) {
+                pending.push_back(i);
+            } else if (cqe.res < 0) {
+                req.result = cqe.res;
+            } else {
+                done[i] += cqe.res;
+                if ((cqe.res > 0) && (done[i] < req.len)) {
+                    pending.push_back(i);
+                } else {
+                    req.result = done[i];
+                }
+            }
+        }
+        __atomic_store_n(_cq_head, cq_head, __ATOMIC_RELEASE);
+    }
+}
+
+#else
+
+class IoUringReader::Ring {
+public:
+    static std::unique_ptr<Ring> create(uint32_t) { return {}; }
+    void read(std::span<Request>) { }
+};
+
+#endif
+
+IoUringReader::IoUringReader(uint32_t queue_depth)
+    : _ring(Ring::create(queue_depth))
+{
+}
+
+IoUringReader::~IoUringReader() = default;
+
+void
+IoUringReader::read_with_pread(std::span<Request> requests)
+{
+    for (Request &req : requests) {
+        ssize_t result = 0;
+        while (size_t(result) < req.len) {
+            ssize_t ret = pread(req.fd, static_cast<char *>(req.buf) + result, req.len - result, req.offset + result);
+            if (ret > 0) {
+                result += ret;
+            } else if (ret == 0) {
+                break;
+            } else if (errno != EINTR) {
+                result = -errno;
+                break;
+            }
+        }
+        req.result = result;
+    }
+}
+
+void
+IoUringReader::read(std::span<Request> requests)
+{
+    if (_ring) {
+        _ring->read(requests);
+        // Some file systems and file types do not support io_uring reads; retry those with pread.
+        for (Request &req : requests) {
+            if ((req.result == -EINVAL) || (req.result == -EOPNOTSUPP)) {
+                read_with_pread(std::span<Request>(&req, 1));
+            }
+        }
+    } else {
+        read_with_pread(requests);
+    }
+}
+
+IoUringReader &
+IoUringReader::thread_local_instance()
+{
+    thread_local IoUringReader reader(default_queue_depth);
+    return reader;
+}
+
+}
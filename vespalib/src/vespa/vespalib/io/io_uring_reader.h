@@ -0,0 +1,63 @@
+// Copyright Yahoo. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <sys/types.h>
+
+namespace vespalib {
+
+/**
+ * Performs batches of positional file reads using an io_uring
+ * submission/completion queue pair, allowing all reads of a batch to
+ * be in flight at the same time instead of blocking the calling
+ * thread for each of them in turn.
+ *
+ * If io_uring is not available (old kernel without IORING_OP_READ,
+ * disabled by sysctl or seccomp, memlock limits), reads are performed
+ * one by one using pread. Reads rejected by io_uring with EINVAL or
+ * EOPNOTSUPP are retried using pread. An instance is not thread safe;
+ * use thread_local_instance() to get a reader owned by the calling
+ * thread.
+ */
+class IoUringReader {
+public:
+    struct Request {
+        int      fd;
+        void    *buf;
+        size_t   len;
+        uint64_t offset;
+        // Number of bytes read (less than len only at end of file), or -errno.
+        ssize_t  result;
+
+        Request(int fd_in, void *buf_in, size_t len_in, uint64_t offset_in) noexcept
+            : fd(fd_in), buf(buf_in), len(len_in), offset(offset_in), result(0)
+        {}
+    };
+    static constexpr uint32_t default_queue_depth = 64;
+
+    explicit IoUringReader(uint32_t queue_depth);
+    IoUringReader(const IoUringReader &) = delete;
+    IoUringReader & operator=(const IoUringReader &) = delete;
+    ~IoUringReader();
+
+    bool is_using_io_uring() const noexcept { return bool(_ring); }
+
+    /**
+     * Perform all the given reads, returning when all of them are
+     * done. The result of each read is stored in the request.
+     */
+    void read(std::span<Request> requests);
+
+    static IoUringReader & thread_local_instance();
+private:
+    class Ring;
+    void read_with_pread(std::span<Request> requests);
+
+    std::unique_ptr<Ring> _ring;
+};
+
+}
@@ -121,6 +121,7 @@ public:
     size_t        getWrite() const { return _write.load(std::memory_order_relaxed); }
     size_t   getInvalidate() const { return _invalidate.load(std::memory_order_relaxed); }
     size_t       getlookup() const { return _lookup.load(std::memory_order_relaxed); }
+    size_t        getEvict() const { return _evict.load(std::memory_order_relaxed); }
 
 protected:
     using UniqueLock = std::unique_lock<std::mutex>;
@@ -165,6 +166,7 @@ private:
     mutable std::atomic<size_t> _update;
     mutable std::atomic<size_t> _invalidate;
     mutable std::atomic<size_t> _lookup;
+    std::atomic<size_t>         _evict;
     BackingStore      & _store;
     mutable std::mutex  _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
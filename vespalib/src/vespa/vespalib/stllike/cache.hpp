@@ -59,6 +59,7 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _update(0),
     _invalidate(0),
     _lookup(0),
+    _evict(0),
     _store(b)
 { }
 
@@ -68,6 +69,7 @@ cache<P>::removeOldest(const value_type & v) {
     bool remove(Lru::removeOldest(v) || (sizeBytes() >= capacityBytes()));
     if (remove) {
         _sizeBytes.store(sizeBytes() - calcSize(v.first, v.second._value), std::memory_order_relaxed);
+        _evict.store(getEvict() + 1, std::memory_order_relaxed);
     }
     return remove;
 }
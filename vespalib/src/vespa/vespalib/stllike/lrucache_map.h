@@ -160,6 +160,9 @@ public:
      * on the real size of the object pointed to.
      */
     virtual bool removeOldest(const value_type & v);
+    /**
+     * Called when an object leaves the cache, either erased or evicted as the oldest.
+     */
     virtual void onRemove(const K & key);
     virtual void onInsert(const K & key);
 
@@ -3,6 +3,7 @@
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -33,6 +34,40 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(const void * data, size_t sz, int compressionLevel)
+    : _data(static_cast<const char *>(data), static_cast<const char *>(data) + sz),
+      _id(ZSTD_getDictID_fromDict(data, sz)),
+      _compressionLevel(compressionLevel),
+      _cdict(ZSTD_createCDict(_data.data(), _data.size(), compressionLevel)),
+      _ddict(ZSTD_createDDict(_data.data(), _data.size()))
+{
+    assert(_cdict != nullptr);
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const void * samples, const std::vector<size_t> & sampleSizes, size_t maxSize, int compressionLevel)
+{
+    std::vector<char> dict(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples, sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return {};
+    }
+    return std::make_shared<ZStdDictionary>(dict.data(), sz, compressionLevel);
+}
+
+uint32_t
+ZStdCompressor::getDictionaryId(const void * input, size_t inputLen)
+{
+    return ZSTD_getDictID_fromFrame(input, inputLen);
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -42,7 +77,9 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, _dictionary->getCompressDict())
+                : ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -54,7 +91,9 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = ((_dictionary != nullptr) && (getDictionaryId(inputV, inputLen) != 0))
+                ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen, _dictionary->getDecompressDict())
+                : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
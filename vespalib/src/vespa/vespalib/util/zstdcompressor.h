@@ -2,15 +2,70 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary, either trained from sample data or loaded from its
+ * serialized form. Both the compression and decompression dictionaries are
+ * digested up front so that they can be shared by all users of the dictionary
+ * without paying the setup cost for every buffer.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    ZStdDictionary(const void * data, size_t sz, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary from the given samples.
+     * @param samples All samples stored back to back.
+     * @param sampleSizes The size of each sample.
+     * @param maxSize The maximum size of the dictionary.
+     * @param compressionLevel The compression level used when compressing with the dictionary.
+     * @return The dictionary, or empty if there was not enough samples to train it.
+     */
+    static SP train(const void * samples, const std::vector<size_t> & sampleSizes, size_t maxSize, int compressionLevel);
+
+    uint32_t getId() const { return _id; }
+    int getCompressionLevel() const { return _compressionLevel; }
+    ConstBufferRef getData() const { return {_data.data(), _data.size()}; }
+    const ZSTD_CDict_s * getCompressDict() const { return _cdict; }
+    const ZSTD_DDict_s * getDecompressDict() const { return _ddict; }
+private:
+    std::vector<char> _data;
+    uint32_t          _id;
+    int               _compressionLevel;
+    ZSTD_CDict_s    * _cdict;
+    ZSTD_DDict_s    * _ddict;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() noexcept : _dictionary(nullptr) { }
+    /**
+     * Compress using the given dictionary, if not null. Frames without a
+     * dictionary id are still decompressed without the dictionary.
+     */
+    explicit ZStdCompressor(const ZStdDictionary * dictionary) noexcept : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+    /**
+     * Return the id of the dictionary needed to decompress the given frame, 0 if none is needed.
+     */
+    static uint32_t getDictionaryId(const void * input, size_t inputLen);
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }